@@ -72,6 +72,9 @@ namespace Isis {
     // Get the MatchDEM Flag
     m.SetMatchDEM(ui.GetBoolean("MATCHDEM"));
 
+    // Place the inputs on the mosaic together instead of one at a time
+    m.StartBatch();
+
     bool mosaicCreated = false;
     for (int i = 0; i < list.size(); i++) {
       if (!m.StartProcess(list[i].toString())) {
@@ -92,6 +95,8 @@ namespace Isis {
         m.SetCreateFlag(false);
       }
     }
+    m.EndBatch();
+
     // Logs the input file location in the mosaic
     for (int i = 0; i < m.imagePositions().groups(); i++) {
       if (log) {
@@ -101,19 +101,19 @@ void FFT1(vector<Buffer *> &in, vector<Buffer *> &out) {
   Buffer &image = *in[0];
 
   int n = image.size();
-  std::vector< std::complex<double> > input(n);
+  std::vector<double> input(n);
 
-  // copy the input data into a complex vector
+  // copy the input data into a real vector
   for(int i = 0; i < n; i++) {
     if(IsSpecial(image[i])) {
       if(IsHrsPixel(image[i]) || IsHisPixel(image[i])) input[i] = HPixel;
       else if(IsLrsPixel(image[i]) || IsLisPixel(image[i])) input[i] = LPixel;
       else input[i] = NPixel;
     }
-    else input[i] = std::complex<double>(image[i]);
+    else input[i] = image[i];
   }
 
-  // perform the fourier transform
+  // perform the fourier transform of the real data
   std::vector< std::complex<double> > output = fft.Transform(input);
   n = output.size();
 
@@ -1,3 +1,5 @@
+#include <QList>
+
 #include "ProcessRubberSheet.h"
 #include "ProjectionFactory.h"
 #include "TProjection.h"
@@ -365,10 +367,28 @@ namespace Isis {
       throw IException(IException::Programmer, msg, _FILEINFO_);
     }
 
+    // Map projections keep the state of their last conversion, so give every
+    //   thread its own copies of the projections to warp tiles in parallel
+    QList<Projection *> threadProjections;
+    bool trim = ui.GetBoolean("TRIM");
+    p.setTransformFactory([&]() -> Transform * {
+      TProjection *threadInproj =
+          (TProjection *) ProjectionFactory::CreateFromCube(*icube->label());
+      TProjection *threadOutproj =
+          (TProjection *) ProjectionFactory::CreateFromCube(*ocube->label());
+      threadProjections << threadInproj << threadOutproj;
+
+      return new Map2map(icube->sampleCount(), icube->lineCount(), threadInproj,
+                         transform->OutputSamples(), transform->OutputLines(),
+                         threadOutproj, trim);
+    });
+
     // Warp the cube
     p.StartProcess(*transform, *interp);
     p.EndProcess();
 
+    qDeleteAll(threadProjections);
+
     if (log){
       log->addLogGroup(cleanOutGrp);
     }
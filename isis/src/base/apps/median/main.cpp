@@ -119,6 +119,7 @@ void FilterValid(Buffer &in, double &v) {
   //to the center. If there are, sort the vector and write
   //the median value to the center.
   std::vector<double> boxdata(0);
+  boxdata.reserve(in.size());
   for(int i = 0; i < in.size(); i++) {
     if(!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
       boxdata.push_back(in[i]);
@@ -137,8 +138,10 @@ void FilterValid(Buffer &in, double &v) {
       return;
     }
   }
-  sort(boxdata.begin(), boxdata.end());
-  v = boxdata[(boxdata.size()-1)/2];
+  // Only the median needs to be in its sorted position
+  std::vector<double>::iterator median = boxdata.begin() + (boxdata.size()-1)/2;
+  nth_element(boxdata.begin(), median, boxdata.end());
+  v = *median;
 }
 
 //Function to loop through the boxcar and find and write
@@ -181,6 +184,7 @@ void FilterInvalid(Buffer &in, double &v) {
   //If there aren't enough to meet the minimum requirements,
   //write a user-selected value to the center pixel.
   std::vector<double> boxdata(0);
+  boxdata.reserve(in.size());
 
   for(int i = 0; i < in.size(); i++) {
     if(!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
@@ -200,8 +204,10 @@ void FilterInvalid(Buffer &in, double &v) {
       return;
     }
   }
-  sort(boxdata.begin(), boxdata.end());
-  v = boxdata[(boxdata.size()-1)/2];
+  // Only the median needs to be in its sorted position
+  std::vector<double>::iterator median = boxdata.begin() + (boxdata.size()-1)/2;
+  nth_element(boxdata.begin(), median, boxdata.end());
+  v = *median;
 }
 
 //Function to find the median value of the boxcar and
@@ -240,6 +246,7 @@ void FilterAll(Buffer &in, double &v) {
   //If there aren't enough to meet the minimum requirements,
   //write a user-selected value to the center pixel.
   std::vector<double> boxdata(0);
+  boxdata.reserve(in.size());
 
   for(int i = 0; i < in.size(); i++) {
     if(!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
@@ -259,7 +266,9 @@ void FilterAll(Buffer &in, double &v) {
       return;
     }
   }
-  sort(boxdata.begin(), boxdata.end());
-  v = boxdata[(boxdata.size()-1)/2];
+  // Only the median needs to be in its sorted position
+  std::vector<double>::iterator median = boxdata.begin() + (boxdata.size()-1)/2;
+  nth_element(boxdata.begin(), median, boxdata.end());
+  v = *median;
 }
 
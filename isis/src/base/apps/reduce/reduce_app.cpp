@@ -1,3 +1,4 @@
+#include "FileName.h"
 #include "IException.h"
 #include "IString.h"
 #include "ProcessByLine.h"
@@ -5,6 +6,7 @@
 #include "Reduce.h"
 
 
+#include <algorithm>
 #include <cmath>
 
 using namespace std;
@@ -12,6 +14,15 @@ namespace Isis{
 
   void reduce(UserInterface &ui, Pvl *log) {
     try {
+      // Build the overviews before the input cube is opened for reading
+      QString overviews = ui.GetString("OVERVIEWS");
+      if (overviews == "CREATE") {
+        Cube overviewCube;
+        overviewCube.open(FileName(ui.GetCubeName("FROM")).expanded(), "rw");
+        overviewCube.createOverviews();
+        overviewCube.close();
+      }
+
       // We will be processing by line
       ProcessByLine p;
       double sscale, lscale;
@@ -60,6 +71,15 @@ namespace Isis{
         throw IException(IException::User, msg, _FILEINFO_);
       }
 
+      // Average from the coarsest overview level that is not coarser than the output
+      int overviewLevel = 0;
+      if (overviews != "NONE" && alg == "AVERAGE") {
+        while (overviewLevel < inCube.overviewCount() &&
+               (1 << (overviewLevel + 1)) <= min(sscale, lscale)) {
+          overviewLevel++;
+        }
+      }
+
       //  Allocate output file
       CubeAttributeOutput &att = ui.GetOutputAttribute("TO");
       Cube *ocube = p.SetOutputCube(ui.GetCubeName("TO"), att, ons, onl, inb);
@@ -71,6 +91,7 @@ namespace Isis{
       PvlGroup results;
       if(alg == "AVERAGE"){
         Average average(&inCube, sscale, lscale, vper, replaceMode);
+        average.setOverviewLevel(overviewLevel);
         p.ProcessCubeInPlace(average, false);
         results = average.UpdateOutputLabel(ocube);
       }
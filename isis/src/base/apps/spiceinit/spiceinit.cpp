@@ -2,12 +2,14 @@
 #include <queue>
 
 #include <QList>
+#include <QSharedPointer>
 #include <QString>
 #include <QStringList>
 #include <QVector>
 
 #include "Camera.h"
 #include "CameraFactory.h"
+#include "FileList.h"
 #include "FileName.h"
 #include "IException.h"
 #include "Kernel.h"
@@ -15,6 +17,7 @@
 #include "Longitude.h"
 #include "Process.h"
 #include "PvlToPvlTranslationManager.h"
+#include "Spice.h"
 #include "SpiceClient.h"
 #include "SpiceClientStarter.h"
 #include "Blob.h"
@@ -26,6 +29,15 @@ using namespace std;
 
 namespace Isis {
 
+  //! The system kernel databases loaded for the last cube, kept for the next cube that uses them
+  struct SystemKernelDbs {
+    QString mission;                       //!< The mission the databases were loaded for
+    QSharedPointer<KernelDb> baseKernels;  //!< The database for kernels of any quality
+    QSharedPointer<KernelDb> ckKernels;    //!< The database for the selected CK qualities
+    QSharedPointer<KernelDb> spkKernels;   //!< The database for the selected SPK qualities
+  };
+
+  void spiceinit(Cube *icube, UserInterface &ui, Pvl *log, SystemKernelDbs &kernelDbs);
   void getUserEnteredKernel(UserInterface &ui, const QString &param, Kernel &kernel);
   bool tryKernels(Cube *icube, Process &p, UserInterface &ui, Pvl *log,
                   Kernel lk, Kernel pck,
@@ -38,30 +50,89 @@ namespace Isis {
   void requestSpice(Cube *icube, UserInterface &ui, Pvl *log, Pvl &labels, QString missionName);
 
   /**
-   * Spiceinit a cube in an Application
+   * Spiceinit the cubes in an Application. The cube in FROM and the cubes in
+   * FROMLIST are spiceinit'd one after the other. The kernel databases and
+   * the loaded kernels are kept from one cube to the next, so cubes from the
+   * same mission do not load them again. If a cube in a list of more than
+   * one cube can not be spiceinit'd, the error is logged in a Warning group
+   * and the rest of the cubes are still spiceinit'd. An error naming the
+   * cubes that failed is thrown at the end.
    *
    * @param ui The Application UI
    * @param(out) log The Pvl that attempted kernel sets will be logged to
    */
   void spiceinit(UserInterface &ui, Pvl *log) {
-    // Open the input cube
-    Process p;
+    FileList cubes;
+    if (ui.WasEntered("FROM")) {
+      cubes.append(FileName(ui.GetCubeName("FROM")));
+    }
+    if (ui.WasEntered("FROMLIST")) {
+      cubes.read(FileName(ui.GetFileName("FROMLIST")));
+    }
+    if (cubes.isEmpty()) {
+      QString msg = "Cubes must be specified in FROM and/or FROMLIST";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
 
-    CubeAttributeInput cai;
-    Cube *icube = p.SetInputCube(ui.GetCubeName("FROM"), cai, ReadWrite);
-    spiceinit(icube, ui, log);
-    p.EndProcess();
+    SystemKernelDbs kernelDbs;
+    QStringList failedCubes;
+    Spice::setKeepKernelsLoaded(cubes.size() > 1);
+    foreach (FileName cube, cubes) {
+      try {
+        // Open the input cube
+        Process p;
+
+        CubeAttributeInput cai;
+        Cube *icube = p.SetInputCube(cube.expanded(), cai, ReadWrite);
+        spiceinit(icube, ui, log, kernelDbs);
+        p.EndProcess();
+      }
+      catch (IException &e) {
+        if (cubes.size() == 1) {
+          throw;
+        }
+
+        // Log the failure and go on with the rest of the cubes
+        failedCubes.append(cube.original());
+        if (log) {
+          PvlGroup failure("Warning");
+          failure += PvlKeyword("FileName", cube.original());
+          failure += PvlKeyword("Error", e.toString());
+          log->addLogGroup(failure);
+        }
+      }
+      catch (...) {
+        Spice::setKeepKernelsLoaded(false);
+        throw;
+      }
+    }
+    Spice::setKeepKernelsLoaded(false);
+
+    if (!failedCubes.isEmpty()) {
+      QString msg = "Unable to spiceinit [" + toString(failedCubes.size()) + "] of [" +
+                    toString(cubes.size()) + "] cubes [" + failedCubes.join(", ") +
+                    "]. The other cubes were spiceinit'd";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+  }
+
+
+  void spiceinit(Cube *icube, UserInterface &ui, Pvl *log) {
+    SystemKernelDbs kernelDbs;
+    spiceinit(icube, ui, log, kernelDbs);
   }
 
 
   /**
-   * Spiceinit a Cube
+   * Spiceinit a Cube, reusing the system kernel databases loaded for the
+   * last cube if the cube uses the same ones
    *
    * @param cube The Cube to spiceinit
    * @param options The options for how the cube should be spiceinit'd
    * @param(out) log The Pvl that attempted kernel sets will be logged to
+   * @param(in/out) kernelDbs The kernel databases loaded for the last cube
    */
-  void spiceinit(Cube *icube, UserInterface &ui, Pvl *log) {
+  void spiceinit(Cube *icube, UserInterface &ui, Pvl *log, SystemKernelDbs &kernelDbs) {
     // Open the input cube
     Process p;
     p.SetInputCube(icube);
@@ -131,13 +202,30 @@ namespace Isis {
       if (ui.GetBoolean("SPKSMITHED"))
         allowedSPK |= Kernel::typeEnum("SMITHED");
 
-      KernelDb baseKernels(allowed);
-      KernelDb ckKernels(allowedCK);
-      KernelDb spkKernels(allowedSPK);
-
-      baseKernels.loadSystemDb(mission, lab);
-      ckKernels.loadSystemDb(mission, lab);
-      spkKernels.loadSystemDb(mission, lab);
+      // The databases are loaded again when the mission or the database files
+      // selected for the cube change
+      bool sameDbFiles = false;
+      if (kernelDbs.baseKernels && kernelDbs.mission == mission) {
+        QList<FileName> loadedFiles = kernelDbs.baseKernels->kernelDbFiles();
+        QList<FileName> cubeFiles = kernelDbs.baseKernels->systemDbFiles(mission, lab);
+        sameDbFiles = (loadedFiles.size() == cubeFiles.size());
+        for (int i = 0; sameDbFiles && i < loadedFiles.size(); i++) {
+          sameDbFiles = (loadedFiles[i].expanded() == cubeFiles[i].expanded());
+        }
+      }
+      if (!sameDbFiles) {
+        kernelDbs.mission = mission;
+        kernelDbs.baseKernels = QSharedPointer<KernelDb>(new KernelDb(allowed));
+        kernelDbs.ckKernels = QSharedPointer<KernelDb>(new KernelDb(allowedCK));
+        kernelDbs.spkKernels = QSharedPointer<KernelDb>(new KernelDb(allowedSPK));
+
+        kernelDbs.baseKernels->loadSystemDb(mission, lab);
+        kernelDbs.ckKernels->loadSystemDb(mission, lab);
+        kernelDbs.spkKernels->loadSystemDb(mission, lab);
+      }
+      KernelDb &baseKernels = *kernelDbs.baseKernels;
+      KernelDb &ckKernels = *kernelDbs.ckKernels;
+      KernelDb &spkKernels = *kernelDbs.spkKernels;
 
       Kernel lk, pck, targetSpk, fk, ik, sclk, spk, iak, dem, exk;
       QList< priority_queue<Kernel> > ck;
@@ -191,7 +279,7 @@ namespace Isis {
       if ((ck.size() == 0 || ck.at(0).size() == 0) && !ui.WasEntered("CK")) {
         // no ck was found in system and user did not enter ck, throw error
         throw IException(IException::Unknown,
-                         "No Camera Kernels found for the image [" + ui.GetCubeName("FROM")
+                         "No Camera Kernels found for the image [" + icube->fileName()
                          + "]",
                          _FILEINFO_);
       }
@@ -5,9 +5,13 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "AutoReg.h"
+
+#include <QScopedPointer>
+
 #include "Buffer.h"
 #include "Centroid.h"
 #include "Chip.h"
+#include "ChipCorrelator.h"
 #include "FileName.h"
 #include "Histogram.h"
 #include "IException.h"
@@ -49,6 +53,7 @@ namespace Isis {
    *       <li>Tolerance = Isis::Null
    *       <li>SubpixelAccuracy = True
    *       <li>ReductionFactor = 1
+   *       <li>FastMatch = False
    *     </ul>
    *  <li> SurfaceModel
    *     <ul>
@@ -81,6 +86,7 @@ namespace Isis {
     SetTolerance(Isis::Null);
 
     SetSubPixelAccuracy(true);
+    SetFastMatch(false);
     SetSurfaceModelDistanceTolerance(1.5);
     SetSurfaceModelWindowSize(5);
 
@@ -208,6 +214,10 @@ namespace Isis {
         SetReductionFactor((int)algo["ReductionFactor"]);
       }
 
+      if(algo.hasKeyword("FastMatch")) {
+        SetFastMatch((QString)algo["FastMatch"] == "True");
+      }
+
       if (algo.hasKeyword("Gradient")) {
         SetGradientFilterType((QString)algo["Gradient"]);
       }
@@ -313,6 +323,22 @@ namespace Isis {
     p_subpixelAccuracy = on;
   }
 
+
+  /**
+   * If fast matching is enabled, the Match() method tests the pattern chip at
+   * every search chip position using the sums of a ChipCorrelator instead of
+   * extracting and testing one sub-search chip at a time. The fits match the
+   * ones computed without it up to floating point roundoff.
+   *
+   * If this method is not called, fast matching defaults to on = false in the
+   * AutoReg object constructor.
+   *
+   * @param on Set the state of fast matching.
+   */
+  void AutoReg::SetFastMatch(bool on) {
+    p_fastMatch = on;
+  }
+
   /**
    * Set the amount of data in the pattern chip that must be valid.  For
    * example, a 21x21 pattern chip has 441 pixels.  If percent is 75 then
@@ -1049,16 +1075,29 @@ namespace Isis {
     // Create a chip the same size as the pattern chip.
     Chip subsearch(pChip.Samples(), pChip.Lines());
 
+    // The correlator computes what the algorithm needs for every position
+    QScopedPointer<ChipCorrelator> correlator;
+    if (p_fastMatch) {
+      correlator.reset(new ChipCorrelator(sChip, pChip, startSamp, endSamp, startLine, endLine));
+    }
+
     for(int line = startLine; line <= endLine; line++) {
       for(int samp = startSamp; samp <= endSamp; samp++) {
-        // Extract the subsearch chip and make sure it has enough valid data
-        sChip.Extract(samp, line, subsearch);
+        double fit;
+        if (correlator) {
+          if (correlator->SubsearchValidPercent(samp, line) < p_subsearchValidPercent) continue;
+          fit = FastMatchAlgorithm(*correlator, samp, line);
+        }
+        else {
+          // Extract the subsearch chip and make sure it has enough valid data
+          sChip.Extract(samp, line, subsearch);
 
-//        if(!subsearch.IsValid(p_patternValidPercent)) continue;
-        if(!subsearch.IsValid(p_subsearchValidPercent)) continue;
+//          if(!subsearch.IsValid(p_patternValidPercent)) continue;
+          if(!subsearch.IsValid(p_subsearchValidPercent)) continue;
 
-        // Try to match the two subchips
-        double fit = MatchAlgorithm(pChip, subsearch);
+          // Try to match the two subchips
+          fit = MatchAlgorithm(pChip, subsearch);
+        }
 
         // If we had a fit save off information about that fit
         if(fit != Isis::Null) {
@@ -1074,6 +1113,24 @@ namespace Isis {
   }
 
 
+  /**
+   * Returns the goodness of fit of the pattern chip and the sub-search chip at
+   * one search chip position when fast matching is enabled. Algorithms that
+   * can use the sums of the correlator override this. The default extracts
+   * the sub-search chip into the correlator's reused chip and calls
+   * MatchAlgorithm().
+   *
+   * @param correlator The correlator of the search and pattern chips
+   * @param samp The search chip sample at the tack of the sub-search chip
+   * @param line The search chip line at the tack of the sub-search chip
+   *
+   * @return @b double The goodness of fit, or Null if there is none
+   */
+  double AutoReg::FastMatchAlgorithm(ChipCorrelator &correlator, int samp, int line) {
+    return MatchAlgorithm(correlator.PatternChip(), correlator.SubsearchChip(samp, line));
+  }
+
+
   /**
    * Set the search chip sample and line to subpixel values if possible.  This
    * method uses a centroiding method to gravitate the whole pixel best fit to a
@@ -1206,6 +1263,28 @@ namespace Isis {
     return (AlgorithmStatistics(pvl));
   }
 
+  /**
+   * Adds the registration statistics of another AutoReg to the statistics of
+   * this one. This combines the statistics of AutoRegs that registered
+   * different parts of the same job, for example on different threads.
+   * Algorithms with statistics of their own add those too.
+   *
+   * @param other The AutoReg whose statistics are added
+   */
+  void AutoReg::MergeStatistics(const AutoReg &other) {
+    p_totalRegistrations += other.p_totalRegistrations;
+    p_pixelSuccesses += other.p_pixelSuccesses;
+    p_subpixelSuccesses += other.p_subpixelSuccesses;
+    p_patternChipNotEnoughValidDataCount += other.p_patternChipNotEnoughValidDataCount;
+    p_patternZScoreNotMetCount += other.p_patternZScoreNotMetCount;
+    p_fitChipNoDataCount += other.p_fitChipNoDataCount;
+    p_fitChipToleranceNotMetCount += other.p_fitChipToleranceNotMetCount;
+    p_surfaceModelNotEnoughValidDataCount += other.p_surfaceModelNotEnoughValidDataCount;
+    p_surfaceModelSolutionInvalidCount += other.p_surfaceModelSolutionInvalidCount;
+    p_surfaceModelDistanceInvalidCount += other.p_surfaceModelDistanceInvalidCount;
+  }
+
+
   /**
    * This function returns the keywords that this object was
    * created from.
@@ -1225,6 +1304,9 @@ namespace Isis {
     if(algo.hasKeyword("ReductionFactor")) {
       reg += PvlKeyword("ReductionFactor", algo["ReductionFactor"][0]);
     }
+    if(algo.hasKeyword("FastMatch")) {
+      reg += PvlKeyword("FastMatch", algo["FastMatch"][0]);
+    }
     if(algo.hasKeyword("Gradient")) {
       reg += PvlKeyword("Gradient", algo["Gradient"][0]);
     }
@@ -1295,6 +1377,9 @@ namespace Isis {
         SubPixelAccuracy() ? "True" : "False");
     reg += PvlKeyword("ReductionFactor", toString(ReductionFactor()));
     reg += PvlKeyword("Gradient", GradientFilterString());
+    if (FastMatch()) {
+      reg += PvlKeyword("FastMatch", "True");
+    }
 
     Chip *pattern = PatternChip();
     reg += PvlKeyword("PatternSamples", toString(pattern->Samples()));
@@ -18,6 +18,7 @@ class QString;
 namespace Isis {
   class AutoRegItem;
   class Buffer;
+  class ChipCorrelator;
   class Pvl;
 
   /**
@@ -249,6 +250,7 @@ namespace Isis {
       };
 
       void SetSubPixelAccuracy(bool on);
+      void SetFastMatch(bool on);
       void SetPatternValidPercent(const double percent);
       void SetSubsearchValidPercent(const double percent);
       void SetTolerance(double tolerance);
@@ -271,6 +273,16 @@ namespace Isis {
         return p_subpixelAccuracy;
       }
 
+      /**
+       * Return whether the pattern chip is matched at every search chip
+       * position at once using a ChipCorrelator.
+       *
+       * @return on Is fast matching enabled?
+       */
+      bool FastMatch() const {
+        return p_fastMatch;
+      }
+
       //! Return the reduction factor.
       int ReductionFactor() {
         return p_reduceFactor;
@@ -363,6 +375,7 @@ namespace Isis {
       }
 
       Pvl RegistrationStatistics();
+      virtual void MergeStatistics(const AutoReg &other);
 
       /**
        * Minimum tolerance specific to algorithm
@@ -445,6 +458,7 @@ namespace Isis {
        * @return double
        */
       virtual double MatchAlgorithm(Chip &pattern, Chip &subsearch) = 0;
+      virtual double FastMatchAlgorithm(ChipCorrelator &correlator, int samp, int line);
 
       PvlObject p_template; //!< AutoRegistration object that created this projection
 
@@ -490,6 +504,7 @@ namespace Isis {
       Chip p_reducedFitChip;                               //!< Fit Chip with reduction factor
 
       bool p_subpixelAccuracy;                             //!< Indicates whether sub-pixel accuracy is enabled. Default is true.
+      bool p_fastMatch;                                    //!< Indicates whether chips are matched with a ChipCorrelator. Default is false.
 
       //TODO: remove these after control points are refactored.
       int p_totalRegistrations;                            //!< Registration Statistics Total keyword.
@@ -12,6 +12,7 @@ find files of those names at the top level of this repository. **/
 #include <cmath>
 #include <iomanip>
 #include <stdint.h>
+#include <typeinfo>
 
 #include <QDebug>
 #include <QList>
@@ -555,6 +556,237 @@ namespace Isis {
   }
 
 
+  /**
+   * Computes the ground point of every image coordinate in a batch. This is
+   * the same as calling SetImage(), UniversalLatitude() and
+   * UniversalLongitude() for each point, but results are written into arrays
+   * so callers that map grids or footprints do not have to make three calls
+   * per point. Camera models that can evaluate many points at once may
+   * override this method.
+   *
+   * Framing cameras with an unprojected image use one time for every pixel,
+   * so the points are passed through the detector, focal plane and distortion
+   * maps as arrays, and only the ground intersection is done point by point.
+   * Other cameras call SetImage() for each point.
+   *
+   * When this method returns the camera is left set to the last point.
+   *
+   * @param samples The sample of each point
+   * @param lines The line of each point, parallel to samples
+   * @param latitudes Set to the universal latitude of each point, or Null if
+   *                  the point does not intersect the target
+   * @param longitudes Set to the universal longitude of each point, or Null if
+   *                   the point does not intersect the target
+   * @param valid Set to true for each point that intersects the target
+   *
+   * @throws IException::Programmer "The sample and line arrays have different sizes"
+   *
+   * @return @b int The number of points that intersect the target
+   */
+  int Camera::SetImages(const std::vector<double> &samples,
+                        const std::vector<double> &lines,
+                        std::vector<double> &latitudes,
+                        std::vector<double> &longitudes,
+                        std::vector<bool> &valid) {
+    if (samples.size() != lines.size()) {
+      QString msg = "The sample and line arrays have different sizes [" +
+                    toString((BigInt)samples.size()) + "] and [" +
+                    toString((BigInt)lines.size()) + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    int numPoints = samples.size();
+    latitudes.assign(numPoints, Null);
+    longitudes.assign(numPoints, Null);
+    valid.assign(numPoints, false);
+
+    int numValid = 0;
+    if (!canMapArrays()) {
+      for (int i = 0; i < numPoints; i++) {
+        if (SetImage(samples[i], lines[i])) {
+          latitudes[i] = UniversalLatitude();
+          longitudes[i] = UniversalLongitude();
+          valid[i] = true;
+          numValid++;
+        }
+      }
+      return numValid;
+    }
+
+    // Convert to parent coordinates (remove crop, pad, shrink, enlarge), then
+    //   to detector, distorted focal plane and undistorted focal plane
+    vector<double> parentSamples(numPoints), parentLines(numPoints);
+    for (int i = 0; i < numPoints; i++) {
+      parentSamples[i] = p_alphaCube->AlphaSample(samples[i]);
+      parentLines[i] = p_alphaCube->AlphaLine(lines[i]);
+    }
+
+    vector<double> detectorSamples(numPoints), detectorLines(numPoints);
+    vector<double> focalPlaneXs(numPoints), focalPlaneYs(numPoints);
+    vector<double> xs(numPoints), ys(numPoints), zs(numPoints);
+    QVector<bool> detectorSuccess(numPoints), focalPlaneSuccess(numPoints);
+    QVector<bool> distortionSuccess(numPoints);
+    p_detectorMap->SetParents(numPoints, parentSamples.data(), parentLines.data(),
+                              detectorSamples.data(), detectorLines.data(),
+                              detectorSuccess.data());
+    p_focalPlaneMap->SetDetectors(numPoints, detectorSamples.data(), detectorLines.data(),
+                                  focalPlaneXs.data(), focalPlaneYs.data(),
+                                  focalPlaneSuccess.data());
+    p_distortionMap->SetFocalPlanes(numPoints, focalPlaneXs.data(), focalPlaneYs.data(),
+                                    xs.data(), ys.data(), zs.data(),
+                                    distortionSuccess.data());
+
+    // Map to the ground
+    ShapeModel *shape = target()->shape();
+    for (int i = 0; i < numPoints; i++) {
+      p_childSample = samples[i];
+      p_childLine = lines[i];
+      p_pointComputed = true;
+      shape->clearSurfacePoint();
+
+      if (detectorSuccess[i] && focalPlaneSuccess[i] && distortionSuccess[i] &&
+          p_groundMap->SetFocalPlane(xs[i], ys[i], zs[i])) {
+        latitudes[i] = UniversalLatitude();
+        longitudes[i] = UniversalLongitude();
+        valid[i] = true;
+        numValid++;
+      }
+      else {
+        shape->clearSurfacePoint();
+      }
+    }
+
+    return numValid;
+  }
+
+
+  /**
+   * Computes the image coordinate of every ground point in a batch. This is
+   * the same as calling SetUniversalGround(), Sample() and Line() for each
+   * point, but results are written into arrays. Camera models that can
+   * evaluate many points at once may override this method.
+   *
+   * For framing cameras with an unprojected image, the ground points are
+   * mapped to the focal plane point by point, and then passed through the
+   * distortion, focal plane and detector maps as arrays. Other cameras call
+   * SetUniversalGround() for each point.
+   *
+   * When this method returns the camera is left set to the last point.
+   *
+   * @param latitudes The universal latitude of each point
+   * @param longitudes The universal longitude of each point, parallel to
+   *                   latitudes
+   * @param samples Set to the sample of each point, or Null if the point is
+   *                not visible to the camera
+   * @param lines Set to the line of each point, or Null if the point is not
+   *              visible to the camera
+   * @param valid Set to true for each point that maps into the camera
+   *
+   * @throws IException::Programmer "The latitude and longitude arrays have
+   *                                 different sizes"
+   *
+   * @return @b int The number of points that map into the camera
+   */
+  int Camera::SetUniversalGrounds(const std::vector<double> &latitudes,
+                                  const std::vector<double> &longitudes,
+                                  std::vector<double> &samples,
+                                  std::vector<double> &lines,
+                                  std::vector<bool> &valid) {
+    if (latitudes.size() != longitudes.size()) {
+      QString msg = "The latitude and longitude arrays have different sizes [" +
+                    toString((BigInt)latitudes.size()) + "] and [" +
+                    toString((BigInt)longitudes.size()) + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    int numPoints = latitudes.size();
+    samples.assign(numPoints, Null);
+    lines.assign(numPoints, Null);
+    valid.assign(numPoints, false);
+
+    int numValid = 0;
+    if (!canMapArrays()) {
+      for (int i = 0; i < numPoints; i++) {
+        if (SetUniversalGround(latitudes[i], longitudes[i])) {
+          samples[i] = Sample();
+          lines[i] = Line();
+          valid[i] = true;
+          numValid++;
+        }
+      }
+      return numValid;
+    }
+
+    // Convert lat/lon to undistorted focal plane x/y
+    vector<double> uxs(numPoints, 0.0), uys(numPoints, 0.0);
+    QVector<bool> groundSuccess(numPoints);
+    for (int i = 0; i < numPoints; i++) {
+      groundSuccess[i] = p_groundMap->SetGround(Latitude(latitudes[i], Angle::Degrees),
+                                                Longitude(longitudes[i], Angle::Degrees));
+      if (groundSuccess[i]) {
+        uxs[i] = p_groundMap->FocalPlaneX();
+        uys[i] = p_groundMap->FocalPlaneY();
+      }
+    }
+
+    // Convert undistorted x/y to distorted x/y, detector and parent positions
+    vector<double> focalPlaneXs(numPoints), focalPlaneYs(numPoints);
+    vector<double> detectorSamples(numPoints), detectorLines(numPoints);
+    vector<double> parentSamples(numPoints), parentLines(numPoints);
+    QVector<bool> distortionSuccess(numPoints), focalPlaneSuccess(numPoints);
+    QVector<bool> detectorSuccess(numPoints);
+    p_distortionMap->SetUndistortedFocalPlanes(numPoints, uxs.data(), uys.data(),
+                                               focalPlaneXs.data(), focalPlaneYs.data(),
+                                               distortionSuccess.data());
+    p_focalPlaneMap->SetFocalPlanes(numPoints, focalPlaneXs.data(), focalPlaneYs.data(),
+                                    detectorSamples.data(), detectorLines.data(),
+                                    focalPlaneSuccess.data());
+    p_detectorMap->SetDetectors(numPoints, detectorSamples.data(), detectorLines.data(),
+                                parentSamples.data(), parentLines.data(),
+                                detectorSuccess.data());
+
+    bool lastValid = false;
+    for (int i = 0; i < numPoints; i++) {
+      lastValid = groundSuccess[i] && distortionSuccess[i] && focalPlaneSuccess[i] &&
+                  detectorSuccess[i];
+      if (lastValid) {
+        samples[i] = p_alphaCube->BetaSample(parentSamples[i]);
+        lines[i] = p_alphaCube->BetaLine(parentLines[i]);
+        valid[i] = true;
+        numValid++;
+      }
+    }
+
+    // Leave the camera set to the last point like SetUniversalGround() does
+    if (lastValid) {
+      p_childSample = samples[numPoints - 1];
+      p_childLine = lines[numPoints - 1];
+      p_pointComputed = true;
+      target()->shape()->setHasIntersection(true);
+    }
+    else if (numPoints > 0) {
+      target()->shape()->clearSurfacePoint();
+    }
+
+    return numValid;
+  }
+
+
+  /**
+   * Checks if SetImages() and SetUniversalGrounds() can pass their points
+   * through the camera maps as arrays. That needs an unprojected image and a
+   * time that does not change from pixel to pixel, which is the case for
+   * framing cameras whose detector map is not specialized.
+   *
+   * @return @b bool True if points can be mapped as arrays
+   */
+  bool Camera::canMapArrays() {
+    return (p_projection == NULL || p_ignoreProjection) &&
+           GetCameraType() == Framing &&
+           typeid(*p_detectorMap) == typeid(CameraDetectorMap);
+  }
+
+
 
   /**
    * @brief This method returns the Oblique Detector Resolution
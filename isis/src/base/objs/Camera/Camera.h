@@ -251,6 +251,18 @@ namespace Isis {
                                       const double radius);
       virtual bool SetGround(Latitude latitude, Longitude longitude);
       virtual bool SetGround(const SurfacePoint & surfacePt);
+
+      virtual int SetImages(const std::vector<double> &samples,
+                            const std::vector<double> &lines,
+                            std::vector<double> &latitudes,
+                            std::vector<double> &longitudes,
+                            std::vector<bool> &valid);
+      virtual int SetUniversalGrounds(const std::vector<double> &latitudes,
+                                      const std::vector<double> &longitudes,
+                                      std::vector<double> &samples,
+                                      std::vector<double> &lines,
+                                      std::vector<bool> &valid);
+
       bool SetRightAscensionDeclination(const double ra, const double dec);
 
       void LocalPhotometricAngles(Angle & phase, Angle & incidence,
@@ -510,6 +522,7 @@ namespace Isis {
       void ringRangeResolution();
       double ComputeAzimuth(const double lat, const double lon);
       bool RawFocalPlanetoImage();
+      bool canMapArrays();
       // SetImage helper functions:
       // bool SetImageNoProjection(const double sample, const double line);
       bool SetImageMapProjection(const double sample, const double line, ShapeModel *shape);
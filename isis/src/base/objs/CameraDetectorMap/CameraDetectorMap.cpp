@@ -5,6 +5,9 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "CameraDetectorMap.h"
+
+#include <typeinfo>
+
 #include "iTime.h"
 
 namespace Isis {
@@ -93,6 +96,76 @@ namespace Isis {
   }
 
 
+  /**
+   * Compute the detector positions of many parent image coordinates. This
+   * gives the same results as calling SetParent() for each point. This class
+   * computes all of the points in one loop and sets the camera time once
+   * instead of once per point. Subclasses that do not override this method
+   * call their SetParent() for each point. When this method returns the map
+   * is set to the last point.
+   *
+   * @param count The number of points
+   * @param samples Sample number of each point in the parent image
+   * @param lines Line number of each point in the parent image
+   * @param detectorSamples Set to the detector sample of each point
+   * @param detectorLines Set to the detector line of each point
+   * @param success Set to whether each point was converted
+   */
+  void CameraDetectorMap::SetParents(int count, const double *samples, const double *lines,
+                                     double *detectorSamples, double *detectorLines,
+                                     bool *success) {
+    if (typeid(*this) != typeid(CameraDetectorMap)) {
+      for (int i = 0; i < count; i++) {
+        success[i] = SetParent(samples[i], lines[i]);
+        detectorSamples[i] = DetectorSample();
+        detectorLines[i] = DetectorLine();
+      }
+      return;
+    }
+
+    for (int i = 0; i < count; i++) {
+      detectorSamples[i] = (samples[i] - 1.0) * p_detectorSampleSumming + p_ss;
+      detectorLines[i]   = (lines[i]   - 1.0) * p_detectorLineSumming + p_sl;
+      success[i] = true;
+    }
+    if (count > 0) SetParent(samples[count - 1], lines[count - 1]);
+  }
+
+
+  /**
+   * Compute the parent image coordinates of many detector positions. This
+   * gives the same results as calling SetDetector() for each point.
+   * Subclasses that do not override this method call their SetDetector() for
+   * each point. When this method returns the map is set to the last point.
+   *
+   * @param count The number of points
+   * @param samples Detector sample of each point
+   * @param lines Detector line of each point
+   * @param parentSamples Set to the parent image sample of each point
+   * @param parentLines Set to the parent image line of each point
+   * @param success Set to whether each point was converted
+   */
+  void CameraDetectorMap::SetDetectors(int count, const double *samples, const double *lines,
+                                       double *parentSamples, double *parentLines,
+                                       bool *success) {
+    if (typeid(*this) != typeid(CameraDetectorMap)) {
+      for (int i = 0; i < count; i++) {
+        success[i] = SetDetector(samples[i], lines[i]);
+        parentSamples[i] = ParentSample();
+        parentLines[i] = ParentLine();
+      }
+      return;
+    }
+
+    for (int i = 0; i < count; i++) {
+      parentSamples[i] = (samples[i] - p_ss) / p_detectorSampleSumming + 1.0;
+      parentLines[i]   = (lines[i]   - p_sl) / p_detectorLineSumming   + 1.0;
+      success[i] = true;
+    }
+    if (count > 0) SetDetector(samples[count - 1], lines[count - 1]);
+  }
+
+
   /** 
    * Compute new offsets whenenver summing or starting sample/lines change
    */
@@ -59,6 +59,13 @@ namespace Isis {
       virtual bool SetDetector(const double sample, 
                                const double line);
 
+      virtual void SetParents(int count, const double *samples, const double *lines,
+                              double *detectorSamples, double *detectorLines,
+                              bool *success);
+      virtual void SetDetectors(int count, const double *samples, const double *lines,
+                                double *parentSamples, double *parentLines,
+                                bool *success);
+
       double AdjustedStartingSample() const;
 
       double AdjustedStartingLine() const;
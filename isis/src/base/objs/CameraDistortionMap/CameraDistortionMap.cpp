@@ -7,6 +7,8 @@ find files of those names at the top level of this repository. **/
 #include "IString.h"
 #include "CameraDistortionMap.h"
 
+#include <typeinfo>
+
 namespace Isis {
   /**
    * Camera distortion map constructor
@@ -186,6 +188,81 @@ namespace Isis {
   }
 
 
+  /**
+   * Compute undistorted focal plane coordinates for many distorted focal
+   * plane coordinates. This gives the same results as calling SetFocalPlane()
+   * and UndistortedFocalPlaneZ() for each point, and this class computes the
+   * polynomial distortion in one loop the compiler can vectorize. Subclasses
+   * that do not override this method call their SetFocalPlane() for each
+   * point. When this method returns the map is set to the last point.
+   *
+   * @param count The number of points
+   * @param dxs Distorted focal plane x of each point in millimeters
+   * @param dys Distorted focal plane y of each point in millimeters
+   * @param uxs Set to the undistorted focal plane x of each point
+   * @param uys Set to the undistorted focal plane y of each point
+   * @param uzs Set to the undistorted focal plane z of each point
+   * @param success Set to whether each point was converted
+   */
+  void CameraDistortionMap::SetFocalPlanes(int count, const double *dxs, const double *dys,
+                                           double *uxs, double *uys, double *uzs,
+                                           bool *success) {
+    if (typeid(*this) != typeid(CameraDistortionMap)) {
+      for (int i = 0; i < count; i++) {
+        success[i] = SetFocalPlane(dxs[i], dys[i]);
+        uxs[i] = UndistortedFocalPlaneX();
+        uys[i] = UndistortedFocalPlaneY();
+        uzs[i] = UndistortedFocalPlaneZ();
+      }
+      return;
+    }
+
+    double uz = UndistortedFocalPlaneZ();
+    bool distorted = p_odk.size() > 0;
+    double odk0 = distorted ? p_odk[0] : 0.0;
+    double odk1 = distorted ? p_odk[1] : 0.0;
+    double odk2 = distorted ? p_odk[2] : 0.0;
+    for (int i = 0; i < count; i++) {
+      double dx = dxs[i];
+      double dy = dys[i];
+      double r2 = (dx * dx) + (dy * dy);
+      // Points near the center and maps without coefficients are not changed
+      double drOverR = (distorted && r2 > 1.0E-6) ? odk0 + (r2 * (odk1 + (r2 * odk2))) : 0.0;
+      uxs[i] = dx - (drOverR * dx);
+      uys[i] = dy - (drOverR * dy);
+      uzs[i] = uz;
+      success[i] = true;
+    }
+    if (count > 0) SetFocalPlane(dxs[count - 1], dys[count - 1]);
+  }
+
+
+  /**
+   * Compute distorted focal plane coordinates for many undistorted focal
+   * plane coordinates by calling SetUndistortedFocalPlane() for each point.
+   * Removing the distortion is iterative, so subclasses with a closed form
+   * may override this method. When this method returns the map is set to the
+   * last point.
+   *
+   * @param count The number of points
+   * @param uxs Undistorted focal plane x of each point in millimeters
+   * @param uys Undistorted focal plane y of each point in millimeters
+   * @param dxs Set to the distorted focal plane x of each point
+   * @param dys Set to the distorted focal plane y of each point
+   * @param success Set to whether each point was converted
+   */
+  void CameraDistortionMap::SetUndistortedFocalPlanes(int count,
+                                                      const double *uxs, const double *uys,
+                                                      double *dxs, double *dys,
+                                                      bool *success) {
+    for (int i = 0; i < count; i++) {
+      success[i] = SetUndistortedFocalPlane(uxs[i], uys[i]);
+      dxs[i] = FocalPlaneX();
+      dys[i] = FocalPlaneY();
+    }
+  }
+
+
   /**
    * Retrieve the distortion coefficients used for this model.
    *
@@ -50,6 +50,12 @@ namespace Isis {
 
       virtual bool SetUndistortedFocalPlane(double ux, double uy);
 
+      virtual void SetFocalPlanes(int count, const double *dxs, const double *dys,
+                                  double *uxs, double *uys, double *uzs, bool *success);
+
+      virtual void SetUndistortedFocalPlanes(int count, const double *uxs, const double *uys,
+                                             double *dxs, double *dys, bool *success);
+
       std::vector<double> OpticalDistortionCoefficients() const;
 
       double ZDirection() const;
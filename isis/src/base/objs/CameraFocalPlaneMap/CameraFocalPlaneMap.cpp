@@ -7,6 +7,7 @@ find files of those names at the top level of this repository. **/
 #include "CameraFocalPlaneMap.h"
 
 #include <cmath>
+#include <typeinfo>
 
 #include <QDebug>
 #include <QVector>
@@ -171,6 +172,80 @@ namespace Isis {
   }
 
 
+  /**
+   * Compute the distorted focal plane coordinates of many detector positions.
+   * This gives the same results as calling SetDetector() for each point, and
+   * this class computes them in one loop the compiler can vectorize.
+   * Subclasses that do not override this method call their SetDetector() for
+   * each point. When this method returns the map is set to the last point.
+   *
+   * @param count The number of points
+   * @param samples Detector sample of each point
+   * @param lines Detector line of each point
+   * @param focalPlaneXs Set to the distorted focal plane x of each point
+   * @param focalPlaneYs Set to the distorted focal plane y of each point
+   * @param success Set to whether each point was converted
+   */
+  void CameraFocalPlaneMap::SetDetectors(int count, const double *samples, const double *lines,
+                                         double *focalPlaneXs, double *focalPlaneYs,
+                                         bool *success) {
+    if (typeid(*this) != typeid(CameraFocalPlaneMap)) {
+      for (int i = 0; i < count; i++) {
+        success[i] = SetDetector(samples[i], lines[i]);
+        focalPlaneXs[i] = FocalPlaneX();
+        focalPlaneYs[i] = FocalPlaneY();
+      }
+      return;
+    }
+
+    for (int i = 0; i < count; i++) {
+      double centeredSample = samples[i] - p_detectorSampleOrigin;
+      double centeredLine   = lines[i]   - p_detectorLineOrigin;
+      focalPlaneXs[i] = p_transx[0] + (p_transx[1] * centeredSample) + (p_transx[2] * centeredLine);
+      focalPlaneYs[i] = p_transy[0] + (p_transy[1] * centeredSample) + (p_transy[2] * centeredLine);
+      success[i] = true;
+    }
+    if (count > 0) SetDetector(samples[count - 1], lines[count - 1]);
+  }
+
+
+  /**
+   * Compute the detector positions of many distorted focal plane coordinates.
+   * This gives the same results as calling SetFocalPlane() for each point.
+   * Subclasses that do not override this method call their SetFocalPlane()
+   * for each point. When this method returns the map is set to the last
+   * point.
+   *
+   * @param count The number of points
+   * @param dxs Distorted focal plane x of each point in millimeters
+   * @param dys Distorted focal plane y of each point in millimeters
+   * @param detectorSamples Set to the detector sample of each point
+   * @param detectorLines Set to the detector line of each point
+   * @param success Set to whether each point was converted
+   */
+  void CameraFocalPlaneMap::SetFocalPlanes(int count, const double *dxs, const double *dys,
+                                           double *detectorSamples, double *detectorLines,
+                                           bool *success) {
+    if (typeid(*this) != typeid(CameraFocalPlaneMap)) {
+      for (int i = 0; i < count; i++) {
+        success[i] = SetFocalPlane(dxs[i], dys[i]);
+        detectorSamples[i] = DetectorSample();
+        detectorLines[i] = DetectorLine();
+      }
+      return;
+    }
+
+    for (int i = 0; i < count; i++) {
+      double centeredSample = p_itranss[0] + (p_itranss[1] * dxs[i]) + (p_itranss[2] * dys[i]);
+      double centeredLine   = p_itransl[0] + (p_itransl[1] * dxs[i]) + (p_itransl[2] * dys[i]);
+      detectorSamples[i] = centeredSample + p_detectorSampleOrigin;
+      detectorLines[i]   = centeredLine   + p_detectorLineOrigin;
+      success[i] = true;
+    }
+    if (count > 0) SetFocalPlane(dxs[count - 1], dys[count - 1]);
+  }
+
+
   /** Return the focal plane x dependency variable
    *
    * This method returns the image variable (sample or line) on
@@ -91,6 +91,11 @@ namespace Isis {
 
       virtual bool SetDetector(const double sample, const double line);
       virtual bool SetFocalPlane(const double dx, const double dy);
+      virtual void SetDetectors(int count, const double *samples, const double *lines,
+                                double *focalPlaneXs, double *focalPlaneYs, bool *success);
+      virtual void SetFocalPlanes(int count, const double *dxs, const double *dys,
+                                  double *detectorSamples, double *detectorLines,
+                                  bool *success);
 
       double FocalPlaneX() const;
       double FocalPlaneY() const;
@@ -0,0 +1,80 @@
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include "CameraPool.h"
+
+#include <QMutexLocker>
+
+#include "Camera.h"
+#include "CameraFactory.h"
+#include "Cube.h"
+#include "IException.h"
+
+namespace Isis {
+  /**
+   * Creates an empty pool of cameras for the given cube. No cameras are
+   * created until a thread calls camera(). The cube must stay open for as
+   * long as new threads may ask for cameras.
+   *
+   * @param cube The cube to create camera models from
+   */
+  CameraPool::CameraPool(Cube &cube) {
+    m_cube = &cube;
+  }
+
+
+  /**
+   * Deletes every camera created by this pool. No thread may be using one of
+   * the cameras when the pool is destroyed.
+   */
+  CameraPool::~CameraPool() {
+    qDeleteAll(m_cameras);
+    m_cameras.clear();
+    m_cube = NULL;
+  }
+
+
+  /**
+   * Returns the calling thread's camera, creating it the first time the
+   * thread asks for one. The camera is owned by the pool and must only be
+   * used from the calling thread.
+   *
+   * @throws IException::Camera "Unable to create a camera for the thread"
+   *
+   * @return Camera* The calling thread's camera
+   */
+  Camera *CameraPool::camera() {
+    QMutexLocker locker(&m_mutex);
+
+    Qt::HANDLE threadId = QThread::currentThreadId();
+    Camera *cam = m_cameras.value(threadId, NULL);
+    if (!cam) {
+      try {
+        cam = CameraFactory::Create(*m_cube);
+      }
+      catch (IException &e) {
+        QString msg = "Unable to create a camera for the thread from cube [" +
+                      m_cube->fileName() + "]";
+        throw IException(e, IException::Camera, msg, _FILEINFO_);
+      }
+      m_cameras.insert(threadId, cam);
+    }
+
+    return cam;
+  }
+
+
+  /**
+   * Returns the number of cameras created so far, i.e. the number of threads
+   * that have asked for a camera.
+   *
+   * @return int The number of cameras in the pool
+   */
+  int CameraPool::size() const {
+    QMutexLocker locker(&m_mutex);
+    return m_cameras.size();
+  }
+}
@@ -0,0 +1,72 @@
+#ifndef CameraPool_h
+#define CameraPool_h
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include <QHash>
+#include <QMutex>
+#include <QThread>
+
+namespace Isis {
+  class Camera;
+  class Cube;
+
+  /**
+   * @brief Per-thread camera models for one cube
+   *
+   * A Camera keeps the results of the last SetImage()/SetGround() call in the
+   * camera itself and in its detector, focal plane, distortion, ground and
+   * SPICE members, so a single instance can not be shared by threads that
+   * each expect their own last results. This class hands every calling thread
+   * its own camera, created from the same cube the first time the thread asks
+   * for one, so the state of one thread's camera is not changed by another.
+   *
+   * This does not make evaluating the cameras at the same time safe. Every
+   * camera, even one whose SPICE is cached in the cube (spiceinit
+   * ATTACH=yes), still calls CSPICE, which is not reentrant: intersections
+   * call surfpt_c and NaifStatus checks the global failed_c/reset_c error
+   * state. Cameras with a DEM shape model also share one DEM cube and
+   * projection through CubeManager. Callers must serialize SetImage(),
+   * SetGround() and every other call that evaluates a camera, for example
+   * with one mutex for the whole pool, and can only run the work between
+   * those calls in parallel. Cameras are created one at a time because
+   * creating a camera loads NAIF kernels into the global kernel pool and
+   * reads from the cube.
+   *
+   * @code
+   *   CameraPool cameras(cube);
+   *   QMutex spiceMutex;
+   *   QtConcurrent::blockingMap(lines, [&cameras, &spiceMutex](const int &line) {
+   *     Camera *cam = cameras.camera();
+   *     {
+   *       QMutexLocker locker(&spiceMutex);
+   *       cam->SetImage(1.0, line);
+   *       ...
+   *     }
+   *     ...
+   *   });
+   * @endcode
+   *
+   * @ingroup Camera
+   */
+  class CameraPool {
+    public:
+      CameraPool(Cube &cube);
+      ~CameraPool();
+
+      Camera *camera();
+      int size() const;
+
+    private:
+      Q_DISABLE_COPY(CameraPool)
+
+      Cube *m_cube;                             //!< The cube the cameras model
+      QHash<Qt::HANDLE, Camera *> m_cameras;    //!< The camera for each thread
+      mutable QMutex m_mutex;                   //!< Guards m_cameras and creation
+  };
+}
+
+#endif
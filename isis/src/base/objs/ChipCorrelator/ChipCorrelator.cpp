@@ -0,0 +1,478 @@
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include "ChipCorrelator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Chip.h"
+#include "FourierTransform.h"
+#include "SpecialPixel.h"
+
+using namespace std;
+
+namespace Isis {
+  namespace {
+    /**
+     * Applies a Fourier transform to every column of an image in place.
+     *
+     * @param image The image, line by line. Both dimensions must be powers of
+     *              two.
+     * @param samples The width of the image
+     * @param lines The height of the image
+     * @param inverse Apply the inverse transform instead
+     */
+    void transformColumns(vector< complex<double> > &image, int samples, int lines,
+                          bool inverse) {
+      FourierTransform fft;
+
+      vector< complex<double> > column(lines);
+      for (int samp = 0; samp < samples; samp++) {
+        for (int line = 0; line < lines; line++) {
+          column[line] = image[line * samples + samp];
+        }
+        if (inverse) {
+          fft.Inverse(column.data(), lines);
+        }
+        else {
+          fft.Transform(column.data(), lines);
+        }
+        for (int line = 0; line < lines; line++) {
+          image[line * samples + samp] = column[line];
+        }
+      }
+    }
+
+
+    /**
+     * Applies a Fourier transform to every row and then every column of an
+     * image in place.
+     *
+     * @param image The image, line by line. Both dimensions must be powers of
+     *              two.
+     * @param samples The width of the image
+     * @param lines The height of the image
+     * @param inverse Apply the inverse transform instead
+     */
+    void transform2D(vector< complex<double> > &image, int samples, int lines,
+                     bool inverse) {
+      FourierTransform fft;
+
+      for (int line = 0; line < lines; line++) {
+        if (inverse) {
+          fft.Inverse(&image[line * samples], samples);
+        }
+        else {
+          fft.Transform(&image[line * samples], samples);
+        }
+      }
+
+      transformColumns(image, samples, lines, inverse);
+    }
+
+
+    /**
+     * Builds a summed-area table of a chip sized image. Entry (s, l) of the
+     * table, with s and l one based, is the sum of every pixel up to and
+     * including sample s and line l. Row and column zero are zero.
+     *
+     * @param image The image, line by line
+     * @param samples The width of the image
+     * @param lines The height of the image
+     *
+     * @return @b vector<double> The (samples + 1) x (lines + 1) table
+     */
+    vector<double> summedAreaTable(const vector<double> &image, int samples, int lines) {
+      vector<double> table((samples + 1) * (lines + 1), 0.0);
+      for (int line = 1; line <= lines; line++) {
+        double rowSum = 0.0;
+        for (int samp = 1; samp <= samples; samp++) {
+          rowSum += image[(line - 1) * samples + samp - 1];
+          table[line * (samples + 1) + samp] =
+              table[(line - 1) * (samples + 1) + samp] + rowSum;
+        }
+      }
+      return table;
+    }
+  }
+
+
+  /**
+   * Prepares the sums for matching a pattern chip at every position in a
+   * range of the search chip. Both chips must stay unchanged for as long as
+   * the correlator is used.
+   *
+   * @param search The search chip
+   * @param pattern The pattern chip
+   * @param startSamp The first search chip sample tested
+   * @param endSamp The last search chip sample tested
+   * @param startLine The first search chip line tested
+   * @param endLine The last search chip line tested
+   */
+  ChipCorrelator::ChipCorrelator(Chip &search, Chip &pattern, int startSamp, int endSamp,
+                                 int startLine, int endLine)
+      : m_search(search), m_pattern(pattern) {
+    m_startSamp = startSamp;
+    m_endSamp = endSamp;
+    m_startLine = startLine;
+    m_endLine = endLine;
+    m_tackSamp = ((pattern.Samples() - 1) / 2) + 1;
+    m_tackLine = ((pattern.Lines() - 1) / 2) + 1;
+    m_fftSamples = 0;
+    m_fftLines = 0;
+    m_haveCorrelationSums = false;
+    m_subsearch = NULL;
+
+    int samples = search.Samples();
+    int lines = search.Lines();
+    vector<double> valid(samples * lines);
+    for (int line = 1; line <= lines; line++) {
+      for (int samp = 1; samp <= samples; samp++) {
+        valid[(line - 1) * samples + samp - 1] = search.IsValid(samp, line) ? 1.0 : 0.0;
+      }
+    }
+    m_validTable = summedAreaTable(valid, samples, lines);
+  }
+
+
+  //! Destroys the ChipCorrelator
+  ChipCorrelator::~ChipCorrelator() {
+    delete m_subsearch;
+    m_subsearch = NULL;
+  }
+
+
+  /**
+   * Returns the percentage of a sub-search chip that is inside the search
+   * chip's valid range. This is the percentage Chip::IsValid(double) tests on
+   * the chip Chip::Extract(int, int, Chip &) would create.
+   *
+   * @param samp The search chip sample at the tack of the sub-search chip
+   * @param line The search chip line at the tack of the sub-search chip
+   *
+   * @return @b double The valid percentage of the sub-search chip
+   */
+  double ChipCorrelator::SubsearchValidPercent(int samp, int line) const {
+    return 100.0 * BoxSum(m_validTable, samp, line) /
+           (double)(m_pattern.Samples() * m_pattern.Lines());
+  }
+
+
+  /**
+   * Extracts the sub-search chip at a position, the same way
+   * Chip::Extract(int, int, Chip &) would. The same chip is reused for every
+   * position, so it is only valid until the next call.
+   *
+   * @param samp The search chip sample at the tack of the sub-search chip
+   * @param line The search chip line at the tack of the sub-search chip
+   *
+   * @return @b Chip& The sub-search chip
+   */
+  Chip &ChipCorrelator::SubsearchChip(int samp, int line) {
+    if (!m_subsearch) {
+      m_subsearch = new Chip(m_pattern.Samples(), m_pattern.Lines());
+    }
+    m_search.Extract(samp, line, *m_subsearch);
+    return *m_subsearch;
+  }
+
+
+  /**
+   * Returns the MaximumCorrelation goodness of fit of the pattern chip and the
+   * sub-search chip at a position: the absolute value of the correlation
+   * coefficient of the pixel pairs that are both valid.
+   *
+   * The result matches MaximumCorrelation::MatchAlgorithm up to floating
+   * point roundoff, except that sub-search chips whose variance is lost in
+   * roundoff are treated as constant.
+   *
+   * @param samp The search chip sample at the tack of the sub-search chip
+   * @param line The search chip line at the tack of the sub-search chip
+   * @param patternValidPercent The percentage of the pixel pairs that must
+   *                            be valid
+   *
+   * @return @b double The goodness of fit, or Null if it can not be computed
+   */
+  double ChipCorrelator::Correlation(int samp, int line, double patternValidPercent) {
+    if (!m_haveCorrelationSums) {
+      ComputeCorrelationSums();
+    }
+
+    int index = (line - m_startLine) * (m_endSamp - m_startSamp + 1) + (samp - m_startSamp);
+    double count = m_count[index];
+    double percentValid = count / (m_pattern.Lines() * m_pattern.Samples());
+    if (percentValid * 100.0 < patternValidPercent) return Null;
+    if (count <= 1.0) return Null;
+
+    double averageX = m_sumX[index] / count;
+    double averageY = m_sumY[index] / count;
+    double covariance = (m_sumXY[index] - averageY * m_sumX[index] -
+                         averageX * m_sumY[index] + averageX * averageY * count) /
+                        (count - 1.0);
+
+    // Variances are computed the way Statistics does
+    double varianceX = count * m_sumXX[index] - m_sumX[index] * m_sumX[index];
+    double varianceY = count * m_sumYY[index] - m_sumY[index] * m_sumY[index];
+    if (varianceX <= 1.0e-10 * count * m_sumXX[index]) return Null;
+    if (varianceY <= 1.0e-10 * count * m_sumYY[index]) return Null;
+    varianceX /= (count - 1.0) * count;
+    varianceY /= (count - 1.0) * count;
+
+    return fabs(covariance / (sqrt(varianceX) * sqrt(varianceY)));
+  }
+
+
+  /**
+   * Computes the MultivariateStatistics sums of the pattern chip and the
+   * sub-search chip at every position. Both chips are shifted by the average
+   * of their valid pixels first, which leaves the correlation coefficients
+   * unchanged and keeps the sums small.
+   */
+  void ChipCorrelator::ComputeCorrelationSums() {
+    int patternSamples = m_pattern.Samples();
+    int patternLines = m_pattern.Lines();
+    int searchSamples = m_search.Samples();
+    int searchLines = m_search.Lines();
+    int positionSamples = m_endSamp - m_startSamp + 1;
+    int positionLines = m_endLine - m_startLine + 1;
+
+    FourierTransform fft;
+    m_fftSamples = fft.NextPowerOfTwo(positionSamples + patternSamples - 1);
+    m_fftLines = fft.NextPowerOfTwo(positionLines + patternLines - 1);
+    int fftSize = m_fftSamples * m_fftLines;
+
+    // Pattern pixel (i, j) of the position at correlation image index (u, v)
+    //   is search chip pixel (u + i + sampOffset, v + j + lineOffset)
+    int sampOffset = m_startSamp - m_tackSamp + 1;
+    int lineOffset = m_startLine - m_tackLine + 1;
+
+    double patternSum = 0.0;
+    double patternCount = 0.0;
+    for (int line = 1; line <= patternLines; line++) {
+      for (int samp = 1; samp <= patternSamples; samp++) {
+        double value = m_pattern.GetValue(samp, line);
+        if (IsValidPixel(value)) {
+          patternSum += value;
+          patternCount++;
+        }
+      }
+    }
+    double patternAverage = (patternCount > 0.0) ? patternSum / patternCount : 0.0;
+
+    double searchSum = 0.0;
+    double searchCount = 0.0;
+    for (int line = 1; line <= searchLines; line++) {
+      for (int samp = 1; samp <= searchSamples; samp++) {
+        double value = m_search.GetValue(samp, line);
+        if (IsValidPixel(value)) {
+          searchSum += value;
+          searchCount++;
+        }
+      }
+    }
+    double searchAverage = (searchCount > 0.0) ? searchSum / searchCount : 0.0;
+
+    // The pattern chip in the corner of the correlation images
+    vector<double> patternMask(fftSize, 0.0);
+    vector<double> patternValues(fftSize, 0.0);
+    vector<double> patternSquares(fftSize, 0.0);
+    double patternValueSum = 0.0;
+    double patternSquareSum = 0.0;
+    for (int line = 1; line <= patternLines; line++) {
+      for (int samp = 1; samp <= patternSamples; samp++) {
+        double value = m_pattern.GetValue(samp, line);
+        if (IsValidPixel(value)) {
+          int index = (line - 1) * m_fftSamples + samp - 1;
+          value -= patternAverage;
+          patternMask[index] = 1.0;
+          patternValues[index] = value;
+          patternSquares[index] = value * value;
+          patternValueSum += value;
+          patternSquareSum += value * value;
+        }
+      }
+    }
+    bool patternComplete = (patternCount == patternSamples * patternLines);
+
+    // The part of the search chip the positions cover, in the correlation
+    //   images, and the whole search chip for the summed-area tables
+    vector<double> searchMask(fftSize, 0.0);
+    vector<double> searchValues(fftSize, 0.0);
+    vector<double> searchSquares(fftSize, 0.0);
+    vector<double> chipMask(searchSamples * searchLines, 0.0);
+    vector<double> chipValues(searchSamples * searchLines, 0.0);
+    vector<double> chipSquares(searchSamples * searchLines, 0.0);
+    for (int line = 1; line <= searchLines; line++) {
+      for (int samp = 1; samp <= searchSamples; samp++) {
+        double value = m_search.GetValue(samp, line);
+        if (!IsValidPixel(value)) continue;
+
+        value -= searchAverage;
+        int chipIndex = (line - 1) * searchSamples + samp - 1;
+        chipMask[chipIndex] = 1.0;
+        chipValues[chipIndex] = value;
+        chipSquares[chipIndex] = value * value;
+
+        int u = samp - sampOffset;
+        int v = line - lineOffset;
+        if (u >= 0 && u < m_fftSamples && v >= 0 && v < m_fftLines) {
+          int index = v * m_fftSamples + u;
+          searchMask[index] = 1.0;
+          searchValues[index] = value;
+          searchSquares[index] = value * value;
+        }
+      }
+    }
+
+    ComplexImage searchValuesTransform = Transform(searchValues);
+    ComplexImage patternValuesTransform = Transform(patternValues);
+    vector<double> sumXY = Correlate(searchValuesTransform, patternValuesTransform);
+
+    vector<double> count, sumX, sumXX, sumY, sumYY;
+    vector<double> maskTable, valueTable, squareTable;
+    if (patternComplete) {
+      maskTable = summedAreaTable(chipMask, searchSamples, searchLines);
+      valueTable = summedAreaTable(chipValues, searchSamples, searchLines);
+      squareTable = summedAreaTable(chipSquares, searchSamples, searchLines);
+    }
+    else {
+      ComplexImage searchMaskTransform = Transform(searchMask);
+      ComplexImage patternMaskTransform = Transform(patternMask);
+      count = Correlate(searchMaskTransform, patternMaskTransform);
+      sumY = Correlate(searchValuesTransform, patternMaskTransform);
+      sumYY = Correlate(Transform(searchSquares), patternMaskTransform);
+    }
+
+    // Pattern sums only change where part of the sub-search chip is invalid
+    bool needPatternSums = !patternComplete;
+    for (int line = m_startLine; line <= m_endLine && !needPatternSums; line++) {
+      for (int samp = m_startSamp; samp <= m_endSamp && !needPatternSums; samp++) {
+        needPatternSums = (BoxSum(maskTable, samp, line) != patternCount);
+      }
+    }
+    if (needPatternSums) {
+      ComplexImage searchMaskTransform = Transform(searchMask);
+      sumX = Correlate(searchMaskTransform, patternValuesTransform);
+      sumXX = Correlate(searchMaskTransform, Transform(patternSquares));
+    }
+
+    int positions = positionSamples * positionLines;
+    m_count.resize(positions);
+    m_sumX.resize(positions);
+    m_sumXX.resize(positions);
+    m_sumY.resize(positions);
+    m_sumYY.resize(positions);
+    m_sumXY.resize(positions);
+    for (int v = 0; v < positionLines; v++) {
+      for (int u = 0; u < positionSamples; u++) {
+        int index = v * positionSamples + u;
+        int fftIndex = v * m_fftSamples + u;
+        int samp = m_startSamp + u;
+        int line = m_startLine + v;
+
+        if (patternComplete) {
+          m_count[index] = BoxSum(maskTable, samp, line);
+          m_sumY[index] = BoxSum(valueTable, samp, line);
+          m_sumYY[index] = BoxSum(squareTable, samp, line);
+        }
+        else {
+          m_count[index] = floor(count[fftIndex] + 0.5);
+          m_sumY[index] = sumY[fftIndex];
+          m_sumYY[index] = sumYY[fftIndex];
+        }
+
+        if (needPatternSums) {
+          m_sumX[index] = sumX[fftIndex];
+          m_sumXX[index] = sumXX[fftIndex];
+        }
+        else {
+          m_sumX[index] = patternValueSum;
+          m_sumXX[index] = patternSquareSum;
+        }
+        m_sumXY[index] = sumXY[fftIndex];
+      }
+    }
+
+    m_haveCorrelationSums = true;
+  }
+
+
+  /**
+   * Returns the Fourier transform of a correlation image.
+   *
+   * @param image The m_fftSamples x m_fftLines image, line by line
+   *
+   * @return @b ComplexImage The transform
+   */
+  ChipCorrelator::ComplexImage ChipCorrelator::Transform(const vector<double> &image) const {
+    FourierTransform fft;
+    ComplexImage transform(image.size());
+
+    // The rows are real, so they use the half size real transform
+    vector<double> row(m_fftSamples);
+    for (int line = 0; line < m_fftLines; line++) {
+      std::copy(image.begin() + line * m_fftSamples,
+                image.begin() + (line + 1) * m_fftSamples, row.begin());
+      vector< complex<double> > rowTransform = fft.Transform(row);
+      std::copy(rowTransform.begin(), rowTransform.end(),
+                transform.begin() + line * m_fftSamples);
+    }
+
+    transformColumns(transform, m_fftSamples, m_fftLines, false);
+    return transform;
+  }
+
+
+  /**
+   * Correlates two images from their Fourier transforms. Entry (u, v) of the
+   * result is the sum of search(u + i, v + j) * pattern(i, j) over every
+   * pixel (i, j) of the pattern.
+   *
+   * @param search The transform of the search image
+   * @param pattern The transform of the pattern image
+   *
+   * @return @b vector<double> The correlation, line by line
+   */
+  vector<double> ChipCorrelator::Correlate(const ComplexImage &search,
+                                           const ComplexImage &pattern) const {
+    ComplexImage product(search.size());
+    for (unsigned int i = 0; i < product.size(); i++) {
+      product[i] = search[i] * conj(pattern[i]);
+    }
+    transform2D(product, m_fftSamples, m_fftLines, true);
+
+    vector<double> result(product.size());
+    for (unsigned int i = 0; i < product.size(); i++) {
+      result[i] = product[i].real();
+    }
+    return result;
+  }
+
+
+  /**
+   * Sums the pixels of a search chip summed-area table that the sub-search
+   * chip at a position covers. Pixels outside of the search chip add nothing.
+   *
+   * @param table A summed-area table the size of the search chip
+   * @param samp The search chip sample at the tack of the sub-search chip
+   * @param line The search chip line at the tack of the sub-search chip
+   *
+   * @return @b double The sum
+   */
+  double ChipCorrelator::BoxSum(const vector<double> &table, int samp, int line) const {
+    int samples = m_search.Samples();
+    int startSamp = std::max(samp - m_tackSamp + 1, 1);
+    int endSamp = std::min(samp - m_tackSamp + m_pattern.Samples(), samples);
+    int startLine = std::max(line - m_tackLine + 1, 1);
+    int endLine = std::min(line - m_tackLine + m_pattern.Lines(), m_search.Lines());
+    if (startSamp > endSamp || startLine > endLine) return 0.0;
+
+    int width = samples + 1;
+    return table[endLine * width + endSamp] - table[(startLine - 1) * width + endSamp] -
+           table[endLine * width + startSamp - 1] + table[(startLine - 1) * width + startSamp - 1];
+  }
+}
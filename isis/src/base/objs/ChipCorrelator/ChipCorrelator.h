@@ -0,0 +1,102 @@
+#ifndef ChipCorrelator_h
+#define ChipCorrelator_h
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include <complex>
+#include <vector>
+
+namespace Isis {
+  class Chip;
+
+  /**
+   * @brief Whole search chip pattern matching sums
+   *
+   * AutoReg::Match extracts a sub-search chip at every tested position of the
+   * search chip and compares it with the pattern chip, so one match costs the
+   * number of positions times the number of pattern pixels. This class
+   * computes the terms that matching algorithms need for every position at
+   * once:
+   *
+   * <ul>
+   *   <li>The number of sub-search chip pixels inside the search chip's valid
+   *       range, from a summed-area table of the search chip.</li>
+   *   <li>The sums a MultivariateStatistics of the pattern and sub-search chip
+   *       would accumulate. The cross term comes from a correlation computed
+   *       with FourierTransform. The sub-search chip counts, sums and sums of
+   *       squares come from summed-area tables when the whole pattern chip is
+   *       valid, and from more correlations when it is not.</li>
+   * </ul>
+   *
+   * Positions use the same coordinates as Chip::Extract(int, int, Chip &): the
+   * search chip sample and line placed at the tack of the sub-search chip.
+   * The correlation sums are only computed the first time they are needed.
+   *
+   * @ingroup PatternMatching
+   *
+   * @see AutoReg MaximumCorrelation MinimumDifference
+   */
+  class ChipCorrelator {
+    public:
+      ChipCorrelator(Chip &search, Chip &pattern, int startSamp, int endSamp,
+                     int startLine, int endLine);
+      ~ChipCorrelator();
+
+      /**
+       * @returns The search chip
+       */
+      Chip &SearchChip() {
+        return m_search;
+      }
+
+      /**
+       * @returns The pattern chip
+       */
+      Chip &PatternChip() {
+        return m_pattern;
+      }
+
+      double SubsearchValidPercent(int samp, int line) const;
+      double Correlation(int samp, int line, double patternValidPercent);
+      Chip &SubsearchChip(int samp, int line);
+
+    private:
+      typedef std::vector< std::complex<double> > ComplexImage;
+
+      void ComputeCorrelationSums();
+      ComplexImage Transform(const std::vector<double> &image) const;
+      std::vector<double> Correlate(const ComplexImage &search,
+                                    const ComplexImage &pattern) const;
+      double BoxSum(const std::vector<double> &table, int samp, int line) const;
+
+      Chip &m_search;  //!< The search chip
+      Chip &m_pattern; //!< The pattern chip
+      int m_startSamp; //!< The first search chip sample tested
+      int m_endSamp;   //!< The last search chip sample tested
+      int m_startLine; //!< The first search chip line tested
+      int m_endLine;   //!< The last search chip line tested
+      int m_tackSamp;  //!< The tack sample of a sub-search chip
+      int m_tackLine;  //!< The tack line of a sub-search chip
+      int m_fftSamples; //!< The width of the correlation images, a power of two
+      int m_fftLines;   //!< The height of the correlation images, a power of two
+
+      //! The sub-search chip returned by SubsearchChip(), reused for every position
+      Chip *m_subsearch;
+
+      //! Summed-area table of the search chip pixels in its valid range
+      std::vector<double> m_validTable;
+
+      bool m_haveCorrelationSums; //!< If the correlation sums have been computed
+      std::vector<double> m_count; //!< Valid pixel pairs at each position
+      std::vector<double> m_sumX;  //!< Sum of the pattern pixels of the pairs
+      std::vector<double> m_sumXX; //!< Sum of the squared pattern pixels
+      std::vector<double> m_sumY;  //!< Sum of the sub-search chip pixels
+      std::vector<double> m_sumYY; //!< Sum of the squared sub-search chip pixels
+      std::vector<double> m_sumXY; //!< Sum of the pixel products
+  };
+};
+
+#endif
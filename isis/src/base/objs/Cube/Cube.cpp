@@ -6,6 +6,7 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "Cube.h"
 
+#include <algorithm>
 #include <sstream>
 #include <unistd.h>
 
@@ -33,8 +34,10 @@ find files of those names at the top level of this repository. **/
 #include "Message.h"
 #include "OriginalLabel.h"
 #include "OriginalXmlLabel.h"
+#include "Portal.h"
 #include "Preference.h"
 #include "ProgramLauncher.h"
+#include "Progress.h"
 #include "Projection.h"
 #include "SpecialPixel.h"
 #include "Statistics.h"
@@ -171,6 +174,9 @@ namespace Isis {
 
     delete m_formatTemplateFile;
     m_formatTemplateFile = NULL;
+
+    delete m_overviews;
+    m_overviews = NULL;
   }
 
 
@@ -232,6 +238,18 @@ namespace Isis {
   }
 
 
+  /**
+   * Test if reads of the opened cube come from its memory mapped data file,
+   *   see the CubeReadMode performance preference. The data file is mapped
+   *   on the first read.
+   *
+   * @returns True if the cube's data file is memory mapped
+   */
+  bool Cube::isMemoryMapped() const {
+    return m_ioHandler && m_ioHandler->isMemoryMapped();
+  }
+
+
   /**
    * Test if labels are attached. If a cube is open, then this indicates
    *   whether or not the opened cube's labels are attached. If a cube is not
@@ -731,6 +749,7 @@ namespace Isis {
     }
 
     initCoreFromLabel(*m_label);
+    m_overviewsListed = hasGroup("Overviews");
 
     // Determine the number of bytes in the label
     if (m_attached) {
@@ -838,6 +857,25 @@ namespace Isis {
   }
 
 
+  /**
+   * This method will read a buffer of data from an overview level of the
+   * cube. Level n has 2^n times fewer samples and lines than the cube, and the
+   * position of the buffer is given in the pixels of that level. Level 0 is
+   * the cube itself. Overviews are created with createOverviews().
+   *
+   * @param bufferToFill The buffer to be filled with cube data
+   * @param level The overview level to read from, 0 to overviewCount()
+   */
+  void Cube::read(Buffer &bufferToFill, int level) const {
+    if (level == 0) {
+      read(bufferToFill);
+      return;
+    }
+
+    overview(level)->read(bufferToFill);
+  }
+
+
   /**
    * Read the History from the Cube.
    *
@@ -1135,6 +1173,9 @@ namespace Isis {
     }
 
     QMutexLocker locker(m_mutex);
+    if (m_overviewsListed) {
+      removeOverviews();
+    }
     m_ioHandler->write(bufferToWrite);
   }
 
@@ -1751,6 +1792,30 @@ namespace Isis {
   }
 
 
+  /**
+   * @returns the number of overview levels listed in the label of the cube,
+   *   or 0 if no cube is open or no overviews have been created. Overviews
+   *   listed for a cube with a different file name or dimensions, like a
+   *   label copied from another cube, are not counted.
+   */
+  int Cube::overviewCount() const {
+    if (!isOpen() || !hasGroup("Overviews")) {
+      return 0;
+    }
+
+    const PvlGroup &overviews = group("Overviews");
+    if (!overviews.hasKeyword("CubeFileName") ||
+        overviews["CubeFileName"][0] != FileName(fileName()).name() ||
+        toInt(overviews["Samples"][0]) != sampleCount() ||
+        toInt(overviews["Lines"][0]) != lineCount() ||
+        toInt(overviews["Bands"][0]) != m_bands) {
+      return 0;
+    }
+
+    return overviews.findKeyword("FileName").size();
+  }
+
+
   /**
    * @returns the accuracy of pixels in the file. If no cube is opened yet, then
    *   this is the accuracy/number of bytes per pixel that will be used if
@@ -1897,6 +1962,138 @@ namespace Isis {
   }
 
 
+  /**
+   * Creates the overview pyramid of the cube. Each level averages the valid
+   * pixels of 2x2 blocks of the level below it, so level n has 2^n times
+   * fewer samples and lines than the cube. Levels are created until neither
+   * dimension is larger than the minimum size. Blocks without valid pixels
+   * are Null.
+   *
+   * Each level is saved as a Real cube next to this cube, named like the
+   * cube with "_overview<level>.cub" appended, and the levels are listed in
+   * the Overviews group of the label with the file name and dimensions of
+   * the cube. Levels left from earlier overviews with more levels are
+   * deleted. Writing to the cube removes its overviews, because they no
+   * longer match the DNs, so they must be created again after the DNs change.
+   *
+   * @param minimumSize The largest dimension of the coarsest level
+   */
+  void Cube::createOverviews(int minimumSize) {
+    if (!isOpen() || !isReadWrite()) {
+      QString msg = "Cannot create overviews of a cube unless it is opened read-write";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (m_virtualBandList) {
+      QString msg = "Cannot create overviews of cube [" + fileName() +
+                    "] while virtual bands are selected";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (minimumSize < 1) {
+      QString msg = "The minimum overview size must be at least 1";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    // Close any overviews read from so the files can be replaced
+    qDeleteAll(*m_overviews);
+    m_overviews->clear();
+
+    int levels = 0;
+    int steps = 0;
+    for (int samples = sampleCount(), lines = lineCount();
+         max(samples, lines) > minimumSize;
+         samples = (samples + 1) / 2, lines = (lines + 1) / 2) {
+      levels++;
+      steps += (lines + 1) / 2 * bandCount();
+    }
+
+    FileName cubeFile(fileName());
+    QString overviewBase = cubeFile.removeExtension().expanded().split("/").last();
+
+    // Remove the levels of earlier overviews that are not created again
+    for (int level = levels + 1; ; level++) {
+      QFile oldOverview(cubeFile.path() + "/" + overviewBase + "_overview" +
+                        toString(level) + ".cub");
+      if (!oldOverview.exists()) {
+        break;
+      }
+      oldOverview.remove();
+    }
+
+    if (levels == 0) {
+      if (hasGroup("Overviews")) {
+        deleteGroup("Overviews");
+      }
+      return;
+    }
+
+    Progress progress;
+    progress.SetText("Creating overviews");
+    progress.SetMaximumSteps(steps);
+    progress.CheckStatus();
+
+    PvlKeyword overviewFiles("FileName");
+
+    // Each level is made from the level before it
+    Cube *source = this;
+    for (int level = 1; level <= levels; level++) {
+      QString overviewFile = overviewBase + "_overview" + toString(level) + ".cub";
+
+      Cube *overview = new Cube;
+      overview->setDimensions((source->sampleCount() + 1) / 2,
+                              (source->lineCount() + 1) / 2,
+                              bandCount());
+      overview->setPixelType(Real);
+      overview->create(cubeFile.path() + "/" + overviewFile);
+      overviewFiles += overviewFile;
+
+      Portal sourceLines(source->sampleCount(), 2, source->pixelType());
+      Portal overviewLine(overview->sampleCount(), 1, Real);
+      for (int band = 1; band <= bandCount(); band++) {
+        for (int line = 1; line <= overview->lineCount(); line++) {
+          sourceLines.SetPosition(1, 2 * line - 1, band);
+          source->read(sourceLines);
+
+          for (int samp = 0; samp < overview->sampleCount(); samp++) {
+            double sum = 0.0;
+            int validCount = 0;
+            for (int i = 0; i < 2; i++) {
+              for (int j = 0; j < 2 && 2 * samp + j < source->sampleCount(); j++) {
+                double value = sourceLines[i * source->sampleCount() + 2 * samp + j];
+                if (IsValidPixel(value)) {
+                  sum += value;
+                  validCount++;
+                }
+              }
+            }
+
+            overviewLine[samp] = (validCount > 0) ? sum / validCount : Null;
+          }
+
+          overviewLine.SetPosition(1, line, band);
+          overview->write(overviewLine);
+          progress.CheckStatus();
+        }
+      }
+
+      if (source != this) {
+        delete source;
+      }
+      source = overview;
+    }
+    delete source;
+
+    PvlGroup overviews("Overviews");
+    overviews += PvlKeyword("CubeFileName", cubeFile.name());
+    overviews += PvlKeyword("Samples", toString(sampleCount()));
+    overviews += PvlKeyword("Lines", toString(lineCount()));
+    overviews += PvlKeyword("Bands", toString(m_bands));
+    overviews += overviewFiles;
+    putGroup(overviews);
+  }
+
+
   /**
    * This method returns a boolean value
    *
@@ -2069,6 +2266,10 @@ namespace Isis {
     else {
       isiscube.addGroup(group);
     }
+
+    if (group.isNamed("Overviews")) {
+      m_overviewsListed = true;
+    }
   }
 
 
@@ -2144,10 +2345,37 @@ namespace Isis {
     delete m_virtualBandList;
     m_virtualBandList = NULL;
 
+    qDeleteAll(*m_overviews);
+    m_overviews->clear();
+
     initialize();
   }
 
 
+  /**
+   * Removes the Overviews group from the label and closes any overview cubes
+   * that were read from. If the overviews were created for this cube, their
+   * files are deleted too. This is called on the first write to the cube,
+   * because the overviews no longer match its DNs. The caller must hold
+   * m_mutex.
+   */
+  void Cube::removeOverviews() {
+    qDeleteAll(*m_overviews);
+    m_overviews->clear();
+
+    if (overviewCount() > 0) {
+      QString path = FileName(fileName()).path();
+      const PvlKeyword &overviewFiles = group("Overviews").findKeyword("FileName");
+      for (int level = 0; level < overviewFiles.size(); level++) {
+        QFile::remove(path + "/" + overviewFiles[level]);
+      }
+    }
+
+    deleteGroup("Overviews");
+    m_overviewsListed = false;
+  }
+
+
   /**
    * Initialize members from their initial undefined states
    *
@@ -2170,6 +2398,7 @@ namespace Isis {
     m_virtualBandList = NULL;
 
     m_mutex = new QMutex();
+    m_overviews = new QList<Cube *>;
     m_formatTemplateFile =
          new FileName("$ISISROOT/appdata/templates/labels/CubeFormatTemplate.pft");
 
@@ -2177,6 +2406,50 @@ namespace Isis {
   }
 
 
+  /**
+   * Returns an overview level of the cube, opening it if it has not been
+   * read from yet. The overview uses the same virtual bands as the cube.
+   *
+   * @param level The overview level, 1 to overviewCount()
+   *
+   * @returns The overview cube
+   */
+  Cube *Cube::overview(int level) const {
+    if (level < 1 || level > overviewCount()) {
+      QString msg = "Overview level [" + toString(level) + "] does not exist in cube [" +
+                    fileName() + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    QMutexLocker locker(m_mutex);
+    PvlKeyword &overviewFiles = group("Overviews").findKeyword("FileName");
+    while (m_overviews->size() < level) {
+      Cube *overview = new Cube;
+      if (m_virtualBandList) {
+        QList<QString> bands;
+        foreach (int band, *m_virtualBandList) {
+          bands.append(toString(band));
+        }
+        overview->setVirtualBands(bands);
+      }
+
+      try {
+        overview->open(FileName(fileName()).path() + "/" +
+                       overviewFiles[m_overviews->size()]);
+      }
+      catch (IException &e) {
+        delete overview;
+        QString msg = "Unable to open overview level [" + toString(m_overviews->size() + 1) +
+                      "] of cube [" + fileName() + "]";
+        throw IException(e, IException::Io, msg, _FILEINFO_);
+      }
+      m_overviews->append(overview);
+    }
+
+    return m_overviews->at(level - 1);
+  }
+
+
   /**
    * This returns the QFile with cube DN data in it. NULL will be returned
    *   if no files are opened.
@@ -2277,6 +2550,8 @@ namespace Isis {
 
     m_base = 0.0;
     m_multiplier = 1.0;
+
+    m_overviewsListed = false;
   }
 
 
@@ -242,6 +242,7 @@ namespace Isis {
       bool isProjected() const;
       bool isReadOnly() const;
       bool isReadWrite() const;
+      bool isMemoryMapped() const;
       bool labelsAttached() const;
 
       void attachSpiceFromIsd(nlohmann::json Isd);
@@ -256,6 +257,7 @@ namespace Isis {
       void read(Blob &blob,
                 const std::vector<PvlKeyword> keywords = std::vector<PvlKeyword>()) const;
       void read(Buffer &rbuf) const;
+      void read(Buffer &rbuf, int level) const;
       OriginalLabel readOriginalLabel(const QString &name="IsisCube") const;
       CubeStretch readCubeStretch(QString name="CubeStretch",
                                   const std::vector<PvlKeyword> keywords = std::vector<PvlKeyword>()) const;
@@ -284,6 +286,8 @@ namespace Isis {
       void setVirtualBands(const QList<QString> &vbands);
       void setVirtualBands(const std::vector<QString> &vbands);
 
+      void createOverviews(int minimumSize = 256);
+
       void relocateDnData(FileName dnDataFile);
 //       static void relocateDnData(FileName externalLabelFile, FileName dnDataFile);
 
@@ -303,6 +307,7 @@ namespace Isis {
       int labelSize(bool actual = false) const;
       int lineCount() const;
       double multiplier() const;
+      int overviewCount() const;
       PixelType pixelType() const;
       virtual int physicalBand(const int &virtualBand) const;
       Projection *projection();
@@ -333,7 +338,9 @@ namespace Isis {
 
       void construct();
       QFile *dataFile() const;
+      Cube *overview(int level) const;
       FileName realDataFileName() const;
+      void removeOverviews();
 
       void initialize();
       void initCoreFromLabel(const Pvl &label);
@@ -451,6 +458,18 @@ namespace Isis {
 
       //! If allocated, converts from physical on-disk band # to virtual band #
       QList<int> *m_virtualBandList;
+
+      /**
+       * The overview cubes opened by read(Buffer &, int), in level order. The
+       *   overviews are opened the first time a level is read.
+       */
+      QList<Cube *> *m_overviews;
+
+      /**
+       * True if the label has an Overviews group, which is removed on the first
+       *   write to the cube.
+       */
+      bool m_overviewsListed;
   };
 }
 
@@ -75,6 +75,10 @@ namespace Isis {
   void CubeBsqHandler::readRaw(RawCubeChunk &chunkToFill) {
     BigInt startByte = getChunkStartByte(chunkToFill);
 
+    if(readMappedRaw(chunkToFill, startByte)) {
+      return;
+    }
+
     bool success = false;
 
     QFile * dataFile = getDataFile();
@@ -10,6 +10,9 @@ find files of those names at the top level of this repository. **/
 #include <cmath>
 #include <iomanip>
 
+#include <sys/mman.h>
+
+#include <QByteArray>
 #include <QDebug>
 #include <QFile>
 #include <QList>
@@ -29,6 +32,7 @@ find files of those names at the top level of this repository. **/
 #include "EndianSwapper.h"
 #include "IException.h"
 #include "IString.h"
+#include "PixelConversion.h"
 #include "PixelType.h"
 #include "Preference.h"
 #include "Pvl.h"
@@ -61,6 +65,8 @@ namespace Isis {
   CubeIoHandler::CubeIoHandler(QFile * dataFile,
       const QList<int> *virtualBandList, const Pvl &label, bool alreadyOnDisk) {
     m_byteSwapper = NULL;
+    m_rawToDouble = NULL;
+    m_doubleToRaw = NULL;
     m_cachingAlgorithms = NULL;
     m_dataIsOnDiskMap = NULL;
     m_rawData = NULL;
@@ -70,6 +76,9 @@ namespace Isis {
     m_writeCache = NULL;
     m_ioThreadPool = NULL;
     m_writeThreadMutex = NULL;
+    m_mappedData = NULL;
+    m_mappedSize = 0;
+    m_useMemoryMap = false;
 
     try {
       if (!dataFile) {
@@ -89,6 +98,16 @@ namespace Isis {
         m_ioThreadPool->setMaxThreadCount(1);
       }
 
+      // Memory mapping is only used for reading existing cubes. Cubes opened
+      //   for writing keep using buffered I/O so that the mapping never has to
+      //   track the file growing or chunks being written back.
+      if (performancePrefs.hasKeyword("CubeReadMode")) {
+        IString cubeReadPerfOpt = performancePrefs["CubeReadMode"][0];
+        m_useMemoryMap = alreadyOnDisk &&
+                         cubeReadPerfOpt.DownCase() == "memorymapped" &&
+                         !(dataFile->openMode() & QIODevice::WriteOnly);
+      }
+
       m_consecutiveOverflowCount = 0;
       m_lastOperationWasWrite = false;
       m_rawData = new QMap<int, RawCubeChunk *>;
@@ -120,6 +139,10 @@ namespace Isis {
         m_byteSwapper = NULL;
       }
 
+      // Choose the pixel conversions once instead of for every pixel
+      m_rawToDouble = PixelConversion::rawToDoubleKernel(m_pixelType, m_byteSwapper != NULL);
+      m_doubleToRaw = PixelConversion::doubleToRawKernel(m_pixelType, m_byteSwapper != NULL);
+
       const PvlGroup &dimensions = core.findGroup("Dimensions");
       m_numSamples = dimensions.findKeyword("Samples");
       m_numLines = dimensions.findKeyword("Lines");
@@ -185,6 +208,14 @@ namespace Isis {
       m_rawData = NULL;
     }
 
+    // Chunks may reference the mapped file, so this must happen after they
+    //   are all gone.
+    if (m_mappedData) {
+      m_dataFile->unmap(m_mappedData);
+      m_mappedData = NULL;
+      m_mappedSize = 0;
+    }
+
     if (m_writeCache) {
       delete m_writeCache->first;
       m_writeCache->first = NULL;
@@ -363,6 +394,7 @@ namespace Isis {
    */
   void CubeIoHandler::addCachingAlgorithm(CubeCachingAlgorithm *algorithm) {
     m_cachingAlgorithms->prepend(algorithm);
+    adviseMappedAccess();
   }
 
 
@@ -456,6 +488,19 @@ namespace Isis {
     return m_writeThreadMutex;
   }
 
+
+  /**
+   * Tells whether reads are served from the memory mapped data file. The file
+   *   is mapped on the first read, so this is false until then, and it stays
+   *   false if the preference is not MemoryMapped, the cube is writable or
+   *   mapping the file failed.
+   *
+   * @return True if the data file is memory mapped
+   */
+  bool CubeIoHandler::isMemoryMapped() const {
+    return m_mappedData != NULL;
+  }
+
   /**
    * @return the number of physical bands in the cube.
    */
@@ -658,6 +703,82 @@ namespace Isis {
   }
 
 
+  /**
+   * Children call this from readRaw() before falling back to a seek and read
+   *   of the data file. When the CubeReadMode preference is MemoryMapped and
+   *   the cube is read only, the data file is mapped on the first call and
+   *   chunkToFill is given a QByteArray that references the mapped pages
+   *   directly, so no system call, allocation or copy happens for the read.
+   *   The chunk's data is copied on write by QByteArray if it is ever
+   *   modified.
+   *
+   * @param chunkToFill The container that needs to be filled with cube data
+   * @param startByte The 0-based file position of the chunk's first byte
+   * @return True if chunkToFill now references the mapped data, false if the
+   *   caller needs to read the data itself
+   */
+  bool CubeIoHandler::readMappedRaw(RawCubeChunk &chunkToFill, BigInt startByte) {
+    if (!m_useMemoryMap) {
+      return false;
+    }
+
+    if (!m_mappedData) {
+      // Map from the start of the file so the mapping is page aligned, which
+      //   is required for the paging hints.
+      m_mappedSize = m_dataFile->size();
+      if (m_mappedSize > 0) {
+        m_mappedData = m_dataFile->map(0, m_mappedSize);
+      }
+
+      if (!m_mappedData) {
+        // Not every file system supports mapping; quietly use buffered reads.
+        m_useMemoryMap = false;
+        m_mappedSize = 0;
+        return false;
+      }
+
+      adviseMappedAccess();
+    }
+
+    if (startByte < 0 || startByte + chunkToFill.getByteCount() > m_mappedSize) {
+      return false;
+    }
+
+    chunkToFill.setRawData(QByteArray::fromRawData(
+        (const char *)m_mappedData + startByte, chunkToFill.getByteCount()));
+    return true;
+  }
+
+
+  /**
+   * Tell the operating system how the mapped data file will be paged in,
+   *   based on the highest priority caching algorithm. This does nothing if
+   *   the data file is not mapped.
+   */
+  void CubeIoHandler::adviseMappedAccess() const {
+    if (!m_mappedData || m_cachingAlgorithms->isEmpty()) {
+      return;
+    }
+
+    int advice = POSIX_MADV_NORMAL;
+
+    switch (m_cachingAlgorithms->first()->accessPattern()) {
+      case CubeCachingAlgorithm::SequentialAccess:
+        advice = POSIX_MADV_SEQUENTIAL;
+        break;
+      case CubeCachingAlgorithm::RandomAccess:
+        advice = POSIX_MADV_RANDOM;
+        break;
+      case CubeCachingAlgorithm::NormalAccess:
+        advice = POSIX_MADV_NORMAL;
+        break;
+    }
+
+    // This is only a hint, a failure here does not affect correctness.
+    posix_madvise(m_mappedData, m_mappedSize, advice);
+  }
+
+
   /**
    * This blocks (doesn't return) until the number of active runnables in the
    *   thread pool goes to 0. This uses the m_writeThreadMutex, because the
@@ -1351,12 +1472,9 @@ namespace Isis {
    */
   void CubeIoHandler::writeIntoDouble(const RawCubeChunk &chunk,
                                       Buffer &output, int index) const {
-    // The code in this method is highly optimized. Even the order of the if
-    //   statements will have a significant impact on performance if changed.
-    //   Also, there is a lot of duplicate code in both writeIntoDouble(...) and
-    //   writeIntoRaw(...). This is needed for performance gain. Any function
-    //   or method calls from within the x loop cause significant performance
-    //   decreases.
+    // The pixel conversion is done a whole row at a time by the kernel that
+    //   was chosen for our pixel type and byte order in the constructor. Keep
+    //   function or method calls out of the y loop when possible.
     int startX = 0;
     int startY = 0;
     int startZ = 0;
@@ -1374,9 +1492,13 @@ namespace Isis {
     int chunkStartBand = chunk.getStartBand();
     int chunkLineSize = chunk.sampleCount();
     int chunkBandSize = chunkLineSize * chunk.lineCount();
+    int pixelSize = SizeOf(m_pixelType);
+    int rowSize = endX - startX + 1;
     //double *buffersDoubleBuf = output.p_buf;
     double *buffersDoubleBuf = output.DoubleBuffer();
-    const char *chunkBuf = chunk.getRawData().data();
+    // Use constData() so chunks referencing a memory mapped file are not
+    //   copied just to be read.
+    const char *chunkBuf = chunk.getRawData().constData();
     char *buffersRawBuf = (char *)output.RawBuffer();
 
     for(int z = startZ; z <= endZ; z++) {
@@ -1392,150 +1514,14 @@ namespace Isis {
           const int &lineIntoChunk = y - chunkStartLine;
           int bufferIndex = output.Index(startX, y, virtualBand);
 
-          for(int x = startX; x <= endX; x++) {
-            const int &sampleIntoChunk = x - chunkStartSample;
-
-            const int &chunkIndex = sampleIntoChunk +
-                (chunkLineSize * lineIntoChunk) +
-                (chunkBandSize * bandIntoChunk);
-
-            double &bufferVal = buffersDoubleBuf[bufferIndex];
-
-            if(m_pixelType == Real) {
-              float raw = ((float *)chunkBuf)[chunkIndex];
-              if(m_byteSwapper)
-                raw = m_byteSwapper->Float(&raw);
-
-              if(raw >= VALID_MIN4) {
-                bufferVal = (double) raw;
-              }
-              else {
-                if(raw == NULL4)
-                  bufferVal = NULL8;
-                else if(raw == LOW_INSTR_SAT4)
-                  bufferVal = LOW_INSTR_SAT8;
-                else if(raw == LOW_REPR_SAT4)
-                  bufferVal = LOW_REPR_SAT8;
-                else if(raw == HIGH_INSTR_SAT4)
-                  bufferVal = HIGH_INSTR_SAT8;
-                else if(raw == HIGH_REPR_SAT4)
-                  bufferVal = HIGH_REPR_SAT8;
-                else
-                  bufferVal = LOW_REPR_SAT8;
-              }
-
-              ((float *)buffersRawBuf)[bufferIndex] = raw;
-            }
-
-            else if(m_pixelType == SignedWord) {
-              short raw = ((short *)chunkBuf)[chunkIndex];
-              if(m_byteSwapper)
-                raw = m_byteSwapper->ShortInt(&raw);
-
-              if(raw >= VALID_MIN2) {
-                bufferVal = (double) raw * m_multiplier + m_base;
-              }
-              else {
-                if(raw == NULL2)
-                  bufferVal = NULL8;
-                else if(raw == LOW_INSTR_SAT2)
-                  bufferVal = LOW_INSTR_SAT8;
-                else if(raw == LOW_REPR_SAT2)
-                  bufferVal = LOW_REPR_SAT8;
-                else if(raw == HIGH_INSTR_SAT2)
-                  bufferVal = HIGH_INSTR_SAT8;
-                else if(raw == HIGH_REPR_SAT2)
-                  bufferVal = HIGH_REPR_SAT8;
-                else
-                  bufferVal = LOW_REPR_SAT8;
-              }
-
-              ((short *)buffersRawBuf)[bufferIndex] = raw;
-            }
-
-
-            else if(m_pixelType == UnsignedWord) {
-              unsigned short raw = ((unsigned short *)chunkBuf)[chunkIndex];
-              if(m_byteSwapper)
-                raw = m_byteSwapper->UnsignedShortInt(&raw);
-
-              if(raw >= VALID_MINU2) {
-                bufferVal = (double) raw * m_multiplier + m_base;
-              }
-              else if (raw > VALID_MAXU2) {
-                if(raw == HIGH_INSTR_SATU2)
-                  bufferVal = HIGH_INSTR_SAT8;
-                else if(raw == HIGH_REPR_SATU2)
-                  bufferVal = HIGH_REPR_SAT8;
-                else
-                  bufferVal = LOW_REPR_SAT8;
-              }
-              else {
-                if(raw == NULLU2)
-                  bufferVal = NULL8;
-                else if(raw == LOW_INSTR_SATU2)
-                  bufferVal = LOW_INSTR_SAT8;
-                else if(raw == LOW_REPR_SATU2)
-                  bufferVal = LOW_REPR_SAT8;
-                else
-                  bufferVal = LOW_REPR_SAT8;
-              }
-
-              ((unsigned short *)buffersRawBuf)[bufferIndex] = raw;
-            }
-
-            else if(m_pixelType == UnsignedInteger) {
-
-              unsigned int raw = ((unsigned int *)chunkBuf)[chunkIndex];
-              if(m_byteSwapper)
-                raw = m_byteSwapper->Uint32_t(&raw);
-
-              if(raw >= VALID_MINUI4) {
-                bufferVal = (double) raw * m_multiplier + m_base;
-              }
-              else if (raw > VALID_MAXUI4) {
-                if(raw == HIGH_INSTR_SATUI4)
-                  bufferVal = HIGH_INSTR_SAT8;
-                else if(raw == HIGH_REPR_SATUI4)
-                  bufferVal = HIGH_REPR_SAT8;
-                else
-                  bufferVal = LOW_REPR_SAT8;
-              }
-              else {
-                if(raw == NULLUI4)
-                  bufferVal = NULL8;
-                else if(raw == LOW_INSTR_SATUI4)
-                  bufferVal = LOW_INSTR_SAT8;
-                else if(raw == LOW_REPR_SATUI4)
-                  bufferVal = LOW_REPR_SAT8;
-                else
-                  bufferVal = LOW_REPR_SAT8;
-              }
-
-              ((unsigned int *)buffersRawBuf)[bufferIndex] = raw;
-
-
-
-            }
-
-            else if(m_pixelType == UnsignedByte) {
-              unsigned char raw = ((unsigned char *)chunkBuf)[chunkIndex];
-
-              if(raw == NULL1) {
-                bufferVal = NULL8;
-              }
-              else if(raw == HIGH_REPR_SAT1) {
-                bufferVal = HIGH_REPR_SAT8;
-              }
-              else {
-                bufferVal = (double) raw * m_multiplier + m_base;
-              }
-
-              ((unsigned char *)buffersRawBuf)[bufferIndex] = raw;
-            }
-
-            bufferIndex ++;
-          }
+          const int &chunkIndex = (startX - chunkStartSample) +
+              (chunkLineSize * lineIntoChunk) +
+              (chunkBandSize * bandIntoChunk);
+
+          m_rawToDouble(chunkBuf + chunkIndex * pixelSize,
+                        buffersRawBuf + bufferIndex * pixelSize,
+                        buffersDoubleBuf + bufferIndex,
+                        rowSize, m_multiplier, m_base);
         }
       }
     }
@@ -1551,12 +1537,9 @@ namespace Isis {
    */
   void CubeIoHandler::writeIntoRaw(const Buffer &buffer, RawCubeChunk &output, int index)
       const {
-    // The code in this method is highly optimized. Even the order of the if
-    //   statements will have a significant impact on performance if changed.
-    //   Also, there is a lot of duplicate code in both writeIntoDouble(...) and
-    //   writeIntoRaw(...). This is needed for performance gain. Any function
-    //   or method calls from within the x loop cause significant performance
-    //   decreases.
+    // The pixel conversion is done a whole row at a time by the kernel that
+    //   was chosen for our pixel type and byte order in the constructor. Keep
+    //   function or method calls out of the y loop when possible.
     int startX = 0;
     int startY = 0;
     int startZ = 0;
@@ -1575,6 +1558,8 @@ namespace Isis {
     int outputStartBand = output.getStartBand();
     int lineSize = output.sampleCount();
     int bandSize = lineSize * output.lineCount();
+    int pixelSize = SizeOf(m_pixelType);
+    int rowSize = endX - startX + 1;
     double *buffersDoubleBuf = buffer.DoubleBuffer();
     char *chunkBuf = output.getRawData().data();
 
@@ -1594,231 +1579,12 @@ namespace Isis {
           const int &lineIntoChunk = y - outputStartLine;
           int bufferIndex = buffer.Index(startX, y, virtualBand);
 
-          for(int x = startX; x <= endX; x++) {
-            const int &sampleIntoChunk = x - outputStartSample;
-
-            const int &chunkIndex = sampleIntoChunk +
-                (lineSize * lineIntoChunk) + (bandSize * bandIntoChunk);
-
-            double bufferVal = buffersDoubleBuf[bufferIndex];
-
-            if(m_pixelType == Real) {
-              float raw = 0;
-
-              if(bufferVal >= VALID_MIN8) {
-                double filePixelValueDbl = (bufferVal - m_base) /
-                    m_multiplier;
-
-                if(filePixelValueDbl < (double) VALID_MIN4) {
-                  raw = LOW_REPR_SAT4;
-                }
-                else if(filePixelValueDbl > (double) VALID_MAX4) {
-                  raw = HIGH_REPR_SAT4;
-                }
-                else {
-                  raw = (float) filePixelValueDbl;
-                }
-              }
-              else {
-                if(bufferVal == NULL8)
-                  raw = NULL4;
-                else if(bufferVal == LOW_INSTR_SAT8)
-                  raw = LOW_INSTR_SAT4;
-                else if(bufferVal == LOW_REPR_SAT8)
-                  raw = LOW_REPR_SAT4;
-                else if(bufferVal == HIGH_INSTR_SAT8)
-                  raw = HIGH_INSTR_SAT4;
-                else if(bufferVal == HIGH_REPR_SAT8)
-                  raw = HIGH_REPR_SAT4;
-                else
-                  raw = LOW_REPR_SAT4;
-              }
-              ((float *)chunkBuf)[chunkIndex] =
-                  m_byteSwapper ? m_byteSwapper->Float(&raw) : raw;
-            }
-
-            else if(m_pixelType == SignedWord) {
-              short raw;
-
-              if(bufferVal >= VALID_MIN8) {
-                double filePixelValueDbl = (bufferVal - m_base) /
-                    m_multiplier;
-                if(filePixelValueDbl < VALID_MIN2 - 0.5) {
-                  raw = LOW_REPR_SAT2;
-                }
-                if(filePixelValueDbl > VALID_MAX2 + 0.5) {
-                  raw = HIGH_REPR_SAT2;
-                }
-                else {
-                  int filePixelValue = (int)round(filePixelValueDbl);
-
-                  if(filePixelValue < VALID_MIN2) {
-                    raw = LOW_REPR_SAT2;
-                  }
-                  else if(filePixelValue > VALID_MAX2) {
-                    raw = HIGH_REPR_SAT2;
-                  }
-                  else {
-                    raw = filePixelValue;
-                  }
-                }
-              }
-              else {
-                if(bufferVal == NULL8)
-                  raw = NULL2;
-                else if(bufferVal == LOW_INSTR_SAT8)
-                  raw = LOW_INSTR_SAT2;
-                else if(bufferVal == LOW_REPR_SAT8)
-                  raw = LOW_REPR_SAT2;
-                else if(bufferVal == HIGH_INSTR_SAT8)
-                  raw = HIGH_INSTR_SAT2;
-                else if(bufferVal == HIGH_REPR_SAT8)
-                  raw = HIGH_REPR_SAT2;
-                else
-                  raw = LOW_REPR_SAT2;
-              }
-
-              ((short *)chunkBuf)[chunkIndex] =
-                  m_byteSwapper ? m_byteSwapper->ShortInt(&raw) : raw;
-            }
-
-            else if(m_pixelType == UnsignedInteger) {
-
-              unsigned int raw;
-
-              if(bufferVal >= VALID_MINUI4) {
-                double filePixelValueDbl = (bufferVal - m_base) /
-                    m_multiplier;
-                if(filePixelValueDbl < VALID_MINUI4 - 0.5) {
-                  raw = LOW_REPR_SATUI4;
-                }
-                if(filePixelValueDbl > VALID_MAXUI4) {
-                  raw = HIGH_REPR_SATUI4;
-                }
-                else {
-                  unsigned int filePixelValue = (unsigned int)round(filePixelValueDbl);
-
-                  if(filePixelValue < VALID_MINUI4) {
-                    raw = LOW_REPR_SATUI4;
-                  }
-                  else if(filePixelValue > VALID_MAXUI4) {
-                    raw = HIGH_REPR_SATUI4;
-                  }
-                  else {
-                    raw = filePixelValue;
-                  }
-                }
-              }
-              else {
-                if(bufferVal == NULL8)
-                  raw = NULLUI4;
-                else if(bufferVal == LOW_INSTR_SAT8)
-                  raw = LOW_INSTR_SATUI4;
-                else if(bufferVal == LOW_REPR_SAT8)
-                  raw = LOW_REPR_SATUI4;
-                else if(bufferVal == HIGH_INSTR_SAT8)
-                  raw = HIGH_INSTR_SATUI4;
-                else if(bufferVal == HIGH_REPR_SAT8)
-                  raw = HIGH_REPR_SATUI4;
-                else
-                  raw = LOW_REPR_SATUI4;
-              }
-
-              ((unsigned int *)chunkBuf)[chunkIndex] =
-                  m_byteSwapper ? m_byteSwapper->Uint32_t(&raw) : raw;
-
-            }
-
-
-            else if(m_pixelType == UnsignedWord) {
-              unsigned short raw;
-
-              if(bufferVal >= VALID_MIN8) {
-                double filePixelValueDbl = (bufferVal - m_base) /
-                    m_multiplier;
-                if(filePixelValueDbl < VALID_MINU2 - 0.5) {
-                  raw = LOW_REPR_SATU2;
-                }
-                if(filePixelValueDbl > VALID_MAXU2 + 0.5) {
-                  raw = HIGH_REPR_SATU2;
-                }
-                else {
-                  int filePixelValue = (int)round(filePixelValueDbl);
-
-                  if(filePixelValue < VALID_MINU2) {
-                    raw = LOW_REPR_SATU2;
-                  }
-                  else if(filePixelValue > VALID_MAXU2) {
-                    raw = HIGH_REPR_SATU2;
-                  }
-                  else {
-                    raw = filePixelValue;
-                  }
-                }
-              }
-              else {
-                if(bufferVal == NULL8)
-                  raw = NULLU2;
-                else if(bufferVal == LOW_INSTR_SAT8)
-                  raw = LOW_INSTR_SATU2;
-                else if(bufferVal == LOW_REPR_SAT8)
-                  raw = LOW_REPR_SATU2;
-                else if(bufferVal == HIGH_INSTR_SAT8)
-                  raw = HIGH_INSTR_SATU2;
-                else if(bufferVal == HIGH_REPR_SAT8)
-                  raw = HIGH_REPR_SATU2;
-                else
-                  raw = LOW_REPR_SATU2;
-              }
-
-              ((unsigned short *)chunkBuf)[chunkIndex] =
-                  m_byteSwapper ? m_byteSwapper->UnsignedShortInt(&raw) : raw;
-            }
-            else if(m_pixelType == UnsignedByte) {
-              unsigned char raw;
-
-              if(bufferVal >= VALID_MIN8) {
-                double filePixelValueDbl = (bufferVal - m_base) /
-                    m_multiplier;
-                if(filePixelValueDbl < VALID_MIN1 - 0.5) {
-                  raw = LOW_REPR_SAT1;
-                }
-                else if(filePixelValueDbl > VALID_MAX1 + 0.5) {
-                  raw = HIGH_REPR_SAT1;
-                }
-                else {
-                  int filePixelValue = (int)(filePixelValueDbl + 0.5);
-                  if(filePixelValue < VALID_MIN1) {
-                    raw = LOW_REPR_SAT1;
-                  }
-                  else if(filePixelValue > VALID_MAX1) {
-                    raw = HIGH_REPR_SAT1;
-                  }
-                  else {
-                    raw = (unsigned char)(filePixelValue);
-                  }
-                }
-              }
-              else {
-                if(bufferVal == NULL8)
-                  raw = NULL1;
-                else if(bufferVal == LOW_INSTR_SAT8)
-                  raw = LOW_INSTR_SAT1;
-                else if(bufferVal == LOW_REPR_SAT8)
-                  raw = LOW_REPR_SAT1;
-                else if(bufferVal == HIGH_INSTR_SAT8)
-                  raw = HIGH_INSTR_SAT1;
-                else if(bufferVal == HIGH_REPR_SAT8)
-                  raw = HIGH_REPR_SAT1;
-                else
-                  raw = LOW_REPR_SAT1;
-              }
-
-              ((unsigned char *)chunkBuf)[chunkIndex] = raw;
-            }
-
-            bufferIndex ++;
-          }
+          const int &chunkIndex = (startX - outputStartSample) +
+              (lineSize * lineIntoChunk) + (bandSize * bandIntoChunk);
+
+          m_doubleToRaw(buffersDoubleBuf + bufferIndex,
+                        chunkBuf + chunkIndex * pixelSize,
+                        rowSize, m_multiplier, m_base);
         }
       }
     }
@@ -13,6 +13,7 @@ find files of those names at the top level of this repository. **/
 
 #include "Constants.h"
 #include "Endian.h"
+#include "PixelConversion.h"
 #include "PixelType.h"
 
 class QFile;
@@ -128,6 +129,8 @@ namespace Isis {
 
       QMutex *dataFileMutex();
 
+      bool isMemoryMapped() const;
+
     protected:
       int bandCount() const;
       int getBandCountInChunk() const;
@@ -146,6 +149,8 @@ namespace Isis {
 
       void setChunkSizes(int numSamples, int numLines, int numBands);
 
+      bool readMappedRaw(RawCubeChunk &chunkToFill, BigInt startByte);
+
       /**
        * This needs to populate the chunkToFill with unswapped raw bytes from
        *   the disk.
@@ -229,6 +234,8 @@ namespace Isis {
        */
       CubeIoHandler &operator=(const CubeIoHandler &other);
 
+      void adviseMappedAccess() const;
+
       void blockUntilThreadPoolEmpty() const;
 
       static bool bufferLessThan(Buffer * const &lhs, Buffer * const &rhs);
@@ -292,6 +299,12 @@ namespace Isis {
       //! A helper that swaps byte order to and from file order.
       EndianSwapper * m_byteSwapper;
 
+      //! Converts raw chunk data to buffer doubles for our pixel type and byte order.
+      PixelConversion::RawToDoubleKernel m_rawToDouble;
+
+      //! Converts buffer doubles to raw chunk data for our pixel type and byte order.
+      PixelConversion::DoubleToRawKernel m_doubleToRaw;
+
       //! The number of samples in the cube.
       int m_numSamples;
 
@@ -360,6 +373,18 @@ namespace Isis {
 
       //! How many times the write cache has overflown in a row
       mutable int m_consecutiveOverflowCount;
+
+      /**
+       * This is true if the Isis preference for the cube read mode is
+       *   MemoryMapped and the data file was opened read only.
+       */
+      bool m_useMemoryMap;
+
+      //! The memory mapped data file, NULL until the first mapped read.
+      uchar *m_mappedData;
+
+      //! The number of bytes of the data file that are mapped.
+      BigInt m_mappedSize;
   };
 }
 
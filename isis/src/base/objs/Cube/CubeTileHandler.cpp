@@ -77,6 +77,10 @@ namespace Isis {
   void CubeTileHandler::readRaw(RawCubeChunk &chunkToFill) {
     BigInt startByte = getTileStartByte(chunkToFill);
 
+    if(readMappedRaw(chunkToFill, startByte)) {
+      return;
+    }
+
     bool success = false;
 
     QFile * dataFile = getDataFile();
@@ -0,0 +1,401 @@
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include "PixelConversion.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ISIS_PIXEL_CONVERSION_X86 1
+#include <immintrin.h>
+#endif
+
+namespace Isis {
+  namespace PixelConversion {
+    //! Used for pixel types that the cube IO does not support; leaves the output alone.
+    static void rawToDoubleUnsupported(const char *raw, char *rawCopy, double *output,
+                                       int count, double multiplier, double base) {
+    }
+
+
+    //! Used for pixel types that the cube IO does not support; leaves the output alone.
+    static void doubleToRawUnsupported(const double *input, char *raw, int count,
+                                       double multiplier, double base) {
+    }
+
+#if ISIS_PIXEL_CONVERSION_X86
+    // The vector kernels below only convert blocks where every pixel is valid
+    //   and within range. Any block containing a special pixel (or NaN) is
+    //   handed to the scalar template instead, so the results are always
+    //   identical to the scalar conversion. Multiplies and adds are never fused.
+
+    /**
+     * Swap the byte order of each 32-bit value using SSE2.
+     */
+    static inline __m128i swap32Sse2(__m128i value) {
+      value = _mm_or_si128(_mm_slli_epi16(value, 8), _mm_srli_epi16(value, 8));
+      value = _mm_shufflelo_epi16(value, _MM_SHUFFLE(2, 3, 0, 1));
+      return _mm_shufflehi_epi16(value, _MM_SHUFFLE(2, 3, 0, 1));
+    }
+
+
+    /**
+     * Swap the byte order of each 16-bit value using SSE2.
+     */
+    static inline __m128i swap16Sse2(__m128i value) {
+      return _mm_or_si128(_mm_slli_epi16(value, 8), _mm_srli_epi16(value, 8));
+    }
+
+
+    //! SSE2 Real to double conversion.
+    template <bool SwapBytes>
+    static void realToDoubleSse2(const char *raw, char *rawCopy, double *output,
+                                 int count, double multiplier, double base) {
+      const __m128 validMin = _mm_set1_ps(VALID_MIN4);
+      int i = 0;
+
+      for (; i + 4 <= count; i += 4) {
+        __m128 values = _mm_loadu_ps((const float *)(raw + i * sizeof(float)));
+
+        if (SwapBytes) {
+          values = _mm_castsi128_ps(swap32Sse2(_mm_castps_si128(values)));
+        }
+
+        if (_mm_movemask_ps(_mm_cmpge_ps(values, validMin)) == 0xF) {
+          _mm_storeu_pd(output + i, _mm_cvtps_pd(values));
+          _mm_storeu_pd(output + i + 2, _mm_cvtps_pd(_mm_movehl_ps(values, values)));
+          _mm_storeu_ps((float *)(rawCopy + i * sizeof(float)), values);
+        }
+        else {
+          rawToDouble<float, SwapBytes>(raw + i * sizeof(float), rawCopy + i * sizeof(float),
+                                        output + i, 4, multiplier, base);
+        }
+      }
+
+      rawToDouble<float, SwapBytes>(raw + i * sizeof(float), rawCopy + i * sizeof(float),
+                                    output + i, count - i, multiplier, base);
+    }
+
+
+    //! SSE2 SignedWord to double conversion.
+    template <bool SwapBytes>
+    static void signedWordToDoubleSse2(const char *raw, char *rawCopy, double *output,
+                                       int count, double multiplier, double base) {
+      const __m128i validMin = _mm_set1_epi16(VALID_MIN2);
+      const __m128d mult = _mm_set1_pd(multiplier);
+      const __m128d add = _mm_set1_pd(base);
+      int i = 0;
+
+      for (; i + 8 <= count; i += 8) {
+        __m128i values = _mm_loadu_si128((const __m128i *)(raw + i * sizeof(short)));
+
+        if (SwapBytes) {
+          values = swap16Sse2(values);
+        }
+
+        if (_mm_movemask_epi8(_mm_cmplt_epi16(values, validMin)) == 0) {
+          // Sign extend to 32 bits
+          __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(values, values), 16);
+          __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(values, values), 16);
+
+          __m128d d0 = _mm_cvtepi32_pd(low);
+          __m128d d1 = _mm_cvtepi32_pd(_mm_shuffle_epi32(low, _MM_SHUFFLE(1, 0, 3, 2)));
+          __m128d d2 = _mm_cvtepi32_pd(high);
+          __m128d d3 = _mm_cvtepi32_pd(_mm_shuffle_epi32(high, _MM_SHUFFLE(1, 0, 3, 2)));
+
+          _mm_storeu_pd(output + i, _mm_add_pd(_mm_mul_pd(d0, mult), add));
+          _mm_storeu_pd(output + i + 2, _mm_add_pd(_mm_mul_pd(d1, mult), add));
+          _mm_storeu_pd(output + i + 4, _mm_add_pd(_mm_mul_pd(d2, mult), add));
+          _mm_storeu_pd(output + i + 6, _mm_add_pd(_mm_mul_pd(d3, mult), add));
+          _mm_storeu_si128((__m128i *)(rawCopy + i * sizeof(short)), values);
+        }
+        else {
+          rawToDouble<short, SwapBytes>(raw + i * sizeof(short), rawCopy + i * sizeof(short),
+                                        output + i, 8, multiplier, base);
+        }
+      }
+
+      rawToDouble<short, SwapBytes>(raw + i * sizeof(short), rawCopy + i * sizeof(short),
+                                    output + i, count - i, multiplier, base);
+    }
+
+
+    //! SSE2 double to Real conversion.
+    template <bool SwapBytes>
+    static void doubleToRealSse2(const double *input, char *raw, int count,
+                                 double multiplier, double base) {
+      const __m128d validMin8 = _mm_set1_pd(VALID_MIN8);
+      const __m128d validMin4 = _mm_set1_pd((double) VALID_MIN4);
+      const __m128d validMax4 = _mm_set1_pd((double) VALID_MAX4);
+      const __m128d mult = _mm_set1_pd(multiplier);
+      const __m128d sub = _mm_set1_pd(base);
+      int i = 0;
+
+      for (; i + 4 <= count; i += 4) {
+        __m128d v0 = _mm_loadu_pd(input + i);
+        __m128d v1 = _mm_loadu_pd(input + i + 2);
+        __m128d f0 = _mm_div_pd(_mm_sub_pd(v0, sub), mult);
+        __m128d f1 = _mm_div_pd(_mm_sub_pd(v1, sub), mult);
+
+        __m128d ok0 = _mm_and_pd(_mm_cmpge_pd(v0, validMin8),
+                                 _mm_and_pd(_mm_cmpge_pd(f0, validMin4), _mm_cmple_pd(f0, validMax4)));
+        __m128d ok1 = _mm_and_pd(_mm_cmpge_pd(v1, validMin8),
+                                 _mm_and_pd(_mm_cmpge_pd(f1, validMin4), _mm_cmple_pd(f1, validMax4)));
+
+        if ((_mm_movemask_pd(ok0) & _mm_movemask_pd(ok1)) == 0x3) {
+          __m128 values = _mm_movelh_ps(_mm_cvtpd_ps(f0), _mm_cvtpd_ps(f1));
+
+          if (SwapBytes) {
+            values = _mm_castsi128_ps(swap32Sse2(_mm_castps_si128(values)));
+          }
+
+          _mm_storeu_ps((float *)(raw + i * sizeof(float)), values);
+        }
+        else {
+          doubleToRaw<float, SwapBytes>(input + i, raw + i * sizeof(float), 4,
+                                        multiplier, base);
+        }
+      }
+
+      doubleToRaw<float, SwapBytes>(input + i, raw + i * sizeof(float), count - i,
+                                    multiplier, base);
+    }
+
+
+    /**
+     * The byte shuffle that reverses each 32-bit value in an AVX2 register.
+     */
+    __attribute__((target("avx2")))
+    static inline __m256i swap32Mask() {
+      return _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                              3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    }
+
+
+    /**
+     * The byte shuffle that reverses each 16-bit value in an AVX2 register.
+     */
+    __attribute__((target("avx2")))
+    static inline __m256i swap16Mask() {
+      return _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                              1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    }
+
+
+    //! AVX2 Real to double conversion.
+    template <bool SwapBytes>
+    __attribute__((target("avx2")))
+    static void realToDoubleAvx2(const char *raw, char *rawCopy, double *output,
+                                 int count, double multiplier, double base) {
+      const __m256 validMin = _mm256_set1_ps(VALID_MIN4);
+      const __m256i swapMask = swap32Mask();
+      int i = 0;
+
+      for (; i + 8 <= count; i += 8) {
+        __m256 values = _mm256_loadu_ps((const float *)(raw + i * sizeof(float)));
+
+        if (SwapBytes) {
+          values = _mm256_castsi256_ps(
+              _mm256_shuffle_epi8(_mm256_castps_si256(values), swapMask));
+        }
+
+        if (_mm256_movemask_ps(_mm256_cmp_ps(values, validMin, _CMP_GE_OQ)) == 0xFF) {
+          _mm256_storeu_pd(output + i, _mm256_cvtps_pd(_mm256_castps256_ps128(values)));
+          _mm256_storeu_pd(output + i + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(values, 1)));
+          _mm256_storeu_ps((float *)(rawCopy + i * sizeof(float)), values);
+        }
+        else {
+          rawToDouble<float, SwapBytes>(raw + i * sizeof(float), rawCopy + i * sizeof(float),
+                                        output + i, 8, multiplier, base);
+        }
+      }
+
+      rawToDouble<float, SwapBytes>(raw + i * sizeof(float), rawCopy + i * sizeof(float),
+                                    output + i, count - i, multiplier, base);
+    }
+
+
+    //! AVX2 SignedWord to double conversion.
+    template <bool SwapBytes>
+    __attribute__((target("avx2")))
+    static void signedWordToDoubleAvx2(const char *raw, char *rawCopy, double *output,
+                                       int count, double multiplier, double base) {
+      const __m256i validMin = _mm256_set1_epi16(VALID_MIN2);
+      const __m256i swapMask = swap16Mask();
+      const __m256d mult = _mm256_set1_pd(multiplier);
+      const __m256d add = _mm256_set1_pd(base);
+      int i = 0;
+
+      for (; i + 16 <= count; i += 16) {
+        __m256i values = _mm256_loadu_si256((const __m256i *)(raw + i * sizeof(short)));
+
+        if (SwapBytes) {
+          values = _mm256_shuffle_epi8(values, swapMask);
+        }
+
+        if (_mm256_movemask_epi8(_mm256_cmpgt_epi16(validMin, values)) == 0) {
+          __m256i low = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(values));
+          __m256i high = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(values, 1));
+
+          __m256d d0 = _mm256_cvtepi32_pd(_mm256_castsi256_si128(low));
+          __m256d d1 = _mm256_cvtepi32_pd(_mm256_extracti128_si256(low, 1));
+          __m256d d2 = _mm256_cvtepi32_pd(_mm256_castsi256_si128(high));
+          __m256d d3 = _mm256_cvtepi32_pd(_mm256_extracti128_si256(high, 1));
+
+          _mm256_storeu_pd(output + i, _mm256_add_pd(_mm256_mul_pd(d0, mult), add));
+          _mm256_storeu_pd(output + i + 4, _mm256_add_pd(_mm256_mul_pd(d1, mult), add));
+          _mm256_storeu_pd(output + i + 8, _mm256_add_pd(_mm256_mul_pd(d2, mult), add));
+          _mm256_storeu_pd(output + i + 12, _mm256_add_pd(_mm256_mul_pd(d3, mult), add));
+          _mm256_storeu_si256((__m256i *)(rawCopy + i * sizeof(short)), values);
+        }
+        else {
+          rawToDouble<short, SwapBytes>(raw + i * sizeof(short), rawCopy + i * sizeof(short),
+                                        output + i, 16, multiplier, base);
+        }
+      }
+
+      rawToDouble<short, SwapBytes>(raw + i * sizeof(short), rawCopy + i * sizeof(short),
+                                    output + i, count - i, multiplier, base);
+    }
+
+
+    //! AVX2 double to Real conversion.
+    template <bool SwapBytes>
+    __attribute__((target("avx2")))
+    static void doubleToRealAvx2(const double *input, char *raw, int count,
+                                 double multiplier, double base) {
+      const __m256d validMin8 = _mm256_set1_pd(VALID_MIN8);
+      const __m256d validMin4 = _mm256_set1_pd((double) VALID_MIN4);
+      const __m256d validMax4 = _mm256_set1_pd((double) VALID_MAX4);
+      const __m256d mult = _mm256_set1_pd(multiplier);
+      const __m256d sub = _mm256_set1_pd(base);
+      const __m256i swapMask = swap32Mask();
+      int i = 0;
+
+      for (; i + 8 <= count; i += 8) {
+        __m256d v0 = _mm256_loadu_pd(input + i);
+        __m256d v1 = _mm256_loadu_pd(input + i + 4);
+        __m256d f0 = _mm256_div_pd(_mm256_sub_pd(v0, sub), mult);
+        __m256d f1 = _mm256_div_pd(_mm256_sub_pd(v1, sub), mult);
+
+        __m256d ok0 = _mm256_and_pd(_mm256_cmp_pd(v0, validMin8, _CMP_GE_OQ),
+                                    _mm256_and_pd(_mm256_cmp_pd(f0, validMin4, _CMP_GE_OQ),
+                                                  _mm256_cmp_pd(f0, validMax4, _CMP_LE_OQ)));
+        __m256d ok1 = _mm256_and_pd(_mm256_cmp_pd(v1, validMin8, _CMP_GE_OQ),
+                                    _mm256_and_pd(_mm256_cmp_pd(f1, validMin4, _CMP_GE_OQ),
+                                                  _mm256_cmp_pd(f1, validMax4, _CMP_LE_OQ)));
+
+        if ((_mm256_movemask_pd(ok0) & _mm256_movemask_pd(ok1)) == 0xF) {
+          __m256 values = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(f0)),
+                                               _mm256_cvtpd_ps(f1), 1);
+
+          if (SwapBytes) {
+            values = _mm256_castsi256_ps(
+                _mm256_shuffle_epi8(_mm256_castps_si256(values), swapMask));
+          }
+
+          _mm256_storeu_ps((float *)(raw + i * sizeof(float)), values);
+        }
+        else {
+          doubleToRaw<float, SwapBytes>(input + i, raw + i * sizeof(float), 8,
+                                        multiplier, base);
+        }
+      }
+
+      doubleToRaw<float, SwapBytes>(input + i, raw + i * sizeof(float), count - i,
+                                    multiplier, base);
+    }
+
+
+    /**
+     * @return True if the CPU running this code supports AVX2
+     */
+    static bool cpuHasAvx2() {
+      static const bool hasAvx2 = []() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+      }();
+
+      return hasAvx2;
+    }
+#endif
+
+
+    /**
+     * Choose the raw to double kernel for the given pixel type and byte order.
+     *   This should be done once, not per pixel.
+     *
+     * @param pixelType The pixel type of the raw data
+     * @param swapBytes True if the raw data is not in native byte order
+     * @return The conversion function to use
+     */
+    RawToDoubleKernel rawToDoubleKernel(PixelType pixelType, bool swapBytes) {
+      switch (pixelType) {
+        case Real:
+#if ISIS_PIXEL_CONVERSION_X86
+          if (cpuHasAvx2()) {
+            return swapBytes ? realToDoubleAvx2<true> : realToDoubleAvx2<false>;
+          }
+          return swapBytes ? realToDoubleSse2<true> : realToDoubleSse2<false>;
+#else
+          return swapBytes ? rawToDouble<float, true> : rawToDouble<float, false>;
+#endif
+        case SignedWord:
+#if ISIS_PIXEL_CONVERSION_X86
+          if (cpuHasAvx2()) {
+            return swapBytes ? signedWordToDoubleAvx2<true> : signedWordToDoubleAvx2<false>;
+          }
+          return swapBytes ? signedWordToDoubleSse2<true> : signedWordToDoubleSse2<false>;
+#else
+          return swapBytes ? rawToDouble<short, true> : rawToDouble<short, false>;
+#endif
+        case UnsignedWord:
+          return swapBytes ? rawToDouble<unsigned short, true> :
+                             rawToDouble<unsigned short, false>;
+        case UnsignedInteger:
+          return swapBytes ? rawToDouble<unsigned int, true> :
+                             rawToDouble<unsigned int, false>;
+        case UnsignedByte:
+          return rawToDouble<unsigned char, false>;
+        default:
+          return rawToDoubleUnsupported;
+      }
+    }
+
+
+    /**
+     * Choose the double to raw kernel for the given pixel type and byte order.
+     *   This should be done once, not per pixel.
+     *
+     * @param pixelType The pixel type of the raw data
+     * @param swapBytes True if the raw data is not in native byte order
+     * @return The conversion function to use
+     */
+    DoubleToRawKernel doubleToRawKernel(PixelType pixelType, bool swapBytes) {
+      switch (pixelType) {
+        case Real:
+#if ISIS_PIXEL_CONVERSION_X86
+          if (cpuHasAvx2()) {
+            return swapBytes ? doubleToRealAvx2<true> : doubleToRealAvx2<false>;
+          }
+          return swapBytes ? doubleToRealSse2<true> : doubleToRealSse2<false>;
+#else
+          return swapBytes ? doubleToRaw<float, true> : doubleToRaw<float, false>;
+#endif
+        case SignedWord:
+          return swapBytes ? doubleToRaw<short, true> : doubleToRaw<short, false>;
+        case UnsignedWord:
+          return swapBytes ? doubleToRaw<unsigned short, true> :
+                             doubleToRaw<unsigned short, false>;
+        case UnsignedInteger:
+          return swapBytes ? doubleToRaw<unsigned int, true> :
+                             doubleToRaw<unsigned int, false>;
+        case UnsignedByte:
+          return doubleToRaw<unsigned char, false>;
+        default:
+          return doubleToRawUnsupported;
+      }
+    }
+  }
+}
@@ -0,0 +1,521 @@
+#ifndef PixelConversion_h
+#define PixelConversion_h
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#include <cmath>
+#include <cstring>
+
+#include "PixelType.h"
+#include "SpecialPixel.h"
+
+namespace Isis {
+  /**
+   * @ingroup LowLevelCubeIO
+   * @brief Conversion kernels between raw cube data and double buffers
+   *
+   * These convert contiguous runs of pixels between the raw (on disk) pixel
+   *   type and the double precision values in a Buffer, including the special
+   *   pixel mapping, the base/multiplier scaling and the byte swap. A kernel is
+   *   chosen once for a pixel type and byte order, so none of those decisions
+   *   are made per pixel. Real and SignedWord reads and Real writes use SSE2 or
+   *   AVX2 (when the CPU supports it) on x86; every other combination uses the
+   *   scalar templates in this file, which produce identical results.
+   *
+   * These should only be used by CubeIoHandler and its tests.
+   *
+   * @author 2026-10-18 ISIS Development Team
+   *
+   * @internal
+   */
+  namespace PixelConversion {
+    /**
+     * Converts count raw pixels to doubles.
+     *
+     * @param raw The raw file data to read from, in file byte order
+     * @param rawCopy The native byte order raw values are written here
+     * @param output The converted double values are written here
+     * @param count The number of pixels to convert
+     * @param multiplier The multiplicative factor of the data on disk
+     * @param base The additive offset of the data on disk
+     */
+    typedef void (*RawToDoubleKernel)(const char *raw, char *rawCopy, double *output,
+                                      int count, double multiplier, double base);
+
+    /**
+     * Converts count doubles to raw pixels.
+     *
+     * @param input The double values to convert
+     * @param raw The raw data is written here, in file byte order
+     * @param count The number of pixels to convert
+     * @param multiplier The multiplicative factor of the data on disk
+     * @param base The additive offset of the data on disk
+     */
+    typedef void (*DoubleToRawKernel)(const double *input, char *raw, int count,
+                                      double multiplier, double base);
+
+    RawToDoubleKernel rawToDoubleKernel(PixelType pixelType, bool swapBytes);
+    DoubleToRawKernel doubleToRawKernel(PixelType pixelType, bool swapBytes);
+
+    //! Byte swap an unsigned char (does nothing).
+    inline unsigned char swapBytes(unsigned char value) {
+      return value;
+    }
+
+    //! Byte swap a short.
+    inline short swapBytes(short value) {
+      return (short)__builtin_bswap16((unsigned short)value);
+    }
+
+    //! Byte swap an unsigned short.
+    inline unsigned short swapBytes(unsigned short value) {
+      return __builtin_bswap16(value);
+    }
+
+    //! Byte swap an unsigned int.
+    inline unsigned int swapBytes(unsigned int value) {
+      return __builtin_bswap32(value);
+    }
+
+    //! Byte swap a float.
+    inline float swapBytes(float value) {
+      unsigned int bits;
+      memcpy(&bits, &value, sizeof(bits));
+      bits = __builtin_bswap32(bits);
+      memcpy(&value, &bits, sizeof(bits));
+      return value;
+    }
+
+
+    /**
+     * This gives the same result as round() (halfway cases away from zero)
+     *   without a library call. The value must already be known to be within
+     *   the range of a long long.
+     *
+     * @param value The value to round
+     * @return The nearest integer
+     */
+    inline long long roundToInteger(double value) {
+      long long truncated = (long long)value;
+      // This subtraction is exact
+      double remainder = value - (double)truncated;
+
+      if (remainder >= 0.5) {
+        truncated++;
+      }
+      else if (remainder <= -0.5) {
+        truncated--;
+      }
+
+      return truncated;
+    }
+
+
+    /**
+     * Convert a native byte order float to a double. Real data is not scaled.
+     */
+    inline double toDouble(float raw, double multiplier, double base) {
+      if (raw >= VALID_MIN4) {
+        return (double) raw;
+      }
+      else if (raw == NULL4) {
+        return NULL8;
+      }
+      else if (raw == LOW_INSTR_SAT4) {
+        return LOW_INSTR_SAT8;
+      }
+      else if (raw == LOW_REPR_SAT4) {
+        return LOW_REPR_SAT8;
+      }
+      else if (raw == HIGH_INSTR_SAT4) {
+        return HIGH_INSTR_SAT8;
+      }
+      else if (raw == HIGH_REPR_SAT4) {
+        return HIGH_REPR_SAT8;
+      }
+      return LOW_REPR_SAT8;
+    }
+
+
+    /**
+     * Convert a native byte order short to a double.
+     */
+    inline double toDouble(short raw, double multiplier, double base) {
+      if (raw >= VALID_MIN2) {
+        return (double) raw * multiplier + base;
+      }
+      else if (raw == NULL2) {
+        return NULL8;
+      }
+      else if (raw == LOW_INSTR_SAT2) {
+        return LOW_INSTR_SAT8;
+      }
+      else if (raw == LOW_REPR_SAT2) {
+        return LOW_REPR_SAT8;
+      }
+      else if (raw == HIGH_INSTR_SAT2) {
+        return HIGH_INSTR_SAT8;
+      }
+      else if (raw == HIGH_REPR_SAT2) {
+        return HIGH_REPR_SAT8;
+      }
+      return LOW_REPR_SAT8;
+    }
+
+
+    /**
+     * Convert a native byte order unsigned short to a double.
+     *
+     * The high saturation check is kept in the same order as the original
+     *   CubeIoHandler loop, so values above VALID_MAXU2 are read as valid DNs.
+     */
+    inline double toDouble(unsigned short raw, double multiplier, double base) {
+      if (raw >= VALID_MINU2) {
+        return (double) raw * multiplier + base;
+      }
+      else if (raw > VALID_MAXU2) {
+        if (raw == HIGH_INSTR_SATU2) {
+          return HIGH_INSTR_SAT8;
+        }
+        else if (raw == HIGH_REPR_SATU2) {
+          return HIGH_REPR_SAT8;
+        }
+        return LOW_REPR_SAT8;
+      }
+      else if (raw == NULLU2) {
+        return NULL8;
+      }
+      else if (raw == LOW_INSTR_SATU2) {
+        return LOW_INSTR_SAT8;
+      }
+      return LOW_REPR_SAT8;
+    }
+
+
+    /**
+     * Convert a native byte order unsigned int to a double.
+     *
+     * The high saturation check is kept in the same order as the original
+     *   CubeIoHandler loop, so values above VALID_MAXUI4 are read as valid DNs.
+     */
+    inline double toDouble(unsigned int raw, double multiplier, double base) {
+      if (raw >= VALID_MINUI4) {
+        return (double) raw * multiplier + base;
+      }
+      else if (raw > VALID_MAXUI4) {
+        if (raw == HIGH_INSTR_SATUI4) {
+          return HIGH_INSTR_SAT8;
+        }
+        else if (raw == HIGH_REPR_SATUI4) {
+          return HIGH_REPR_SAT8;
+        }
+        return LOW_REPR_SAT8;
+      }
+      else if (raw == NULLUI4) {
+        return NULL8;
+      }
+      else if (raw == LOW_INSTR_SATUI4) {
+        return LOW_INSTR_SAT8;
+      }
+      return LOW_REPR_SAT8;
+    }
+
+
+    /**
+     * Convert an unsigned char to a double.
+     */
+    inline double toDouble(unsigned char raw, double multiplier, double base) {
+      if (raw == NULL1) {
+        return NULL8;
+      }
+      else if (raw == HIGH_REPR_SAT1) {
+        return HIGH_REPR_SAT8;
+      }
+      return (double) raw * multiplier + base;
+    }
+
+
+    /**
+     * Convert a double to a native byte order float.
+     */
+    inline void fromDouble(double value, double multiplier, double base, float &raw) {
+      if (value >= VALID_MIN8) {
+        double filePixelValueDbl = (value - base) / multiplier;
+
+        if (filePixelValueDbl < (double) VALID_MIN4) {
+          raw = LOW_REPR_SAT4;
+        }
+        else if (filePixelValueDbl > (double) VALID_MAX4) {
+          raw = HIGH_REPR_SAT4;
+        }
+        else {
+          raw = (float) filePixelValueDbl;
+        }
+      }
+      else if (value == NULL8) {
+        raw = NULL4;
+      }
+      else if (value == LOW_INSTR_SAT8) {
+        raw = LOW_INSTR_SAT4;
+      }
+      else if (value == LOW_REPR_SAT8) {
+        raw = LOW_REPR_SAT4;
+      }
+      else if (value == HIGH_INSTR_SAT8) {
+        raw = HIGH_INSTR_SAT4;
+      }
+      else if (value == HIGH_REPR_SAT8) {
+        raw = HIGH_REPR_SAT4;
+      }
+      else {
+        raw = LOW_REPR_SAT4;
+      }
+    }
+
+
+    /**
+     * Convert a double to a native byte order short.
+     */
+    inline void fromDouble(double value, double multiplier, double base, short &raw) {
+      if (value >= VALID_MIN8) {
+        double filePixelValueDbl = (value - base) / multiplier;
+
+        if (filePixelValueDbl < VALID_MIN2 - 0.5) {
+          raw = LOW_REPR_SAT2;
+        }
+        else if (filePixelValueDbl > VALID_MAX2 + 0.5) {
+          raw = HIGH_REPR_SAT2;
+        }
+        else {
+          int filePixelValue = (int)roundToInteger(filePixelValueDbl);
+
+          if (filePixelValue < VALID_MIN2) {
+            raw = LOW_REPR_SAT2;
+          }
+          else if (filePixelValue > VALID_MAX2) {
+            raw = HIGH_REPR_SAT2;
+          }
+          else {
+            raw = filePixelValue;
+          }
+        }
+      }
+      else if (value == NULL8) {
+        raw = NULL2;
+      }
+      else if (value == LOW_INSTR_SAT8) {
+        raw = LOW_INSTR_SAT2;
+      }
+      else if (value == LOW_REPR_SAT8) {
+        raw = LOW_REPR_SAT2;
+      }
+      else if (value == HIGH_INSTR_SAT8) {
+        raw = HIGH_INSTR_SAT2;
+      }
+      else if (value == HIGH_REPR_SAT8) {
+        raw = HIGH_REPR_SAT2;
+      }
+      else {
+        raw = LOW_REPR_SAT2;
+      }
+    }
+
+
+    /**
+     * Convert a double to a native byte order unsigned short.
+     */
+    inline void fromDouble(double value, double multiplier, double base, unsigned short &raw) {
+      if (value >= VALID_MIN8) {
+        double filePixelValueDbl = (value - base) / multiplier;
+
+        if (filePixelValueDbl < VALID_MINU2 - 0.5) {
+          raw = LOW_REPR_SATU2;
+        }
+        else if (filePixelValueDbl > VALID_MAXU2 + 0.5) {
+          raw = HIGH_REPR_SATU2;
+        }
+        else {
+          int filePixelValue = (int)roundToInteger(filePixelValueDbl);
+
+          if (filePixelValue < VALID_MINU2) {
+            raw = LOW_REPR_SATU2;
+          }
+          else if (filePixelValue > VALID_MAXU2) {
+            raw = HIGH_REPR_SATU2;
+          }
+          else {
+            raw = filePixelValue;
+          }
+        }
+      }
+      else if (value == NULL8) {
+        raw = NULLU2;
+      }
+      else if (value == LOW_INSTR_SAT8) {
+        raw = LOW_INSTR_SATU2;
+      }
+      else if (value == LOW_REPR_SAT8) {
+        raw = LOW_REPR_SATU2;
+      }
+      else if (value == HIGH_INSTR_SAT8) {
+        raw = HIGH_INSTR_SATU2;
+      }
+      else if (value == HIGH_REPR_SAT8) {
+        raw = HIGH_REPR_SATU2;
+      }
+      else {
+        raw = LOW_REPR_SATU2;
+      }
+    }
+
+
+    /**
+     * Convert a double to a native byte order unsigned int.
+     *
+     * Like the original CubeIoHandler loop, values below VALID_MINUI4 are
+     *   treated as special pixels.
+     */
+    inline void fromDouble(double value, double multiplier, double base, unsigned int &raw) {
+      if (value >= VALID_MINUI4) {
+        double filePixelValueDbl = (value - base) / multiplier;
+
+        if (filePixelValueDbl < VALID_MINUI4 - 0.5) {
+          raw = LOW_REPR_SATUI4;
+        }
+        else if (filePixelValueDbl > VALID_MAXUI4) {
+          raw = HIGH_REPR_SATUI4;
+        }
+        else {
+          unsigned int filePixelValue = (unsigned int)roundToInteger(filePixelValueDbl);
+
+          if (filePixelValue < VALID_MINUI4) {
+            raw = LOW_REPR_SATUI4;
+          }
+          else if (filePixelValue > VALID_MAXUI4) {
+            raw = HIGH_REPR_SATUI4;
+          }
+          else {
+            raw = filePixelValue;
+          }
+        }
+      }
+      else if (value == NULL8) {
+        raw = NULLUI4;
+      }
+      else if (value == LOW_INSTR_SAT8) {
+        raw = LOW_INSTR_SATUI4;
+      }
+      else if (value == LOW_REPR_SAT8) {
+        raw = LOW_REPR_SATUI4;
+      }
+      else if (value == HIGH_INSTR_SAT8) {
+        raw = HIGH_INSTR_SATUI4;
+      }
+      else if (value == HIGH_REPR_SAT8) {
+        raw = HIGH_REPR_SATUI4;
+      }
+      else {
+        raw = LOW_REPR_SATUI4;
+      }
+    }
+
+
+    /**
+     * Convert a double to an unsigned char.
+     */
+    inline void fromDouble(double value, double multiplier, double base, unsigned char &raw) {
+      if (value >= VALID_MIN8) {
+        double filePixelValueDbl = (value - base) / multiplier;
+
+        if (filePixelValueDbl < VALID_MIN1 - 0.5) {
+          raw = LOW_REPR_SAT1;
+        }
+        else if (filePixelValueDbl > VALID_MAX1 + 0.5) {
+          raw = HIGH_REPR_SAT1;
+        }
+        else {
+          int filePixelValue = (int)(filePixelValueDbl + 0.5);
+
+          if (filePixelValue < VALID_MIN1) {
+            raw = LOW_REPR_SAT1;
+          }
+          else if (filePixelValue > VALID_MAX1) {
+            raw = HIGH_REPR_SAT1;
+          }
+          else {
+            raw = (unsigned char)(filePixelValue);
+          }
+        }
+      }
+      else if (value == NULL8) {
+        raw = NULL1;
+      }
+      else if (value == LOW_INSTR_SAT8) {
+        raw = LOW_INSTR_SAT1;
+      }
+      else if (value == LOW_REPR_SAT8) {
+        raw = LOW_REPR_SAT1;
+      }
+      else if (value == HIGH_INSTR_SAT8) {
+        raw = HIGH_INSTR_SAT1;
+      }
+      else if (value == HIGH_REPR_SAT8) {
+        raw = HIGH_REPR_SAT1;
+      }
+      else {
+        raw = LOW_REPR_SAT1;
+      }
+    }
+
+
+    /**
+     * The scalar raw to double kernel for a raw type and byte order. The raw
+     *   data does not need to be aligned.
+     *
+     * @see RawToDoubleKernel
+     */
+    template <typename RawType, bool SwapBytes>
+    void rawToDouble(const char *raw, char *rawCopy, double *output, int count,
+                     double multiplier, double base) {
+      for (int i = 0; i < count; i++) {
+        RawType value;
+        memcpy(&value, raw + i * sizeof(RawType), sizeof(RawType));
+
+        if (SwapBytes) {
+          value = swapBytes(value);
+        }
+
+        output[i] = toDouble(value, multiplier, base);
+        memcpy(rawCopy + i * sizeof(RawType), &value, sizeof(RawType));
+      }
+    }
+
+
+    /**
+     * The scalar double to raw kernel for a raw type and byte order. The raw
+     *   data does not need to be aligned.
+     *
+     * @see DoubleToRawKernel
+     */
+    template <typename RawType, bool SwapBytes>
+    void doubleToRaw(const double *input, char *raw, int count,
+                     double multiplier, double base) {
+      for (int i = 0; i < count; i++) {
+        RawType value;
+        fromDouble(input[i], multiplier, base, value);
+
+        if (SwapBytes) {
+          value = swapBytes(value);
+        }
+
+        memcpy(raw + i * sizeof(RawType), &value, sizeof(RawType));
+      }
+    }
+  }
+}
+
+#endif
@@ -93,7 +93,9 @@ namespace Isis {
 
   /**
    * Sets the chunk's raw data. This size of the new raw data must match that
-   *   of the chunk's current raw data buffer.
+   *   of the chunk's current raw data buffer. The data is shared, not copied,
+   *   until the chunk is modified; this allows rawData to reference a memory
+   *   mapped file.
    *
    * @param rawData the raw data
    */
@@ -106,7 +108,9 @@ namespace Isis {
 
     m_dirty = true;
     *m_rawBuffer = rawData;
-    m_rawBufferInternalPtr = m_rawBuffer->data();
+    // Taking a writable pointer would force a deep copy, so wait until the
+    //   first setData().
+    m_rawBufferInternalPtr = NULL;
   }
 
 
@@ -168,6 +172,8 @@ namespace Isis {
   void RawCubeChunk::setData(unsigned char value, int offset) {
 
     m_dirty = true;
+    if (!m_rawBufferInternalPtr)
+      m_rawBufferInternalPtr = m_rawBuffer->data();
     m_rawBufferInternalPtr[offset] = value;
   }
 
@@ -182,6 +188,8 @@ namespace Isis {
   void RawCubeChunk::setData(short value, int offset) {
 
     m_dirty = true;
+    if (!m_rawBufferInternalPtr)
+      m_rawBufferInternalPtr = m_rawBuffer->data();
     ((short *)m_rawBufferInternalPtr)[offset] = value;
   }
 
@@ -196,6 +204,8 @@ namespace Isis {
   void RawCubeChunk::setData(const float &value, const int &offset) {
 
     m_dirty = true;
+    if (!m_rawBufferInternalPtr)
+      m_rawBufferInternalPtr = m_rawBuffer->data();
     ((float *)m_rawBufferInternalPtr)[offset] = value;
   }
 
@@ -28,6 +28,18 @@ namespace Isis {
   }
 
 
+  /**
+   * The order in which this algorithm expects chunks to be requested. Children
+   *   that know their I/O pattern should override this so that memory mapped
+   *   cubes can give the operating system a good paging hint.
+   *
+   * @return NormalAccess unless overridden
+   */
+  CubeCachingAlgorithm::AccessPattern CubeCachingAlgorithm::accessPattern() const {
+    return NormalAccess;
+  }
+
+
   /**
    * Construct a cache algorithm result with the idea that the algorithm did
    *   not understand/was unable to determine a good result for what to free.
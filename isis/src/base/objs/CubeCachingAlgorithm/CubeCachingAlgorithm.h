@@ -33,6 +33,19 @@ namespace Isis {
       CubeCachingAlgorithm();
       virtual ~CubeCachingAlgorithm();
 
+      /**
+       * The pattern in which an algorithm expects cube chunks to be requested.
+       *   This is used as a paging hint when cube data is memory mapped.
+       */
+      enum AccessPattern {
+        //! No particular order is expected
+        NormalAccess,
+        //! Chunks are expected to be requested front to back
+        SequentialAccess,
+        //! Chunks are expected to be requested in an unpredictable order
+        RandomAccess
+      };
+
       /**
        * @brief This stores the results of the caching algorithm.
        *
@@ -76,6 +89,8 @@ namespace Isis {
       virtual CacheResult recommendChunksToFree(
           QList<RawCubeChunk *> allocated, QList<RawCubeChunk *> justUsed,
           const Buffer &justRequested) = 0;
+
+      virtual AccessPattern accessPattern() const;
   };
 }
 
@@ -25,16 +25,18 @@ find files of those names at the top level of this repository. **/
 
 #include "Cube.h"
 #include "CubeManager.h"
+#include "DemTileCache.h"
 #include "Distance.h"
 #include "EllipsoidShape.h"
 //#include "Geometry3D.h"
 #include "IException.h"
+#include "IString.h"
 #include "Interpolator.h"
 #include "Latitude.h"
 //#include "LinearAlgebra.h"
 #include "Longitude.h"
 #include "NaifStatus.h"
-#include "Portal.h"
+#include "Preference.h"
 #include "Projection.h"
 #include "Pvl.h"
 #include "Spice.h"
@@ -56,7 +58,7 @@ namespace Isis {
     m_demProj = NULL;
     m_demCube = NULL;
     m_interp = NULL;
-    m_portal = NULL;
+    m_pyramidLevels = 0;
   }
 
 
@@ -73,7 +75,7 @@ namespace Isis {
     m_demProj = NULL;
     m_demCube = NULL;
     m_interp = NULL;
-    m_portal = NULL;
+    m_pyramidLevels = 0;
 
     PvlGroup &kernels = pvl.findGroup("Kernels", Pvl::Traverse);
 
@@ -96,9 +98,14 @@ namespace Isis {
     m_demCube->addCachingAlgorithm(new UniqueIOCachingAlgorithm(5));
     m_demProj = m_demCube->projection();
     m_interp = new Interpolator(Interpolator::BiLinearType);
-    m_portal = new Portal(m_interp->Samples(), m_interp->Lines(),
-                            m_demCube->pixelType(),
-                            m_interp->HotSample(), m_interp->HotLine());
+
+    // Radius lookups are served from memory, shared by every shape using this DEM
+    m_demCache = DemTileCache::forCube(m_demCube);
+
+    PvlGroup &performancePrefs = Preference::Preferences().findGroup("Performance");
+    if (performancePrefs.hasKeyword("DemPyramidLevels")) {
+      m_pyramidLevels = std::max(0, toInt(performancePrefs["DemPyramidLevels"][0]));
+    }
 
     // Read in the Scale of the DEM file in pixels/degree
     const PvlGroup &mapgrp = m_demCube->label()->findGroup("Mapping", Pvl::Traverse);
@@ -118,8 +125,8 @@ namespace Isis {
     delete m_interp;
     m_interp = NULL;
 
-    delete m_portal;
-    m_portal = NULL;
+    m_lastDemTile.clear();
+    m_demCache.clear();
   }
 
 
@@ -195,10 +202,22 @@ namespace Isis {
         lonDD += 360;
       }
 
+      // Early iterations may use a coarse level of the DEM to get close to the surface
+      //   cheaply. Later iterations always use full resolution.
+      int level = std::max(0, m_pyramidLevels - (it - 1));
+      Distance radiusKm;
+      if (level > 0 && m_demProj->SetUniversalGround(latDD, lonDD)) {
+        radiusKm = Distance(demValue(m_demProj->WorldX(), m_demProj->WorldY(), level),
+                            Distance::Meters);
+      }
+
       // Previous Sensor version used local version of this method with lat and lon doubles.
       // Steven made the change to improve speed.  He said the difference was negilgible.
-      Distance radiusKm = localRadius(Latitude(latDD, Angle::Degrees),
-                                      Longitude(lonDD, Angle::Degrees));
+      if (level == 0 || Isis::IsSpecial(radiusKm.meters())) {
+        level = 0;
+        radiusKm = localRadius(Latitude(latDD, Angle::Degrees),
+                               Longitude(lonDD, Angle::Degrees));
+      }
 
       if (Isis::IsSpecial(radiusKm.kilometers())) {
         setHasIntersection(false);
@@ -234,8 +253,9 @@ namespace Isis {
       dZ = currentIntersectPt[2] - newIntersectPt[2];
       dist2 = (dX*dX + dY*dY + dZ*dZ) * 1000 * 1000;
 
-      // Now recompute tolerance at updated surface point and recheck
-      if (dist2 < tol2) {
+      // Now recompute tolerance at updated surface point and recheck. Only full
+      //   resolution iterations can converge.
+      if (level == 0 && dist2 < tol2) {
         surfaceIntersection()->FromNaifArray(newIntersectPt);
         tol = resolution() / 100.0;
         tol2 = tol * tol;
@@ -273,17 +293,42 @@ namespace Isis {
       // if (!m_demProj->IsGood())
       //   return Distance();
 
-      m_portal->SetPosition(m_demProj->WorldX(), m_demProj->WorldY(), 1);
+      distance = Distance(demValue(m_demProj->WorldX(), m_demProj->WorldY(), 0),
+                          Distance::Meters);
+    }
 
-      m_demCube->read(*m_portal);
+    return distance;
+  }
 
-      distance = Distance(m_interp->Interpolate(m_demProj->WorldX(),
-                                                m_demProj->WorldY(),
-                                                m_portal->DoubleBuffer()),
-                                                Distance::Meters);
+
+  /**
+   * Interpolates the DEM at a sample/line. Level 0 gives exactly the value a
+   * Portal read of the DEM cube and bilinear interpolation would. Coarser
+   * levels interpolate the averaged DEM at the same location.
+   *
+   * @param sample The sample in the full resolution DEM
+   * @param line The line in the full resolution DEM
+   * @param level The pyramid level to interpolate, 0 for full resolution
+   *
+   * @return @b double The interpolated DEM value
+   */
+  double DemShape::demValue(double sample, double line, int level) {
+    if (level > 0) {
+      // Pixel centers of level n are 2^n level 0 pixels apart
+      double scale = (double)(1 << level);
+      sample = (sample + (scale - 1.0) / 2.0) / scale;
+      line = (line + (scale - 1.0) / 2.0) / scale;
     }
 
-    return distance;
+    // Same neighborhood that Portal::SetPosition selects
+    int startSample = (int)floor(sample - m_interp->HotSample());
+    int startLine = (int)floor(line - m_interp->HotLine());
+
+    double buffer[16];
+    m_demCache->read(level, startSample, startLine,
+                     m_interp->Samples(), m_interp->Lines(), buffer, m_lastDemTile);
+
+    return m_interp->Interpolate(sample, line, buffer);
   }
 
 
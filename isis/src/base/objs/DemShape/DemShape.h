@@ -7,6 +7,9 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 
+#include <QSharedPointer>
+
+#include "DemTileCache.h"
 #include "ShapeModel.h"
 
 template<class T> class QVector;
@@ -14,7 +17,6 @@ template<class T> class QVector;
 namespace Isis {
   class Cube;
   class Interpolator;
-  class Portal;
   class Projection;
 
   /**
@@ -48,6 +50,9 @@ namespace Isis {
    *   @history 2017-06-07 Kristin Berry - Added a using declaration so that the new
    *                            intersectSurface methods in ShapeModel are accessible by DemShape.
    *
+   * Radii are looked up in a DemTileCache shared by every DemShape on the same DEM. If the
+   * DemPyramidLevels performance preference is greater than zero, the first iterations of
+   * intersectSurface() use coarser levels of the DEM before switching to full resolution.
    */
   class DemShape : public ShapeModel {
     public:
@@ -92,11 +97,16 @@ namespace Isis {
      Cube *demCube();         //!< Returns the cube defining the shape model.
 
     private:
+      double demValue(double sample, double line, int level);
+
       Cube *m_demCube;        //!< The cube containing the model
       Projection *m_demProj;  //!< The projection of the model
       double m_pixPerDegree;  //!< Scale of DEM file in pixels per degree
-      Portal *m_portal;       //!< Buffer used to read from the model
       Interpolator *m_interp; //!< Use bilinear interpolation from dem
+
+      QSharedPointer<DemTileCache> m_demCache; //!< In-memory tiles of the model
+      DemTileCache::TilePtr m_lastDemTile;     //!< The tile used by the last lookup
+      int m_pyramidLevels;    //!< Coarse levels to use in early intersection iterations
   };
 }
 
@@ -0,0 +1,328 @@
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include "DemTileCache.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <QMutexLocker>
+#include <QWeakPointer>
+
+#include "Cube.h"
+#include "IString.h"
+#include "Portal.h"
+#include "Preference.h"
+#include "SpecialPixel.h"
+
+using namespace std;
+
+namespace Isis {
+  namespace {
+    //! Guards the caches shared between DemShapes
+    QMutex sharedCachesMutex;
+    //! The cache of every DEM cube in use, shared between DemShapes
+    QHash<Cube *, QWeakPointer<DemTileCache> > sharedCaches;
+  }
+
+
+  /**
+   * Returns the cache for a DEM cube, creating it if no other caller is using
+   * a cache for the cube. The cache is deleted when the last caller releases
+   * it. The cube must stay open for as long as the cache is used.
+   *
+   * @param demCube The DEM cube to cache
+   *
+   * @return @b QSharedPointer<DemTileCache> The cache for the cube
+   */
+  QSharedPointer<DemTileCache> DemTileCache::forCube(Cube *demCube) {
+    QMutexLocker locker(&sharedCachesMutex);
+
+    QSharedPointer<DemTileCache> cache = sharedCaches.value(demCube).toStrongRef();
+    if (!cache) {
+      cache = QSharedPointer<DemTileCache>(new DemTileCache(demCube));
+      sharedCaches.insert(demCube, cache.toWeakRef());
+    }
+
+    return cache;
+  }
+
+
+  /**
+   * Creates an empty cache for a DEM cube. The number of tiles to keep comes
+   * from the DemTileCacheSize performance preference, or DefaultMaximumTiles
+   * if it is not set.
+   *
+   * @param demCube The DEM cube to cache
+   */
+  DemTileCache::DemTileCache(Cube *demCube) {
+    m_demCube = demCube;
+    m_samples = demCube->sampleCount();
+    m_lines = demCube->lineCount();
+    m_useCounter = 0;
+
+    m_maximumTiles = DefaultMaximumTiles;
+    PvlGroup &performancePrefs = Preference::Preferences().findGroup("Performance");
+    if (performancePrefs.hasKeyword("DemTileCacheSize")) {
+      m_maximumTiles = std::max(1, toInt(performancePrefs["DemTileCacheSize"][0]));
+    }
+  }
+
+
+  /**
+   * Frees every cached tile and forgets the cache of the cube.
+   */
+  DemTileCache::~DemTileCache() {
+    QMutexLocker locker(&sharedCachesMutex);
+
+    // Another cache for the cube may have been created after the last
+    //   reference to this one was released, leave that one alone
+    if (sharedCaches.contains(m_demCube) && !sharedCaches.value(m_demCube)) {
+      sharedCaches.remove(m_demCube);
+    }
+    m_demCube = NULL;
+  }
+
+
+  /**
+   * Returns the number of samples in a level of the DEM.
+   *
+   * @param level The pyramid level, 0 for the DEM itself
+   *
+   * @return @b int The number of samples in the level
+   */
+  int DemTileCache::sampleCount(int level) const {
+    return (m_samples + (1 << level) - 1) >> level;
+  }
+
+
+  /**
+   * Returns the number of lines in a level of the DEM.
+   *
+   * @param level The pyramid level, 0 for the DEM itself
+   *
+   * @return @b int The number of lines in the level
+   */
+  int DemTileCache::lineCount(int level) const {
+    return (m_lines + (1 << level) - 1) >> level;
+  }
+
+
+  /**
+   * Returns the number of tiles the cache keeps before it evicts the least
+   * recently used ones.
+   *
+   * @return @b int The maximum number of cached tiles
+   */
+  int DemTileCache::maximumTiles() const {
+    return m_maximumTiles;
+  }
+
+
+  /**
+   * Reads a block of pixels from a level of the DEM, the same way a Portal
+   * read from the DEM cube would. Pixels outside of the DEM are Null.
+   *
+   * @param level The pyramid level, 0 for the DEM itself
+   * @param startSample The first sample of the block
+   * @param startLine The first line of the block
+   * @param samples The number of samples in the block
+   * @param lines The number of lines in the block
+   * @param buffer Set to the samples * lines values of the block, line by line
+   * @param lastTile The tile the caller used last. Lookups in this tile do
+   *                 not lock the cache. Updated to the last tile used.
+   */
+  void DemTileCache::read(int level, int startSample, int startLine,
+                          int samples, int lines, double *buffer,
+                          TilePtr &lastTile) {
+    for (int line = 0; line < lines; line++) {
+      for (int samp = 0; samp < samples; samp++) {
+        *buffer++ = value(level, startSample + samp, startLine + line, lastTile);
+      }
+    }
+  }
+
+
+  /**
+   * Returns one pixel of a level of the DEM.
+   *
+   * @param level The pyramid level
+   * @param sample The sample of the pixel in the level
+   * @param line The line of the pixel in the level
+   * @param lastTile The tile the caller used last, updated to the tile used
+   *
+   * @return @b double The pixel value, or Null outside of the DEM
+   */
+  double DemTileCache::value(int level, int sample, int line, TilePtr &lastTile) {
+    if (sample < 1 || line < 1 ||
+        sample > sampleCount(level) || line > lineCount(level)) {
+      return Null;
+    }
+
+    if (!lastTile || lastTile->level != level ||
+        sample < lastTile->startSample ||
+        sample >= lastTile->startSample + TileSize ||
+        line < lastTile->startLine ||
+        line >= lastTile->startLine + TileSize) {
+      lastTile = tile(level, (sample - 1) / TileSize, (line - 1) / TileSize);
+    }
+
+    return lastTile->values[(line - lastTile->startLine) * TileSize +
+                            (sample - lastTile->startSample)];
+  }
+
+
+  /**
+   * Returns a tile, loading it if it is not in the cache.
+   *
+   * @param level The pyramid level of the tile
+   * @param tileSample The zero based tile index in the sample direction
+   * @param tileLine The zero based tile index in the line direction
+   *
+   * @return @b TilePtr The tile
+   */
+  DemTileCache::TilePtr DemTileCache::tile(int level, int tileSample, int tileLine) {
+    QMutexLocker locker(&m_mutex);
+    TilePtr result = findOrLoadTile(level, tileSample, tileLine);
+    evictTiles();
+    return result;
+  }
+
+
+  /**
+   * Returns a tile, loading it if it is not in the cache. The cache must be
+   * locked by the caller.
+   *
+   * @param level The pyramid level of the tile
+   * @param tileSample The zero based tile index in the sample direction
+   * @param tileLine The zero based tile index in the line direction
+   *
+   * @return @b TilePtr The tile
+   */
+  DemTileCache::TilePtr DemTileCache::findOrLoadTile(int level, int tileSample,
+                                                     int tileLine) {
+    quint64 key = tileKey(level, tileSample, tileLine);
+    TilePtr result = m_tiles.value(key);
+    if (!result) {
+      result = loadTile(level, tileSample, tileLine);
+      m_tiles.insert(key, result);
+    }
+
+    result->lastUse = m_useCounter++;
+    return result;
+  }
+
+
+  /**
+   * Creates a tile. Level 0 tiles are read from the DEM cube. Tiles of coarser
+   * levels are averaged from the four tiles of the next finer level that they
+   * cover. The cache must be locked by the caller.
+   *
+   * @param level The pyramid level of the tile
+   * @param tileSample The zero based tile index in the sample direction
+   * @param tileLine The zero based tile index in the line direction
+   *
+   * @return @b TilePtr The new tile
+   */
+  DemTileCache::TilePtr DemTileCache::loadTile(int level, int tileSample,
+                                               int tileLine) {
+    Tile *newTile = new Tile;
+    newTile->level = level;
+    newTile->startSample = tileSample * TileSize + 1;
+    newTile->startLine = tileLine * TileSize + 1;
+    newTile->values.resize(TileSize * TileSize);
+
+    if (level == 0) {
+      Portal portal(TileSize, TileSize, m_demCube->pixelType(), 0.0, 0.0);
+      portal.SetPosition(newTile->startSample, newTile->startLine, 1);
+      m_demCube->read(portal);
+      std::copy(portal.DoubleBuffer(), portal.DoubleBuffer() + portal.size(),
+                newTile->values.begin());
+      return TilePtr(newTile);
+    }
+
+    // The tile covers a 2x2 block of tiles in the next finer level
+    TilePtr finerTiles[2][2];
+    for (int i = 0; i < 2; i++) {
+      for (int j = 0; j < 2; j++) {
+        finerTiles[i][j] = findOrLoadTile(level - 1, 2 * tileSample + j,
+                                          2 * tileLine + i);
+      }
+    }
+
+    for (int line = 0; line < TileSize; line++) {
+      for (int samp = 0; samp < TileSize; samp++) {
+        // Position of the 2x2 block in the finer tiles
+        int finerLine = 2 * line;
+        int finerSamp = 2 * samp;
+        const Tile &finer = *finerTiles[finerLine / TileSize][finerSamp / TileSize];
+        finerLine %= TileSize;
+        finerSamp %= TileSize;
+
+        double sum = 0.0;
+        int validCount = 0;
+        for (int i = 0; i < 2; i++) {
+          for (int j = 0; j < 2; j++) {
+            double finerValue = finer.values[(finerLine + i) * TileSize + finerSamp + j];
+            if (!IsSpecial(finerValue)) {
+              sum += finerValue;
+              validCount++;
+            }
+          }
+        }
+
+        newTile->values[line * TileSize + samp] = (validCount > 0) ? sum / validCount : Null;
+      }
+    }
+
+    return TilePtr(newTile);
+  }
+
+
+  /**
+   * Removes the least recently used quarter of the tiles once the cache holds
+   * more than maximumTiles() tiles. The cache must be locked by the caller.
+   */
+  void DemTileCache::evictTiles() {
+    if (m_tiles.size() <= m_maximumTiles) {
+      return;
+    }
+
+    vector<quint64> lastUses;
+    lastUses.reserve(m_tiles.size());
+    foreach (const TilePtr &cachedTile, m_tiles) {
+      lastUses.push_back(cachedTile->lastUse);
+    }
+
+    vector<quint64>::iterator cutoff = lastUses.begin() + lastUses.size() / 4;
+    std::nth_element(lastUses.begin(), cutoff, lastUses.end());
+    quint64 oldestKept = *cutoff;
+
+    QHash<quint64, TilePtr>::iterator it = m_tiles.begin();
+    while (it != m_tiles.end()) {
+      if (it.value()->lastUse < oldestKept) {
+        it = m_tiles.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+  }
+
+
+  /**
+   * Returns the hash key of a tile.
+   *
+   * @param level The pyramid level of the tile
+   * @param tileSample The zero based tile index in the sample direction
+   * @param tileLine The zero based tile index in the line direction
+   *
+   * @return @b quint64 The key of the tile in the cache
+   */
+  quint64 DemTileCache::tileKey(int level, int tileSample, int tileLine) {
+    return ((quint64)level << 56) | ((quint64)tileLine << 28) | (quint64)tileSample;
+  }
+}
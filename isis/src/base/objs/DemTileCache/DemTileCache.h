@@ -0,0 +1,94 @@
+#ifndef DemTileCache_h
+#define DemTileCache_h
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QVector>
+
+namespace Isis {
+  class Cube;
+
+  /**
+   * @brief In-memory tile cache for the first band of a DEM cube
+   *
+   * DemShape reads a small neighborhood of the DEM for every radius lookup, and
+   * an intersection takes many lookups close to each other. This class keeps
+   * square tiles of the DEM in memory, already converted to double, so those
+   * lookups do not go through cube I/O and pixel conversion every time.
+   *
+   * The cache can also build coarser levels of the DEM. Each pixel in level n
+   * is the average of the valid pixels in the 2x2 block of level n-1 it
+   * covers, and it is Null if none of them are valid. Level 0 is the DEM
+   * itself.
+   *
+   * One cache is shared by every DemShape that uses the same DEM cube, and it
+   * may be used from multiple threads. Tiles are reference counted, so a
+   * tile stays valid while a caller holds it even if the cache evicts it.
+   *
+   * The number of tiles kept in memory is set by the DemTileCacheSize
+   * performance preference.
+   *
+   * @ingroup Camera
+   */
+  class DemTileCache {
+    public:
+      /**
+       * One tile of one level of the DEM.
+       */
+      class Tile {
+        public:
+          int level;              //!< The pyramid level of the tile
+          int startSample;        //!< First sample of the tile in its level
+          int startLine;          //!< First line of the tile in its level
+          QVector<double> values; //!< The tile's pixels, line by line
+          //! When the tile was last used, for least recently used eviction.
+          //!   Only changed while the cache is locked.
+          mutable quint64 lastUse;
+      };
+
+      //! A reference counted pointer to a tile
+      typedef QSharedPointer<const Tile> TilePtr;
+
+      static QSharedPointer<DemTileCache> forCube(Cube *demCube);
+
+      ~DemTileCache();
+
+      int sampleCount(int level) const;
+      int lineCount(int level) const;
+      int maximumTiles() const;
+
+      void read(int level, int startSample, int startLine,
+                int samples, int lines, double *buffer, TilePtr &lastTile);
+
+      static const int TileSize = 128;             //!< Samples and lines in a tile
+      static const int DefaultMaximumTiles = 2048; //!< Tiles kept without a preference
+
+    private:
+      DemTileCache(Cube *demCube);
+      Q_DISABLE_COPY(DemTileCache)
+
+      double value(int level, int sample, int line, TilePtr &lastTile);
+      TilePtr tile(int level, int tileSample, int tileLine);
+      TilePtr findOrLoadTile(int level, int tileSample, int tileLine);
+      TilePtr loadTile(int level, int tileSample, int tileLine);
+      void evictTiles();
+
+      static quint64 tileKey(int level, int tileSample, int tileLine);
+
+      Cube *m_demCube;                 //!< The DEM being cached
+      int m_samples;                   //!< Samples in level 0 of the DEM
+      int m_lines;                     //!< Lines in level 0 of the DEM
+      QHash<quint64, TilePtr> m_tiles; //!< Loaded tiles of every level
+      int m_maximumTiles;              //!< Tiles kept before evicting
+      QMutex m_mutex;                  //!< Guards m_tiles and loading
+      quint64 m_useCounter;            //!< Source of Tile::lastUse values
+  };
+}
+
+#endif
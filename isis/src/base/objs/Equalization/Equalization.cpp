@@ -6,12 +6,20 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "Equalization.h"
 
+#include <algorithm>
+#include <functional>
 #include <iomanip>
+#include <numeric>
 #include <vector>
 
+#include <QFuture>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QString>
 #include <QStringList>
+#include <QThread>
 #include <QVector>
+#include <QtConcurrentMap>
 
 #include "Buffer.h"
 #include "Cube.h"
@@ -23,6 +31,7 @@ find files of those names at the top level of this repository. **/
 #include "OverlapStatistics.h"
 #include "Process.h"
 #include "ProcessByLine.h"
+#include "Progress.h"
 #include "Projection.h"
 #include "Pvl.h"
 #include "PvlGroup.h"
@@ -32,6 +41,38 @@ find files of those names at the top level of this repository. **/
 using namespace std;
 
 namespace Isis {
+  namespace {
+    //! The projection x/y extent of an image
+    struct ImageExtent {
+      double minX; //!< Projection x of the left edge
+      double maxX; //!< Projection x of the right edge
+      double minY; //!< Projection y of the bottom edge
+      double maxY; //!< Projection y of the top edge
+
+      /**
+       * Checks for the same overlap OverlapStatistics looks for
+       *
+       * @param other The extent of the other image
+       *
+       * @return bool Whether the extents intersect
+       */
+      bool intersects(const ImageExtent &other) const {
+        return minX < other.maxX && maxX > other.minX &&
+               minY < other.maxY && maxY > other.minY;
+      }
+    };
+
+    //! A pair of images that may overlap and their statistics, gathered on the global thread pool
+    struct ImagePair {
+      int first = 0;                    //!< Index of the first image
+      int second = 0;                   //!< Index of the second image
+      OverlapStatistics *stats = NULL;  //!< The statistics, NULL if gathering them failed
+      IException error;                 //!< Why gathering the statistics failed
+    };
+
+    //! Serializes opening cubes and creating their projections, which is not thread safe
+    QMutex cubeOpenMutex;
+  }
 
 
   /**
@@ -247,7 +288,9 @@ namespace Isis {
    * @brief Calculates the overlap statistics for each pair of input images
    *
    * This method calculates any overlap statistics that have not been previously
-   * calculated for the input images.
+   * calculated for the input images. Only pairs of images whose projected
+   * extents intersect are read, and the overlaps of all of those pairs are
+   * gathered on the global thread pool.
    */
   void Equalization::calculateOverlapStatistics() {
     // Add adjustments for all input images
@@ -255,53 +298,140 @@ namespace Isis {
       addAdjustment(new ImageAdjustment(m_sType));
     }
 
-    // Find overlapping areas and add them to the set of known overlaps for
-    // each band shared amongst cubes
+    // Find the projected extent of every image. Images whose extents do not
+    // intersect can not overlap, so only the pairs found by sweeping the
+    // extents from left to right have to be opened and read.
+    QVector<ImageExtent> extents(m_imageList.size());
     for (int i = 0; i < m_imageList.size(); i++) {
-      Cube cube1;
-      cube1.open(m_imageList[i].toString());
+      Cube cube;
+      cube.open(m_imageList[i].toString());
+      Projection *proj = cube.projection();
+
+      extents[i].minX = proj->ToProjectionX(0.5);
+      extents[i].maxY = proj->ToProjectionY(0.5);
+      extents[i].maxX = proj->ToProjectionX(cube.sampleCount() + 0.5);
+      extents[i].minY = proj->ToProjectionY(cube.lineCount() + 0.5);
+    }
+
+    QVector<int> byMinX(m_imageList.size());
+    iota(byMinX.begin(), byMinX.end(), 0);
+    sort(byMinX.begin(), byMinX.end(), [&extents](int a, int b) {
+      return extents[a].minX < extents[b].minX;
+    });
+
+    QVector<ImagePair> pairs;
+    for (int a = 0; a < byMinX.size(); a++) {
+      for (int b = a + 1; b < byMinX.size() &&
+                          extents[byMinX[b]].minX < extents[byMinX[a]].maxX; b++) {
+        int i = qMin(byMinX[a], byMinX[b]);
+        int j = qMax(byMinX[a], byMinX[b]);
 
-      for (int j = (i + 1); j < m_imageList.size(); j++) {
         // Skip if overlap already calculated
-        if (m_alreadyCalculated[i] == true && m_alreadyCalculated[j] == true) {
-          //cout << " *** Cube " << i << " vs Cube " << j << " already calculated." << endl;
-          //cout << endl << "    " << i << " = " << m_imageList[i].toString() << " ; " << j
-          //     << " = " << m_imageList[j].toString() << endl << endl;
-          continue;
+        if (m_alreadyCalculated[i] == true && m_alreadyCalculated[j] == true) continue;
+
+        if (extents[i].intersects(extents[j])) {
+          ImagePair pair;
+          pair.first = i;
+          pair.second = j;
+          pairs.append(pair);
         }
+      }
+    }
 
-        Cube cube2;
-        cube2.open(m_imageList[j].toString());
-        QString cubeStr1 = toString((int)(i + 1));
-        QString cubeStr2 = toString((int)(j + 1));
-        QString statMsg = "Gathering Overlap Statisitcs for Cube " +
-                         cubeStr1 + " vs " + cubeStr2 + " of " +
-                         toString(m_maxCube);
-
-        // Get overlap statistics for new cubes
-        OverlapStatistics *oStats = new OverlapStatistics(cube1, cube2, statMsg, m_samplingPercent);
-        // Only push the stats onto the overlap statistics vector if there is an overlap in at
-        // least one of the bands
-        if (oStats->HasOverlap()) {
-          m_overlapStats.push_back(oStats);
-          oStats->SetMincount(m_mincnt);
-          for (int band = 1; band <= m_maxBand; band++) {
-            // Fill wt vector with 1's if the overlaps are not to be weighted, or
-            // fill the vector with the number of valid pixels in each overlap
-            int weight = 1;
-            if (m_wtopt) weight = oStats->GetMStats(band).ValidPixels();
-
-            // Make sure overlap has at least MINCOUNT valid pixels and add
-            if (oStats->GetMStats(band).ValidPixels() >= m_mincnt) {
-              m_overlapNorms[band - 1]->AddOverlap(
-                  oStats->GetMStats(band).X(), i,
-                  oStats->GetMStats(band).Y(), j, weight);
-              m_doesOverlapList[i] = true;
-              m_doesOverlapList[j] = true;
+    // Add the overlaps in the same order as they would be one at a time
+    sort(pairs.begin(), pairs.end(), [](const ImagePair &a, const ImagePair &b) {
+      return (a.first != b.first) ? a.first < b.first : a.second < b.second;
+    });
+
+    Progress progress;
+    progress.SetText("Gathering Overlap Statistics");
+    progress.SetMaximumSteps(pairs.size());
+    if (!pairs.isEmpty()) progress.CheckStatus();
+
+    // Gather the statistics of every pair on the global thread pool. Each
+    // task opens the two cubes of its pair and closes them when it is done,
+    // so only two cubes per running task are open at a time and the tasks
+    // do not wait on each other to read a cube they share.
+    std::function<void(ImagePair &)> gatherStatistics =
+        [this](ImagePair &pair) {
+          QString statMsg = "Gathering Overlap Statisitcs for Cube " +
+                           toString((int)(pair.first + 1)) + " vs " +
+                           toString((int)(pair.second + 1)) + " of " + toString(m_maxCube);
+          try {
+            Cube first;
+            Cube second;
+            {
+              QMutexLocker locker(&cubeOpenMutex);
+              first.open(m_imageList[pair.first].toString());
+              first.projection();
+              second.open(m_imageList[pair.second].toString());
+              second.projection();
             }
+
+            pair.stats = new OverlapStatistics(first, second, statMsg,
+                                               m_samplingPercent, false);
+          }
+          catch (IException &e) {
+            pair.error = e;
+          }
+        };
+    QFuture<void> future = QtConcurrent::map(pairs, gatherStatistics);
+
+    // Translate the progress of the future into Isis progress
+    int reportedProgress = 0;
+    while (!future.isFinished()) {
+      QThread::msleep(100);
+      while (reportedProgress < future.progressValue()) {
+        progress.CheckStatus();
+        reportedProgress++;
+      }
+    }
+    while (reportedProgress < future.progressValue()) {
+      progress.CheckStatus();
+      reportedProgress++;
+    }
+
+    // Report the first failure, after freeing the statistics of every pair
+    for (int p = 0; p < pairs.size(); p++) {
+      if (pairs[p].stats == NULL) {
+        for (int gathered = 0; gathered < pairs.size(); gathered++) {
+          delete pairs[gathered].stats;
+        }
+        throw pairs[p].error;
+      }
+    }
+
+    // Find overlapping areas and add them to the set of known overlaps for
+    // each band shared amongst cubes
+    for (int p = 0; p < pairs.size(); p++) {
+      int i = pairs[p].first;
+      int j = pairs[p].second;
+      OverlapStatistics *oStats = pairs[p].stats;
+
+      // Only push the stats onto the overlap statistics vector if there is an overlap in at
+      // least one of the bands
+      if (oStats->HasOverlap()) {
+        m_overlapStats.push_back(oStats);
+        oStats->SetMincount(m_mincnt);
+        for (int band = 1; band <= m_maxBand; band++) {
+          // Fill wt vector with 1's if the overlaps are not to be weighted, or
+          // fill the vector with the number of valid pixels in each overlap
+          int weight = 1;
+          if (m_wtopt) weight = oStats->GetMStats(band).ValidPixels();
+
+          // Make sure overlap has at least MINCOUNT valid pixels and add
+          if (oStats->GetMStats(band).ValidPixels() >= m_mincnt) {
+            m_overlapNorms[band - 1]->AddOverlap(
+                oStats->GetMStats(band).X(), i,
+                oStats->GetMStats(band).Y(), j, weight);
+            m_doesOverlapList[i] = true;
+            m_doesOverlapList[j] = true;
           }
         }
       }
+      else {
+        delete oStats;
+      }
     }
 
     // Compute the number valid and invalid overlaps
@@ -648,31 +778,31 @@ namespace Isis {
    * @throws IException::User "Mapping groups do not match between cubes"
    */
   void Equalization::errorCheck(QString fromListName) {
-    for (int i = 0; i < m_imageList.size(); i++) {
-      Cube cube1;
-      cube1.open(m_imageList[i].toString());
-
-      for (int j = (i + 1); j < m_imageList.size(); j++) {
-        Cube cube2;
-        cube2.open(m_imageList[j].toString());
-
-        // Make sure number of bands match
-        if (m_maxBand != cube2.bandCount()) {
-          QString msg = "Number of bands do not match between cubes [" +
-            m_imageList[i].toString() + "] and [" + m_imageList[j].toString() + "]";
-          throw IException(IException::User, msg, _FILEINFO_);
-        }
+    // The band counts and projections that must match are single values, so
+    // every image only has to be compared to the first one
+    Cube cube1;
+    cube1.open(m_imageList[0].toString());
+
+    for (int j = 1; j < m_imageList.size(); j++) {
+      Cube cube2;
+      cube2.open(m_imageList[j].toString());
+
+      // Make sure number of bands match
+      if (m_maxBand != cube2.bandCount()) {
+        QString msg = "Number of bands do not match between cubes [" +
+          m_imageList[0].toString() + "] and [" + m_imageList[j].toString() + "]";
+        throw IException(IException::User, msg, _FILEINFO_);
+      }
 
-        //Create projection from each cube
-        Projection *proj1 = cube1.projection();
-        Projection *proj2 = cube2.projection();
+      //Create projection from each cube
+      Projection *proj1 = cube1.projection();
+      Projection *proj2 = cube2.projection();
 
-        // Test to make sure projection parameters match
-        if (*proj1 != *proj2) {
-          QString msg = "Mapping groups do not match between cubes [" +
-            m_imageList[i].toString() + "] and [" + m_imageList[j].toString() + "]";
-          throw IException(IException::User, msg, _FILEINFO_);
-        }
+      // Test to make sure projection parameters match
+      if (*proj1 != *proj2) {
+        QString msg = "Mapping groups do not match between cubes [" +
+          m_imageList[0].toString() + "] and [" + m_imageList[j].toString() + "]";
+        throw IException(IException::User, msg, _FILEINFO_);
       }
     }
   }
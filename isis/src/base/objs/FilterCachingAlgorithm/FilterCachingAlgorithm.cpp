@@ -104,5 +104,14 @@ namespace Isis {
 
     return result;
   }
-}
 
+
+  /**
+   * Filters walk the cube from the top line to the bottom line.
+   *
+   * @return SequentialAccess
+   */
+  CubeCachingAlgorithm::AccessPattern FilterCachingAlgorithm::accessPattern() const {
+    return SequentialAccess;
+  }
+}
@@ -29,6 +29,8 @@ namespace Isis {
           QList<RawCubeChunk *> allocated, QList<RawCubeChunk *> justUsed,
           const Buffer &justRequested);
 
+      virtual AccessPattern accessPattern() const;
+
     private:
       /**
        * This is stored from parallel read # -> list of chunks for that read.
@@ -7,9 +7,77 @@ find files of those names at the top level of this repository. **/
 
 #include "FourierTransform.h"
 
+#include <algorithm>
+#include <map>
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSharedPointer>
+
+#include "IException.h"
+#include "IString.h"
+
 using namespace std;
 
 namespace Isis {
+  namespace {
+    /**
+     * The tables a power of two transform size needs: the bit reversed
+     * position of every element and the roots of unity.
+     */
+    struct FftPlan {
+      vector<int> bitReverse;                 //!< Bit reversed index of each element
+      vector< complex<double> > twiddles;     //!< e^(-2*PI*i*k/n) for k < n/2
+    };
+
+    //! Guards fftPlans
+    QMutex fftPlansMutex;
+    //! The plan of every transform size used so far, never changed once made
+    map< int, QSharedPointer<const FftPlan> > fftPlans;
+
+
+    /**
+     * Returns the plan for a power of two transform size, making it the first
+     * time the size is used. Plans are shared between every FourierTransform
+     * and thread.
+     *
+     * @param n The transform size, a power of two
+     *
+     * @return @b const FftPlan& The plan for the size
+     */
+    const FftPlan &fftPlan(int n) {
+      QMutexLocker locker(&fftPlansMutex);
+
+      QSharedPointer<const FftPlan> &plan = fftPlans[n];
+      if (!plan) {
+        FftPlan *newPlan = new FftPlan;
+
+        newPlan->bitReverse.resize(n);
+        int bits = 0;
+        while ((1 << bits) < n) bits++;
+        for (int i = 0; i < n; i++) {
+          int reversed = 0;
+          for (int bit = 0; bit < bits; bit++) {
+            if (i & (1 << bit)) reversed |= 1 << (bits - 1 - bit);
+          }
+          newPlan->bitReverse[i] = reversed;
+        }
+
+        // Each root is computed directly instead of by repeated
+        //   multiplication so the error does not grow with the size
+        newPlan->twiddles.resize(n / 2);
+        for (int k = 0; k < n / 2; k++) {
+          newPlan->twiddles[k] = polar(1.0, -2.0 * PI * k / n);
+        }
+
+        plan = QSharedPointer<const FftPlan>(newPlan);
+      }
+
+      return *plan;
+    }
+  }
+
+
   //! Constructs the FourierTransform object.
   FourierTransform::FourierTransform() {};
 
@@ -25,41 +93,102 @@ namespace Isis {
    * @return vector
    */
   std::vector< std::complex<double> >
-  FourierTransform::Transform(std::vector< std::complex<double> > input) {
+  FourierTransform::Transform(const std::vector< std::complex<double> > &input) {
     // data length must be a power of two
     // any extra space is filled with zeroes
+    vector< std::complex<double> > output(input);
+    output.resize(NextPowerOfTwo(input.size()));
+    Transform(output.data(), output.size());
+    return output;
+  }
+
+
+  /**
+   * Applies the Fourier transform on real input data and returns the result.
+   * This is the same as transforming the data as complex numbers with zero
+   * imaginary parts, but does about half the work by transforming the even
+   * and odd elements as the real and imaginary parts of a half size transform.
+   *
+   * @param input The data to be transformed.
+   *
+   * @return vector
+   */
+  std::vector< std::complex<double> >
+  FourierTransform::Transform(const std::vector<double> &input) {
     int n = NextPowerOfTwo(input.size());
-    vector< std::complex<double> > output(n);
-    input.resize(n);
+    if (n < 4) {
+      return Transform(vector< complex<double> >(input.begin(), input.end()));
+    }
+
+    // Pack the even elements as the real and the odd elements as the
+    //   imaginary parts, zero filling the padding
+    int half = n / 2;
+    vector< complex<double> > packed(half);
+    for (int k = 0; k < half; k++) {
+      double even = (2 * k < (int)input.size()) ? input[2 * k] : 0.0;
+      double odd = (2 * k + 1 < (int)input.size()) ? input[2 * k + 1] : 0.0;
+      packed[k] = complex<double>(even, odd);
+    }
+    Transform(packed.data(), half);
+
+    // Separate the transforms of the even and odd elements and combine them
+    const vector< complex<double> > &twiddles = fftPlan(n).twiddles;
+    vector< complex<double> > output(n);
+    for (int k = 0; k <= half; k++) {
+      complex<double> z = packed[k % half];
+      complex<double> zMirror = conj(packed[(half - k) % half]);
+      complex<double> even = 0.5 * (z + zMirror);
+      complex<double> odd = complex<double>(0.0, -0.5) * (z - zMirror);
+      complex<double> twiddle = (k < half) ? twiddles[k] : complex<double>(-1.0, 0.0);
+
+      output[k] = even + twiddle * odd;
+      if (k > 0 && k < half) {
+        output[n - k] = conj(output[k]);
+      }
+    }
+
+    return output;
+  }
+
+
+  /**
+   * Applies the Fourier transform on data in place.
+   *
+   * @param data The data to be transformed.
+   * @param n The number of elements in the data, which must be a power of two
+   */
+  void FourierTransform::Transform(std::complex<double> *data, int n) {
+    if (n < 0 || !IsPowerOfTwo(n)) {
+      QString msg = "Fourier transforms in place need a power of two number of elements, not [" +
+                    toString(n) + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    const FftPlan &plan = fftPlan(n);
 
     // rearrange the data to fit the iterative algorithm
     // which will apply the transform from the bottom up
-    for(int i = 0; i < n; i++) {
-      if(output[i] == 0.0) {
-        int j = BitReverse(n, i);
-        output[i] = input[j];
-        output[j] = input[i];
+    for (int i = 0; i < n; i++) {
+      int j = plan.bitReverse[i];
+      if (i < j) {
+        swap(data[i], data[j]);
       }
     }
 
     // do the iterative fft calculation by first combining
     // subarrays of length 2, then 4, 8, etc.
-    for(int m = 1; m < n; m *= 2) {
-      complex<double> Wm(polar(1.0, -1.0 * PI / m)); // Wm = e^(-PI/m *i)
-      for(int k = 0; k < n; k += 2 * m) {
-        // W = Wm^j, the roots of unity for x^m=1
-        complex<double> W(1.0);
-        for(int j = 0; j < m; j++) {
-          complex<double> t = W * output[k+j+m]; // the "twiddle" factor
-          complex<double> u = output[k+j];
-          output[k+j] = u + t; // a[k+j]+Wm^j*a[k+j+m]
-          output[k+j+m] = u - t; // a[k+j]+Wm^(j+m)*[k+j+m] = a[k+j]-Wm^j*[k+j+m]
-          W = W * Wm;
+    for (int m = 1; m < n; m *= 2) {
+      // Wm^j = e^(-PI*j/m *i) is every n/(2m)th root of the plan
+      int stride = n / (2 * m);
+      for (int k = 0; k < n; k += 2 * m) {
+        for (int j = 0; j < m; j++) {
+          complex<double> t = plan.twiddles[j * stride] * data[k+j+m]; // the "twiddle" factor
+          complex<double> u = data[k+j];
+          data[k+j] = u + t; // a[k+j]+Wm^j*a[k+j+m]
+          data[k+j+m] = u - t; // a[k+j]+Wm^(j+m)*[k+j+m] = a[k+j]-Wm^j*[k+j+m]
         }
       }
     }
-
-    return output;
   }
 
 
@@ -72,15 +201,15 @@ namespace Isis {
    * @return vector
    */
   std::vector< std::complex<double> >
-  FourierTransform::Inverse(std::vector< std::complex<double> > input) {
+  FourierTransform::Inverse(const std::vector< std::complex<double> > &input) {
     // Inverse(input) = 1/n*conj(Transform(conj(input)))
     int n = input.size();
-    std::vector< std::complex<double> > temp(n);
+    vector< std::complex<double> > output(NextPowerOfTwo(n));
     for(int i = 0; i < n; i++) {
-      temp[i] = conj(input[i]);
+      output[i] = conj(input[i]);
     }
 
-    std::vector< std::complex<double> > output = Transform(temp);
+    Transform(output.data(), output.size());
 
     for(int i = 0; i < n; i++) {
       output[i] = conj(output[i]) / ((double)n);
@@ -89,6 +218,33 @@ namespace Isis {
     return output;
   }
 
+
+  /**
+   * Applies the inverse Fourier transform on data in place.
+   *
+   * @param data The data to be transformed.
+   * @param n The number of elements in the data, which must be a power of two
+   */
+  void FourierTransform::Inverse(std::complex<double> *data, int n) {
+    // Check the size before the data is conjugated
+    if (n < 0 || !IsPowerOfTwo(n)) {
+      QString msg = "Fourier transforms in place need a power of two number of elements, not [" +
+                    toString(n) + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    // Inverse(input) = 1/n*conj(Transform(conj(input)))
+    for (int i = 0; i < n; i++) {
+      data[i] = conj(data[i]);
+    }
+
+    Transform(data, n);
+
+    for (int i = 0; i < n; i++) {
+      data[i] = conj(data[i]) / ((double)n);
+    }
+  }
+
   /**
    * Checks to see if the input integer is a power of two
    *
@@ -24,6 +24,13 @@ namespace Isis {
    * If you would like to see FourierTransform being used
    *         in implementation, see fft.cpp or ifft.cpp.
    *
+   * The bit reversal order and roots of unity of each transform size are
+   * computed once and shared by every FourierTransform, so repeated
+   * transforms of the same size only do the butterflies. The in place
+   * methods avoid copying the data for callers that already hold power of
+   * two sized buffers, and real input is transformed as a half size complex
+   * transform.
+   *
    * @ingroup Math and Statistics
    *
    * @author 2005-11-28 Jacob Danton
@@ -34,8 +41,11 @@ namespace Isis {
     public:
       FourierTransform();
       ~FourierTransform();
-      std::vector< std::complex<double> > Transform(std::vector< std::complex<double> > input);
-      std::vector< std::complex<double> > Inverse(std::vector< std::complex<double> > input);
+      std::vector< std::complex<double> > Transform(const std::vector< std::complex<double> > &input);
+      std::vector< std::complex<double> > Transform(const std::vector<double> &input);
+      void Transform(std::complex<double> *data, int n);
+      std::vector< std::complex<double> > Inverse(const std::vector< std::complex<double> > &input);
+      void Inverse(std::complex<double> *data, int n);
       bool IsPowerOfTwo(int n);
       int lg(int n);
       int BitReverse(int n, int x);
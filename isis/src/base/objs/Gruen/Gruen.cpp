@@ -840,6 +840,41 @@ namespace Isis {
     return (pvl);
   }
 
+  /**
+   * @brief Adds the statistics of another AutoReg to this one
+   *
+   * Adds the AutoReg statistics and, if the other AutoReg is also a Gruen, its
+   * error counts, iteration counts and radiometric and eigen value
+   * statistics.
+   *
+   * @param other The AutoReg whose statistics are added
+   */
+  void Gruen::MergeStatistics(const AutoReg &other) {
+    AutoReg::MergeStatistics(other);
+
+    const Gruen *gruen = dynamic_cast<const Gruen *>(&other);
+    if (!gruen) return;
+
+    m_callCount += gruen->m_callCount;
+    m_totalIterations += gruen->m_totalIterations;
+    m_unclassified += gruen->m_unclassified;
+    for (int e = 0 ; e < gruen->m_errors.size() ; e++) {
+      int gerrno = gruen->m_errors.key(e);
+      if (m_errors.exists(gerrno)) {
+        m_errors.get(gerrno).m_count += gruen->m_errors.getNth(e).Count();
+      }
+      else {
+        m_unclassified += gruen->m_errors.getNth(e).Count();
+      }
+    }
+
+    m_eigenStat.Merge(gruen->m_eigenStat);
+    m_iterStat.Merge(gruen->m_iterStat);
+    m_shiftStat.Merge(gruen->m_shiftStat);
+    m_gainStat.Merge(gruen->m_gainStat);
+  }
+
+
   /**
    * @brief Create a PvlGroup with the Gruen specific statistics
    *
@@ -5,14 +5,20 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 #include <cmath>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include <QSharedPointer>
+#include <QVector>
+#include <QtConcurrentMap>
+
 #include "Cube.h"
 #include "FileName.h"
+#include "geos/geom/Envelope.h"
 #include "geos/operation/distance/DistanceOp.h"
 #include "geos/util/IllegalArgumentException.h"
 #include "geos/geom/Point.h"
@@ -29,6 +35,78 @@ find files of those names at the top level of this repository. **/
 using namespace std;
 
 namespace Isis {
+  namespace {
+    //! The footprint of one image, read on the global thread pool
+    struct Footprint {
+      //! How far reading the footprint got
+      enum Status {
+        Read,          //!< The footprint was read and despiked
+        OpenFailed,    //!< The cube could not be opened
+        ReadFailed,    //!< The footprint could not be read from the cube
+        Invalid,       //!< The footprint in the cube is invalid
+        DespikeFailed  //!< The footprint could not be despiked and is invalid
+      };
+
+      int index;        //!< The index of the image in the serial number list
+      Status status;    //!< How far reading the footprint got
+      IException error; //!< The error when opening, reading or despiking failed
+      QSharedPointer<geos::geom::MultiPolygon> polygon; //!< The despiked footprint
+    };
+
+
+    /**
+     * Reads and despikes the footprint of a cube. This does not use any state
+     * of the ImageOverlapSet, so it is safe to call on many threads at once.
+     *
+     * @param fileName The cube to read the footprint from
+     * @param footprint Set to the footprint, or to the reason there is none
+     */
+    void readFootprint(QString fileName, Footprint &footprint) {
+      Cube cube;
+      try {
+        cube.open(fileName);
+      }
+      catch (IException &error) {
+        footprint.status = Footprint::OpenFailed;
+        footprint.error = error;
+        return;
+      }
+
+      QSharedPointer<geos::geom::MultiPolygon> tmp;
+      try {
+        ImagePolygon poly = cube.readFootprint();
+        cube.close();
+        tmp = QSharedPointer<geos::geom::MultiPolygon>(
+            PolygonTools::MakeMultiPolygon(poly.Polys()));
+      }
+      catch (IException &error) {
+        footprint.status = Footprint::ReadFailed;
+        footprint.error = error;
+        return;
+      }
+
+      if (!tmp->isValid()) {
+        footprint.status = Footprint::Invalid;
+        return;
+      }
+
+      try {
+        footprint.polygon = QSharedPointer<geos::geom::MultiPolygon>(
+            PolygonTools::Despike(tmp.data()));
+      }
+      catch (IException &e) {
+        if (!tmp->isValid()) {
+          footprint.status = Footprint::DespikeFailed;
+          footprint.error = e;
+          return;
+        }
+        footprint.polygon = tmp;
+      }
+
+      footprint.status = Footprint::Read;
+    }
+  }
+
 
   /**
    * Create FindImageOverlaps object.
@@ -76,67 +154,57 @@ namespace Isis {
    */
   void ImageOverlapSet::FindImageOverlaps(SerialNumberList &sns) {
 
+    // Read and despike the footprints on the global thread pool. Only the
+    //   reading is done in parallel, the footprints are added and errors are
+    //   handled in the order of the serial number list.
+    QVector<Footprint> footprints(sns.size());
+    for (int i = 0; i < footprints.size(); i++) {
+      footprints[i].index = i;
+    }
+
+    std::function<void(Footprint &)> readFootprints =
+        [&sns](Footprint &footprint) {
+          readFootprint(sns.fileName(footprint.index), footprint);
+        };
+    QtConcurrent::blockingMap(footprints, readFootprints);
+
     // Create an ImageOverlap for each image boundary
-    for (int i = 0; i < sns.size(); i++) {
-      // Open the cube
-      Cube cube;
-      try {
-        cube.open(sns.fileName(i));
-      }
-      catch (IException &error) {
+    for (int i = 0; i < footprints.size(); i++) {
+      Footprint &footprint = footprints[i];
+
+      if (footprint.status == Footprint::OpenFailed) {
         QString msg = "Unable to open cube for serial number [";
         msg += sns.serialNumber(i) + "] filename [" + sns.fileName(i) + "]";
 
-        HandleError(error, &sns, msg);
+        HandleError(footprint.error, &sns, msg);
+        continue;
       }
 
-      // Read the bounding polygon
-      ImagePolygon poly = cube.readFootprint();
-      cube.close();
-      // Create an ImageOverlap with the serial number and the bounding
-      // polygon and save it
-      geos::geom::MultiPolygon *tmp = PolygonTools::MakeMultiPolygon(poly.Polys());
-
-      geos::geom::MultiPolygon *mp = NULL;
+      // Errors reading the footprint are not handled, as when it is read here
+      if (footprint.status == Footprint::ReadFailed) {
+        throw footprint.error;
+      }
 
       // If footprint is invalid throw exception
-      if(!tmp->isValid()) {
-        delete tmp;
-        tmp = NULL;
+      if (footprint.status == Footprint::Invalid) {
         QString msg = "The image [" + sns.fileName(sns.serialNumber(i)) +
                       "] has an invalid footprint";
         throw IException(IException::Programmer, msg, _FILEINFO_);
       }
 
-      try {
-        mp = PolygonTools::Despike(tmp);
-      }
-      catch (IException &e) {
-        if (tmp->isValid()) {
-          mp = tmp;
-          tmp = NULL;
-        }
-        else {
-          delete tmp;
-          tmp = NULL;
-          HandleError(e, &sns);
-          continue;
-        }
+      if (footprint.status == Footprint::DespikeFailed) {
+        HandleError(footprint.error, &sns);
+        continue;
       }
 
+      // Create an ImageOverlap with the serial number and the bounding
+      // polygon and save it
       p_lonLatOverlapsMutex.lock();
-      p_lonLatOverlaps.push_back(CreateNewOverlap(sns.serialNumber(i), mp));
+      p_lonLatOverlaps.push_back(CreateNewOverlap(sns.serialNumber(i),
+                                                  footprint.polygon.data()));
       p_lonLatOverlapsMutex.unlock();
 
-      if (mp) {
-        delete mp;
-        mp = NULL;
-      }
-
-      if (tmp) {
-        delete tmp;
-        tmp = NULL;
-      }
+      footprint.polygon.clear();
     }
 
     // Despikes the polygons from the Serial Numbers prior to overlap
@@ -563,13 +631,25 @@ namespace Isis {
       // below it
       for (int inside = outside + 1; inside < p_lonLatOverlaps.size(); ++inside) {
         try {
-          if (p_lonLatOverlaps.at(outside)->HasAnySameSerialNumber(*p_lonLatOverlaps.at(inside)))
-            continue;
-
           // We know these are valid because they were filtered early on
           const geos::geom::MultiPolygon *poly1 = p_lonLatOverlaps.at(outside)->Polygon();
           const geos::geom::MultiPolygon *poly2 = p_lonLatOverlaps.at(inside)->Polygon();
 
+          // Most pairs are far apart. Polygons with disjoint bounding boxes
+          //   can be neither equal nor intersect, so they are passed over
+          //   before comparing serial numbers or geometries. Empty polygons
+          //   have null envelopes, and they and tiny polygons take the full
+          //   path, which removes them.
+          const geos::geom::Envelope *envelope1 = poly1->getEnvelopeInternal();
+          const geos::geom::Envelope *envelope2 = poly2->getEnvelopeInternal();
+          if (!envelope1->isNull() && !envelope2->isNull() &&
+              !envelope1->intersects(envelope2) && poly2->getArea() >= 1.0e-14) {
+            continue;
+          }
+
+          if (p_lonLatOverlaps.at(outside)->HasAnySameSerialNumber(*p_lonLatOverlaps.at(inside)))
+            continue;
+
           // Check to see if the two poygons are equivalent.
           // If they are, then we can get rid of one of them
           if (PolygonTools::Equal(poly1, poly2)) {
@@ -123,6 +123,16 @@ namespace Isis {
 
     p_cube = &cube;
 
+    // The remembered image coordinates stay valid while polygons are created
+    //   for the same cube and band with the same limits
+    QString validImagePointsKey = QString("%1 %2 %3 %4 %5 %6")
+        .arg((quintptr) &cube).arg(cube.fileName()).arg(band)
+        .arg(p_emission, 0, 'g', 17).arg(p_incidence, 0, 'g', 17).arg(p_ellipsoid);
+    if (validImagePointsKey != m_validImagePointsKey) {
+      m_validImagePoints.clear();
+      m_validImagePointsKey = validImagePointsKey;
+    }
+
     Camera *cam = NULL;
     p_isProjected = false;
 
@@ -780,7 +790,7 @@ namespace Isis {
     vector<geos::geom::Coordinate> *crossingPoints = new vector<geos::geom::Coordinate>;
     for (unsigned int i = 0; i < points.size(); i++) {
       geos::geom::Coordinate *temp = &(points.at(i));
-      SetImage(temp->x, temp->y);
+      SetImageUncached(temp->x, temp->y);
       lon = p_gMap->UniversalLongitude();
       lat = p_gMap->UniversalLatitude();
       if (abs(lon - prevLon) >= 180 && i != 0) {
@@ -1061,6 +1071,37 @@ namespace Isis {
   }
 
 
+  /**
+   * Returns whether an image coordinate has valid lat/lon values, the same way
+   * SetImageUncached() does. The walk around the image and the subpixel search
+   * test the same coordinates many times, and Create() walks the image again
+   * at finer increments when increasing precision, so the result for each
+   * coordinate is remembered. The results are kept across calls to Create()
+   * for the same cube, band, emission and incidence limits and limb shape
+   * model, and are forgotten when any of these change. The ground
+   * map is only set to the coordinate when the result is not remembered, so
+   * callers that need the lat/lon must use SetImageUncached().
+   *
+   * @param[in] sample   (const double)  Sample coordinate of the cube
+   *
+   * @param[in] line     (const double)  Line coordinate of the cube
+   *
+   * @return bool Returns true if the image coordinate is valid
+   */
+  bool ImagePolygon::SetImage(const double sample, const double line) {
+    QPair<double, double> point(sample, line);
+    QHash<QPair<double, double>, bool>::const_iterator cached =
+        m_validImagePoints.constFind(point);
+    if (cached != m_validImagePoints.constEnd()) {
+      return cached.value();
+    }
+
+    bool valid = SetImageUncached(sample, line);
+    m_validImagePoints.insert(point, valid);
+    return valid;
+  }
+
+
   /**
    * Sets the sample/line values of the cube to get lat/lon values.  This
    * method checks whether the image pixel is Null for level 2 images and
@@ -1073,7 +1114,7 @@ namespace Isis {
    * @return bool Returns true if the image was set successfully and false if it
    *              was not or if pixel of level 2 images is NULL.
    */
-  bool ImagePolygon::SetImage(const double sample, const double line) {
+  bool ImagePolygon::SetImageUncached(const double sample, const double line) {
     bool found = false;
     if (!p_isProjected) {
       found = p_gMap->SetImage(sample, line);
@@ -11,6 +11,9 @@ find files of those names at the top level of this repository. **/
 #include <sstream>
 #include <vector>
 
+#include <QHash>
+#include <QPair>
+
 #include "IException.h"
 #include "Cube.h"
 #include "Brick.h"
@@ -239,6 +242,7 @@ namespace Isis {
       // Please do not add new polygon manipulation methods to this class.
       // Polygon manipulation should be done in the PolygonTools class.
       bool SetImage(const double sample, const double line);
+      bool SetImageUncached(const double sample, const double line);
 
       geos::geom::Coordinate FindFirstPoint();
       void WalkPoly();
@@ -296,6 +300,11 @@ namespace Isis {
 
       int p_subpixelAccuracy; //!< The subpixel accuracy to use
 
+      //! Whether each image coordinate tested while creating polygons is valid
+      QHash<QPair<double, double>, bool> m_validImagePoints;
+      //! The cube, band and limits the remembered image coordinates are valid for
+      QString m_validImagePointsKey;
+
   };
 };
 
@@ -7,6 +7,8 @@ find files of those names at the top level of this repository. **/
 
 #include "LineScanCameraGroundMap.h"
 
+#include <algorithm>
+#include <cfloat>
 #include <iostream>
 #include <iomanip>
 
@@ -25,6 +27,7 @@ find files of those names at the top level of this repository. **/
 #include "iTime.h"
 #include "Latitude.h"
 #include "Longitude.h"
+#include "Preference.h"
 #include "Statistics.h"
 #include "SurfacePoint.h"
 #include "FunctionTools.h"
@@ -194,7 +197,15 @@ namespace Isis {
    *
    * @param cam pointer to camera model
    */
-  LineScanCameraGroundMap::LineScanCameraGroundMap(Camera *cam) : CameraGroundMap(cam) {}
+  LineScanCameraGroundMap::LineScanCameraGroundMap(Camera *cam) : CameraGroundMap(cam) {
+    PvlGroup &performancePrefs = Preference::Preferences().findGroup("Performance");
+    m_useInverseModel = performancePrefs.hasKeyword("LineScanInverseModel") &&
+        performancePrefs["LineScanInverseModel"][0].toUpper() == "ON";
+    m_inverseModelBuilt = false;
+    m_inverseModelSamples = 0;
+    m_inverseModelLines = 0;
+    m_inverseModelRange = 0.0;
+  }
 
 
   /** Destructor
@@ -245,7 +256,15 @@ namespace Isis {
    * @return conversion was successful
    */
   bool LineScanCameraGroundMap::SetGround(const SurfacePoint &surfacePoint) {
-    FindFocalPlaneStatus status = FindFocalPlane(-1, surfacePoint);
+    int approxLine = -1;
+    if (m_useInverseModel) {
+      double modelLine = inverseModelLine(surfacePoint);
+      if (modelLine >= 0.5) {
+        approxLine = std::max(1, qRound(modelLine));
+      }
+    }
+
+    FindFocalPlaneStatus status = FindFocalPlane(approxLine, surfacePoint);
 
     if (status == Success) return true;
 
@@ -357,7 +376,7 @@ namespace Isis {
 
         // See if we converged on the point so set up the undistorted focal plane values and return
         if (fabs(f) < 1e-2) {
-          p_camera->Sensor::setTime(approxTime);
+          p_camera->Sensor::setTime(etGuess);
           // check to make sure the point isn't behind the planet
           if (!p_camera->Sensor::SetGround(surfacePoint, true)) {
             return Failure;
@@ -610,6 +629,136 @@ namespace Isis {
 
     return Success;
   }
+
+
+  /**
+   * Builds the inverse model grid by intersecting a coarse grid of pixels,
+   * spread evenly over the image, with the target. Pixels that miss the
+   * target are left out of the grid.
+   */
+  void LineScanCameraGroundMap::buildInverseModel() {
+    m_inverseModelBuilt = true;
+    m_inverseModel.clear();
+
+    int samples = p_camera->Samples();
+    int lines = p_camera->Lines();
+    m_inverseModelSamples = std::min(samples, 5);
+    m_inverseModelLines = std::min(lines, 65);
+    m_inverseModel.resize(m_inverseModelSamples * m_inverseModelLines);
+
+    for (int i = 0; i < m_inverseModelLines; i++) {
+      double line = (m_inverseModelLines > 1) ?
+          1.0 + (lines - 1.0) * i / (m_inverseModelLines - 1.0) : (1.0 + lines) / 2.0;
+
+      for (int j = 0; j < m_inverseModelSamples; j++) {
+        double sample = (m_inverseModelSamples > 1) ?
+            1.0 + (samples - 1.0) * j / (m_inverseModelSamples - 1.0) : (1.0 + samples) / 2.0;
+
+        InverseModelNode &node = m_inverseModel[i * m_inverseModelSamples + j];
+        try {
+          node.valid = p_camera->SetImage(sample, line);
+        }
+        catch (IException &) {
+          node.valid = false;
+        }
+
+        if (node.valid) {
+          p_camera->Coordinate(node.coordinate);
+          node.line = p_camera->DetectorMap()->ParentLine();
+        }
+      }
+    }
+
+    // Ground points more than two grid cells from every node are not in the
+    // image, or not near enough to the grid to trust it
+    double maxSpacing = 0.0;
+    for (int i = 0; i < m_inverseModelLines; i++) {
+      for (int j = 0; j < m_inverseModelSamples; j++) {
+        const InverseModelNode &node = m_inverseModel[i * m_inverseModelSamples + j];
+        if (!node.valid) continue;
+
+        const InverseModelNode *neighbors[2] = {
+          (j + 1 < m_inverseModelSamples) ? &m_inverseModel[i * m_inverseModelSamples + j + 1] : NULL,
+          (i + 1 < m_inverseModelLines) ? &m_inverseModel[(i + 1) * m_inverseModelSamples + j] : NULL
+        };
+
+        for (int k = 0; k < 2; k++) {
+          if (neighbors[k] && neighbors[k]->valid) {
+            double dx = neighbors[k]->coordinate[0] - node.coordinate[0];
+            double dy = neighbors[k]->coordinate[1] - node.coordinate[1];
+            double dz = neighbors[k]->coordinate[2] - node.coordinate[2];
+            maxSpacing = std::max(maxSpacing, sqrt(dx * dx + dy * dy + dz * dz));
+          }
+        }
+      }
+    }
+
+    m_inverseModelRange = 2.0 * maxSpacing;
+  }
+
+
+  /**
+   * Estimates the parent line that imaged a ground point from the inverse
+   * model grid. The line of the nearest grid node is interpolated toward the
+   * node of the neighboring grid line that the ground point lies toward.
+   *
+   * @param surfacePoint The ground point
+   *
+   * @return @b double The estimated parent line, or -1 if the ground point is
+   *                   not near the grid
+   */
+  double LineScanCameraGroundMap::inverseModelLine(const SurfacePoint &surfacePoint) {
+    if (!m_inverseModelBuilt) {
+      buildInverseModel();
+    }
+
+    double point[3] = {surfacePoint.GetX().kilometers(),
+                       surfacePoint.GetY().kilometers(),
+                       surfacePoint.GetZ().kilometers()};
+
+    int nearest = -1;
+    double nearestDistance = DBL_MAX;
+    for (int i = 0; i < m_inverseModel.size(); i++) {
+      const InverseModelNode &node = m_inverseModel[i];
+      if (!node.valid) continue;
+
+      double dx = point[0] - node.coordinate[0];
+      double dy = point[1] - node.coordinate[1];
+      double dz = point[2] - node.coordinate[2];
+      double distance = dx * dx + dy * dy + dz * dz;
+      if (distance < nearestDistance) {
+        nearestDistance = distance;
+        nearest = i;
+      }
+    }
+
+    if (nearest < 0 || sqrt(nearestDistance) > m_inverseModelRange) {
+      return -1.0;
+    }
+
+    const InverseModelNode &node = m_inverseModel[nearest];
+    int row = nearest / m_inverseModelSamples;
+    for (int step = -1; step <= 1; step += 2) {
+      if (row + step < 0 || row + step >= m_inverseModelLines) continue;
+
+      const InverseModelNode &neighbor = m_inverseModel[nearest + step * m_inverseModelSamples];
+      if (!neighbor.valid) continue;
+
+      double along = 0.0;
+      double length = 0.0;
+      for (int k = 0; k < 3; k++) {
+        double direction = neighbor.coordinate[k] - node.coordinate[k];
+        along += (point[k] - node.coordinate[k]) * direction;
+        length += direction * direction;
+      }
+
+      if (length > 0.0 && along > 0.0) {
+        return node.line + std::min(along / length, 1.0) * (neighbor.line - node.line);
+      }
+    }
+
+    return node.line;
+  }
 }
 
 
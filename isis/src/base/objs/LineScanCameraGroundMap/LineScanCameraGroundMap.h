@@ -6,6 +6,8 @@ The authors of ISIS do not claim copyright on the contents of this file.
 For more details about the LICENSE terms and the AUTHORS, you will
 find files of those names at the top level of this repository. **/
 
+#include <QVector>
+
 #include "CameraGroundMap.h"
 
 namespace Isis {
@@ -45,6 +47,10 @@ namespace Isis {
    *   @history 2012-07-06 Debbie A. Cook, Updated Spice members to be more compliant with Isis 
    *            coding standards. References #972.
    *
+   * When the LineScanInverseModel keyword of the Performance preferences is
+   * On, SetGround without an approximate line starts the search from a line
+   * interpolated in a coarse grid of ground points. The grid is built from the
+   * forward camera model the first time it is needed.
    */
   class LineScanCameraGroundMap : public CameraGroundMap {
     public:
@@ -70,6 +76,27 @@ namespace Isis {
                                           const SurfacePoint &surfacePoint);
       double FindSpacecraftDistance(int line, const SurfacePoint &surfacePoint);
 
+    private:
+      /**
+       * A node of the inverse model grid: the body-fixed coordinate of the
+       * ground imaged at a grid pixel and the parent line of the pixel.
+       */
+      struct InverseModelNode {
+        double coordinate[3]; //!< The body-fixed coordinate in kilometers
+        double line;          //!< The parent line of the pixel
+        bool valid;           //!< If the pixel intersects the target
+      };
+
+      void buildInverseModel();
+      double inverseModelLine(const SurfacePoint &surfacePoint);
+
+      bool m_useInverseModel;      //!< If SetGround starts from the inverse model
+      bool m_inverseModelBuilt;    //!< If the inverse model grid has been built
+      int m_inverseModelSamples;   //!< The number of grid nodes across the image
+      int m_inverseModelLines;     //!< The number of grid nodes down the image
+      double m_inverseModelRange;  //!< The largest distance from a grid node a
+                                   //!< ground point can be and use the grid
+      QVector<InverseModelNode> m_inverseModel; //!< The grid, line by line
   };
 };
 #endif
@@ -6,6 +6,7 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "MaximumCorrelation.h"
 #include "Chip.h"
+#include "ChipCorrelator.h"
 #include "MultivariateStatistics.h"
 
 namespace Isis {
@@ -31,6 +32,23 @@ namespace Isis {
     return fabs(r);
   }
 
+
+  /**
+   * Returns the absolute value of the correlation coefficient of the pattern
+   * chip and the sub-search chip at one search chip position, computed from
+   * the correlation sums of the correlator.
+   *
+   * @param correlator The correlator of the search and pattern chips
+   * @param samp The search chip sample at the tack of the sub-search chip
+   * @param line The search chip line at the tack of the sub-search chip
+   *
+   * @return @b double The goodness of fit, or Null if there is none
+   */
+  double MaximumCorrelation::FastMatchAlgorithm(ChipCorrelator &correlator,
+                                                int samp, int line) {
+    return correlator.Correlation(samp, line, this->PatternValidPercent());
+  }
+
   /**
    * This virtual method must return if the 1st fit is equal to or better
    * than the second fit.
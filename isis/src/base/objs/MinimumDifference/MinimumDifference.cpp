@@ -7,6 +7,7 @@ find files of those names at the top level of this repository. **/
 
 #include "MinimumDifference.h"
 #include "Chip.h"
+#include "ChipCorrelator.h"
 
 namespace Isis {
 
@@ -50,6 +51,49 @@ namespace Isis {
     return diff / count;
   }
 
+
+  /**
+   * Minimum difference match algorithm for fast matching. The correlator has
+   * already checked the sub-search chip's valid percentage, so the
+   * differences are taken straight from the search chip without extracting
+   * the sub-search chip. The result is the same as MatchAlgorithm().
+   *
+   * @param correlator The correlator of the search and pattern chips
+   * @param samp The search chip sample at the tack of the sub-search chip
+   * @param line The search chip line at the tack of the sub-search chip
+   *
+   * @return The sum of the absolute value of the DN differences divided by the
+   *         valid pixel count
+   */
+  double MinimumDifference::FastMatchAlgorithm(ChipCorrelator &correlator,
+                                               int samp, int line) {
+    Chip &pattern = correlator.PatternChip();
+    Chip &search = correlator.SearchChip();
+    int sampOffset = samp - (((pattern.Samples() - 1) / 2) + 1);
+    int lineOffset = line - (((pattern.Lines() - 1) / 2) + 1);
+
+    double diff = 0.0;
+    double count = 0;
+    for(int l = 1; l <= pattern.Lines(); l++) {
+      int searchLine = l + lineOffset;
+      if(searchLine < 1 || searchLine > search.Lines()) continue;
+
+      for(int s = 1; s <= pattern.Samples(); s++) {
+        int searchSamp = s + sampOffset;
+        if(searchSamp < 1 || searchSamp > search.Samples()) continue;
+
+        double pdn = pattern.GetValue(s, l);
+        double sdn = search.GetValue(searchSamp, searchLine);
+        if(IsSpecial(pdn)) continue;
+        if(IsSpecial(sdn)) continue;
+        diff += fabs(pdn - sdn);
+        count++;
+      }
+    }
+
+    return diff / count;
+  }
+
   /**
    * This virtual method must return if the 1st fit is equal to or better
    * than the second fit.
@@ -12,6 +12,7 @@ find files of those names at the top level of this repository. **/
 namespace Isis {
   class Pvl;
   class Chip;
+  class ChipCorrelator;
 
   /**
    * @brief Minimum difference pattern matching
@@ -64,6 +65,7 @@ namespace Isis {
 
     protected:
       virtual double MatchAlgorithm(Chip &pattern, Chip &subsearch);
+      virtual double FastMatchAlgorithm(ChipCorrelator &correlator, int samp, int line);
       virtual bool CompareFits(double fit1, double fit2);
       virtual double IdealFit() const {
         return 0.0;
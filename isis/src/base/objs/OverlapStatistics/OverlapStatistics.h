@@ -62,7 +62,7 @@ namespace Isis {
     public:
       OverlapStatistics(Isis::Cube &x, Isis::Cube &y,
                         QString progressMsg = "Gathering Overlap Statistics",
-                        double sampPercent = 100.0);
+                        double sampPercent = 100.0, bool showProgress = true);
       OverlapStatistics(const PvlObject &inStats);
 
       /**
@@ -396,7 +396,10 @@ Isis::Cube *Process::SetOutputCubeStretch(const QString &parameter, const int ns
             InputCubes[0]->label()->findObject("IsisCube");
         Isis::PvlObject &outcube = cube->label()->findObject("IsisCube");
         for(int i = 0; i < incube.groups(); i++) {
-          outcube.addGroup(incube.group(i));
+          // Overviews are made from the DNs of the input, not the output
+          if(!incube.group(i).isNamed("Overviews")) {
+            outcube.addGroup(incube.group(i));
+          }
         }
 
         if (InputCubes[0]->label()->hasObject("NaifKeywords")) {
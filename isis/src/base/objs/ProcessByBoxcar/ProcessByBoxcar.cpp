@@ -4,12 +4,16 @@ For more details about the LICENSE terms and the AUTHORS, you will
 find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
+#include <algorithm>
+#include <vector>
+
 #include "BoxcarCachingAlgorithm.h"
 #include "BoxcarManager.h"
 #include "Buffer.h"
 #include "LineManager.h"
 #include "Process.h"
 #include "ProcessByBoxcar.h"
+#include "SpecialPixel.h"
 
 using namespace std;
 namespace Isis {
@@ -80,19 +84,53 @@ namespace Isis {
     // Construct boxcar buffer and line buffer managers
     Isis::BoxcarManager box(*InputCubes[0], p_boxSamples, p_boxLines);
     Isis::LineManager line(*OutputCubes[0]);
+    Isis::LineManager inLine(*InputCubes[0]);
     double out;
 
-    InputCubes[0]->addCachingAlgorithm(new BoxcarCachingAlgorithm());
     OutputCubes[0]->addCachingAlgorithm(new BoxcarCachingAlgorithm());
 
+    // The boxcar is filled from the input lines it covers, which are read
+    //   once each instead of reading every boxcar from the cube. Each line is
+    //   padded with Null on both sides for the part of the boxcar that hangs
+    //   off the left and right of the cube, and lines above and below the cube
+    //   are all Null, which is what reading the boxcar returns there.
+    int samples = InputCubes[0]->sampleCount();
+    int lines = InputCubes[0]->lineCount();
+    int leftSamples = (p_boxSamples - 1) / 2;
+    int topLines = (p_boxLines - 1) / 2;
+    vector< vector<double> > window(p_boxLines,
+                                    vector<double>(samples + p_boxSamples - 1, Null));
+    int oldest = 0;
+    int currentBand = 0;
+
     // Loop and let the app programmer use the boxcar to change output pixel
     p_progress->SetMaximumSteps(InputCubes[0]->lineCount()*InputCubes[0]->bandCount());
     p_progress->CheckStatus();
 
     box.begin();
     for(line.begin(); !line.end(); line.next()) {
+      if(line.Band() != currentBand) {
+        // Load the whole boxcar for the first line of a band
+        currentBand = line.Band();
+        oldest = 0;
+        for(int row = 0; row < p_boxLines; row++) {
+          readBoxcarLine(inLine, line.Line() - topLines + row, currentBand,
+                         leftSamples, window[row]);
+        }
+      }
+      else {
+        // Slide the boxcar down a line, replacing its oldest line
+        readBoxcarLine(inLine, line.Line() - topLines + p_boxLines - 1, currentBand,
+                       leftSamples, window[oldest]);
+        oldest = (oldest + 1) % p_boxLines;
+      }
+
       for(int i = 0; i < line.size(); i++) {
-        InputCubes[0]->read(box);
+        for(int row = 0; row < p_boxLines; row++) {
+          const vector<double> &boxLine = window[(oldest + row) % p_boxLines];
+          copy(boxLine.begin() + i, boxLine.begin() + i + p_boxSamples,
+               box.DoubleBuffer() + row * p_boxSamples);
+        }
         funct(box, out);
         line[i] = out;
         box++;
@@ -103,6 +141,30 @@ namespace Isis {
 
   }
 
+
+  /**
+   * Reads an input line into one line of the boxcar window, leaving the
+   * padding on either side of it Null. Lines outside of the cube are all Null.
+   *
+   * @param inLine The line manager used to read the input cube
+   * @param lineNumber The line to read
+   * @param band The band to read
+   * @param leftSamples The number of padding samples left of the line
+   * @param windowLine The window line to fill
+   */
+  void ProcessByBoxcar::readBoxcarLine(LineManager &inLine, int lineNumber, int band,
+                                       int leftSamples, vector<double> &windowLine) {
+    if(lineNumber < 1 || lineNumber > InputCubes[0]->lineCount()) {
+      fill(windowLine.begin(), windowLine.end(), Null);
+      return;
+    }
+
+    inLine.SetLine(lineNumber, band);
+    InputCubes[0]->read(inLine);
+    copy(inLine.DoubleBuffer(), inLine.DoubleBuffer() + inLine.size(),
+         windowLine.begin() + leftSamples);
+  }
+
   /**
    * End the boxcar processing sequence and cleans up by closing cubes, freeing
    * memory, etc.
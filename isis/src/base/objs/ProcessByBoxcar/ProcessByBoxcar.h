@@ -6,10 +6,14 @@ For more details about the LICENSE terms and the AUTHORS, you will
 find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
+#include <vector>
+
 #include "Process.h"
 #include "Buffer.h"
 
 namespace Isis {
+  class LineManager;
+
   /**
    * @brief Process cubes by boxcar
    *
@@ -43,6 +47,8 @@ namespace Isis {
       int p_boxSamples;  //!< Number of samples in boxcar
       int p_boxLines;    //!< Number of lines in boxcar
 
+      void readBoxcarLine(LineManager &inLine, int lineNumber, int band,
+                          int leftSamples, std::vector<double> &windowLine);
 
     public:
 
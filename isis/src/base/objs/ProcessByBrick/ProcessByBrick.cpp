@@ -6,13 +6,200 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 #include <functional>
 
+#include <QSharedPointer>
+#include <QThreadPool>
+
 #include "ProcessByBrick.h"
 #include "Brick.h"
 #include "Cube.h"
+#include "IString.h"
+#include "Preference.h"
 
 using namespace std;
 
 namespace Isis {
+  namespace {
+    /**
+     * The output bricks produced for one brick position by a worker thread.
+     *   These are held until every earlier position has been written. The
+     *   bricks are deleted with this.
+     */
+    class ProcessedBricks {
+      public:
+        ~ProcessedBricks() {
+          for (unsigned int i = 0; i < bricks.size(); i++) {
+            delete bricks[i];
+          }
+        }
+
+        //! The bricks to write, parallel to the writer's output cubes
+        vector<Brick *> bricks;
+    };
+
+    typedef QSharedPointer<ProcessedBricks> ProcessedBricksPtr;
+
+
+    /**
+     * Reads and processes one brick position of a cube processed in place.
+     */
+    class InPlaceBrickMapper :
+        public std::unary_function<const int &, ProcessedBricksPtr> {
+      public:
+        InPlaceBrickMapper(Cube *cube, const Brick *templateBrick,
+                           bool readInput, void funct(Buffer &)) :
+            m_cube(cube), m_templateBrick(templateBrick),
+            m_readInput(readInput), m_funct(funct) {
+        }
+
+        ProcessedBricksPtr operator()(const int &brickPosition) const {
+          ProcessedBricksPtr result(new ProcessedBricks);
+          Brick *brick = new Brick(*m_templateBrick);
+          result->bricks.push_back(brick);
+
+          brick->setpos(brickPosition);
+          if (m_readInput) {
+            m_cube->read(*brick);
+          }
+
+          m_funct(*brick);
+          return result;
+        }
+
+      private:
+        Cube *m_cube;                  //!< The cube being processed
+        const Brick *m_templateBrick;  //!< A brick with the right shape
+        bool m_readInput;              //!< Read the cube before processing
+        void (*m_funct)(Buffer &);     //!< The application function
+    };
+
+
+    /**
+     * Reads and processes one brick position of one input and one output cube.
+     */
+    class InputOutputBrickMapper :
+        public std::unary_function<const int &, ProcessedBricksPtr> {
+      public:
+        InputOutputBrickMapper(Cube *inputCube, const Brick *inputTemplateBrick,
+                               const Brick *outputTemplateBrick,
+                               void funct(Buffer &, Buffer &)) :
+            m_inputCube(inputCube), m_inputTemplateBrick(inputTemplateBrick),
+            m_outputTemplateBrick(outputTemplateBrick), m_funct(funct) {
+        }
+
+        ProcessedBricksPtr operator()(const int &brickPosition) const {
+          ProcessedBricksPtr result(new ProcessedBricks);
+          Brick *outputBrick = new Brick(*m_outputTemplateBrick);
+          result->bricks.push_back(outputBrick);
+
+          Brick inputBrick(*m_inputTemplateBrick);
+          inputBrick.setpos(brickPosition);
+          outputBrick->setpos(brickPosition);
+
+          m_inputCube->read(inputBrick);
+          m_funct(inputBrick, *outputBrick);
+          return result;
+        }
+
+      private:
+        Cube *m_inputCube;                   //!< The cube to read from
+        const Brick *m_inputTemplateBrick;   //!< A brick shaped for the input
+        const Brick *m_outputTemplateBrick;  //!< A brick shaped for the output
+        void (*m_funct)(Buffer &, Buffer &); //!< The application function
+    };
+
+
+    /**
+     * Reads and processes one brick position of any number of input and
+     *   output cubes.
+     */
+    class MultipleCubeBrickMapper :
+        public std::unary_function<const int &, ProcessedBricksPtr> {
+      public:
+        MultipleCubeBrickMapper(const vector<Cube *> &inputCubes,
+                                const vector<Brick *> &inputTemplateBricks,
+                                const vector<Brick *> &outputTemplateBricks,
+                                bool wraps,
+                                void funct(vector<Buffer *> &, vector<Buffer *> &)) :
+            m_inputCubes(inputCubes), m_inputTemplateBricks(inputTemplateBricks),
+            m_outputTemplateBricks(outputTemplateBricks), m_wraps(wraps),
+            m_funct(funct) {
+        }
+
+        ProcessedBricksPtr operator()(const int &brickPosition) const {
+          ProcessedBricksPtr result(new ProcessedBricks);
+          // Owns the input bricks, so they are freed even if reading or the
+          //   application function throws
+          ProcessedBricks inputBricks;
+          vector<Buffer *> inputBuffers;
+          vector<Buffer *> outputBuffers;
+
+          for (unsigned int i = 0; i < m_inputTemplateBricks.size(); i++) {
+            Brick *inputBrick = new Brick(*m_inputTemplateBricks[i]);
+            inputBricks.bricks.push_back(inputBrick);
+            inputBuffers.push_back(inputBrick);
+
+            if (m_wraps) {
+              inputBrick->setpos(brickPosition % inputBrick->Bricks());
+            }
+            else {
+              inputBrick->setpos(brickPosition);
+            }
+
+            // Enforce same band
+            if (i != 0 &&
+                inputBrick->Band() != inputBuffers[0]->Band() &&
+                m_inputCubes[i]->bandCount() != 1) {
+              inputBrick->SetBaseBand(inputBuffers[0]->Band());
+            }
+
+            m_inputCubes[i]->read(*inputBrick);
+          }
+
+          for (unsigned int i = 0; i < m_outputTemplateBricks.size(); i++) {
+            Brick *outputBrick = new Brick(*m_outputTemplateBricks[i]);
+            outputBrick->setpos(brickPosition);
+            outputBuffers.push_back(outputBrick);
+            result->bricks.push_back(outputBrick);
+          }
+
+          m_funct(inputBuffers, outputBuffers);
+          return result;
+        }
+
+      private:
+        vector<Cube *> m_inputCubes;            //!< The cubes to read from
+        vector<Brick *> m_inputTemplateBricks;  //!< Bricks shaped for the inputs
+        vector<Brick *> m_outputTemplateBricks; //!< Bricks shaped for the outputs
+        bool m_wraps;                           //!< Wrap smaller input cubes
+        //! The application function
+        void (*m_funct)(vector<Buffer *> &, vector<Buffer *> &);
+    };
+
+
+    /**
+     * Writes processed bricks to the output cubes. QtConcurrent calls this
+     *   from one thread at a time in brick order, so the cubes are written in
+     *   exactly the same sequence as the serial processing loop.
+     */
+    class OrderedBrickWriter {
+      public:
+        OrderedBrickWriter(const vector<Cube *> &outputCubes) :
+            m_outputCubes(outputCubes) {
+        }
+
+        void operator()(int &bricksWritten, const ProcessedBricksPtr &processed) {
+          for (unsigned int i = 0; i < m_outputCubes.size(); i++) {
+            m_outputCubes[i]->write(*processed->bricks[i]);
+          }
+          bricksWritten++;
+        }
+
+      private:
+        vector<Cube *> m_outputCubes; //!< The cubes to write to
+    };
+  }
+
+
   ProcessByBrick::ProcessByBrick() {
     p_inputBrickSamples.clear();
     p_inputBrickLines.clear();
@@ -27,6 +214,14 @@ namespace Isis {
     p_outputBrickSizeSet = false;
     p_wrapOption = false;
     p_reverse = false;
+
+    p_threaded = false;
+    PvlGroup &performancePrefs =
+        Preference::Preferences().findGroup("Performance");
+    if (performancePrefs.hasKeyword("ProcessByBrickThreading")) {
+      IString threadingPref = performancePrefs["ProcessByBrickThreading"][0];
+      p_threaded = (threadingPref.DownCase() == "always");
+    }
   }
 
 
@@ -421,6 +616,32 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
   }
 
 
+  /**
+   * Allows the function based StartProcess() methods to read and process
+   * bricks on multiple threads. Only enable this when the processing function
+   * is thread safe, i.e. it only works with the buffers it is given and does
+   * not modify shared state. Output bricks are written back in the same order
+   * as when processing serially. The default comes from the
+   * ProcessByBrickThreading keyword in the Performance preferences.
+   *
+   * @param threaded True to process bricks on multiple threads
+   */
+  void ProcessByBrick::SetThreaded(bool threaded) {
+    p_threaded = threaded;
+  }
+
+
+  /**
+   * Returns true if the function based StartProcess() methods may process
+   * bricks on multiple threads.
+   * @see SetThreaded()
+   * @return The value of the threading option
+   */
+  bool ProcessByBrick::Threaded() const {
+    return p_threaded;
+  }
+
+
   /**
    * Starts the systematic processing of the input cube by moving an arbitrarily-shaped
    * brick through the cube. This method requires that exactly one input
@@ -439,6 +660,19 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
 
     bool haveInput = PrepProcessCubeInPlace(&cube, &brick);
 
+    if (UseOrderedThreads()) {
+      vector<Cube *> outputCubes;
+      if ((!haveInput) || (cube->isReadWrite())) {
+        outputCubes.push_back(cube);
+      }
+
+      RunOrderedProcess(InPlaceBrickMapper(cube, brick, haveInput, funct),
+                        outputCubes, brick->Bricks());
+
+      delete brick;
+      return;
+    }
+
     // Loop and let the app programmer work with the bricks
     p_progress->SetMaximumSteps(brick->Bricks());
     p_progress->CheckStatus();
@@ -520,6 +754,17 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
 
     int numBricks = PrepProcessCube(&ibrick, &obrick);
 
+    if (UseOrderedThreads()) {
+      vector<Cube *> outputCubes(1, OutputCubes[0]);
+      RunOrderedProcess(
+          InputOutputBrickMapper(InputCubes[0], ibrick, obrick, funct),
+          outputCubes, numBricks);
+
+      delete ibrick;
+      delete obrick;
+      return;
+    }
+
     // Loop and let the app programmer work with the bricks
     p_progress->SetMaximumSteps(numBricks);
     p_progress->CheckStatus();
@@ -606,40 +851,47 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
 
     int numBricks = PrepProcessCubes(ibufs, obufs, imgrs, omgrs);
 
-    // Loop and let the app programmer process the bricks
-    p_progress->SetMaximumSteps(numBricks);
-    p_progress->CheckStatus();
+    if (UseOrderedThreads()) {
+      RunOrderedProcess(
+          MultipleCubeBrickMapper(InputCubes, imgrs, omgrs, Wraps(), funct),
+          OutputCubes, numBricks);
+    }
+    else {
+      // Loop and let the app programmer process the bricks
+      p_progress->SetMaximumSteps(numBricks);
+      p_progress->CheckStatus();
 
-    for(int t = 0; t < numBricks; t++) {
-      // Read the input buffers
-      for(unsigned int i = 0; i < InputCubes.size(); i++) {
-        InputCubes[i]->read(*ibufs[i]);
-      }
+      for(int t = 0; t < numBricks; t++) {
+        // Read the input buffers
+        for(unsigned int i = 0; i < InputCubes.size(); i++) {
+          InputCubes[i]->read(*ibufs[i]);
+        }
 
-      // Pass them to the application function
-      funct(ibufs, obufs);
+        // Pass them to the application function
+        funct(ibufs, obufs);
 
-      // And copy them into the output cubes
-      for(unsigned int i = 0; i < OutputCubes.size(); i++) {
-        OutputCubes[i]->write(*obufs[i]);
-        omgrs[i]->next();
-      }
+        // And copy them into the output cubes
+        for(unsigned int i = 0; i < OutputCubes.size(); i++) {
+          OutputCubes[i]->write(*obufs[i]);
+          omgrs[i]->next();
+        }
 
-      for(unsigned int i = 0; i < InputCubes.size(); i++) {
-        imgrs[i]->next();
+        for(unsigned int i = 0; i < InputCubes.size(); i++) {
+          imgrs[i]->next();
 
-        // if the manager has reached the end and the
-        // wrap option is on, wrap around to the beginning
-        if(Wraps() && imgrs[i]->end())
-          imgrs[i]->begin();
+          // if the manager has reached the end and the
+          // wrap option is on, wrap around to the beginning
+          if(Wraps() && imgrs[i]->end())
+            imgrs[i]->begin();
 
-        // Enforce same band
-        if(imgrs[i]->Band() != imgrs[0]->Band() &&
-           InputCubes[i]->bandCount() != 1) {
-          imgrs[i]->SetBaseBand(imgrs[0]->Band());
+          // Enforce same band
+          if(imgrs[i]->Band() != imgrs[0]->Band() &&
+             InputCubes[i]->bandCount() != 1) {
+            imgrs[i]->SetBaseBand(imgrs[0]->Band());
+          }
         }
+        p_progress->CheckStatus();
       }
-      p_progress->CheckStatus();
     }
 
     for(unsigned int i = 0; i < ibufs.size(); i++) {
@@ -791,6 +1043,47 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
   }
 
 
+  /**
+   * Returns true if the function based StartProcess() methods should run on
+   *   multiple threads. Threading has to be enabled and the global thread pool
+   *   has to have more than one thread available.
+   *
+   * @return True if bricks should be processed on multiple threads
+   */
+  bool ProcessByBrick::UseOrderedThreads() const {
+    return Threaded() && QThreadPool::globalInstance()->maxThreadCount() > 1;
+  }
+
+
+  /**
+   * Reads and processes bricks on the global thread pool and writes the
+   *   results to the output cubes in brick order. Reading and processing
+   *   happen in any order on any thread, but only one thread at a time writes
+   *   and the writes happen in the same sequence as the serial loop. This
+   *   method is a blocking call.
+   *
+   * @param mapFunctor A functor that reads and processes one brick position
+   *            and returns the bricks to write, parallel to outputCubes.
+   * @param outputCubes The cubes to write the processed bricks to.
+   * @param numSteps The number of brick positions to process.
+   */
+  template <typename MapFunctor>
+  void ProcessByBrick::RunOrderedProcess(const MapFunctor &mapFunctor,
+                                         const std::vector<Cube *> &outputCubes,
+                                         int numSteps) {
+    ProcessIterator begin(0);
+    ProcessIterator end(numSteps);
+
+    p_progress->SetMaximumSteps(numSteps);
+    p_progress->CheckStatus();
+
+    QFuture<void> result = QtConcurrent::mappedReduced<int>(begin, end,
+        mapFunctor, OrderedBrickWriter(outputCubes),
+        QtConcurrent::OrderedReduce | QtConcurrent::SequentialReduce);
+    BlockingReportProgress(result);
+  }
+
+
   /**
    * Calculates the maximum dimensions of all the cubes and returns them in a
    * vector where position 0 is the max sample, position 1 is the max line, and
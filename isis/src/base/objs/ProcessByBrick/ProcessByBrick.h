@@ -79,6 +79,10 @@ namespace Isis {
    *                          Fixes #4698.
    *   @history 2022-04-22 Jesse Mapel - Added std::function process method for multiple
    *                          input and output cubes.
+   *
+   * The function based StartProcess() methods can optionally process bricks
+   *   on multiple threads (see SetThreaded()). Bricks are still written to the
+   *   output cubes in the same order the serial loop writes them.
    */
   class ProcessByBrick : public Process {
     public:
@@ -131,6 +135,9 @@ namespace Isis {
       void SetWrap(bool wrap);
       bool Wraps();
 
+      void SetThreaded(bool threaded);
+      bool Threaded() const;
+
       using Isis::Process::StartProcess;  // make parents virtual function visable
       virtual void StartProcess(void funct(Buffer &in));
       virtual void StartProcess(std::function<void(Buffer &in)> funct );
@@ -730,6 +737,11 @@ namespace Isis {
 
 
       void BlockingReportProgress(QFuture<void> &future);
+      bool UseOrderedThreads() const;
+      template <typename MapFunctor>
+      void RunOrderedProcess(const MapFunctor &mapFunctor,
+                             const std::vector<Cube *> &outputCubes,
+                             int numSteps);
       std::vector<int> CalculateMaxDimensions(std::vector<Cube *> cubes) const;
       bool PrepProcessCubeInPlace(Cube **cube, Brick **bricks);
       int PrepProcessCube(Brick **ibrick, Brick **obrick);
@@ -819,6 +831,9 @@ namespace Isis {
                         objects when the Processing Direction is changed from
                         LinesFirst to BandsFirst*/
       bool p_wrapOption;    //!< Indicates whether the brick manager will wrap
+      bool p_threaded;      /**< Indicates whether the function based
+                                 StartProcess() methods may process bricks on
+                                 multiple threads*/
       bool p_inputBrickSizeSet;  /**< Indicates whether the brick size has been
                                       set*/
       bool p_outputBrickSizeSet; /**< Indicates whether the brick size has been
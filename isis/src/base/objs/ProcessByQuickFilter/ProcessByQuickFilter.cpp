@@ -6,6 +6,9 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "ProcessByQuickFilter.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "Application.h"
 #include "FilterCachingAlgorithm.h"
 #include "IException.h"
@@ -63,7 +66,6 @@ namespace Isis {
     }
 
     // Construct line buffer managers
-    Isis::LineManager *topline = new Isis::LineManager(*InputCubes[0]);
     Isis::LineManager *iline = new Isis::LineManager(*InputCubes[0]);
     Isis::LineManager *botline = new Isis::LineManager(*InputCubes[0]);
     Isis::LineManager *oline = new Isis::LineManager(*OutputCubes[0]);
@@ -93,44 +95,53 @@ namespace Isis {
     filter.SetMinMax(p_low, p_high);
     filter.SetMinimumPixels(p_minimum);
 
+    // The lines in the boxcar, oldest first. Lines leave the boxcar in the
+    //   order they were added, so keeping them means every input line is read
+    //   from the cube only once instead of being read again to remove it and
+    //   to process it.
+    int halfHeight = filter.HalfHeight();
+    vector< vector<double> > window(filter.Height(), vector<double>(samples));
+    int oldest = 0;
+    int newest = -1;
+
     // Loop for each band
     p_progress->SetMaximumSteps(lines * bands);
     p_progress->CheckStatus();
     for(int band = 1; band <= bands; band++) {
       // Preload the filter
       filter.Reset();
-      int top = 1 - filter.HalfHeight();
+      oldest = 0;
+      newest = -1;
       int bot;
-      for(bot = top; bot <= (1 + filter.HalfHeight()); bot++) {
+      for(bot = 1 - halfHeight; bot <= (1 + halfHeight); bot++) {
         int iline = bot;
         if(bot <= 0) iline = (-1 * bot + 2);
         botline->SetLine(iline, band);
         InputCubes[0]->read(*botline);
         filter.AddLine(botline->DoubleBuffer());
+
+        newest = (newest + 1) % filter.Height();
+        copy(botline->DoubleBuffer(), botline->DoubleBuffer() + samples,
+             window[newest].begin());
       }
-      bot = 1 + filter.HalfHeight() + 1;
+      bot = 1 + halfHeight + 1;
 
       // Loop for each line
       for(int line = 1; line <= lines; line++) {
-        // Process a line
+        // Process a line, which is the middle line of the boxcar
         iline->SetLine(line, band);
         oline->SetLine(line, band);
 
-        InputCubes[0]->read(*iline);
+        const vector<double> &middle = window[(oldest + halfHeight) % filter.Height()];
+        for(int i = 0; i < samples; i++) {
+          (*iline)[i] = middle[i];
+        }
         funct(*iline, *oline, filter);
         OutputCubes[0]->write(*oline);
 
         // Remove the top line
-        if(top >= 1) {
-          topline->SetLine(top, band);
-        }
-        else {
-          topline->SetLine(-1 * top + 2, band);
-        }
-
-        InputCubes[0]->read(*topline);
-        filter.RemoveLine(topline->DoubleBuffer());
-        top++;
+        filter.RemoveLine(&window[oldest][0]);
+        oldest = (oldest + 1) % filter.Height();
 
         // Add the next line
         p_progress->CheckStatus();
@@ -147,12 +158,15 @@ namespace Isis {
         filter.AddLine(botline->DoubleBuffer());
         bot++;
 
+        newest = (newest + 1) % filter.Height();
+        copy(botline->DoubleBuffer(), botline->DoubleBuffer() + samples,
+             window[newest].begin());
+
         // Update the progress
       }
     }
 
     // Free buffers before returning
-    delete topline;
     delete iline;
     delete botline;
     delete oline;
@@ -4,6 +4,8 @@ For more details about the LICENSE terms and the AUTHORS, you will
 find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
+#include <algorithm>
+
 #include "Preference.h"
 
 #include "Application.h"
@@ -64,11 +66,14 @@ namespace Isis {
     m_osl = -1;
     m_osb = -1;
     m_onb = -1;
+
+    m_batch = false;
   }
 
 
   //!  Destroys the Mosaic object. It will close all opened cubes.
   ProcessMosaic::~ProcessMosaic() {
+    CloseBatchCubes();
     if (m_trackingCube) {
       m_trackingCube->close();
       delete m_trackingCube;
@@ -110,6 +115,12 @@ namespace Isis {
       throw IException(IException::Programmer, m, _FILEINFO_);
     }
 
+    // Band priority compares against the mosaic as it is, so the inputs kept
+    // before it are placed first
+    if (m_imageOverlay == UseBandPlacementCriteria) {
+      PlaceBatch();
+    }
+
     bool bTrackExists = false;
     if (!m_createOutputMosaic) {
       bTrackExists = GetTrackStatus();
@@ -379,8 +390,28 @@ namespace Isis {
       }
     }
 
+    // Keep the input to place it with the rest of the batch
+    if (m_batch && m_imageOverlay != UseBandPlacementCriteria) {
+      BatchPlacement placement;
+      placement.cube = InputCubes[0];
+      // The batch closes the cube once it is placed, so Process must not
+      placement.ownsCube = m_ownedCubes->remove(InputCubes[0]);
+      placement.iss = iss;
+      placement.isl = isl;
+      placement.isb = isb;
+      placement.ins = ins;
+      placement.inl = inl;
+      placement.nb = std::min(inb, m_onb - m_osb + 1);
+      placement.oss = m_oss;
+      placement.osl = m_osl;
+      placement.osb = m_osb;
+      placement.onb = m_onb;
+      placement.trackingIndex = m_trackingEnabled ? iIndex : -1;
+      placement.create = m_createOutputMosaic;
+      m_batchPlacements.append(placement);
+    }
     // Process Band Priority with no tracking
-    if (m_imageOverlay == UseBandPlacementCriteria && !m_trackingEnabled ) {
+    else if (m_imageOverlay == UseBandPlacementCriteria && !m_trackingEnabled ) {
       BandPriorityWithNoTracking(iss, isl, isb, ins, inl, inb, bandPriorityInputBandNumber,
                                  bandPriorityOutputBandNumber);
     }
@@ -391,6 +422,13 @@ namespace Isis {
       Portal countPortal(ins, 1, OutputCubes[0]->pixelType());
       Portal trackingPortal(ins, 1, PixelType::UnsignedInteger);
 
+      // The comparison bands only depend on the line, so they are read once
+      // per line instead of once per pixel
+      bool compareBands = !m_createOutputMosaic && m_trackingEnabled &&
+                          m_imageOverlay == UseBandPlacementCriteria;
+      Portal iComparePortal(ins, 1, InputCubes[0]->pixelType());
+      Portal oComparePortal(ins, 1, OutputCubes[0]->pixelType());
+
       for (int ib = isb, ob = m_osb; ib < (isb + inb) && ob <= m_onb; ib++, ob++) {
         for (int il = isl, ol = m_osl; il < isl + inl; il++, ol++) {
           // Set the position of the portals in the input and output cubes
@@ -409,35 +447,24 @@ namespace Isis {
             OutputCubes[0]->read(countPortal);
           }
 
+          if (compareBands) {
+            iComparePortal.SetPosition(iss, il, bandPriorityInputBandNumber);
+            InputCubes[0]->read(iComparePortal);
+            oComparePortal.SetPosition(m_oss, ol, bandPriorityOutputBandNumber);
+            OutputCubes[0]->read(oComparePortal);
+          }
+
           bool bChanged = false;
+          // Lines of an existing mosaic that no input pixel is placed on are
+          // not written back
+          bool outputChanged = m_createOutputMosaic;
           // Move the input data to the output
           for (int pixel = 0; pixel < oPortal.size(); pixel++) {
-            // Creating Mosaic, copy the input onto mosaic
-            // regardless of the priority
-            if (m_createOutputMosaic) {
-              oPortal[pixel] = iPortal[pixel];
-              if (m_trackingEnabled) {
-                trackingPortal[pixel] = iIndex;
-                bChanged = true;
-              }
-              else if (m_imageOverlay == AverageImageWithMosaic) {
-                if (IsValidPixel(iPortal[pixel])) {
-                  countPortal[pixel]=1;
-                  bChanged = true;
-                }
-              }
-            }
             // Band Priority
-            else if (m_trackingEnabled && m_imageOverlay == UseBandPlacementCriteria) {
+            if (!m_createOutputMosaic && m_trackingEnabled &&
+                m_imageOverlay == UseBandPlacementCriteria) {
               int iPixelOrigin = qRound(trackingPortal[pixel]);
 
-              Portal iComparePortal( ins, 1, InputCubes[0]->pixelType() );
-              Portal oComparePortal( ins, 1, OutputCubes[0]->pixelType() );
-              iComparePortal.SetPosition(iss, il, bandPriorityInputBandNumber);
-              InputCubes[0]->read(iComparePortal);
-              oComparePortal.SetPosition(m_oss, ol, bandPriorityOutputBandNumber);
-              OutputCubes[0]->read(oComparePortal);
-
               if (iPixelOrigin == iIndex) {
                 if ( ( IsValidPixel(iComparePortal[pixel]) &&
                        IsValidPixel(oComparePortal[pixel]) ) &&
@@ -452,6 +479,7 @@ namespace Isis {
                        ( m_placeNullPixels    && IsNullPixel(iPortal[pixel]) ) ){
                     oPortal[pixel] = iPortal[pixel];
                     bChanged = true;
+                    outputChanged = true;
                   }
                 }
                 else { //bad comparison
@@ -461,39 +489,16 @@ namespace Isis {
                        ( m_placeNullPixels    && IsNullPixel(iPortal[pixel]) ) ) {
                     oPortal[pixel] = iPortal[pixel];
                     bChanged = true;
+                    outputChanged = true;
                   }
                 }
               }
             }
-            // OnTop/Input Priority
-            else if (m_imageOverlay == PlaceImagesOnTop) {
-              if (IsNullPixel(oPortal[pixel])  ||
-                 IsValidPixel(iPortal[pixel]) ||
-                 (m_placeHighSatPixels && IsHighPixel(iPortal[pixel])) ||
-                 (m_placeLowSatPixels  && IsLowPixel(iPortal[pixel]))  ||
-                 (m_placeNullPixels    && IsNullPixel(iPortal[pixel]))) {
-                oPortal[pixel] = iPortal[pixel];
-                if (m_trackingEnabled) {
-                  trackingPortal[pixel] = iIndex;
-                  bChanged = true;
-                }
-              }
-            }
-            // AverageImageWithMosaic priority
-            else if (m_imageOverlay == AverageImageWithMosaic) {
-              bChanged |= ProcessAveragePriority(pixel, iPortal, oPortal, countPortal);
-            }
-            // Beneath/Mosaic Priority
-            else if (m_imageOverlay == PlaceImagesBeneath) {
-              if (IsNullPixel(oPortal[pixel])) {
-                oPortal[pixel] = iPortal[pixel];
-                // Set the origin if number of input bands equal to 1
-                // and if the track flag was set
-                if (m_trackingEnabled) {
-                  trackingPortal[pixel] = iIndex;
-                  bChanged = true;
-                }
-              }
+            // Creating, OnTop, Beneath and Average Priority
+            else if (PlacePixel(iPortal[pixel], oPortal[pixel], countPortal[pixel],
+                                trackingPortal[pixel], m_trackingEnabled ? iIndex : -1,
+                                m_createOutputMosaic, bChanged)) {
+              outputChanged = true;
             }
           } // End sample loop
           if (bChanged) {
@@ -504,7 +509,9 @@ namespace Isis {
               OutputCubes[0]->write(countPortal);
             }
           }
-          OutputCubes[0]->write(oPortal);
+          if (outputChanged) {
+            OutputCubes[0]->write(oPortal);
+          }
           p_progress->CheckStatus();
         } // End line loop
       }   // End band loop
@@ -514,13 +521,20 @@ namespace Isis {
       delete m_trackingCube;
       m_trackingCube = NULL;
     }
+
+    // Limit the number of input cubes the batch keeps open
+    if (m_batchPlacements.size() >= MAX_BATCH_PLACEMENTS) {
+      PlaceBatch();
+    }
   } // End StartProcess
 
 
   /**
-   * Cleans up by closing input, output and tracking cubes
+   * Cleans up by closing input, output and tracking cubes. Inputs kept while
+   * batching are placed on the mosaic first.
    */
   void ProcessMosaic::EndProcess() {
+    EndBatch();
     if (m_trackingCube) {
       m_trackingCube->close();
       delete m_trackingCube;
@@ -530,6 +544,166 @@ namespace Isis {
   }
 
 
+  /**
+   * Starts keeping the inputs given to StartProcess() so that EndBatch() can
+   * place them on the mosaic together. The labels of the mosaic and tracking
+   * cube are still updated by StartProcess(), but the pixels of the inputs are
+   * not placed until EndBatch() is called. Band priority inputs are placed
+   * right away.
+   */
+  void ProcessMosaic::StartBatch() {
+    m_batch = true;
+  }
+
+
+  /**
+   * Places the inputs kept since StartBatch() on the mosaic and stops keeping
+   * inputs.
+   */
+  void ProcessMosaic::EndBatch() {
+    PlaceBatch();
+    m_batch = false;
+  }
+
+
+  /**
+   * Places the inputs kept while batching on the mosaic. Each line of the
+   * mosaic is read once, every input that is on the line is placed on it in
+   * the order the inputs were given to StartProcess(), and the line is written
+   * once if any of them changed it. This gives the same mosaic as placing the
+   * inputs one at a time, because each pixel only depends on the pixel already
+   * in the mosaic.
+   *
+   * @throws IException::User "Unable to mosaic cube"
+   */
+  void ProcessMosaic::PlaceBatch() {
+    if (m_batchPlacements.isEmpty()) {
+      return;
+    }
+
+    Cube *mosaic = OutputCubes[0];
+    bool averaging = (m_imageOverlay == AverageImageWithMosaic);
+    bool tracking = false;
+    int firstLine = mosaic->lineCount();
+    int lastLine = 1;
+    int lastBand = 1;
+    foreach (const BatchPlacement &placement, m_batchPlacements) {
+      tracking |= (placement.trackingIndex != -1);
+      firstLine = std::min(firstLine, placement.osl);
+      lastLine = std::max(lastLine, placement.osl + placement.inl - 1);
+      lastBand = std::max(lastBand, placement.osb + placement.nb - 1);
+    }
+
+    Cube trackingCube;
+    if (tracking) {
+      QString trackingPath = FileName(mosaic->fileName()).path();
+      QString trackingFile = mosaic->group("Tracking").findKeyword("FileName")[0];
+      trackingCube.open(trackingPath + "/" + trackingFile, "rw");
+    }
+
+    p_progress->SetText("Placing " + toString(m_batchPlacements.size()) + " images");
+    p_progress->SetMaximumSteps(lastBand * (lastLine - firstLine + 1));
+    p_progress->CheckStatus();
+
+    for (int ob = 1; ob <= lastBand; ob++) {
+      for (int ol = firstLine; ol <= lastLine; ol++) {
+        // Find the inputs on this line and the samples they cover
+        QList<const BatchPlacement *> placements;
+        int firstSample = mosaic->sampleCount();
+        int lastSample = 1;
+        for (int i = 0; i < m_batchPlacements.size(); i++) {
+          const BatchPlacement &placement = m_batchPlacements.at(i);
+          if (ol >= placement.osl && ol < placement.osl + placement.inl &&
+              ob >= placement.osb && ob < placement.osb + placement.nb) {
+            placements.append(&placement);
+            firstSample = std::min(firstSample, placement.oss);
+            lastSample = std::max(lastSample, placement.oss + placement.ins - 1);
+          }
+        }
+
+        if (placements.isEmpty()) {
+          p_progress->CheckStatus();
+          continue;
+        }
+
+        int ns = lastSample - firstSample + 1;
+        Portal oPortal(ns, 1, mosaic->pixelType());
+        oPortal.SetPosition(firstSample, ol, ob);
+        mosaic->read(oPortal);
+
+        Portal countPortal(ns, 1, mosaic->pixelType());
+        if (averaging) {
+          countPortal.SetPosition(firstSample, ol, ob + placements[0]->onb);
+          mosaic->read(countPortal);
+        }
+
+        Portal trackingPortal(ns, 1, PixelType::UnsignedInteger);
+        if (tracking) {
+          trackingPortal.SetPosition(firstSample, ol, 1);
+          trackingCube.read(trackingPortal);
+        }
+
+        bool outputChanged = false;
+        bool countOrTrackingChanged = false;
+        foreach (const BatchPlacement *placement, placements) {
+          Portal iPortal(placement->ins, 1, placement->cube->pixelType());
+          iPortal.SetPosition(placement->iss, placement->isl + ol - placement->osl,
+                              placement->isb + ob - placement->osb);
+          try {
+            placement->cube->read(iPortal);
+          }
+          catch (IException &e) {
+            QString msg = "Unable to mosaic cube [" +
+                          FileName(placement->cube->fileName()).name() + "]";
+            throw IException(e, IException::User, msg, _FILEINFO_);
+          }
+
+          int offset = placement->oss - firstSample;
+          for (int pixel = 0; pixel < iPortal.size(); pixel++) {
+            if (PlacePixel(iPortal[pixel], oPortal[offset + pixel], countPortal[offset + pixel],
+                           trackingPortal[offset + pixel], placement->trackingIndex,
+                           placement->create, countOrTrackingChanged)) {
+              outputChanged = true;
+            }
+          }
+        }
+
+        if (countOrTrackingChanged) {
+          if (tracking) {
+            trackingCube.write(trackingPortal);
+          }
+          if (averaging) {
+            mosaic->write(countPortal);
+          }
+        }
+        if (outputChanged) {
+          mosaic->write(oPortal);
+        }
+        p_progress->CheckStatus();
+      }
+    }
+
+    if (tracking) {
+      trackingCube.close();
+    }
+    CloseBatchCubes();
+  }
+
+
+  /**
+   * Closes the input cubes kept while batching and forgets the inputs.
+   */
+  void ProcessMosaic::CloseBatchCubes() {
+    foreach (const BatchPlacement &placement, m_batchPlacements) {
+      if (placement.ownsCube) {
+        placement.cube->close();
+        delete placement.cube;
+      }
+    }
+    m_batchPlacements.clear();
+  }
+
+
   /**
    * Accessor for the placed images and their locations.
    *
@@ -1027,41 +1201,40 @@ namespace Isis {
 
   /**
    * Calculate DN value for a pixel for AverageImageWithMosaic priority and set the
-   * Count band portal
+   * Count band pixel
    *
    * @author Sharmila Prasad (1/13/2011)
    *
-   * @param piPixel     - Pixel index
-   * @param piPortal    - Input Portal
-   * @param poPortal    - Output Portal
-   * @param countPortal - Count Portal
+   * @param inPixel    - Input pixel
+   * @param outPixel   - Output pixel
+   * @param countPixel - Count band pixel
    *
    * @return bool
    */
-  bool ProcessMosaic::ProcessAveragePriority(int piPixel, Portal& piPortal, Portal& poPortal,
-                                             Portal& countPortal)
+  bool ProcessMosaic::ProcessAveragePriority(double inPixel, double &outPixel,
+                                             double &countPixel)
   {
     bool bChanged=false;
-    if (IsValidPixel(piPortal[piPixel]) && IsValidPixel(poPortal[piPixel])) {
-      int iCount = (int)countPortal[piPixel];
-      double dNewDN = (poPortal[piPixel] * iCount + piPortal[piPixel]) / (iCount + 1);
-      poPortal[piPixel] = dNewDN;
-      countPortal[piPixel] =iCount +1;
+    if (IsValidPixel(inPixel) && IsValidPixel(outPixel)) {
+      int iCount = (int)countPixel;
+      double dNewDN = (outPixel * iCount + inPixel) / (iCount + 1);
+      outPixel = dNewDN;
+      countPixel =iCount +1;
       bChanged = true;
     }
     // Input-Valid, Mosaic-Special
-    else if (IsValidPixel(piPortal[piPixel])) {
-      poPortal[piPixel] = piPortal[piPixel];
-      countPortal[piPixel] = 1;
+    else if (IsValidPixel(inPixel)) {
+      outPixel = inPixel;
+      countPixel = 1;
       bChanged = true;
     }
     // Input-Special, Flags-True
-    else if (IsSpecial(piPortal[piPixel])) {
-      if ((m_placeHighSatPixels && IsHighPixel(piPortal[piPixel])) ||
-         (m_placeLowSatPixels  && IsLowPixel (piPortal[piPixel]))  ||
-         (m_placeNullPixels    && IsNullPixel(piPortal[piPixel]))) {
-        poPortal[piPixel]    = piPortal[piPixel];
-        countPortal[piPixel] = 0;
+    else if (IsSpecial(inPixel)) {
+      if ((m_placeHighSatPixels && IsHighPixel(inPixel)) ||
+         (m_placeLowSatPixels  && IsLowPixel (inPixel))  ||
+         (m_placeNullPixels    && IsNullPixel(inPixel))) {
+        outPixel    = inPixel;
+        countPixel = 0;
         bChanged = true;
       }
     }
@@ -1069,6 +1242,81 @@ namespace Isis {
   }
 
 
+  /**
+   * Places an input pixel on a mosaic pixel with the ontop, beneath or average
+   * priority, or copies it onto a mosaic that is being created.
+   *
+   * @param inPixel The input pixel
+   * @param outPixel The mosaic pixel
+   * @param countPixel The count band pixel when averaging
+   * @param trackingPixel The tracking cube pixel
+   * @param trackingIndex The tracking index of the input, or -1 without tracking
+   * @param create If the mosaic is being created
+   * @param countOrTrackingChanged Set to true when the count or tracking pixel
+   *                               changes
+   *
+   * @return @b bool True if the mosaic pixel was placed
+   */
+  bool ProcessMosaic::PlacePixel(double inPixel, double &outPixel, double &countPixel,
+                                 double &trackingPixel, int trackingIndex, bool create,
+                                 bool &countOrTrackingChanged) {
+    bool tracking = (trackingIndex != -1);
+
+    // Creating Mosaic, copy the input onto mosaic
+    // regardless of the priority
+    if (create) {
+      outPixel = inPixel;
+      if (tracking) {
+        trackingPixel = trackingIndex;
+        countOrTrackingChanged = true;
+      }
+      else if (m_imageOverlay == AverageImageWithMosaic) {
+        if (IsValidPixel(inPixel)) {
+          countPixel = 1;
+          countOrTrackingChanged = true;
+        }
+      }
+      return true;
+    }
+    // OnTop/Input Priority
+    else if (m_imageOverlay == PlaceImagesOnTop) {
+      if (IsNullPixel(outPixel)  ||
+         IsValidPixel(inPixel) ||
+         (m_placeHighSatPixels && IsHighPixel(inPixel)) ||
+         (m_placeLowSatPixels  && IsLowPixel(inPixel))  ||
+         (m_placeNullPixels    && IsNullPixel(inPixel))) {
+        outPixel = inPixel;
+        if (tracking) {
+          trackingPixel = trackingIndex;
+          countOrTrackingChanged = true;
+        }
+        return true;
+      }
+    }
+    // AverageImageWithMosaic priority
+    else if (m_imageOverlay == AverageImageWithMosaic) {
+      if (ProcessAveragePriority(inPixel, outPixel, countPixel)) {
+        countOrTrackingChanged = true;
+        return true;
+      }
+    }
+    // Beneath/Mosaic Priority
+    else if (m_imageOverlay == PlaceImagesBeneath) {
+      if (IsNullPixel(outPixel)) {
+        outPixel = inPixel;
+        // Set the origin if number of input bands equal to 1
+        // and if the track flag was set
+        if (tracking) {
+          trackingPixel = trackingIndex;
+          countOrTrackingChanged = true;
+        }
+        return true;
+      }
+    }
+    return false;
+  }
+
+
   /**
    *  This method matches the input BandBin group to the mosaic BandBin Group
    *  and allows band to be replaced in mosaic if it is NA (not assigned).
@@ -1408,9 +1656,6 @@ void ProcessMosaic::BandPriorityWithNoTracking(int iss, int isl, int isb, int in
       oComparePortal.SetPosition(m_oss, outLine, bandPriorityOutputBandNumber);
       OutputCubes[0]->read(oComparePortal);
 
-      Portal iPortal( ins, 1, InputCubes[0]->pixelType() );
-      Portal oPortal( ins, 1, OutputCubes[0]->pixelType() );
-
       bool inCopy = false;
 //       Move the input data to the output
       for (int iPixel = 0; iPixel < ins; iPixel++) {
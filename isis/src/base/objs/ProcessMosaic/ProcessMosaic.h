@@ -6,6 +6,8 @@ For more details about the LICENSE terms and the AUTHORS, you will
 find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
+#include <QList>
+
 #include "Process.h"
 
 namespace Isis {
@@ -86,6 +88,14 @@ namespace Isis {
    *  T OR T OR  T     V      V      Criteria based
    *  T OR T OR  T     V      S      I
    *
+   * Applications that place many inputs on one mosaic, like automos, can call
+   * StartBatch() before placing them. StartProcess() then checks each input and
+   * updates the mosaic and tracking labels as usual, but keeps the input open
+   * instead of copying it onto the mosaic. EndBatch() copies all of the kept
+   * inputs in one pass over the mosaic, reading and writing each mosaic line
+   * once for every input on it, in the order the inputs were placed. Band
+   * priority is not batched, and places any kept inputs before its own.
+   *
    * For priority=average, following is the criteria for pixel assignment:
    * -----------------------------------------------------
    * ---Options---   ---Images----
@@ -196,6 +206,9 @@ namespace Isis {
     public:
       static const char *TRACKING_TABLE_NAME;
 
+      //! The number of inputs kept in a batch before they are placed on the mosaic
+      static const int MAX_BATCH_PLACEMENTS = 100;
+
       // see http://blog.stata.com/tag/binary/
       static const int FLOAT_STORE_INT_PRECISELY_MAX_VALUE = 16777216;
       static const int FLOAT_STORE_INT_PRECISELY_MIN_VALUE = -16777215;
@@ -226,6 +239,10 @@ namespace Isis {
       // Finish with tracking cube
       virtual void EndProcess();
 
+      // Place inputs on the mosaic in batches
+      void StartBatch();
+      void EndBatch();
+
       // Accessor for the placed images.
       PvlObject imagePositions();
 
@@ -313,8 +330,14 @@ namespace Isis {
       // Mosaic exists, match the band with the input image
       void MatchBandBinGroup(int origIsb, int &inb);
 
-      bool ProcessAveragePriority(int piPixel, Portal& pInPortal, Portal& pOutPortal,
-                                  Portal& pOrigPortal);
+      bool ProcessAveragePriority(double inPixel, double &outPixel, double &countPixel);
+
+      bool PlacePixel(double inPixel, double &outPixel, double &countPixel,
+                      double &trackingPixel, int trackingIndex, bool create,
+                      bool &countOrTrackingChanged);
+
+      void PlaceBatch();
+      void CloseBatchCubes();
 
       void ResetCountBands();
 
@@ -360,6 +383,30 @@ namespace Isis {
       bool m_placeHighSatPixels; //!<
       bool m_placeLowSatPixels;  //!<
       bool m_placeNullPixels;    //!<
+
+      /**
+       * An input kept by StartProcess() while batching, which PlaceBatch()
+       * copies onto the mosaic.
+       */
+      struct BatchPlacement {
+        Cube *cube;        //!< The input cube
+        bool ownsCube;     //!< If the input cube is closed once it is placed
+        int iss;           //!< The starting sample within the input cube
+        int isl;           //!< The starting line within the input cube
+        int isb;           //!< The starting band within the input cube
+        int ins;           //!< The number of samples from the input cube
+        int inl;           //!< The number of lines from the input cube
+        int nb;            //!< The number of bands placed on the mosaic
+        int oss;           //!< The starting sample within the mosaic
+        int osl;           //!< The starting line within the mosaic
+        int osb;           //!< The starting band within the mosaic
+        int onb;           //!< The number of mosaic bands, not counting count bands
+        int trackingIndex; //!< The tracking index of the input, or -1 without tracking
+        bool create;       //!< If the input is copied onto a new mosaic
+      };
+
+      bool m_batch; //!< If inputs are kept and placed by EndBatch()
+      QList<BatchPlacement> m_batchPlacements; //!< The inputs kept while batching
   };
 };
 
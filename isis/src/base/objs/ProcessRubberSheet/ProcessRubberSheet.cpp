@@ -8,12 +8,22 @@ find files of those names at the top level of this repository. **/
 #include <iomanip>
 #include <algorithm>
 
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSharedPointer>
+#include <QThread>
+#include <QThreadPool>
 #include <QVector>
+#include <QtConcurrentMap>
 
 #include "Affine.h"
 #include "BasisFunction.h"
 #include "BoxcarCachingAlgorithm.h"
 #include "Brick.h"
+#include "Buffer.h"
+#include "IException.h"
+#include "IString.h"
 #include "Interpolator.h"
 #include "LeastSquares.h"
 #include "Portal.h"
@@ -49,9 +59,33 @@ namespace Isis {
     m_patchLines = 5;
     m_patchSampleIncrement = 4;
     m_patchLineIncrement = 4;
+
+    m_createTransform = NULL;
   };
 
 
+  /**
+   * Enables processing output tiles in parallel in StartProcess(). A
+   * Transform usually keeps the state of its last conversion (e.g. a camera
+   * or projection), so a single instance cannot be shared between threads.
+   * The factory is called once for every thread that processes tiles and
+   * must return a new Transform equivalent to the one given to
+   * StartProcess(). This object takes ownership of the returned transforms
+   * and deletes them when StartProcess() finishes. Calls to the factory are
+   * never made concurrently.
+   *
+   * Tiles are only processed in parallel when no BandChange() function is
+   * registered and the global thread pool has more than one thread.
+   *
+   * @param createTransform Function that creates a new Transform, or NULL to
+   *                        always process tiles serially
+   */
+  void ProcessRubberSheet::setTransformFactory(
+      std::function<Transform *()> createTransform) {
+    m_createTransform = createTransform;
+  }
+
+
   /**
    * This method allows the programmer to override the default values for patch
    * parameters used in the patch transform method (processPatchTransform)
@@ -159,6 +193,14 @@ namespace Isis {
                          InputCubes[0]->pixelType() ,
                          interp.HotSample(), interp.HotLine());
 
+    if (p_bandChangeFunct == NULL && m_createTransform &&
+        QThreadPool::globalInstance()->maxThreadCount() > 1) {
+      processTilesThreaded(interp, otile.Tiles() / OutputCubes[0]->bandCount());
+      p_sampMap.clear();
+      p_lineMap.clear();
+      return;
+    }
+
     // Start the progress meter
     p_progress->SetMaximumSteps(otile.Tiles());
     p_progress->CheckStatus();
@@ -181,7 +223,8 @@ namespace Isis {
             SlowGeom(otile, iportal, trans, interp);
           }
           else {
-            QuadTree(otile, iportal, trans, interp, useLastTileMap);
+            QuadTree(otile, iportal, trans, interp, useLastTileMap,
+                     p_lineMap, p_sampMap);
           }
 
           useLastTileMap = true;
@@ -206,7 +249,7 @@ namespace Isis {
           SlowGeom(otile, iportal, trans, interp);
         }
         else {
-          QuadTree(otile, iportal, trans, interp, false);
+          QuadTree(otile, iportal, trans, interp, false, p_lineMap, p_sampMap);
         }
 
         OutputCubes[0]->write(otile);
@@ -219,6 +262,152 @@ namespace Isis {
   }
 
 
+  namespace {
+    /**
+     * The output tiles of every band at one tile position, held until every
+     * earlier tile position has been written to the output cube.
+     */
+    class ProcessedTiles {
+      public:
+        ~ProcessedTiles() {
+          for (unsigned int i = 0; i < tiles.size(); i++) {
+            delete tiles[i];
+          }
+        }
+
+        //! One output tile for each band, in band order
+        vector<Buffer *> tiles;
+    };
+  }
+
+
+  /**
+   * The parallel version of the output driven tile algorithm in
+   * StartProcess(). Each tile position (all bands) is a unit of work. Worker
+   * threads compute the tile map with their own Transform from the factory,
+   * interpolate the tiles and hand them back; tiles are then written to the
+   * output cube one at a time in the same order as the serial algorithm.
+   *
+   * @param interp The interpolator. Interpolating does not modify it, so it is
+   *               shared by all threads.
+   * @param tilesPerBand The number of output tiles in one band
+   */
+  void ProcessRubberSheet::processTilesThreaded(Interpolator &interp,
+                                                long long tilesPerBand) {
+    Cube *inputCube = InputCubes[0];
+    Cube *outputCube = OutputCubes[0];
+    int threadCount = QThreadPool::globalInstance()->maxThreadCount();
+
+    // Every thread reads a different part of the input, so keep enough chunks
+    //   around for all of them
+    inputCube->addCachingAlgorithm(
+        new UniqueIOCachingAlgorithm(2 * inputCube->bandCount() * threadCount));
+    outputCube->addCachingAlgorithm(new BoxcarCachingAlgorithm());
+
+    QMutex transformsMutex;
+    QHash<Qt::HANDLE, Transform *> transforms;
+    QList<IException> errors;
+
+    bool useSlowGeom = p_startQuadSize <= 2 ||
+        min(outputCube->lineCount(), outputCube->sampleCount()) <= p_startQuadSize;
+
+    typedef QSharedPointer<ProcessedTiles> ProcessedTilesPtr;
+
+    std::function<ProcessedTilesPtr(const long long &)> processTile =
+        [&](const long long &tile) -> ProcessedTilesPtr {
+      ProcessedTilesPtr result(new ProcessedTiles);
+
+      try {
+        Transform *trans = NULL;
+        {
+          QMutexLocker locker(&transformsMutex);
+          Qt::HANDLE threadId = QThread::currentThreadId();
+          trans = transforms.value(threadId, NULL);
+          if (!trans) {
+            trans = m_createTransform();
+            transforms.insert(threadId, trans);
+          }
+        }
+
+        TileManager otile(*outputCube, p_startQuadSize, p_startQuadSize);
+        Portal iportal(interp.Samples(), interp.Lines(), inputCube->pixelType(),
+                       interp.HotSample(), interp.HotLine());
+
+        vector< vector<double> > lineMap(p_startQuadSize,
+                                         vector<double>(p_startQuadSize));
+        vector< vector<double> > sampMap(p_startQuadSize,
+                                         vector<double>(p_startQuadSize));
+
+        bool useLastTileMap = false;
+        for (int band = 1; band <= outputCube->bandCount(); band++) {
+          otile.SetTile(tile, band);
+
+          if (useSlowGeom) {
+            SlowGeom(otile, iportal, *trans, interp);
+          }
+          else {
+            QuadTree(otile, iportal, *trans, interp, useLastTileMap,
+                     lineMap, sampMap);
+          }
+          useLastTileMap = true;
+
+          result->tiles.push_back(new Buffer(otile));
+        }
+      }
+      catch (IException &e) {
+        QMutexLocker locker(&transformsMutex);
+        errors.append(e);
+        result = ProcessedTilesPtr(new ProcessedTiles);
+      }
+
+      return result;
+    };
+
+    std::function<void(int &, const ProcessedTilesPtr &)> writeTiles =
+        [outputCube](int &tilesWritten, const ProcessedTilesPtr &processed) {
+      // Tiles that failed to process are left out and reported afterwards
+      for (unsigned int i = 0; i < processed->tiles.size(); i++) {
+        outputCube->write(*processed->tiles[i]);
+        tilesWritten++;
+      }
+    };
+
+    QVector<long long> tiles;
+    tiles.reserve(tilesPerBand);
+    for (long long tile = 1; tile <= tilesPerBand; tile++) {
+      tiles.append(tile);
+    }
+
+    p_progress->SetMaximumSteps(tilesPerBand);
+    p_progress->CheckStatus();
+
+    QFuture<int> future = QtConcurrent::mappedReduced<int>(tiles, processTile,
+        writeTiles, QtConcurrent::OrderedReduce | QtConcurrent::SequentialReduce);
+
+    // Translate the progress of the future into Isis progress
+    int reportedProgress = 0;
+    while (!future.isFinished()) {
+      QThread::msleep(100);
+      while (reportedProgress < future.progressValue()) {
+        p_progress->CheckStatus();
+        reportedProgress++;
+      }
+    }
+    while (reportedProgress < future.progressValue()) {
+      p_progress->CheckStatus();
+      reportedProgress++;
+    }
+
+    qDeleteAll(transforms);
+
+    if (!errors.isEmpty()) {
+      QString msg = "Unable to transform [" + toString(errors.size()) +
+                    "] output tiles";
+      throw IException(errors.first(), IException::Programmer, msg, _FILEINFO_);
+    }
+  }
+
+
   /**
    * Registers a function to be called when the current output cube band number
    * changes. This includes the first time. If and application does NOT need to
@@ -270,7 +459,9 @@ namespace Isis {
 
   void ProcessRubberSheet::QuadTree(TileManager &otile, Portal &iportal,
                                     Transform &trans, Interpolator &interp,
-                                    bool useLastTileMap) {
+                                    bool useLastTileMap,
+                                    vector< vector<double> > &lineMap,
+                                    vector< vector<double> > &sampMap) {
 
     // Initializations
     vector<Quad *> quadTree;
@@ -291,7 +482,7 @@ namespace Isis {
       // Loop and compute the input coordinates filling the maps
       // until the quad tree is empty
       while (quadTree.size() > 0) {
-        ProcessQuad(quadTree, trans, p_lineMap, p_sampMap);
+        ProcessQuad(quadTree, trans, lineMap, sampMap);
       }
     }
 
@@ -299,8 +490,8 @@ namespace Isis {
     int outputBand = otile.Band();
     for (int i = 0, line = 0; line < p_startQuadSize; line++) {
       for (int samp = 0; samp < p_startQuadSize; samp++, i++) {
-        double inputLine = p_lineMap[line][samp];
-        double inputSamp = p_sampMap[line][samp];
+        double inputLine = lineMap[line][samp];
+        double inputSamp = sampMap[line][samp];
         if (inputLine != NULL8) {
           iportal.SetPosition(inputSamp, inputLine, outputBand);
           InputCubes[0]->read(iportal);
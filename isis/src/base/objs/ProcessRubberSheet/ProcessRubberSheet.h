@@ -8,6 +8,8 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "Process.h"
 #include "Buffer.h"
+#include <functional>
+
 #include "Transform.h"
 #include "Interpolator.h"
 #include "Portal.h"
@@ -98,6 +100,11 @@ namespace Isis {
    *   @history 2017-06-09 Christopher Combs - Changed loop counter int in
                                StartProcess to long long int. References #4611.
    *
+   * If a transform factory is set with setTransformFactory(), StartProcess()
+   * spreads the output tiles over the global threads. Each thread gets its own
+   * Transform from the factory and the finished tiles are written to the
+   * output cube in the same order as the serial algorithm.
+   *
    *   @todo 2005-02-11 Stuart Sides - finish documentation and add coded and
    *                        implementation example to class documentation
    */
@@ -141,6 +148,8 @@ namespace Isis {
                                 int samples, int lines,
                                 int sampleIncrement, int lineIncrement);
 
+      void setTransformFactory(std::function<Transform *()> createTransform);
+
 
     private:
 
@@ -175,7 +184,11 @@ namespace Isis {
                     Transform &trans, Interpolator &interp);
       void QuadTree(TileManager &otile, Portal &iportal,
                     Transform &trans, Interpolator &interp,
-                    bool useLastTileMap);
+                    bool useLastTileMap,
+                    std::vector< std::vector<double> > &lineMap,
+                    std::vector< std::vector<double> > &sampMap);
+
+      void processTilesThreaded(Interpolator &interp, long long tilesPerBand);
 
       bool TestLine(Transform &trans, int ssamp, int esamp, int sline,
                     int eline, int increment);
@@ -213,6 +226,9 @@ namespace Isis {
       int m_patchSampleIncrement;
       int m_patchLineIncrement;
 
+      //! Creates a Transform for each thread when processing tiles in parallel
+      std::function<Transform *()> m_createTransform;
+
 #if 0
       Portal *m_iportal;
       Brick *m_obrick;
@@ -10,6 +10,7 @@ find files of those names at the top level of this repository. **/
 #include <cfloat>
 #include <cmath>
 #include <iomanip>
+#include <vector>
 
 #include "Camera.h"
 #include "Cube.h"
@@ -663,8 +664,31 @@ namespace Isis {
 
         // Loop for each line testing the left and right sides of the image
         for(int line = 0; line <= cam.Lines(); line++) {
+          // The first and last lines are tested across the whole line, so all
+          // of their points are mapped to the ground in one call
+          if (line == 0 || line == cam.Lines()) {
+            vector<double> samples, lines, lats, lons;
+            vector<bool> valid;
+            for(int samp = 0; samp <= cam.Samples(); samp++) {
+              samples.push_back((double)samp + 0.5);
+              lines.push_back((double)line + 0.5);
+            }
+
+            cam.SetImages(samples, lines, lats, lons, valid);
+            for(unsigned int i = 0; i < valid.size(); i++) {
+              if (!valid[i]) continue;
+              proj->SetUniversalGround(lats[i], lons[i]);
+              if (proj->IsGood()) {
+                if (proj->XCoord() < minX) minX = proj->XCoord();
+                if (proj->XCoord() > maxX) maxX = proj->XCoord();
+                if (proj->YCoord() < minY) minY = proj->YCoord();
+                if (proj->YCoord() > maxY) maxY = proj->YCoord();
+              }
+            }
+            continue;
+          }
+
           // Look for the first good lat/lon on the left edge of the image
-          // If it is the first or last line then test the whole line
           int samp;
           for(samp = 0; samp <= cam.Samples(); samp++) {
             if (cam.SetImage((double)samp + 0.5, (double)line + 0.5)) {
@@ -676,7 +700,7 @@ namespace Isis {
                 if (proj->XCoord() > maxX) maxX = proj->XCoord();
                 if (proj->YCoord() < minY) minY = proj->YCoord();
                 if (proj->YCoord() > maxY) maxY = proj->YCoord();
-                if ((line != 0) && (line != cam.Lines())) break;
+                break;
               }
             }
           }
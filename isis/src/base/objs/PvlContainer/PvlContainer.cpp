@@ -351,8 +351,10 @@ namespace Isis {
   PvlContainer::PvlKeywordIterator PvlContainer::findKeyword(const QString &name,
       PvlContainer::PvlKeywordIterator beg,
       PvlContainer::PvlKeywordIterator end) {
-    PvlKeyword temp(name);
-    return find(beg, end, temp);
+    while (beg != end && !beg->isNamed(name)) {
+      ++beg;
+    }
+    return beg;
   };
 
 
@@ -366,8 +368,10 @@ namespace Isis {
   PvlContainer::ConstPvlKeywordIterator PvlContainer::findKeyword(const QString &name,
       PvlContainer::ConstPvlKeywordIterator beg,
       PvlContainer::ConstPvlKeywordIterator end) const {
-    PvlKeyword temp(name);
-    return find(beg, end, temp);
+    while (beg != end && !beg->isNamed(name)) {
+      ++beg;
+    }
+    return beg;
   };
 
 
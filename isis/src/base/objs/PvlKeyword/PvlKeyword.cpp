@@ -5,6 +5,8 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 
+#include <cctype>
+
 #include <QDebug>
 #include <QString>
 #include <QRegularExpression>
@@ -17,6 +19,35 @@ find files of those names at the top level of this repository. **/
 
 using namespace std;
 using json = nlohmann::json;
+
+namespace {
+  /**
+   * Returns whether a character is left out when comparing names, these are
+   * the whitespace characters, spaces and underscores.
+   *
+   * @param c The character
+   *
+   * @return @b bool True if the character is ignored
+   */
+  inline bool isIgnoredInName(ushort c) {
+    return c == ' ' || c == '_' || c == '\n' || c == '\r' || c == '\t' ||
+           c == '\f' || c == '\v' || c == '\b';
+  }
+
+
+  /**
+   * Converts a lower case ASCII letter to upper case. Other characters are
+   * returned unchanged.
+   *
+   * @param c The character
+   *
+   * @return @b ushort The upper case character
+   */
+  inline ushort upCaseAscii(ushort c) {
+    return (c >= 'a' && c <= 'z') ? c - ('a' - 'A') : c;
+  }
+}
+
 namespace Isis {
   //! Constructs a blank PvlKeyword object.
   PvlKeyword::PvlKeyword() {
@@ -591,20 +622,28 @@ namespace Isis {
    */
   bool PvlKeyword::stringEqual(const QString &QString1,
                                const QString &QString2) {
-    Isis::IString s1(QString1);
-    Isis::IString s2(QString2);
+    // Compare in place, skipping the ignored characters, instead of building
+    //   cleaned up copies of both QStrings
+    const QChar *c1 = QString1.constData();
+    const QChar *end1 = c1 + QString1.size();
+    const QChar *c2 = QString2.constData();
+    const QChar *end2 = c2 + QString2.size();
 
-    s1.ConvertWhiteSpace();
-    s2.ConvertWhiteSpace();
+    while (true) {
+      while (c1 != end1 && isIgnoredInName(c1->unicode())) c1++;
+      while (c2 != end2 && isIgnoredInName(c2->unicode())) c2++;
 
-    s1.Remove(" _");
-    s2.Remove(" _");
+      if (c1 == end1 || c2 == end2) {
+        return (c1 == end1 && c2 == end2);
+      }
 
-    s1.UpCase();
-    s2.UpCase();
+      if (upCaseAscii(c1->unicode()) != upCaseAscii(c2->unicode())) {
+        return false;
+      }
 
-    if (s1 == s2) return true;
-    return false;
+      c1++;
+      c2++;
+    }
   }
 
   /**
@@ -1766,27 +1805,31 @@ namespace Isis {
    * @return QString The first encountered line of data
    */
   QString PvlKeyword::readLine(std::istream &is, bool insideComment) {
-    QString lineOfData;
+    // Characters are taken straight from the stream buffer and collected in a
+    //   std::string, the stream state is updated the same way get() and peek()
+    //   would update it.
+    std::streambuf *buffer = is.rdbuf();
+    std::string lineOfData;
 
-    while(is.good() && lineOfData.isEmpty()) {
+    while(is.good() && lineOfData.empty()) {
 
       // read until \n (works for both \r\n and \n) or */
       while(is.good() &&
-            (!lineOfData.size() || lineOfData[lineOfData.size() - 1] != '\n')) {
-        char next = is.get();
+            (lineOfData.empty() || lineOfData[lineOfData.size() - 1] != '\n')) {
+        int nextChar = buffer->sbumpc();
+        if (nextChar == std::char_traits<char>::eof()) {
+          is.setstate(ios::eofbit | ios::failbit);
+        }
+        char next = (char) nextChar;
 
         // if non-ascii found then we're done... immediately
         if (next <= 0) {
           is.seekg(0, ios::end);
           is.get();
-          return lineOfData;
+          return QString::fromLatin1(lineOfData.data(), lineOfData.size());
         }
 
-        // if any errors (i.e. eof) happen in the get operation then don't
-        //   store this data
-        if (is.good()) {
-          lineOfData += next;
-        }
+        lineOfData += next;
 
         if (insideComment &&
             lineOfData.size() >= 2 && lineOfData[lineOfData.size() - 2] == '*' &&
@@ -1802,20 +1845,29 @@ namespace Isis {
       }
 
       // Trim off non-visible characters from this line of data
-      lineOfData = lineOfData.trimmed();
+      size_t first = 0;
+      size_t last = lineOfData.size();
+      while (first < last && isspace((unsigned char) lineOfData[first])) first++;
+      while (last > first && isspace((unsigned char) lineOfData[last - 1])) last--;
+      lineOfData = lineOfData.substr(first, last - first);
 
       // read up to next non-whitespace in input stream
-      while(is.good() &&
-            (is.peek() == ' ' ||
-             is.peek() == '\r' ||
-             is.peek() == '\n')) {
-        is.get();
+      while(is.good()) {
+        int peeked = buffer->sgetc();
+        if (peeked == std::char_traits<char>::eof()) {
+          is.setstate(ios::eofbit);
+        }
+        else if (peeked == ' ' || peeked == '\r' || peeked == '\n') {
+          buffer->sbumpc();
+          continue;
+        }
+        break;
       }
 
       // if lineOfData is empty (line was empty), we repeat
     }
 
-    return lineOfData;
+    return QString::fromLatin1(lineOfData.data(), lineOfData.size());
   }
 
 
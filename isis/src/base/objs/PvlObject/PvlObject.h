@@ -129,8 +129,10 @@ namespace Isis {
       PvlGroupIterator findGroup(const QString &name,
                                  PvlGroupIterator beg,
                                  PvlGroupIterator end) {
-        Isis::PvlGroup temp(name);
-        return std::find(beg, end, temp);
+        while (beg != end && !PvlKeyword::stringEqual(beg->name(), name)) {
+          ++beg;
+        }
+        return beg;
       }
 
 
@@ -143,8 +145,10 @@ namespace Isis {
       ConstPvlGroupIterator findGroup(const QString &name,
                                       ConstPvlGroupIterator beg,
                                       ConstPvlGroupIterator end) const {
-        Isis::PvlGroup temp(name);
-        return std::find(beg, end, temp);
+        while (beg != end && !PvlKeyword::stringEqual(beg->name(), name)) {
+          ++beg;
+        }
+        return beg;
       }
 
 
@@ -276,8 +280,10 @@ namespace Isis {
       PvlObjectIterator findObject(const QString &name,
                                    PvlObjectIterator beg,
                                    PvlObjectIterator end) {
-        PvlObject temp(name);
-        return std::find(beg, end, temp);
+        while (beg != end && !PvlKeyword::stringEqual(beg->name(), name)) {
+          ++beg;
+        }
+        return beg;
       }
 
 
@@ -291,8 +297,10 @@ namespace Isis {
       ConstPvlObjectIterator findObject(const QString &name,
                                         ConstPvlObjectIterator beg,
                                         ConstPvlObjectIterator end) const {
-        PvlObject temp(name);
-        return std::find(beg, end, temp);
+        while (beg != end && !PvlKeyword::stringEqual(beg->name(), name)) {
+          ++beg;
+        }
+        return beg;
       }
 
 
@@ -168,16 +168,19 @@ namespace Isis {
       throw IException(IException::Programmer, m, _FILEINFO_);
     }
 
+    // Pixels outside the valid range are added as zeros so the loop has no
+    //   branches and can be vectorized by the compiler
+    int used = 0;
     for(int i = 0; i < p_ns; i++) {
-      if(Isis::IsValidPixel(buf[i])) {
-        if(buf[i] < p_minimum) continue;
-        if(buf[i] > p_maximum) continue;
-        p_sums[i] += buf[i];
-        p_sumsqrs[i] += buf[i] * buf[i];
-        p_counts[i]++;
-        p_lastIndex = -100;
-      }
+      bool use = Isis::IsValidPixel(buf[i]) &&
+                 buf[i] >= p_minimum && buf[i] <= p_maximum;
+      double value = use ? buf[i] : 0.0;
+      p_sums[i] += value;
+      p_sumsqrs[i] += value * value;
+      p_counts[i] += use;
+      used += use;
     }
+    if(used > 0) p_lastIndex = -100;
   }
 
   /**
@@ -186,16 +189,17 @@ namespace Isis {
    * @param buf Pointer to array of doubles to remove
    */
   void QuickFilter::RemoveLine(const double *buf) {
+    int used = 0;
     for(int i = 0; i < p_ns; i++) {
-      if(Isis::IsValidPixel(buf[i])) {
-        if(buf[i] < p_minimum) continue;
-        if(buf[i] > p_maximum) continue;
-        p_sums[i] -= buf[i];
-        p_sumsqrs[i] -= buf[i] * buf[i];
-        p_counts[i]--;
-        p_lastIndex = -100;
-      }
+      bool use = Isis::IsValidPixel(buf[i]) &&
+                 buf[i] >= p_minimum && buf[i] <= p_maximum;
+      double value = use ? buf[i] : 0.0;
+      p_sums[i] -= value;
+      p_sumsqrs[i] -= value * value;
+      p_counts[i] -= use;
+      used += use;
     }
+    if(used > 0) p_lastIndex = -100;
     p_linesAdded--;
   }
 
@@ -5,6 +5,7 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "Reduce.h"
+#include "IException.h"
 #include "IString.h"
 #include "SpecialPixel.h"
 #include "SubArea.h"
@@ -36,6 +37,7 @@ namespace Isis {
     
     mdLine      = 1;
     miBandIndex = 1;
+    miOverviewLevel = 0;
     // Set input image area to defaults
     miStartSample = 1;
     miEndSample   = mInCube->sampleCount();
@@ -99,6 +101,39 @@ namespace Isis {
     miOutputLines   = (int)((double)miInputLines / mdLineScale + 0.5);
   }
   
+  /**
+   * Read the input from an overview level of the input cube instead of the
+   * cube itself. Level n has 2^n times fewer samples and lines, so the sample
+   * and line scales are divided by 2^n. The whole image is reduced, and the
+   * output label still describes a reduction of the full resolution image.
+   *
+   * @param level - overview level, 0 to the overview count of the input cube
+   */
+  void Reduce::setOverviewLevel(int level) {
+    if (level < 0 || level > mInCube->overviewCount()) {
+      QString msg = "Overview level [" + toString(level) + "] does not exist in cube [" +
+                    mInCube->fileName() + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    double levelScale = (double)(1 << level) / (double)(1 << miOverviewLevel);
+    miOverviewLevel = level;
+    mdSampleScale /= levelScale;
+    mdLineScale   /= levelScale;
+
+    // Each level has half the pixels of the level below it, rounded up
+    miStartSample  = 1;
+    miInputSamples = (mInCube->sampleCount() + (1 << level) - 1) >> level;
+    miEndSample    = miInputSamples;
+    miStartLine    = 1;
+    miInputLines   = (mInCube->lineCount() + (1 << level) - 1) >> level;
+    miEndLine      = miInputLines;
+    mdLine         = 1;
+
+    delete m_iPortal;
+    m_iPortal = new Isis::Portal(miInputSamples, 1, Isis::Real);
+  }
+
   /**
    * Update the Mapping, Instrument, and AlphaCube groups in the output
    * cube label
@@ -116,21 +151,36 @@ namespace Isis {
     // log file. This group must be created by the calling application.
     // Information will be added to it if the Mapping or Instrument
     // groups are deleted from the output image label
+    // Describe reductions from an overview level in full resolution pixels
+    int inputLines = miInputLines;
+    int inputSamples = miInputSamples;
+    int endLine = miEndLine;
+    int endSample = miEndSample;
+    double lineScale = mdLineScale * (1 << miOverviewLevel);
+    double sampleScale = mdSampleScale * (1 << miOverviewLevel);
+    if (miOverviewLevel > 0) {
+      inputLines = endLine = mInCube->lineCount();
+      inputSamples = endSample = mInCube->sampleCount();
+    }
+
     PvlGroup resultsGrp("Results");
-    resultsGrp += PvlKeyword("InputLines",      toString(miInputLines));
-    resultsGrp += PvlKeyword("InputSamples",    toString(miInputSamples));
+    resultsGrp += PvlKeyword("InputLines",      toString(inputLines));
+    resultsGrp += PvlKeyword("InputSamples",    toString(inputSamples));
     resultsGrp += PvlKeyword("StartingLine",    toString(miStartLine));
     resultsGrp += PvlKeyword("StartingSample",  toString(miStartSample));
-    resultsGrp += PvlKeyword("EndingLine",      toString(miEndLine));
-    resultsGrp += PvlKeyword("EndingSample",    toString(miEndSample));
-    resultsGrp += PvlKeyword("LineIncrement",   toString(mdLineScale));
-    resultsGrp += PvlKeyword("SampleIncrement", toString(mdSampleScale));
+    resultsGrp += PvlKeyword("EndingLine",      toString(endLine));
+    resultsGrp += PvlKeyword("EndingSample",    toString(endSample));
+    resultsGrp += PvlKeyword("LineIncrement",   toString(lineScale));
+    resultsGrp += PvlKeyword("SampleIncrement", toString(sampleScale));
     resultsGrp += PvlKeyword("OutputLines",     toString(miOutputLines));
     resultsGrp += PvlKeyword("OutputSamples",   toString(miOutputSamples));
+    if (miOverviewLevel > 0) {
+      resultsGrp += PvlKeyword("OverviewLevel", toString(miOverviewLevel));
+    }
    
     Isis::SubArea subArea;
     subArea.SetSubArea(mInCube->lineCount(), mInCube->sampleCount(), miStartLine, miStartSample, 
-                       miEndLine, miEndSample, mdLineScale, mdSampleScale);
+                       endLine, endSample, lineScale, sampleScale);
     subArea.UpdateLabel(mInCube, pOutCube, resultsGrp);
     
     return resultsGrp;
@@ -147,7 +197,7 @@ namespace Isis {
     int readLine = (int)(mdLine + 0.5);
 
     m_iPortal->SetPosition(miStartSample, readLine, miBandIndex);
-    mInCube->read(*m_iPortal);
+    mInCube->read(*m_iPortal, miOverviewLevel);
     
     // Scale down buffer
     for(int os = 0; os < miOutputSamples; os++) {
@@ -194,7 +244,7 @@ namespace Isis {
     while(mdLine <= rline) {
       if((int)mdLine <= miInputLines) {
         m_iPortal->SetPosition(miStartSample, mdLine, miBandIndex);
-        mInCube->read(*m_iPortal);
+        mInCube->read(*m_iPortal, miOverviewLevel);
       }
       int isamp = 1;
       for(int osamp = 0; osamp < out.size(); osamp++) {
@@ -225,7 +275,7 @@ namespace Isis {
 
     if(mdLine <= miInputLines) {
       m_iPortal->SetPosition(miStartSample, mdLine, miBandIndex);
-      mInCube->read(*m_iPortal);
+      mInCube->read(*m_iPortal, miOverviewLevel);
     }
     double ldel = (double)mdLine - rline;
     double ldel2 = 1.0 - ldel;
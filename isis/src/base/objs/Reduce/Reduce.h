@@ -59,6 +59,9 @@ namespace Isis {
     void setInputBoundary(int startSample, int endSample,
                           int startLine, int endLine);
 
+    //! Read the input from an overview level
+    void setOverviewLevel(int level);
+
     protected:
       Isis::Cube *mInCube;        //!< Input image
       double mdSampleScale;       //!< Sample scale
@@ -74,6 +77,7 @@ namespace Isis {
       int miInputLines;           //!< Input Lines
       int miInputBands;           //!< Input Bands
       mutable int miBandIndex;            //!< Band Index
+      int miOverviewLevel;        //!< Overview level the input is read from
       Isis::Portal *m_iPortal;    //!< Input portal
   };
 
@@ -8,8 +8,12 @@ find files of those names at the top level of this repository. **/
 
 #include <cfloat>
 #include <iomanip>
+#include <sstream>
 
 #include <QDebug>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStringList>
 #include <QVector>
 
 #include <getSpkAbCorrState.hpp>
@@ -33,12 +37,50 @@ using json = nlohmann::json;
 #include "NaifStatus.h"
 #include "ShapeModel.h"
 #include "SpacecraftPosition.h"
+#include "SpiceCache.h"
 #include "Target.h"
 #include "Blob.h"
 
 using namespace std;
 
 namespace Isis {
+  namespace {
+    //! Guards keepKernels and keptKernels
+    QMutex keptKernelsMutex;
+    //! Whether kernels stay loaded after the Spice object that loaded them is destroyed
+    bool keepKernels = false;
+    //! The expanded names of the kept kernels, in the order they were loaded
+    QStringList keptKernels;
+
+
+    /**
+     * Unloads the kept kernels after the first count of them, last loaded
+     * first. keptKernelsMutex must be locked.
+     *
+     * @param count The number of kept kernels to leave loaded
+     */
+    void unloadKeptKernels(int count) {
+      while (keptKernels.size() > count) {
+        unload_c(keptKernels.takeLast().toLatin1().data());
+      }
+    }
+
+
+    /**
+     * Unloads the kernels kept for an earlier Spice object after the first
+     * count of them, if kernels are being kept.
+     *
+     * @param count The number of kept kernels to leave loaded
+     */
+    void trimKeptKernels(int count) {
+      QMutexLocker locker(&keptKernelsMutex);
+      if (keepKernels) {
+        unloadKeptKernels(count);
+      }
+    }
+  }
+
+
   /**
    * Constructs a Spice object and loads SPICE kernels using information from the
    * label object. The constructor expects an Instrument and Kernels group to be
@@ -109,6 +151,7 @@ namespace Isis {
 
     m_et = nullptr;
     m_kernels = new QVector<QString>;
+    m_keptKernelCount = 0;
 
     m_startTime = new iTime;
     m_endTime = new iTime;
@@ -202,14 +245,30 @@ namespace Isis {
         }
 
         if (isd == NULL){
-          // try using ALE
-          std::ostringstream kernel_pvl;
-          kernel_pvl << kernels;
+          // Reuse the ISD saved by an earlier run
+          QString cacheFile = SpiceCache::isdFile(lab);
+          if (!cacheFile.isEmpty()) {
+            isd = SpiceCache::readIsd(cacheFile);
+          }
+
+          if (isd == NULL) {
+            // ALE loads the kernels it needs itself, so it must not see the
+            // kernels kept for an earlier object
+            trimKeptKernels(m_keptKernelCount);
+
+            // try using ALE
+            std::ostringstream kernel_pvl;
+            kernel_pvl << kernels;
 
-          json props;
-          props["kernels"] = kernel_pvl.str();
+            json props;
+            props["kernels"] = kernel_pvl.str();
 
-          isd = ale::load(lab.fileName().toStdString(), props.dump(), "ale", false);
+            isd = ale::load(lab.fileName().toStdString(), props.dump(), "ale", false);
+
+            if (!cacheFile.isEmpty()) {
+              SpiceCache::writeIsd(cacheFile, isd);
+            }
+          }
         }
 
         json aleNaifKeywords = isd["naif_keywords"];
@@ -260,6 +319,9 @@ namespace Isis {
       // NAIF keywords have been pulled from the cube labels, so we can find target body codes
       // that are defined in kernels and not just body codes build into spicelib
       // TODO: Move this below the else once the rings code below has been refactored
+      // The kernels kept for an earlier object that this one did not load are
+      // unloaded first, so the target only sees this object's kernels
+      trimKeptKernels(m_keptKernelCount);
       m_target = new Target(this, lab);
 
       // This should not be here. Consider having spiceinit add the necessary rings kernels to the
@@ -280,6 +342,7 @@ namespace Isis {
       // that are defined in kernels and not just body codes build into spicelib
       // TODO: Move this below the else once the rings code above has been refactored
 
+      trimKeptKernels(m_keptKernelCount);
       m_target = new Target(this, lab);
     }
 
@@ -412,10 +475,10 @@ namespace Isis {
       solarLongitude();
     }
     else if (kernels["TargetPosition"][0].toUpper() == "TABLE") {
-      Table t("SunPosition", lab.fileName(), lab);
+      Table t = SpiceCache::table("SunPosition", lab);
       m_sunPosition->LoadCache(t);
 
-      Table t2("BodyRotation", lab.fileName(), lab);
+      Table t2 = SpiceCache::table("BodyRotation", lab);
       m_bodyRotation->LoadCache(t2);
       if (t2.Label().hasKeyword("SolarLongitude")) {
         *m_solarLongitude = Longitude(t2.Label()["SolarLongitude"],
@@ -456,7 +519,7 @@ namespace Isis {
      }
     }
     else if (kernels["InstrumentPointing"][0].toUpper() == "TABLE") {
-      Table t("InstrumentPointing", lab.fileName(), lab);
+      Table t = SpiceCache::table("InstrumentPointing", lab);
       m_instrumentRotation->LoadCache(t);
     }
 
@@ -471,7 +534,7 @@ namespace Isis {
       m_instrumentPosition->LoadCache(isd["instrument_position"]);
     }
     else if (kernels["InstrumentPosition"][0].toUpper() == "TABLE") {
-      Table t("InstrumentPosition", lab.fileName(), lab);
+      Table t = SpiceCache::table("InstrumentPosition", lab);
       m_instrumentPosition->LoadCache(t);
     }
     NaifStatus::CheckErrors();
@@ -501,8 +564,53 @@ namespace Isis {
         throw IException(IException::Io, msg, _FILEINFO_);
       }
       QString fileName = file.expanded();
-      furnsh_c(fileName.toLatin1().data());
-      m_kernels->push_back(key[i]);
+
+      QMutexLocker locker(&keptKernelsMutex);
+      if (keepKernels) {
+        // Kernels loaded in the same order as for the last object are still
+        // loaded. Past the first one that differs, the kept kernels are
+        // unloaded so the kernels are loaded in the same order as they would
+        // be without keeping them.
+        if (m_keptKernelCount >= keptKernels.size() ||
+            keptKernels[m_keptKernelCount] != fileName) {
+          unloadKeptKernels(m_keptKernelCount);
+          furnsh_c(fileName.toLatin1().data());
+          keptKernels.append(fileName);
+        }
+        m_keptKernelCount++;
+      }
+      else {
+        furnsh_c(fileName.toLatin1().data());
+        m_kernels->push_back(key[i]);
+      }
+    }
+
+    NaifStatus::CheckErrors();
+  }
+
+
+  /**
+   * Sets whether the kernels loaded by Spice objects stay loaded after the
+   * objects are destroyed or have cached their data. While they are kept, a
+   * new Spice object only loads the kernels that differ from the ones the
+   * last object loaded, which saves loading the same kernels over and over
+   * when creating cameras for many images that share their kernels, one
+   * after the other. The kernels are still loaded in the order the new
+   * object asks for them, so the NAIF data it sees does not change.
+   *
+   * Kernels are only kept for one Spice object at a time, so do not create a
+   * Spice object while another one that has not cached its data yet exists.
+   * Turning this off unloads the kept kernels.
+   *
+   * @param keep Whether to keep the loaded kernels
+   */
+  void Spice::setKeepKernelsLoaded(bool keep) {
+    NaifStatus::CheckErrors();
+
+    QMutexLocker locker(&keptKernelsMutex);
+    keepKernels = keep;
+    if (!keep) {
+      unloadKeptKernels(0);
     }
 
     NaifStatus::CheckErrors();
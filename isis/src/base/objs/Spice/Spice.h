@@ -340,6 +340,8 @@ namespace Isis {
       PvlObject getStoredNaifKeywords() const;
       virtual double resolution();
 
+      static void setKeepKernelsLoaded(bool keep);
+
     protected:
       /**
        * NAIF value primitive type
@@ -394,6 +396,7 @@ namespace Isis {
       void load(PvlKeyword &key, bool notab);
 
       QVector<QString> * m_kernels; //!< Vector containing kernels filenames
+      int m_keptKernelCount; //!< Number of kernels this object loaded while keeping kernels
 
       // cache stuff
       iTime *m_startTime; //!< Corrected start (shutter open) time of the observation.
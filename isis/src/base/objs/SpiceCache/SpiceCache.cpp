@@ -0,0 +1,254 @@
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include "SpiceCache.h"
+
+#include <sstream>
+#include <vector>
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+#include "FileName.h"
+#include "IException.h"
+#include "Preference.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlObject.h"
+#include "Table.h"
+
+using json = nlohmann::json;
+
+namespace Isis {
+  namespace {
+    QMutex tablesMutex;            //!< Guards tables and tableOrder
+    QHash<QString, Table> tables;  //!< The cached tables, by key
+    QList<QString> tableOrder;     //!< The keys of the tables, oldest first
+
+
+    /**
+     * Adds the path, size and modification time of a file to a hash. Files
+     * that do not exist are not added.
+     *
+     * @param hash The hash to add to
+     * @param fileName The file
+     */
+    void addFile(QCryptographicHash &hash, const QString &fileName) {
+      QFileInfo file(FileName(fileName).expanded());
+      if (file.isFile()) {
+        hash.addData(file.absoluteFilePath().toUtf8());
+        hash.addData(QString::number(file.size()).toLatin1());
+        hash.addData(QString::number(file.lastModified().toMSecsSinceEpoch()).toLatin1());
+      }
+    }
+
+
+    /**
+     * Adds the text of an object of a label, with all of its groups, to a
+     * hash. Objects the label does not have are not added.
+     *
+     * @param hash The hash to add to
+     * @param label The label
+     * @param objectName The name of the object
+     */
+    void addObject(QCryptographicHash &hash, Pvl &label, const QString &objectName) {
+      if (!label.hasObject(objectName)) {
+        return;
+      }
+      std::ostringstream objectStream;
+      objectStream << label.findObject(objectName);
+      std::string objectText = objectStream.str();
+      hash.addData(objectText.c_str(), objectText.size());
+    }
+  }
+
+
+  /**
+   * Returns whether the SpiceCacheDirectory performance preference turns
+   * caching ISDs on.
+   *
+   * @return @b bool If ISDs are cached
+   */
+  bool SpiceCache::enabled() {
+    return !directory().isEmpty();
+  }
+
+
+  /**
+   * Returns whether the SpiceTableCache performance preference turns
+   * keeping SPICE tables in memory on.
+   *
+   * @return @b bool If SPICE tables are cached
+   */
+  bool SpiceCache::tablesEnabled() {
+    PvlGroup &performancePrefs = Preference::Preferences().findGroup("Performance");
+    return performancePrefs.hasKeyword("SpiceTableCache") &&
+           performancePrefs["SpiceTableCache"][0].toUpper() == "ON";
+  }
+
+
+  /**
+   * Returns the directory of the SpiceCacheDirectory performance preference,
+   * or an empty QString if the preference is not set or is None.
+   *
+   * @return @b QString The cache directory
+   */
+  QString SpiceCache::directory() {
+    PvlGroup &performancePrefs = Preference::Preferences().findGroup("Performance");
+    if (!performancePrefs.hasKeyword("SpiceCacheDirectory")) {
+      return "";
+    }
+
+    QString directory = performancePrefs["SpiceCacheDirectory"][0];
+    if (directory.isEmpty() || directory.toUpper() == "NONE") {
+      return "";
+    }
+    return FileName(directory).expanded();
+  }
+
+
+  /**
+   * Returns the file that caches the ISD computed by ALE for a label, or an
+   * empty QString if caching is off.
+   *
+   * @param label The label the ISD is computed for
+   *
+   * @return @b QString The cache file
+   */
+  QString SpiceCache::isdFile(Pvl &label) {
+    QString cacheDirectory = directory();
+    if (cacheDirectory.isEmpty()) {
+      return "";
+    }
+
+    // ALE reads any part of the cube label, such as the dimensions and the
+    //   AlphaCube group of a cropped cube
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    addObject(hash, label, "IsisCube");
+
+    PvlGroup &kernels = label.findGroup("Kernels", Pvl::Traverse);
+    for (int k = 0; k < kernels.keywords(); k++) {
+      for (int v = 0; v < kernels[k].size(); v++) {
+        addFile(hash, kernels[k][v]);
+      }
+    }
+
+#ifdef ALELIBRARY
+    // A new ALE may compute a different ISD from the same kernels
+    addFile(hash, ALELIBRARY);
+#endif
+
+    return cacheDirectory + "/" + QString(hash.result().toHex()) + ".isd";
+  }
+
+
+  /**
+   * Reads a cached ISD. The file is mapped into memory and decoded in
+   * place.
+   *
+   * @param isdFile The cache file
+   *
+   * @return @b json The ISD, or null if the file can not be read
+   */
+  json SpiceCache::readIsd(const QString &isdFile) {
+    QFile file(isdFile);
+    if (!file.open(QIODevice::ReadOnly) || file.size() == 0) {
+      return json();
+    }
+
+    uchar *data = file.map(0, file.size());
+    if (!data) {
+      return json();
+    }
+
+    json isd = json::from_cbor(data, data + file.size(), true, false);
+    file.unmap(data);
+
+    if (isd.is_discarded()) {
+      return json();
+    }
+    return isd;
+  }
+
+
+  /**
+   * Saves an ISD to its cache file. The file is written under a temporary
+   * name and then renamed, so other programs never read a partial file.
+   * Failing to write the cache is not an error.
+   *
+   * @param isdFile The cache file
+   * @param isd The ISD to save
+   */
+  void SpiceCache::writeIsd(const QString &isdFile, const json &isd) {
+    QDir().mkpath(QFileInfo(isdFile).absolutePath());
+
+    std::vector<std::uint8_t> data = json::to_cbor(isd);
+    QSaveFile file(isdFile);
+    if (file.open(QIODevice::WriteOnly)) {
+      file.write(reinterpret_cast<const char *>(data.data()), data.size());
+      file.commit();
+    }
+  }
+
+
+  /**
+   * Reads a table attached to a cube, or returns the copy kept from the last
+   * time it was read. Only the last MaximumTables tables are kept, and only
+   * when the SpiceTableCache performance preference is On.
+   *
+   * @param tableName The name of the table
+   * @param label The label of the cube, with the file name of the cube
+   *
+   * @return @b Table The table
+   */
+  Table SpiceCache::table(const QString &tableName, Pvl &label) {
+    QFileInfo file(label.fileName());
+    if (!tablesEnabled() || !file.isFile()) {
+      return Table(tableName, label.fileName(), label);
+    }
+
+    // The table's label has the position and size of its data in the file
+    QString key = file.absoluteFilePath() + "\n" + QString::number(file.size()) + "\n" +
+                  QString::number(file.lastModified().toMSecsSinceEpoch());
+    for (int o = 0; o < label.objects(); o++) {
+      PvlObject &object = label.object(o);
+      if (object.isNamed("Table") && object.hasKeyword("Name") &&
+          object["Name"][0] == tableName) {
+        std::ostringstream objectStream;
+        objectStream << object;
+        key += "\n" + QString::fromStdString(objectStream.str());
+        break;
+      }
+    }
+
+    {
+      QMutexLocker locker(&tablesMutex);
+      if (tables.contains(key)) {
+        return tables.value(key);
+      }
+    }
+
+    Table table(tableName, label.fileName(), label);
+
+    QMutexLocker locker(&tablesMutex);
+    if (!tables.contains(key)) {
+      tables.insert(key, table);
+      tableOrder.append(key);
+      while (tableOrder.size() > MaximumTables) {
+        tables.remove(tableOrder.takeFirst());
+      }
+    }
+    return table;
+  }
+}
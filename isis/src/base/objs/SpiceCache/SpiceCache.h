@@ -0,0 +1,66 @@
+#ifndef SpiceCache_h
+#define SpiceCache_h
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include <QString>
+
+#include <nlohmann/json.hpp>
+
+namespace Isis {
+  class Pvl;
+  class Table;
+
+  /**
+   * @brief Reuses the SPICE data read or computed for a camera
+   *
+   * Creating a camera either computes the SPICE data of the cube with ALE,
+   * when the SPICE is not attached to the cube, or reads it from the tables
+   * attached to the cube. Both are done again every time a camera is
+   * created, which happens once per thread for cameras in a CameraPool and
+   * once per run for programs run on the same cube over and over.
+   *
+   * Each cache has a performance preference of its own:
+   *
+   * <ul>
+   *   <li>When SpiceCacheDirectory names a directory, the ISDs computed by ALE
+   *       are saved in that directory. An ISD file is named for a hash of the
+   *       IsisCube object of the label, with all of its groups, of the path,
+   *       size and modification time of every kernel file and of the ALE
+   *       library. Changing any of them uses another file.</li>
+   *   <li>When SpiceTableCache is On, the last SPICE tables read from cubes are
+   *       kept in memory. A table is kept for its cube file, the size and
+   *       modification time of the file and the table's label, which has the
+   *       position of the table data in the file. Rewriting the table or the
+   *       file reads it again. Copies of a Table share their records, so a
+   *       cached table costs the memory of one copy.</li>
+   * </ul>
+   *
+   * With a cache turned off every call reads or computes the data again.
+   *
+   * @ingroup SpiceInstrumentsAndCameras
+   */
+  class SpiceCache {
+    public:
+      static bool enabled();
+      static bool tablesEnabled();
+
+      static QString isdFile(Pvl &label);
+      static nlohmann::json readIsd(const QString &isdFile);
+      static void writeIsd(const QString &isdFile, const nlohmann::json &isd);
+
+      static Table table(const QString &tableName, Pvl &label);
+
+      static const int MaximumTables = 64; //!< Tables kept in memory
+
+    private:
+      SpiceCache() = delete;
+
+      static QString directory();
+  };
+}
+
+#endif
@@ -469,14 +469,13 @@ namespace Isis {
     }
 
     std::vector<ale::State> stateCache;
-    // Loop through and move the table to the cache
+    // Read the table a column at a time and move it to the cache
     if (p_source != PolyFunction) {
-      for (int r = 0; r < table.Records(); r++) {
-        TableRecord &rec = table[r];
-        if (rec.Fields() == 7) {
+      if (table.Records() > 0) {
+        if (table.RecordFields() == 7) {
           p_hasVelocity = true;
         }
-        else if (rec.Fields() == 4) {
+        else if (table.RecordFields() == 4) {
           p_hasVelocity = false;
         }
         else  {
@@ -484,20 +483,31 @@ namespace Isis {
           throw IException(IException::Programmer, msg, _FILEINFO_);
         }
 
-        ale::State currentState(ale::Vec3d((double)rec[0],
-                                           (double)rec[1],
-                                           (double)rec[2]));
+        std::vector<double> x = table.DoubleColumn(0);
+        std::vector<double> y = table.DoubleColumn(1);
+        std::vector<double> z = table.DoubleColumn(2);
+        std::vector<double> vx, vy, vz;
 
         int inext = 3;
 
         if (p_hasVelocity) {
-          currentState.velocity = ale::Vec3d((double)rec[3],
-                                             (double)rec[4],
-                                             (double)rec[5]);
+          vx = table.DoubleColumn(3);
+          vy = table.DoubleColumn(4);
+          vz = table.DoubleColumn(5);
           inext = 6;
         }
-        stateCache.push_back(currentState);
-        p_cacheTime.push_back((double)rec[inext]);
+        std::vector<double> times = table.DoubleColumn(inext);
+
+        stateCache.reserve(x.size());
+        p_cacheTime.reserve(p_cacheTime.size() + times.size());
+        for (size_t r = 0; r < x.size(); r++) {
+          ale::State currentState(ale::Vec3d(x[r], y[r], z[r]));
+          if (p_hasVelocity) {
+            currentState.velocity = ale::Vec3d(vx[r], vy[r], vz[r]);
+          }
+          stateCache.push_back(currentState);
+          p_cacheTime.push_back(times[r]);
+        }
       }
 
       if (m_state != NULL) {
@@ -613,24 +613,24 @@ namespace Isis {
     std::vector<ale::Rotation> rotationCache;
     std::vector<ale::Vec3d> avCache;
     if (recFields == 5) {
-      for (int r = 0; r < table.Records(); r++) {
-        TableRecord &rec = table[r];
-
-        if (rec.Fields() != recFields) {
-          // throw and error
-        }
+      std::vector<double> q0 = table.DoubleColumn(0);
+      std::vector<double> q1 = table.DoubleColumn(1);
+      std::vector<double> q2 = table.DoubleColumn(2);
+      std::vector<double> q3 = table.DoubleColumn(3);
+      std::vector<double> times = table.DoubleColumn(4);
 
+      for (size_t r = 0; r < times.size(); r++) {
         std::vector<double> j2000Quat;
-        j2000Quat.push_back((double)rec[0]);
-        j2000Quat.push_back((double)rec[1]);
-        j2000Quat.push_back((double)rec[2]);
-        j2000Quat.push_back((double)rec[3]);
+        j2000Quat.push_back(q0[r]);
+        j2000Quat.push_back(q1[r]);
+        j2000Quat.push_back(q2[r]);
+        j2000Quat.push_back(q3[r]);
 
         Quaternion q(j2000Quat);
         std::vector<double> CJ = q.ToMatrix();
         rotationCache.push_back(ale::Rotation(CJ));
 
-        p_cacheTime.push_back((double)rec[4]);
+        p_cacheTime.push_back(times[r]);
       }
       if (p_TC.size() > 1) {
         m_orientation = new ale::Orientations(rotationCache, p_cacheTime, avCache,
@@ -645,30 +645,29 @@ namespace Isis {
 
     // list table of quaternion, angular velocity vector, and time
     else if (recFields == 8) {
-      for (int r = 0; r < table.Records(); r++) {
-        TableRecord &rec = table[r];
-
-        if (rec.Fields() != recFields) {
-          // throw and error
-        }
-
+      std::vector<double> q0 = table.DoubleColumn(0);
+      std::vector<double> q1 = table.DoubleColumn(1);
+      std::vector<double> q2 = table.DoubleColumn(2);
+      std::vector<double> q3 = table.DoubleColumn(3);
+      std::vector<double> avX = table.DoubleColumn(4);
+      std::vector<double> avY = table.DoubleColumn(5);
+      std::vector<double> avZ = table.DoubleColumn(6);
+      std::vector<double> times = table.DoubleColumn(7);
+
+      for (size_t r = 0; r < times.size(); r++) {
         std::vector<double> j2000Quat;
-        j2000Quat.push_back((double)rec[0]);
-        j2000Quat.push_back((double)rec[1]);
-        j2000Quat.push_back((double)rec[2]);
-        j2000Quat.push_back((double)rec[3]);
+        j2000Quat.push_back(q0[r]);
+        j2000Quat.push_back(q1[r]);
+        j2000Quat.push_back(q2[r]);
+        j2000Quat.push_back(q3[r]);
 
 
         Quaternion q(j2000Quat);
         std::vector<double> CJ = q.ToMatrix();
         rotationCache.push_back(ale::Rotation(CJ));
 
-        std::vector<double> av;
-        av.push_back((double)rec[4]);
-        av.push_back((double)rec[5]);
-        av.push_back((double)rec[6]);
-        avCache.push_back(ale::Vec3d(av));
-        p_cacheTime.push_back((double)rec[7]);
+        avCache.push_back(ale::Vec3d(avX[r], avY[r], avZ[r]));
+        p_cacheTime.push_back(times[r]);
         p_hasAngularVelocity = true;
       }
 
@@ -12,8 +12,14 @@ find files of those names at the top level of this repository. **/
 #include <QUuid>
 #include <QXmlStreamWriter>
 
+#include <algorithm>
 #include <float.h>
 
+#if defined(__SSE2__)
+#define ISIS_STATISTICS_SSE2 1
+#include <emmintrin.h>
+#endif
+
 #include "IException.h"
 #include "IString.h"
 #include "Project.h"
@@ -133,16 +139,122 @@ namespace Isis {
    * This method can be invoked multiple times (for example: once
    * for each line in a cube) before obtaining statistics.
    *
+   * Pixels that are valid and within the valid range are selected with a
+   * comparison mask instead of the special pixel tests, and their sums are
+   * accumulated with Kahan compensation in two independent lanes. Any other
+   * pixel (special, out of range or NaN) is handled by AddData(double).
+   *
    * @param data The data to be added to the data set used for statistical
    *    calculations.
    *
    * @param count The number of elements in the incoming data to be added.
    */
   void Statistics::AddData(const double *data, const unsigned int count) {
-    for(unsigned int i = 0; i < count; i++) {
+    // Every special pixel is less than ValidMinimum, so values within these
+    //   bounds are valid and in range. NaN fails both comparisons.
+    const double rangeMinimum = std::max(m_validMinimum, Isis::ValidMinimum);
+    const double rangeMaximum = m_validMaximum;
+
+    double sum[2] = {0.0, 0.0};
+    double sumError[2] = {0.0, 0.0};
+    double sumsum[2] = {0.0, 0.0};
+    double sumsumError[2] = {0.0, 0.0};
+    double minimum = m_minimum;
+    double maximum = m_maximum;
+    BigInt validPixels = 0;
+    unsigned int i = 0;
+
+#if ISIS_STATISTICS_SSE2
+    const __m128d lower = _mm_set1_pd(rangeMinimum);
+    const __m128d upper = _mm_set1_pd(rangeMaximum);
+    const __m128d noMinimum = _mm_set1_pd(DBL_MAX);
+    const __m128d noMaximum = _mm_set1_pd(-DBL_MAX);
+    __m128d sumLanes = _mm_setzero_pd();
+    __m128d sumErrorLanes = _mm_setzero_pd();
+    __m128d sumsumLanes = _mm_setzero_pd();
+    __m128d sumsumErrorLanes = _mm_setzero_pd();
+    __m128d minimumLanes = _mm_set1_pd(minimum);
+    __m128d maximumLanes = _mm_set1_pd(maximum);
+
+    for (; i + 2 <= count; i += 2) {
+      __m128d values = _mm_loadu_pd(data + i);
+      __m128d valid = _mm_and_pd(_mm_cmpge_pd(values, lower), _mm_cmple_pd(values, upper));
+      int validMask = _mm_movemask_pd(valid);
+
+      // Invalid lanes add zero and do not move the extrema
+      __m128d validValues = _mm_and_pd(valid, values);
+      __m128d y = _mm_sub_pd(validValues, sumErrorLanes);
+      __m128d t = _mm_add_pd(sumLanes, y);
+      sumErrorLanes = _mm_sub_pd(_mm_sub_pd(t, sumLanes), y);
+      sumLanes = t;
+
+      y = _mm_sub_pd(_mm_mul_pd(validValues, validValues), sumsumErrorLanes);
+      t = _mm_add_pd(sumsumLanes, y);
+      sumsumErrorLanes = _mm_sub_pd(_mm_sub_pd(t, sumsumLanes), y);
+      sumsumLanes = t;
+
+      minimumLanes = _mm_min_pd(minimumLanes,
+          _mm_or_pd(validValues, _mm_andnot_pd(valid, noMinimum)));
+      maximumLanes = _mm_max_pd(maximumLanes,
+          _mm_or_pd(validValues, _mm_andnot_pd(valid, noMaximum)));
+
+      if (validMask == 3) {
+        validPixels += 2;
+      }
+      else {
+        for (int lane = 0; lane < 2; lane++) {
+          if (validMask & (1 << lane)) {
+            validPixels++;
+          }
+          else {
+            Statistics::AddData(data[i + lane]);
+          }
+        }
+      }
+    }
+
+    _mm_storeu_pd(sum, sumLanes);
+    _mm_storeu_pd(sumError, sumErrorLanes);
+    _mm_storeu_pd(sumsum, sumsumLanes);
+    _mm_storeu_pd(sumsumError, sumsumErrorLanes);
+
+    double lanes[2];
+    _mm_storeu_pd(lanes, minimumLanes);
+    minimum = std::min(lanes[0], lanes[1]);
+    _mm_storeu_pd(lanes, maximumLanes);
+    maximum = std::max(lanes[0], lanes[1]);
+#endif
+
+    for (; i < count; i++) {
       double value = data[i];
-      AddData(value);
+      if (value >= rangeMinimum && value <= rangeMaximum) {
+        int lane = i % 2;
+        double y = value - sumError[lane];
+        double t = sum[lane] + y;
+        sumError[lane] = (t - sum[lane]) - y;
+        sum[lane] = t;
+
+        y = value * value - sumsumError[lane];
+        t = sumsum[lane] + y;
+        sumsumError[lane] = (t - sumsum[lane]) - y;
+        sumsum[lane] = t;
+
+        if (value < minimum) minimum = value;
+        if (value > maximum) maximum = value;
+        validPixels++;
+      }
+      else {
+        Statistics::AddData(value);
+      }
     }
+
+    // Pixels handled by AddData(double) may have moved the extrema already
+    m_minimum = std::min(m_minimum, minimum);
+    m_maximum = std::max(m_maximum, maximum);
+    m_sum += (sum[0] - sumError[0]) + (sum[1] - sumError[1]);
+    m_sumsum += (sumsum[0] - sumsumError[0]) + (sumsum[1] - sumsumError[1]);
+    m_validPixels += validPixels;
+    m_totalPixels += validPixels;
   }
 
 
@@ -252,6 +364,42 @@ namespace Isis {
   }
 
 
+  /**
+   * Adds the data accumulated by another Statistics object to this one, as if
+   * every value given to the other object had been added to this one. This
+   * allows separate threads to each accumulate part of a data set and combine
+   * the results afterwards. Counts, minimum and maximum are combined exactly.
+   *
+   * @param other The statistics to combine with these
+   *
+   * @throws IException::Programmer The valid ranges of the statistics differ
+   */
+  void Statistics::Merge(const Statistics &other) {
+    if (other.m_validMinimum != m_validMinimum || other.m_validMaximum != m_validMaximum) {
+      QString msg = "Unable to merge statistics with valid range [" +
+                    toString(other.m_validMinimum) + ", " + toString(other.m_validMaximum) +
+                    "] into statistics with valid range [" + toString(m_validMinimum) +
+                    ", " + toString(m_validMaximum) + "].";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    m_sum += other.m_sum;
+    m_sumsum += other.m_sumsum;
+    if (other.m_minimum < m_minimum) m_minimum = other.m_minimum;
+    if (other.m_maximum > m_maximum) m_maximum = other.m_maximum;
+    m_totalPixels += other.m_totalPixels;
+    m_validPixels += other.m_validPixels;
+    m_nullPixels += other.m_nullPixels;
+    m_lrsPixels += other.m_lrsPixels;
+    m_lisPixels += other.m_lisPixels;
+    m_hrsPixels += other.m_hrsPixels;
+    m_hisPixels += other.m_hisPixels;
+    m_underRangePixels += other.m_underRangePixels;
+    m_overRangePixels += other.m_overRangePixels;
+    m_removedData = m_removedData || other.m_removedData;
+  }
+
+
   void Statistics::SetValidRange(const double minimum, const double maximum) {
     m_validMinimum = minimum;
     m_validMaximum = maximum;
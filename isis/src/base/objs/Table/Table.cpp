@@ -6,7 +6,10 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "Table.h"
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <limits>
 #include <string>
 
 #include "Blob.h"
@@ -17,6 +20,10 @@ find files of those names at the top level of this repository. **/
 using namespace std;
 namespace Isis {
 
+  // The largest QByteArray is a little under 2 GB, its header and terminating
+  //   null are part of the same allocation
+  static const qint64 MaximumDataBytes = std::numeric_limits<int>::max() - 64;
+
   Table::Table(Blob &blob) {
     initFromBlob(blob);
   }
@@ -114,7 +121,8 @@ namespace Isis {
 
   /**
    * Copy constructor for an Table object.  This constructor copies TableRecords
-   * and the member variable values for record, records, assoc, and swap.
+   * and the member variable values for record, records, assoc, and swap. The
+   * record buffer is shared with the other table until either one changes.
    *
    * @param other The table to copy from
    */
@@ -125,16 +133,7 @@ namespace Isis {
     p_records = other.p_records;
     p_assoc = other.p_assoc;
     p_swap = other.p_swap;
-
-    for (unsigned int i = 0; i < other.p_recbufs.size(); i++) {
-      char *data = new char[RecordSize()];
-
-      for (int j = 0; j < RecordSize(); j++) {
-        data[j] = other.p_recbufs[i][j];
-      }
-
-      p_recbufs.push_back(data);
-    }
+    p_data = other.p_data;
   }
 
 
@@ -176,14 +175,82 @@ namespace Isis {
     if (Isis::IsLsb() && (bo == Isis::Msb)) p_swap = true;
     if (Isis::IsMsb() && (bo == Isis::Lsb)) p_swap = true;
 
-    for (int rec = 0; rec < p_records; rec++) {
-      size_t bufferPos = rec * RecordSize();
+    // Copy all of the records at once and swap them in place
+    if (RecordSize() > 0) {
+      qint64 bytes = dataBytes(p_records);
+      if (p_records < 0 || bytes > blob.Size()) {
+        QString msg = "Unable to read Isis Table [" + p_name + "]. The [" +
+                      Isis::toString(p_records) + "] records of [" +
+                      Isis::toString(RecordSize()) + " bytes] do not fit in the [" +
+                      Isis::toString(blob.Size()) + " bytes] of table data.";
+        throw IException(IException::Unknown, msg, _FILEINFO_);
+      }
+
+      p_data = QByteArray(blob.getBuffer(), (int) bytes);
+      if (p_swap) swapRecords();
+    }
+  }
 
-      char *buf = new char[RecordSize()];
-      memcpy(buf, &blob.getBuffer()[bufferPos], RecordSize());
 
-      if (p_swap) p_record.Swap(buf);
-      p_recbufs.push_back(buf);
+  /**
+   * Returns the number of bytes in a number of records. The records are kept
+   * in one QByteArray, so they can not take more than the largest size a
+   * QByteArray can hold.
+   *
+   * @param records The number of records
+   *
+   * @throws IException::Unknown "Unable to hold the records in memory"
+   *
+   * @return @b qint64 The bytes in the records
+   */
+  qint64 Table::dataBytes(qint64 records) const {
+    qint64 bytes = records * RecordSize();
+    if (bytes > MaximumDataBytes) {
+      QString msg = "Unable to hold the [" + QString::number(records) +
+                    "] records of Isis Table [" + p_name + "] in memory. The [" +
+                    QString::number(bytes) + " bytes] of records are over the " +
+                    "2 GB limit for a table.";
+      throw IException(IException::Unknown, msg, _FILEINFO_);
+    }
+    return bytes;
+  }
+
+
+  /**
+   * Swaps the byte order of every value in the records. The values to swap
+   * are found once from the record's fields and then swapped record by record.
+   */
+  void Table::swapRecords() {
+    // The offset and size of each value that needs to be swapped
+    vector< pair<int, int> > values;
+    int offset = 0;
+    for (int f = 0; f < p_record.Fields(); f++) {
+      const TableField &field = p_record[f];
+      if (field.isText()) {
+        offset += field.bytes();
+        continue;
+      }
+
+      if (!field.isDouble() && !field.isInteger() && !field.isReal()) {
+        string msg = "Unable to swap bytes. Invalid field type";
+        throw IException(IException::Programmer, msg, _FILEINFO_);
+      }
+
+      int valueBytes = field.bytes() / field.size();
+      for (int i = 0; i < field.size(); i++) {
+        values.push_back(pair<int, int>(offset, valueBytes));
+        offset += valueBytes;
+      }
+    }
+
+    char *data = p_data.data();
+    int records = Records();
+    for (int rec = 0; rec < records; rec++) {
+      char *record = data + (size_t)rec * RecordSize();
+      for (unsigned int v = 0; v < values.size(); v++) {
+        std::reverse(record + values[v].first,
+                     record + values[v].first + values[v].second);
+      }
     }
   }
 
@@ -205,16 +272,7 @@ namespace Isis {
     p_records = other.p_records;
     p_assoc = other.p_assoc;
     p_swap = other.p_swap;
-
-    for (unsigned int i = 0; i < other.p_recbufs.size(); i++) {
-      char *data = new char[RecordSize()];
-
-      for (int j = 0; j < RecordSize(); j++) {
-        data[j] = other.p_recbufs[i][j];
-      }
-
-      p_recbufs.push_back(data);
-    }
+    p_data = other.p_data;
 
     return *this;
   }
@@ -311,7 +369,10 @@ namespace Isis {
    * @return @b int Number of records
    */
   int Table::Records() const {
-    return p_recbufs.size();
+    if (RecordSize() == 0) {
+      return 0;
+    }
+    return p_data.size() / RecordSize();
   }
 
 
@@ -343,11 +404,58 @@ namespace Isis {
    * @return Returns the TableRecord at specific index
    */
   Isis::TableRecord &Table::operator[](const int index) {
-    p_record.Unpack(p_recbufs[index]);
+    p_record.Unpack(RecordData(index));
     return p_record;
   }
 
 
+  /**
+   * Returns the packed values of a record, in native byte order. The pointer
+   * is valid until the Table is changed.
+   *
+   * @param index Index of the record
+   *
+   * @return @b const char* The RecordSize() bytes of the record
+   */
+  const char *Table::RecordData(const int index) const {
+    return p_data.constData() + (size_t)index * RecordSize();
+  }
+
+
+  /**
+   * Returns the values of a Double field for every record, without unpacking
+   * the records. The values of each record follow the values of the record
+   * before it, so a field with N values per record gives Records() * N values.
+   *
+   * @param field Index of the field in the records
+   *
+   * @throws IException::Programmer "Field is not a Double field"
+   *
+   * @return @b std::vector<double> The values of the field
+   */
+  std::vector<double> Table::DoubleColumn(const int field) const {
+    const TableField &column = p_record[field];
+    if (!column.isDouble()) {
+      QString msg = "Field [" + column.name() + "] of Isis Table [" + p_name +
+                    "] is not a Double field";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    int offset = 0;
+    for (int f = 0; f < field; f++) {
+      offset += p_record[f].bytes();
+    }
+
+    int records = Records();
+    std::vector<double> values((size_t)records * column.size());
+    for (int rec = 0; rec < records; rec++) {
+      memcpy(&values[(size_t)rec * column.size()], RecordData(rec) + offset,
+             column.bytes());
+    }
+    return values;
+  }
+
+
   /**
    * Adds a TableRecord to the Table
    *
@@ -367,9 +475,9 @@ namespace Isis {
                      + Isis::toString(RecordSize()) + " bytes]. Record sizes must match.";
        throw IException(IException::Unknown, msg, _FILEINFO_);
      }
-    char *newbuf = new char[RecordSize()];
-    rec.Pack(newbuf);
-    p_recbufs.push_back(newbuf);
+    int bufferPos = p_data.size();
+    p_data.resize((int) dataBytes(Records() + 1));
+    rec.Pack(p_data.data() + bufferPos);
   }
 
 
@@ -380,7 +488,7 @@ namespace Isis {
    * @param index Index of TableRecord to be updated
    */
   void Table::Update(const Isis::TableRecord &rec, const int index) {
-    rec.Pack(p_recbufs[index]);
+    rec.Pack(p_data.data() + (size_t)index * RecordSize());
   }
 
 
@@ -390,10 +498,15 @@ namespace Isis {
    * @param index Index of TableRecord to be deleted
    */
   void Table::Delete(const int index) {
-    vector<char *>::iterator it = p_recbufs.begin();
-    for (int i = 0; i < index; i++, it++);
-    delete [] p_recbufs[index];
-    p_recbufs.erase(it);
+    if (index < 0 || index >= Records()) {
+      QString msg = "Unable to delete record [" + Isis::toString(index) +
+                    "] from Isis Table [" + p_name + "] with [" +
+                    Isis::toString(Records()) + "] records.";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    // The records fit in p_data, so the offset of any of them fits in an int
+    p_data.remove((int) dataBytes(index), RecordSize());
   }
 
 
@@ -401,8 +514,7 @@ namespace Isis {
    * Clear the table of all records
    */
   void Table::Clear() {
-    for (int i = 0; i < (int)p_recbufs.size(); i++) delete [] p_recbufs[i];
-    p_recbufs.clear();
+    p_data.clear();
   }
 
 
@@ -417,7 +529,7 @@ namespace Isis {
 
     // Label setup
     blobLabel += PvlKeyword("Records", Isis::toString(Records()));
-    int nbytes = Records() * RecordSize();
+    int nbytes = (int) dataBytes(Records());
 
     if (Isis::IsLsb()) {
       blobLabel+= PvlKeyword("ByteOrder", Isis::ByteOrderName(Isis::Lsb));
@@ -452,12 +564,7 @@ namespace Isis {
 
     // Binary data setup
     char *buf = new char[nbytes];
-
-    for (int rec = 0; rec < Records(); rec++) {
-      size_t bufferPos = rec * RecordSize();
-
-      memcpy(&buf[bufferPos], p_recbufs[rec], RecordSize());
-    }
+    memcpy(buf, p_data.constData(), nbytes);
 
     tableBlob.takeData(buf, nbytes);
 
@@ -8,6 +8,9 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "Pvl.h"
 #include <vector>
+
+#include <QByteArray>
+
 #include "TableRecord.h"
 
 namespace Isis {
@@ -27,6 +30,11 @@ namespace Isis {
    *
    * See the classes TableRecord and TableField for more information.
    *
+   * The records are kept one after another in a single buffer, in native byte
+   * order, that is shared between copies of the Table until one of them is
+   * changed. DoubleColumn() reads the values of one field of every record
+   * without unpacking whole records.
+   *
    * If you would like to see Table being used in implementation, see histats.cpp
    *
    * @ingroup LowLevelCubeIO
@@ -100,6 +108,8 @@ namespace Isis {
 
       // Read a record
       TableRecord &operator[](const int index);
+      const char *RecordData(const int index) const;
+      std::vector<double> DoubleColumn(const int field) const;
 
       // Add a record
       void operator+=(TableRecord &rec);
@@ -121,12 +131,15 @@ namespace Isis {
     protected:
 
       void initFromBlob(Blob &blob);
+      void swapRecords();
+      qint64 dataBytes(qint64 records) const;
 
       TableRecord p_record;          //!< The current table record
-      std::vector<char *> p_recbufs; //!< Buffers containing record values
+      QByteArray p_data;             /**< The packed records, one after another.
+                                          Shared between copies of the Table.*/
 
       int p_records; /**< Holds record count read from labels, may differ from
-                         the size of p_recbufs.*/
+                         the number of records in p_data.*/
 
       Association p_assoc; //!< Association Type of the table
       bool p_swap;         //!< Only used for reading
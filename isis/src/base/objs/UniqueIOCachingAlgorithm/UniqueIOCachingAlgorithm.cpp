@@ -118,5 +118,14 @@ namespace Isis {
 
     return result;
   }
-}
 
+
+  /**
+   * The I/Os this algorithm is designed for jump between distant areas of the cube.
+   *
+   * @return RandomAccess
+   */
+  CubeCachingAlgorithm::AccessPattern UniqueIOCachingAlgorithm::accessPattern() const {
+    return RandomAccess;
+  }
+}
@@ -36,6 +36,8 @@ namespace Isis {
           QList <RawCubeChunk *> allocated, QList <RawCubeChunk *> justUsed,
           const Buffer &justRequested);
 
+      virtual AccessPattern accessPattern() const;
+
     private:
       /**
        * This is the set of past unique IOs. All chunks not in this set of
@@ -8,6 +8,14 @@ find files of those names at the top level of this repository. **/
 
 #include <sys/resource.h>
 
+#include <functional>
+
+#include <QHash>
+#include <QSet>
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrentMap>
+
 #include "pointreg.h"
 
 #include "AutoReg.h"
@@ -23,6 +31,7 @@ find files of those names at the top level of this repository. **/
 #include "Pixel.h"
 #include "Progress.h"
 #include "SerialNumberList.h"
+#include "SpecialPixel.h"
 #include "UserInterface.h"
 #include "Application.h"
 #include "IException.h"
@@ -37,6 +46,39 @@ namespace Isis {
   SerialNumberList *files;
   QList<QString> *falsePositives;
 
+  /**
+   * The result of registering one measure to its reference measure. When
+   * registering on multiple threads, it also holds the chips loaded on the
+   * main thread for the worker to register.
+   *
+   * A default Registration is a failed one.
+   *
+   * @internal
+   */
+  struct Registration {
+    ControlMeasure *measure = NULL;          //!< The registered measure
+    ControlMeasure *patternMeasure = NULL;   //!< The reference measure
+    bool loaded = false;                     //!< If the chips were loaded
+    bool failed = true;                      //!< If loading or registering threw
+    Chip patternChip;                        //!< The loaded pattern chip
+    Chip searchChip;                         //!< The loaded search chip
+    AutoReg::RegisterStatus status = AutoReg::FitChipNoData; //!< What AutoReg::Register returned
+    bool success = false;                    //!< If the registration succeeded
+    double cubeSample = Null;                //!< The registered cube sample
+    double cubeLine = Null;                  //!< The registered cube line
+    double goodnessOfFit = Null;             //!< The goodness of fit
+    double zScoreMin = Null;                 //!< The minimum pattern z-score
+    double zScoreMax = Null;                 //!< The maximum pattern z-score
+  };
+
+  // One AutoReg for each thread when registering on multiple threads. The
+  //   workers only register chips, all cube reads and camera evaluations are
+  //   done on the main thread.
+  QList<AutoReg *> *workers;
+  // Registrations of the points in preparedPoints, by measure
+  QHash<ControlMeasure *, Registration> *registrations;
+  QSet<ControlPoint *> *preparedPoints;
+
   int ignored;
   int locked;
   int registered;
@@ -184,6 +226,12 @@ namespace Isis {
   };
 
 
+  bool wantsRegistration(const ControlPoint *point, QString registerPoints);
+  void prepareRegistrations(ControlNet &net, int first, QString registerPoints,
+      QString registerMeasures);
+  bool loadSearchChip(AutoReg *reg, CubeManager &cubes, ControlMeasure *patternCM,
+      ControlMeasure *measure);
+  void registerChips(AutoReg *reg, Registration &registration);
   void registerPoint(ControlPoint *outPoint, ControlMeasure *patternCM,
       QString registerMeasures, bool outputFailed);
   void validatePoint(ControlPoint *point, ControlMeasure *reference,
@@ -210,6 +258,9 @@ namespace Isis {
     validator = NULL;
     cubeMgr = NULL;
     falsePositives = NULL;
+    workers = NULL;
+    registrations = NULL;
+    preparedPoints = NULL;
 
     ignored = 0;
     locked = 0;
@@ -251,6 +302,20 @@ namespace Isis {
     Pvl pvl(ui.GetFileName("DEFFILE"));
     ar = AutoRegFactory::Create(pvl);
 
+    // Register on multiple threads with an AutoReg and cubes of their own
+    int maxThreads = ui.GetInteger("MAXTHREADS");
+    if (maxThreads <= 0) {
+      maxThreads = QThreadPool::globalInstance()->maxThreadCount();
+    }
+    if (maxThreads > 1) {
+      workers = new QList<AutoReg *>;
+      for (int t = 0; t < maxThreads; t++) {
+        workers->append(AutoRegFactory::Create(pvl));
+      }
+      registrations = new QHash<ControlMeasure *, Registration>;
+      preparedPoints = new QSet<ControlPoint *>;
+    }
+
     Progress progress;
     progress.SetText("Registering Points");
     progress.SetMaximumSteps(outNet.GetNumPoints());
@@ -303,12 +368,12 @@ namespace Isis {
       ControlPoint * outPoint = outNet.GetPoint(i);
 
       // Establish whether or not we want to attempt to register this point.
-      bool wantToRegister = true;
-      if (outPoint->IsIgnored()) {
-        if (registerPoints == "NONIGNORED") wantToRegister = false;
-      }
-      else {
-        if (registerPoints == "IGNORED") wantToRegister = false;
+      bool wantToRegister = wantsRegistration(outPoint, registerPoints);
+
+      // Register this and the following points on the worker threads
+      if (workers && wantToRegister && validate != "ONLY" &&
+          !preparedPoints->contains(outPoint)) {
+        prepareRegistrations(outNet, i, registerPoints, registerMeasures);
       }
 
       // Check if this is a point we wish to disregard.
@@ -337,6 +402,9 @@ namespace Isis {
 
         if (validate != "ONLY") {
           registerPoint(outPoint, patternCM, registerMeasures, outputFailed);
+          if (preparedPoints) {
+            preparedPoints->remove(outPoint);
+          }
         }
         if (validate != "SKIP") {
           validatePoint(outPoint, patternCM, ui.GetDouble("SHIFT"));
@@ -479,6 +547,11 @@ namespace Isis {
     appLog->addLogGroup(mLog);
 
     // Log Registration Statistics
+    if (workers) {
+      foreach (AutoReg *worker, *workers) {
+        ar->MergeStatistics(*worker);
+      }
+    }
     Pvl arPvl = ar->RegistrationStatistics();
 
     for (int i = 0; i < arPvl.groups(); i++) {
@@ -525,17 +598,190 @@ namespace Isis {
 
     delete falsePositives;
     falsePositives = NULL;
+
+    if (workers) {
+      qDeleteAll(*workers);
+    }
+    delete workers;
+    workers = NULL;
+
+    delete registrations;
+    registrations = NULL;
+
+    delete preparedPoints;
+    preparedPoints = NULL;
+  }
+
+
+  /**
+   * Returns whether the POINTS parameter selects a point for registration.
+   *
+   * @param point The control point
+   * @param registerPoints The value of the POINTS parameter
+   *
+   * @return @b bool If the point should be registered
+   */
+  bool wantsRegistration(const ControlPoint *point, QString registerPoints) {
+    if (point->IsIgnored()) {
+      return registerPoints != "NONIGNORED";
+    }
+    return registerPoints != "IGNORED";
+  }
+
+
+  /**
+   * Registers the measures of a batch of points, starting with the point at
+   * index first, on the worker threads. The pattern and search chips of every
+   * measure are loaded on this thread, because loading them reads the cubes
+   * and evaluates their cameras. The workers only register the loaded chips.
+   * The results are saved in registrations for registerPoint to apply, and the
+   * points are added to preparedPoints.
+   *
+   * @param net The control network
+   * @param first The index of the first point of the batch
+   * @param registerPoints The value of the POINTS parameter
+   * @param registerMeasures The value of the MEASURES parameter
+   */
+  void prepareRegistrations(ControlNet &net, int first, QString registerPoints,
+      QString registerMeasures) {
+    int batchSize = 64 * workers->size();
+
+    QVector<Registration> batch;
+    for (int i = first; i < net.GetNumPoints() && batch.size() < batchSize; i++) {
+      ControlPoint *point = net.GetPoint(i);
+      if (!wantsRegistration(point, registerPoints)) continue;
+      preparedPoints->insert(point);
+
+      ControlMeasure *patternCM = point->GetRefMeasure();
+      bool patternLoaded = false;
+
+      for (int j = 0; j < point->GetNumMeasures(); j++) {
+        ControlMeasure *measure = point->GetMeasure(j);
+        if (measure == patternCM || measure->IsEditLocked()) continue;
+        if (measure->IsMeasured() && registerMeasures == "CANDIDATES") continue;
+
+        Registration registration;
+        registration.measure = measure;
+        registration.patternMeasure = patternCM;
+
+        if (!patternLoaded) {
+          Cube &patternCube = *cubeMgr->OpenCube(
+              files->fileName(patternCM->GetCubeSerialNumber()));
+          ar->PatternChip()->TackCube(patternCM->GetSample(), patternCM->GetLine());
+          ar->PatternChip()->Load(patternCube);
+          patternLoaded = true;
+        }
+
+        registration.loaded = loadSearchChip(ar, *cubeMgr, patternCM, measure);
+        if (registration.loaded) {
+          registration.patternChip = *(ar->PatternChip());
+          registration.searchChip = *(ar->SearchChip());
+        }
+        batch.append(registration);
+      }
+    }
+
+    // Each worker registers every workers->size()-th measure of the batch
+    QVector<int> workerIndexes;
+    for (int t = 0; t < workers->size(); t++) {
+      workerIndexes.append(t);
+    }
+
+    std::function<void(int &)> registerBatch =
+        [&batch](int &workerIndex) {
+          AutoReg *worker = (*workers)[workerIndex];
+
+          for (int k = workerIndex; k < batch.size(); k += workers->size()) {
+            Registration &registration = batch[k];
+            if (registration.loaded) {
+              *(worker->PatternChip()) = registration.patternChip;
+              *(worker->SearchChip()) = registration.searchChip;
+              registerChips(worker, registration);
+            }
+
+            // Free the chips, they are not needed anymore
+            registration.patternChip = Chip();
+            registration.searchChip = Chip();
+          }
+        };
+    QtConcurrent::blockingMap(workerIndexes, registerBatch);
+
+    foreach (const Registration &registration, batch) {
+      registrations->insert(registration.measure, registration);
+    }
+  }
+
+
+  /**
+   * Loads the search chip of an AutoReg for registering a measure to its
+   * reference measure. The pattern chip of the AutoReg must already be loaded.
+   *
+   * @param reg The AutoReg to load the search chip of
+   * @param cubes The cube manager to open the cubes with
+   * @param patternCM The reference measure
+   * @param measure The measure to register
+   *
+   * @return @b bool If the search chip was loaded
+   */
+  bool loadSearchChip(AutoReg *reg, CubeManager &cubes, ControlMeasure *patternCM,
+      ControlMeasure *measure) {
+    // refresh pattern cube pointer to ensure it stays valid
+    Cube &patternCube = *cubes.OpenCube(files->fileName(
+          patternCM->GetCubeSerialNumber()));
+    Cube &searchCube = *cubes.OpenCube(files->fileName(
+          measure->GetCubeSerialNumber()));
+
+    reg->SearchChip()->TackCube(measure->GetSample(), measure->GetLine());
+
+    verifyCube(patternCube);
+    verifyCube(searchCube);
+
+    try {
+      reg->SearchChip()->Load(searchCube, *(reg->PatternChip()), patternCube);
+      searchCube.clearIoCache();
+      patternCube.clearIoCache();
+    }
+    catch (IException &e) {
+      return false;
+    }
+
+    return true;
+  }
+
+
+  /**
+   * Registers the loaded chips of an AutoReg and saves the result.
+   *
+   * @param reg The AutoReg with loaded pattern and search chips
+   * @param registration Set to the result of the registration
+   */
+  void registerChips(AutoReg *reg, Registration &registration) {
+    try {
+      registration.status = reg->Register();
+      reg->ZScores(registration.zScoreMin, registration.zScoreMax);
+      registration.success = reg->Success();
+      registration.cubeSample = reg->CubeSample();
+      registration.cubeLine = reg->CubeLine();
+      registration.goodnessOfFit = reg->GoodnessOfFit();
+      registration.failed = false;
+    }
+    catch (IException &e) {
+      registration.failed = true;
+    }
   }
 
 
   void registerPoint(ControlPoint *outPoint, ControlMeasure *patternCM,
       QString registerMeasures, bool outputFailed) {
 
-    Cube &patternCube = *cubeMgr->OpenCube(
-        files->fileName(patternCM->GetCubeSerialNumber()));
+    // Registrations prepared on the worker threads loaded their own chips
+    if (!registrations) {
+      Cube &patternCube = *cubeMgr->OpenCube(
+          files->fileName(patternCM->GetCubeSerialNumber()));
 
-    ar->PatternChip()->TackCube(patternCM->GetSample(), patternCM->GetLine());
-    ar->PatternChip()->Load(patternCube);
+      ar->PatternChip()->TackCube(patternCM->GetSample(), patternCM->GetLine());
+      ar->PatternChip()->Load(patternCube);
+    }
 
     if (patternCM->IsEditLocked()) {
       locked++;
@@ -557,45 +803,44 @@ namespace Isis {
         }
         else if (!measure->IsMeasured() || registerMeasures != "CANDIDATES") {
 
-          // refresh pattern cube pointer to ensure it stays valid
-          Cube &patternCube = *cubeMgr->OpenCube(files->fileName(
-                patternCM->GetCubeSerialNumber()));
-          Cube &searchCube = *cubeMgr->OpenCube(files->fileName(
-                measure->GetCubeSerialNumber()));
-
-          ar->SearchChip()->TackCube(measure->GetSample(), measure->GetLine());
-
-          verifyCube(patternCube);
-          verifyCube(searchCube);
+          Registration registration;
+          if (registrations) {
+            registration = registrations->take(measure);
+          }
+          else {
+            registration.measure = measure;
+            registration.loaded = loadSearchChip(ar, *cubeMgr, patternCM, measure);
+            if (registration.loaded) {
+              registerChips(ar, registration);
+            }
+          }
 
           try {
-            ar->SearchChip()->Load(searchCube, *(ar->PatternChip()), patternCube);
-
-            // If the measurements were correctly registered
-            // Write them to the new ControlNet
-            AutoReg::RegisterStatus res = ar->Register();
-            searchCube.clearIoCache();
-            patternCube.clearIoCache();
-
-            double score1, score2;
-            ar->ZScores(score1, score2);
+            if (registration.failed) {
+              QString msg = "Unable to register measure [" +
+                  measure->GetCubeSerialNumber() + "]";
+              throw IException(IException::Unknown, msg, _FILEINFO_);
+            }
 
             // Set the minimum and maximum z-score values for the measure
             measure->SetLogData(ControlMeasureLogData(
-                  ControlMeasureLogData::MinimumPixelZScore, score1));
+                  ControlMeasureLogData::MinimumPixelZScore, registration.zScoreMin));
             measure->SetLogData(ControlMeasureLogData(
-                  ControlMeasureLogData::MaximumPixelZScore, score2));
+                  ControlMeasureLogData::MaximumPixelZScore, registration.zScoreMax));
 
-            if (ar->Success()) {
+            if (registration.success) {
               // Check to make sure the newly calculated measure position is on
               // the surface of the planet
+              Cube &searchCube = *cubeMgr->OpenCube(files->fileName(
+                    measure->GetCubeSerialNumber()));
               Camera *cam = searchCube.camera();
-              bool foundLatLon = cam->SetImage(ar->CubeSample(), ar->CubeLine());
+              bool foundLatLon = cam->SetImage(registration.cubeSample,
+                                               registration.cubeLine);
 
               if (foundLatLon) {
                 registered++;
 
-                if (res == AutoReg::SuccessSubPixel) {
+                if (registration.status == AutoReg::SuccessSubPixel) {
                   measure->SetType(ControlMeasure::RegisteredSubPixel);
                 }
                 else {
@@ -604,11 +849,11 @@ namespace Isis {
 
                 measure->SetLogData(ControlMeasureLogData(
                       ControlMeasureLogData::GoodnessOfFit,
-                      ar->GoodnessOfFit()));
+                      registration.goodnessOfFit));
 
                 measure->SetAprioriSample(measure->GetSample());
                 measure->SetAprioriLine(measure->GetLine());
-                measure->SetCoordinate(ar->CubeSample(), ar->CubeLine());
+                measure->SetCoordinate(registration.cubeSample, registration.cubeLine);
                 measure->SetIgnored(false);
 
                 // We successfully registered the current measure to the
@@ -637,10 +882,10 @@ namespace Isis {
               if (outputFailed) {
                 measure->SetType(ControlMeasure::Candidate);
 
-                if (res == AutoReg::FitChipToleranceNotMet) {
+                if (registration.status == AutoReg::FitChipToleranceNotMet) {
                   measure->SetLogData(ControlMeasureLogData(
                         ControlMeasureLogData::GoodnessOfFit,
-                        ar->GoodnessOfFit()));
+                        registration.goodnessOfFit));
                 }
                 measure->SetIgnored(true);
               }
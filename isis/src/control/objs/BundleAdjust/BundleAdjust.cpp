@@ -9,6 +9,7 @@ find files of those names at the top level of this repository. **/
 #include "BundleAdjust.h"
 
 // std lib
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -18,6 +19,10 @@ find files of those names at the top level of this repository. **/
 #include <QDebug>
 #include <QFile>
 #include <QMutex>
+#include <QPair>
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrentMap>
 
 // boost lib
 #include <boost/lexical_cast.hpp>
@@ -53,6 +58,7 @@ find files of those names at the top level of this repository. **/
 #include "LidarControlPoint.h"
 #include "Longitude.h"
 #include "MaximumLikelihoodWFunctions.h"
+#include "Preference.h"
 #include "SpecialPixel.h"
 #include "StatCumProbDistDynCalc.h"
 #include "SurfacePoint.h"
@@ -62,6 +68,35 @@ using namespace boost::numeric::ublas;
 
 namespace Isis {
 
+  namespace {
+    /**
+     * The partial derivatives of one measure, kept until the normals of its point are formed.
+     */
+    struct MeasurePartials {
+      LinearAlgebra::Matrix coeffTarget;  //!< Target body partial derivatives
+      LinearAlgebra::Matrix coeffImage;   //!< Camera parameter partial derivatives
+      LinearAlgebra::Matrix coeffPoint3D; //!< Point partial derivatives
+      LinearAlgebra::Vector coeffRHS;     //!< Weighted x,y residuals
+      int observationIndex;               //!< Index of the measure's observation
+    };
+
+
+    /**
+     * The measure partials and point normal equations of one control point in a batch.
+     */
+    struct PointNormals {
+      PointNormals() : numPartials(0), N22(3), n2(3), numConstrainedCoordinates(0) {}
+
+      BundleControlPointQsp point;                //!< The control point
+      std::vector<MeasurePartials> partials;      //!< Storage for the partials of the measures
+      int numPartials;                            //!< Number of partials used for this point
+      LinearAlgebra::MatrixUpperTriangular N22;   //!< Normal equation matrix for the point
+      SparseBlockColumnMatrix N12;                //!< Normal equation matrix for the cameras
+      LinearAlgebra::Vector n2;                   //!< Right hand side vector for the point
+      int numConstrainedCoordinates;              //!< Number of constrained point coordinates
+    };
+  }
+
 
   /**
    * Custom error handler for CHOLMOD.
@@ -426,6 +461,10 @@ namespace Isis {
     emit(statusUpdate("Initialization"));
     m_previousNumberImagePartials = 0;
 
+    PvlGroup &performancePrefs = Preference::Preferences().findGroup("Performance");
+    m_threadedNormalEquations = performancePrefs.hasKeyword("BundleAdjustThreading") &&
+        performancePrefs["BundleAdjustThreading"][0].toUpper() == "ALWAYS";
+
     // initialize
     //
     // JWB
@@ -1227,53 +1266,60 @@ namespace Isis {
 
     outputBundleStatus("\n\n");
 
-    for (int i = 0; i < num3DPoints; i++) {
-      emit(pointUpdate(i+1));
-      BundleControlPointQsp point = m_bundleControlPoints.at(i);
+    if (m_threadedNormalEquations) {
+      status = formPointNormalsThreaded(coeffTarget, coeffImage, coeffPoint3D, coeffRHS, n1,
+                                        numObservations, numGood3DPoints, numRejected3DPoints,
+                                        numConstrainedCoordinates);
+    }
+    else {
+      for (int i = 0; i < num3DPoints; i++) {
+        emit(pointUpdate(i+1));
+        BundleControlPointQsp point = m_bundleControlPoints.at(i);
 
-      if (point->isRejected()) {
-        numRejected3DPoints++;
-        continue;
-      }
+        if (point->isRejected()) {
+          numRejected3DPoints++;
+          continue;
+        }
 
-      if ( i != 0 ) {
-        N22.clear();
-        N12.wipe();
-        n2.clear();
-      }
+        if ( i != 0 ) {
+          N22.clear();
+          N12.wipe();
+          n2.clear();
+        }
 
-      // loop over measures for this point
-      int numMeasures = point->size();
-      for (int j = 0; j < numMeasures; j++) {
-        BundleMeasureQsp measure = point->at(j);
+        // loop over measures for this point
+        int numMeasures = point->size();
+        for (int j = 0; j < numMeasures; j++) {
+          BundleMeasureQsp measure = point->at(j);
 
-        // flagged as "JigsawFail" implies this measure has been rejected
-        // TODO  IsRejected is obsolete -- replace code or add to ControlMeasure
-        if (measure->isRejected()) {
-          continue;
-        }
+          // flagged as "JigsawFail" implies this measure has been rejected
+          // TODO  IsRejected is obsolete -- replace code or add to ControlMeasure
+          if (measure->isRejected()) {
+            continue;
+          }
 
-        status = computePartials(coeffTarget, coeffImage, coeffPoint3D, coeffRHS, *measure,
-                                     *point);
+          status = computePartials(coeffTarget, coeffImage, coeffPoint3D, coeffRHS, *measure,
+                                       *point);
 
-        if (!status) {
-          // TODO should status be set back to true? JAM
-          // TODO this measure should be flagged as rejected.
-          continue;
-        }
+          if (!status) {
+            // TODO should status be set back to true? JAM
+            // TODO this measure should be flagged as rejected.
+            continue;
+          }
 
-        // increment number of observations
-        numObservations += 2;
+          // increment number of observations
+          numObservations += 2;
 
-        formMeasureNormals(N22, N12, n1, n2, coeffTarget, coeffImage, coeffPoint3D, coeffRHS,
+          formMeasureNormals(N22, N12, n1, n2, coeffTarget, coeffImage, coeffPoint3D, coeffRHS,
                              measure->observationIndex());
 
-      } // end loop over this points measures
+        } // end loop over this points measures
 
-      numConstrainedCoordinates += formPointNormals(N22, N12, n2, m_RHS, point);
+        numConstrainedCoordinates += formPointNormals(N22, N12, n2, m_RHS, point);
 
-      numGood3DPoints++;
-  } // end loop over 3D points
+        numGood3DPoints++;
+      } // end loop over 3D points
+    }
 
     m_bundleResults.setNumberConstrainedPointParameters(numConstrainedCoordinates);
     m_bundleResults.setNumberImageObservations(numObservations);
@@ -1347,6 +1393,172 @@ namespace Isis {
 }
 
 
+  /**
+   * Forms the contributions of the image control points to the normal equations on the global
+   * threads. This does the same work as the image control point loop in formNormalEquations(),
+   * and gives the same result to the last bit for any number of threads.
+   *
+   * The points are handled in batches, in three steps:
+   * @li The partials for every measure in the batch are computed one at a time in point order,
+   *     because they use the cameras and build the residual probability distributions. The
+   *     right hand side contributions of the measures are added to n1 as they are computed.
+   * @li The point normal equations, Q matrix, and NIC vector of each point are formed on the
+   *     threads. These only depend on the point's own measures.
+   * @li The block columns of the normal equations matrix are split into ranges, and each range
+   *     is handled on a thread. A thread goes through the batch in point order and adds the
+   *     contributions of every point to the blocks and right hand side elements of its columns.
+   *
+   * Every element of the normal equations is only changed by one thread, and it gets its
+   * contributions in the same order as in the serial loop.
+   *
+   * @param coeffTarget A matrix used to compute target body partial derivatives.
+   * @param coeffImage A matrix used to compute camera parameter partial derivatives.
+   * @param coeffPoint3D A matrix used to compute point partial derivatives.
+   * @param coeffRHS A vector used to compute weighted x,y residuals.
+   * @param n1 The right hand side vector for the camera and the target body.
+   * @param numObservations Incremented by the number of image observations.
+   * @param numGood3DPoints Incremented by the number of points that are not rejected.
+   * @param numRejected3DPoints Incremented by the number of rejected points.
+   * @param numConstrainedCoordinates Incremented by the number of constrained point
+   *                                  coordinates.
+   *
+   * @return @b bool The status of the last partials computation, as in formNormalEquations().
+   *
+   * @see BundleAdjust::formNormalEquations
+   */
+  bool BundleAdjust::formPointNormalsThreaded(LinearAlgebra::Matrix &coeffTarget,
+                                              LinearAlgebra::Matrix &coeffImage,
+                                              LinearAlgebra::Matrix &coeffPoint3D,
+                                              LinearAlgebra::Vector &coeffRHS,
+                                              LinearAlgebra::VectorCompressed &n1,
+                                              int &numObservations, int &numGood3DPoints,
+                                              int &numRejected3DPoints,
+                                              int &numConstrainedCoordinates) {
+    bool status = false;
+
+    // The partials of every measure in a batch are kept until its normals are formed
+    static const int pointsPerBatch = 4096;
+
+    int num3DPoints = m_bundleControlPoints.size();
+    std::vector<PointNormals> batch(std::min(pointsPerBatch, num3DPoints));
+
+    // Split the block columns into more ranges than threads to even out the work
+    int numColumns = m_sparseNormals.size();
+    int numRanges = std::min(numColumns, 4 * QThreadPool::globalInstance()->maxThreadCount());
+    QVector< QPair<int, int> > columnRanges;
+    for (int range = 0; range < numRanges; range++) {
+      columnRanges.append(qMakePair(range * numColumns / numRanges,
+                                    (range + 1) * numColumns / numRanges));
+    }
+
+    for (int batchStart = 0; batchStart < num3DPoints; batchStart += pointsPerBatch) {
+      int batchSize = std::min(pointsPerBatch, num3DPoints - batchStart);
+
+      for (int i = 0; i < batchSize; i++) {
+        emit(pointUpdate(batchStart+i+1));
+        PointNormals &pointNormals = batch[i];
+        pointNormals.point = m_bundleControlPoints.at(batchStart + i);
+        pointNormals.numPartials = 0;
+
+        if (pointNormals.point->isRejected()) {
+          numRejected3DPoints++;
+          continue;
+        }
+
+        int numMeasures = pointNormals.point->size();
+        for (int j = 0; j < numMeasures; j++) {
+          BundleMeasureQsp measure = pointNormals.point->at(j);
+
+          if (measure->isRejected()) {
+            continue;
+          }
+
+          // The partials are computed directly into storage that is reused from batch to batch
+          if (pointNormals.numPartials == (int) pointNormals.partials.size()) {
+            pointNormals.partials.push_back(MeasurePartials());
+          }
+          MeasurePartials &partials = pointNormals.partials[pointNormals.numPartials];
+          partials.coeffTarget.resize(coeffTarget.size1(), coeffTarget.size2(), false);
+          partials.coeffPoint3D.resize(coeffPoint3D.size1(), coeffPoint3D.size2(), false);
+          partials.coeffRHS.resize(coeffRHS.size(), false);
+          m_previousNumberImagePartials = partials.coeffImage.size2();
+
+          status = computePartials(partials.coeffTarget, partials.coeffImage,
+                                   partials.coeffPoint3D, partials.coeffRHS, *measure,
+                                   *pointNormals.point);
+
+          if (!status) {
+            continue;
+          }
+
+          numObservations += 2;
+
+          partials.observationIndex = measure->observationIndex();
+          accumMeasureRHS(n1, partials.coeffTarget, partials.coeffImage, partials.coeffRHS,
+                          partials.observationIndex);
+          pointNormals.numPartials++;
+        }
+
+        numGood3DPoints++;
+      }
+
+      QtConcurrent::blockingMap(batch.begin(), batch.begin() + batchSize,
+          [this](PointNormals &pointNormals) {
+        if (pointNormals.point->isRejected()) {
+          return;
+        }
+
+        pointNormals.N22.clear();
+        pointNormals.N12.wipe();
+        pointNormals.n2.clear();
+
+        for (int j = 0; j < pointNormals.numPartials; j++) {
+          MeasurePartials &partials = pointNormals.partials[j];
+          formMeasurePointNormals(pointNormals.N22, pointNormals.N12, pointNormals.n2,
+                                  partials.coeffTarget, partials.coeffImage,
+                                  partials.coeffPoint3D, partials.coeffRHS,
+                                  partials.observationIndex);
+        }
+
+        pointNormals.numConstrainedCoordinates =
+            formPointQMatrix(pointNormals.N22, pointNormals.N12, pointNormals.n2,
+                             pointNormals.point);
+      });
+
+      QtConcurrent::blockingMap(columnRanges,
+          [this, &batch, batchSize](const QPair<int, int> &columns) {
+        for (int i = 0; i < batchSize; i++) {
+          PointNormals &pointNormals = batch[i];
+          if (pointNormals.point->isRejected()) {
+            continue;
+          }
+
+          for (int j = 0; j < pointNormals.numPartials; j++) {
+            MeasurePartials &partials = pointNormals.partials[j];
+            accumMeasureNormals(columns.first, columns.second, partials.coeffTarget,
+                                partials.coeffImage, partials.observationIndex);
+          }
+
+          SparseBlockRowMatrix &Q = pointNormals.point->cholmodQMatrix();
+          productAB(pointNormals.N12, Q, columns.first, columns.second);
+          accumProductAlphaAB(-1.0, Q, pointNormals.n2, m_RHS, columns.first, columns.second);
+        }
+      });
+
+      for (int i = 0; i < batchSize; i++) {
+        if (!batch[i].point->isRejected()) {
+          numConstrainedCoordinates += batch[i].numConstrainedCoordinates;
+        }
+      }
+    }
+
+    // The partials were not computed into coeffImage, so its size has to be checked again
+    m_previousNumberImagePartials = coeffImage.size2();
+
+    return status;
+  }
+
+
   /**
    * Form the auxilary normal equation matrices for a measure.
    * N22, N12, n1, and n2 will contain the auxilary matrices when completed.
@@ -1376,6 +1588,35 @@ namespace Isis {
                                         LinearAlgebra::Vector &coeffRHS,
                                         int observationIndex) {
 
+    accumMeasureNormals(0, m_sparseNormals.size(), coeffTarget, coeffImage, observationIndex);
+
+    accumMeasureRHS(n1, coeffTarget, coeffImage, coeffRHS, observationIndex);
+
+    formMeasurePointNormals(N22, N12, n2, coeffTarget, coeffImage, coeffPoint3D, coeffRHS,
+                            observationIndex);
+
+    return true;
+  }
+
+
+  /**
+   * Add the camera and target body contributions of a measure to the blocks of
+   * m_sparseNormals that are in a range of block columns.
+   *
+   * @param firstColumn The first block column to add to.
+   * @param endColumn One past the last block column to add to.
+   * @param coeffTarget The matrix containing target body partial derivatives.
+   * @param coeffImage The matrix containing camera parameter partial derivatives.
+   * @param observationIndex The index of the observation containing the measure that
+   *                         the partial derivative matrices are for.
+   *
+   * @see BundleAdjust::formMeasureNormals
+   */
+  void BundleAdjust::accumMeasureNormals(int firstColumn, int endColumn,
+                                         LinearAlgebra::Matrix &coeffTarget,
+                                         LinearAlgebra::Matrix &coeffImage,
+                                         int observationIndex) {
+
     int blockIndex = observationIndex;
 
     // if we are solving for target body parameters
@@ -1383,19 +1624,60 @@ namespace Isis {
       int numTargetPartials = coeffTarget.size2();
       blockIndex++;
 
-      // insert submatrix at column, row
-      m_sparseNormals.insertMatrixBlock(0, 0, numTargetPartials, numTargetPartials);
+      if (firstColumn <= 0 && 0 < endColumn) {
+        // insert submatrix at column, row
+        SparseBlockColumnMatrix *targetColumn = m_sparseNormals.at(0);
+        targetColumn->insertMatrixBlock(0, numTargetPartials, numTargetPartials);
 
-      // contribution to N11 matrix for target body
-      (*(*m_sparseNormals[0])[0]) += prod(trans(coeffTarget), coeffTarget);
+        // contribution to N11 matrix for target body
+        (*(*targetColumn)[0]) += prod(trans(coeffTarget), coeffTarget);
+      }
 
-      m_sparseNormals.insertMatrixBlock(blockIndex, 0,
-                                        numTargetPartials, coeffImage.size2());
-      (*(*m_sparseNormals[blockIndex])[0]) += prod(trans(coeffTarget),coeffImage);
+      if (firstColumn <= blockIndex && blockIndex < endColumn) {
+        SparseBlockColumnMatrix *imageColumn = m_sparseNormals.at(blockIndex);
+        imageColumn->insertMatrixBlock(0, numTargetPartials, coeffImage.size2());
+        (*(*imageColumn)[0]) += prod(trans(coeffTarget),coeffImage);
+      }
+    }
 
-      // insert N12 target into N12
-      N12.insertMatrixBlock(0, numTargetPartials, 3);
-      *N12[0] += prod(trans(coeffTarget), coeffPoint3D);
+    if (blockIndex < firstColumn || blockIndex >= endColumn) {
+      return;
+    }
+
+    int numImagePartials = coeffImage.size2();
+
+    // insert submatrix at column, row
+    SparseBlockColumnMatrix *imageColumn = m_sparseNormals.at(blockIndex);
+    imageColumn->insertMatrixBlock(blockIndex, numImagePartials, numImagePartials);
+
+    (*(*imageColumn)[blockIndex]) += prod(trans(coeffImage), coeffImage);
+  }
+
+
+  /**
+   * Add the camera and target body right hand side contributions of a measure to n1.
+   *
+   * @param n1 The right hand side vector for the camera and the target body.
+   * @param coeffTarget The matrix containing target body partial derivatives.
+   * @param coeffImage The matrix containing camera parameter partial derivatives.
+   * @param coeffRHS The vector containing weighted x,y residuals.
+   * @param observationIndex The index of the observation containing the measure that
+   *                         the partial derivative matrices are for.
+   *
+   * @see BundleAdjust::formMeasureNormals
+   */
+  void BundleAdjust::accumMeasureRHS(LinearAlgebra::VectorCompressed &n1,
+                                     LinearAlgebra::Matrix &coeffTarget,
+                                     LinearAlgebra::Matrix &coeffImage,
+                                     LinearAlgebra::Vector &coeffRHS,
+                                     int observationIndex) {
+
+    int blockIndex = observationIndex;
+
+    // if we are solving for target body parameters
+    if (m_bundleSettings->solveTargetBody()) {
+      int numTargetPartials = coeffTarget.size2();
+      blockIndex++;
 
       // contribution to n1 vector
       vector_range<LinearAlgebra::VectorCompressed> n1_range(n1, range(0, numTargetPartials));
@@ -1403,19 +1685,8 @@ namespace Isis {
       n1_range += prod(trans(coeffTarget), coeffRHS);
     }
 
-
     int numImagePartials = coeffImage.size2();
 
-    // insert submatrix at column, row
-    m_sparseNormals.insertMatrixBlock(blockIndex, blockIndex,
-                                      numImagePartials, numImagePartials);
-
-    (*(*m_sparseNormals[blockIndex])[blockIndex]) += prod(trans(coeffImage), coeffImage);
-
-    // insert N12Image into N12
-    N12.insertMatrixBlock(blockIndex, numImagePartials, 3);
-    *N12[blockIndex] += prod(trans(coeffImage), coeffPoint3D);
-
     // insert n1Image into n1
     vector_range<LinearAlgebra::VectorCompressed> vr(
           n1,
@@ -1424,14 +1695,57 @@ namespace Isis {
                 m_sparseNormals.at(blockIndex)->startColumn() + numImagePartials));
 
     vr += prod(trans(coeffImage), coeffRHS);
+  }
+
+
+  /**
+   * Add the contributions of a measure to the normal equation matrices of its point.
+   * These do not change anything that is shared with other points.
+   *
+   * @param N22 The normal equation matrix for the point on the body.
+   * @param N12 The normal equation matrix for the camera and the target body.
+   * @param n2 The right hand side vector for the point on the body.
+   * @param coeffTarget The matrix containing target body partial derivatives.
+   * @param coeffImage The matrix containing camera parameter partial derivatives.
+   * @param coeffPoint3D The matrix containing point parameter partial derivatives.
+   * @param coeffRHS The vector containing weighted x,y residuals.
+   * @param observationIndex The index of the observation containing the measure that
+   *                         the partial derivative matrices are for.
+   *
+   * @see BundleAdjust::formMeasureNormals
+   */
+  void BundleAdjust::formMeasurePointNormals(LinearAlgebra::MatrixUpperTriangular &N22,
+                                             SparseBlockColumnMatrix &N12,
+                                             LinearAlgebra::Vector &n2,
+                                             LinearAlgebra::Matrix &coeffTarget,
+                                             LinearAlgebra::Matrix &coeffImage,
+                                             LinearAlgebra::Matrix &coeffPoint3D,
+                                             LinearAlgebra::Vector &coeffRHS,
+                                             int observationIndex) {
+
+    int blockIndex = observationIndex;
+
+    // if we are solving for target body parameters
+    if (m_bundleSettings->solveTargetBody()) {
+      int numTargetPartials = coeffTarget.size2();
+      blockIndex++;
+
+      // insert N12 target into N12
+      N12.insertMatrixBlock(0, numTargetPartials, 3);
+      *N12[0] += prod(trans(coeffTarget), coeffPoint3D);
+    }
+
+    int numImagePartials = coeffImage.size2();
+
+    // insert N12Image into N12
+    N12.insertMatrixBlock(blockIndex, numImagePartials, 3);
+    *N12[blockIndex] += prod(trans(coeffImage), coeffPoint3D);
 
     // form N22 matrix
     N22 += prod(trans(coeffPoint3D), coeffPoint3D);
 
     // form n2 vector
     n2 += prod(trans(coeffPoint3D), coeffRHS);
-
-    return true;
   }
 
 
@@ -1458,6 +1772,40 @@ namespace Isis {
                                       vector<double> &nj,
                                       BundleControlPointQsp &bundleControlPoint) {
 
+    int numConstrainedCoordinates = formPointQMatrix(N22, N12, n2, bundleControlPoint);
+
+    SparseBlockRowMatrix &Q = bundleControlPoint->cholmodQMatrix();
+
+    // accumulate -R directly into reduced normal equations
+    productAB(N12, Q);
+
+    // accumulate -nj
+    accumProductAlphaAB(-1.0, Q, n2, nj);
+
+    return numConstrainedCoordinates;
+  }
+
+
+  /**
+   * Compute the Q matrix and NIC vector for a control point and store them in the
+   * BundleControlPoint. The point weights are applied to N22 and n2, and N22 is inverted.
+   * Nothing that is shared with other points is changed.
+   *
+   * @param N22 The normal equation matrix for the point on the body.
+   * @param N12 The normal equation matrix for the camera and the target body.
+   * @param n2 The right hand side vector for the point on the body.
+   * @param bundleControlPoint The control point that the Q matrixs are NIC vector
+   *                           are being formed for.
+   *
+   * @return @b int Number of constrained coordinates.
+   *
+   * @see BundleAdjust::formPointNormals
+   */
+  int BundleAdjust::formPointQMatrix(symmetric_matrix<double, upper>&N22,
+                                     SparseBlockColumnMatrix &N12,
+                                     vector<double> &n2,
+                                     BundleControlPointQsp &bundleControlPoint) {
+
     boost::numeric::ublas::bounded_vector<double, 3> &NIC = bundleControlPoint->nicVector();
     SparseBlockRowMatrix &Q = bundleControlPoint->cholmodQMatrix();
 
@@ -1505,12 +1853,6 @@ namespace Isis {
     // form product of N22(inverse) and n2; store in NIC
     NIC = prod(N22, n2);
 
-    // accumulate -R directly into reduced normal equations
-    productAB(N12, Q);
-
-    // accumulate -nj
-    accumProductAlphaAB(-1.0, Q, n2, nj);
-
     return numConstrainedCoordinates;
   }
 
@@ -1716,6 +2058,24 @@ namespace Isis {
    */
   void BundleAdjust::productAB(SparseBlockColumnMatrix &N12,
                                SparseBlockRowMatrix &Q) {
+    productAB(N12, Q, 0, m_sparseNormals.size());
+  }
+
+
+  /**
+   * Perform the matrix multiplication C = N12 x Q for the blocks of C that are in a
+   * range of block columns. The result, C, is stored in m_sparseNormals.
+   *
+   * @param N12 A sparse block matrix.
+   * @param Q A sparse block matrix
+   * @param firstColumn The first block column of C to compute.
+   * @param endColumn One past the last block column of C to compute.
+   *
+   * @see BundleAdjust::formPointNormalsThreaded
+   */
+  void BundleAdjust::productAB(SparseBlockColumnMatrix &N12,
+                               SparseBlockRowMatrix &Q,
+                               int firstColumn, int endColumn) {
     // iterators for N12 and Q
     QMapIterator<int, LinearAlgebra::Matrix*> N12it(N12);
     QMapIterator<int, LinearAlgebra::Matrix*> Qit(Q);
@@ -1732,17 +2092,17 @@ namespace Isis {
 
         int columnIndex = Qit.key();
 
-        if ( rowIndex > columnIndex ) {
+        if ( rowIndex > columnIndex || columnIndex < firstColumn || columnIndex >= endColumn ) {
           continue;
         }
 
         LinearAlgebra::Matrix *Qblock = Qit.value();
 
         // insert submatrix at column, row
-        m_sparseNormals.insertMatrixBlock(columnIndex, rowIndex,
-                                          N12block->size1(), Qblock->size2());
+        SparseBlockColumnMatrix *column = m_sparseNormals.at(columnIndex);
+        column->insertMatrixBlock(rowIndex, N12block->size1(), Qblock->size2());
 
-        (*(*m_sparseNormals[columnIndex])[rowIndex]) -= prod(*N12block,*Qblock);
+        (*(*column)[rowIndex]) -= prod(*N12block,*Qblock);
       }
       Qit.toFront();
     }
@@ -1763,6 +2123,28 @@ namespace Isis {
                                          SparseBlockRowMatrix &Q,
                                          vector<double> &n2,
                                          vector<double> &nj) {
+    accumProductAlphaAB(alpha, Q, n2, nj, 0, m_sparseNormals.size());
+  }
+
+
+  /**
+   * Performs the matrix multiplication nj = nj + alpha (Q x n2) for the elements of nj
+   * that belong to a range of block columns.
+   *
+   * @param alpha A constant multiplier.
+   * @param Q A sparse block matrix.
+   * @param n2 A vector.
+   * @param nj The output accumulation vector.
+   * @param firstColumn The first block column to compute.
+   * @param endColumn One past the last block column to compute.
+   *
+   * @see BundleAdjust::formPointNormalsThreaded
+   */
+  void BundleAdjust::accumProductAlphaAB(double alpha,
+                                         SparseBlockRowMatrix &Q,
+                                         vector<double> &n2,
+                                         vector<double> &nj,
+                                         int firstColumn, int endColumn) {
 
     if (alpha == 0.0) {
       return;
@@ -1776,6 +2158,10 @@ namespace Isis {
       Qit.next();
 
       int columnIndex = Qit.key();
+      if ( columnIndex < firstColumn || columnIndex >= endColumn ) {
+        continue;
+      }
+
       LinearAlgebra::Matrix *Qblock = Qit.value();
 
       LinearAlgebra::Vector blockProduct = prod(trans(*Qblock),n2);
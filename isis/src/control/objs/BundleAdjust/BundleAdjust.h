@@ -412,6 +412,13 @@ namespace Isis {
       // normal equation matrices methods
 
       bool formNormalEquations();
+      bool formPointNormalsThreaded(LinearAlgebra::Matrix           &coeffTarget,
+                                    LinearAlgebra::Matrix           &coeffImage,
+                                    LinearAlgebra::Matrix           &coeffPoint3D,
+                                    LinearAlgebra::Vector           &coeffRHS,
+                                    LinearAlgebra::VectorCompressed &n1,
+                                    int &numObservations, int &numGood3DPoints,
+                                    int &numRejected3DPoints, int &numConstrainedCoordinates);
       bool computePartials(LinearAlgebra::Matrix  &coeffTarget,
                            LinearAlgebra::Matrix  &coeffImage,
                            LinearAlgebra::Matrix  &coeffPoint3D,
@@ -427,11 +434,33 @@ namespace Isis {
                               LinearAlgebra::Matrix                &coeffPoint3D,
                               LinearAlgebra::Vector                &coeffRHS,
                               int                                  observationIndex);
+      void accumMeasureNormals(int                   firstColumn,
+                               int                   endColumn,
+                               LinearAlgebra::Matrix &coeffTarget,
+                               LinearAlgebra::Matrix &coeffImage,
+                               int                   observationIndex);
+      void accumMeasureRHS(LinearAlgebra::VectorCompressed &n1,
+                           LinearAlgebra::Matrix           &coeffTarget,
+                           LinearAlgebra::Matrix           &coeffImage,
+                           LinearAlgebra::Vector           &coeffRHS,
+                           int                             observationIndex);
+      void formMeasurePointNormals(LinearAlgebra::MatrixUpperTriangular &N22,
+                                   SparseBlockColumnMatrix              &N12,
+                                   LinearAlgebra::Vector                &n2,
+                                   LinearAlgebra::Matrix                &coeffTarget,
+                                   LinearAlgebra::Matrix                &coeffImage,
+                                   LinearAlgebra::Matrix                &coeffPoint3D,
+                                   LinearAlgebra::Vector                &coeffRHS,
+                                   int                                  observationIndex);
       int formPointNormals(LinearAlgebra::MatrixUpperTriangular &N22,
                            SparseBlockColumnMatrix              &N12,
                            LinearAlgebra::Vector                &n2,
                            LinearAlgebra::Vector                &nj,
                            BundleControlPointQsp                &point);
+      int formPointQMatrix(LinearAlgebra::MatrixUpperTriangular &N22,
+                           SparseBlockColumnMatrix              &N12,
+                           LinearAlgebra::Vector                &n2,
+                           BundleControlPointQsp                &point);
       int formLidarPointNormals(LinearAlgebra::MatrixUpperTriangular &N22,
                                 SparseBlockColumnMatrix              &N12,
                                 LinearAlgebra::Vector                &n2,
@@ -444,10 +473,20 @@ namespace Isis {
 
       void productAB(SparseBlockColumnMatrix &A,
                      SparseBlockRowMatrix    &B);
+      void productAB(SparseBlockColumnMatrix &A,
+                     SparseBlockRowMatrix    &B,
+                     int                     firstColumn,
+                     int                     endColumn);
       void accumProductAlphaAB(double                alpha,
                                SparseBlockRowMatrix  &A,
                                LinearAlgebra::Vector &B,
                                LinearAlgebra::Vector &C);
+      void accumProductAlphaAB(double                alpha,
+                               SparseBlockRowMatrix  &A,
+                               LinearAlgebra::Vector &B,
+                               LinearAlgebra::Vector &C,
+                               int                   firstColumn,
+                               int                   endColumn);
       bool invert3x3(LinearAlgebra::MatrixUpperTriangular &m);
       bool productATransB(LinearAlgebra::MatrixUpperTriangular &N22,
                           SparseBlockColumnMatrix              &N12,
@@ -537,6 +576,10 @@ namespace Isis {
       int m_previousNumberImagePartials;                     /**!< used in ::computePartials method
                                                                    to avoid unnecessary resizing
                                                                    of the coeffImage matrix.*/
+      bool m_threadedNormalEquations;                        /**!< If the control point
+                                                                   contributions to the normal
+                                                                   equations are formed on the
+                                                                   global threads.*/
   };
 }
 
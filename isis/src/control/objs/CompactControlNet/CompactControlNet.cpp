@@ -0,0 +1,943 @@
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include "CompactControlNet.h"
+
+#include "ControlNet.h"
+#include "ControlNetVersioner.h"
+#include "Displacement.h"
+#include "FileName.h"
+#include "IException.h"
+#include "SpecialPixel.h"
+#include "SurfacePoint.h"
+
+using namespace std;
+using boost::numeric::ublas::symmetric_matrix;
+using boost::numeric::ublas::upper;
+
+namespace Isis {
+  namespace {
+    /**
+     * Appends the body-fixed coordinates of a surface point to one array and
+     * the upper triangle of its rectangular covariance to another, the same
+     * way ControlNetVersioner writes them. Nulls are appended for coordinates
+     * of a surface point that is not valid and for a covariance that is not
+     * set.
+     *
+     * @param surfacePoint The surface point
+     * @param requireSigmas If the covariance is only kept when the latitude,
+     *                      longitude and radius sigmas are all set, as for
+     *                      apriori surface points
+     * @param coordinates The array of coordinates to append to
+     * @param covariances The array of covariances to append to
+     */
+    void appendSurfacePoint(const SurfacePoint &surfacePoint, bool requireSigmas,
+                            vector<double> &coordinates, vector<double> &covariances) {
+      if (!surfacePoint.Valid()) {
+        coordinates.insert(coordinates.end(), 3, Null);
+        covariances.insert(covariances.end(), 6, Null);
+        return;
+      }
+
+      coordinates.push_back(surfacePoint.GetX().meters());
+      coordinates.push_back(surfacePoint.GetY().meters());
+      coordinates.push_back(surfacePoint.GetZ().meters());
+
+      symmetric_matrix<double, upper> covariance = surfacePoint.GetRectangularMatrix();
+      if (covariance.size1() == 0 ||
+          (requireSigmas && (surfacePoint.GetLatSigmaDistance().meters() == Null ||
+                             surfacePoint.GetLonSigmaDistance().meters() == Null ||
+                             surfacePoint.GetLocalRadiusSigma().meters() == Null))) {
+        covariances.insert(covariances.end(), 6, Null);
+        return;
+      }
+
+      covariances.push_back(covariance(0, 0));
+      covariances.push_back(covariance(0, 1));
+      covariances.push_back(covariance(0, 2));
+      covariances.push_back(covariance(1, 1));
+      covariances.push_back(covariance(1, 2));
+      covariances.push_back(covariance(2, 2));
+    }
+
+
+    /**
+     * Creates a surface point from body-fixed coordinates and the upper
+     * triangle of its rectangular covariance.
+     *
+     * @param coordinates The X, Y and Z of the point in meters
+     * @param covariance The six covariance values, or Nulls if there is no
+     *                   covariance
+     *
+     * @return @b SurfacePoint The surface point, invalid if the coordinates
+     *                         are Null
+     */
+    SurfacePoint surfacePoint(const double *coordinates, const double *covariance) {
+      if (IsSpecial(coordinates[0])) {
+        return SurfacePoint();
+      }
+
+      SurfacePoint point(Displacement(coordinates[0], Displacement::Meters),
+                         Displacement(coordinates[1], Displacement::Meters),
+                         Displacement(coordinates[2], Displacement::Meters));
+
+      if (!IsSpecial(covariance[0])) {
+        symmetric_matrix<double, upper> covarianceMatrix;
+        covarianceMatrix.resize(3);
+        covarianceMatrix.clear();
+        covarianceMatrix(0, 0) = covariance[0];
+        covarianceMatrix(0, 1) = covariance[1];
+        covarianceMatrix(0, 2) = covariance[2];
+        covarianceMatrix(1, 1) = covariance[3];
+        covarianceMatrix(1, 2) = covariance[4];
+        covarianceMatrix(2, 2) = covariance[5];
+        point.SetRectangularMatrix(covarianceMatrix);
+      }
+      return point;
+    }
+  }
+
+
+  /**
+   * Adds a string to the table if it is not in it yet.
+   *
+   * @param string The string to add
+   *
+   * @return @b int The index of the string
+   */
+  int CompactControlNet::StringTable::add(const QString &string) {
+    QHash<QString, int>::const_iterator it = indices.constFind(string);
+    if (it != indices.constEnd()) {
+      return it.value();
+    }
+
+    int index = strings.size();
+    strings.append(string);
+    indices.insert(string, index);
+    return index;
+  }
+
+
+  /**
+   * Returns the index of a string.
+   *
+   * @param string The string to look for
+   *
+   * @return @b int The index of the string, or -1 if it is not in the table
+   */
+  int CompactControlNet::StringTable::indexOf(const QString &string) const {
+    return indices.value(string, -1);
+  }
+
+
+  /**
+   * Creates an empty network.
+   */
+  CompactControlNet::CompactControlNet() {
+    m_pointMeasures.push_back(0);
+    m_measureLogs.push_back(0);
+  }
+
+
+  /**
+   * Reads a network file. The points are read and added one at a time.
+   *
+   * @param netFile The network file
+   * @param progress The progress of reading the network, or NULL
+   */
+  CompactControlNet::CompactControlNet(const FileName &netFile, Progress *progress) {
+    m_pointMeasures.push_back(0);
+    m_measureLogs.push_back(0);
+
+    ControlNetVersioner reader(netFile,
+                               [this](ControlPoint *point) {
+                                 addPoint(point);
+                                 delete point;
+                               },
+                               progress);
+
+    m_networkId = reader.netId();
+    m_targetName = reader.targetName();
+    m_userName = reader.userName();
+    m_created = reader.creationDate();
+    m_description = reader.description();
+  }
+
+
+  /**
+   * Creates a compact copy of a network.
+   *
+   * @param net The network to copy
+   */
+  CompactControlNet::CompactControlNet(const ControlNet &net) {
+    m_pointMeasures.push_back(0);
+    m_measureLogs.push_back(0);
+
+    m_networkId = net.GetNetworkId();
+    m_targetName = net.GetTarget();
+    m_userName = net.GetUserName();
+    m_created = net.CreatedDate();
+    m_description = net.Description();
+
+    for (int p = 0; p < net.GetNumPoints(); p++) {
+      addPoint(net.GetPoint(p));
+    }
+  }
+
+
+  //! Destroys the network
+  CompactControlNet::~CompactControlNet() {
+  }
+
+
+  /**
+   * Returns the network ID.
+   *
+   * @return @b QString The network ID
+   */
+  QString CompactControlNet::networkId() const {
+    return m_networkId;
+  }
+
+
+  /**
+   * Returns the name of the target.
+   *
+   * @return @b QString The target name
+   */
+  QString CompactControlNet::targetName() const {
+    return m_targetName;
+  }
+
+
+  /**
+   * Returns the name of the last user to change the network.
+   *
+   * @return @b QString The user name
+   */
+  QString CompactControlNet::userName() const {
+    return m_userName;
+  }
+
+
+  /**
+   * Returns the date the network was created.
+   *
+   * @return @b QString The creation date
+   */
+  QString CompactControlNet::createdDate() const {
+    return m_created;
+  }
+
+
+  /**
+   * Returns the network description.
+   *
+   * @return @b QString The description
+   */
+  QString CompactControlNet::description() const {
+    return m_description;
+  }
+
+
+  /**
+   * Sets the network ID.
+   *
+   * @param id The network ID
+   */
+  void CompactControlNet::setNetworkId(const QString &id) {
+    m_networkId = id;
+  }
+
+
+  /**
+   * Sets the name of the target.
+   *
+   * @param target The target name
+   */
+  void CompactControlNet::setTargetName(const QString &target) {
+    m_targetName = target;
+  }
+
+
+  /**
+   * Sets the name of the last user to change the network.
+   *
+   * @param name The user name
+   */
+  void CompactControlNet::setUserName(const QString &name) {
+    m_userName = name;
+  }
+
+
+  /**
+   * Sets the date the network was created.
+   *
+   * @param date The creation date
+   */
+  void CompactControlNet::setCreatedDate(const QString &date) {
+    m_created = date;
+  }
+
+
+  /**
+   * Sets the network description.
+   *
+   * @param description The description
+   */
+  void CompactControlNet::setDescription(const QString &description) {
+    m_description = description;
+  }
+
+
+  /**
+   * Adds a copy of a control point and its measures to the end of the
+   * network. The point is not changed or taken.
+   *
+   * @param point The control point to add
+   *
+   * @throws IException::Programmer "Control point already exists in the network"
+   */
+  void CompactControlNet::addPoint(const ControlPoint *point) {
+    if (m_pointIds.indexOf(point->GetId()) != -1) {
+      QString msg = "Control point [" + point->GetId() + "] already exists in the network";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    int pointIndex = m_pointIds.add(point->GetId());
+    int firstMeasure = numMeasures();
+
+    m_pointChooser.push_back(m_chooserNames.add(point->GetChooserName()));
+    m_pointTypes.push_back(point->GetType());
+    m_pointFlags.push_back((point->IsIgnored() ? Ignored : 0) |
+                           (point->IsEditLocked() ? EditLocked : 0) |
+                           (point->IsRejected() ? Rejected : 0));
+    m_pointReference.push_back(point->IsReferenceExplicit() ?
+                               firstMeasure + point->IndexOfRefMeasure() : -1);
+    appendSurfacePoint(point->GetAprioriSurfacePoint(), true,
+                       m_aprioriCoordinates, m_aprioriCovariances);
+    appendSurfacePoint(point->GetAdjustedSurfacePoint(), false,
+                       m_adjustedCoordinates, m_adjustedCovariances);
+    m_pointDates.push_back(m_texts.add(point->GetDateTime()));
+    m_pointSources.push_back(point->GetAprioriSurfacePointSource());
+    m_pointSources.push_back(point->GetAprioriRadiusSource());
+    m_pointSourceFiles.push_back(m_texts.add(point->GetAprioriSurfacePointSourceFile()));
+    m_pointSourceFiles.push_back(m_texts.add(point->GetAprioriRadiusSourceFile()));
+
+    for (int m = 0; m < point->GetNumMeasures(); m++) {
+      const ControlMeasure *measure = point->GetMeasure(m);
+
+      int image = m_serialNumbers.add(measure->GetCubeSerialNumber());
+      if (image == (int) m_imageMeasureCounts.size()) {
+        m_imageMeasureCounts.push_back(0);
+      }
+      m_imageMeasureCounts[image]++;
+
+      m_measurePoint.push_back(pointIndex);
+      m_measureImage.push_back(image);
+      m_measureChooser.push_back(m_chooserNames.add(measure->GetChooserName()));
+      m_measureTypes.push_back(measure->GetType());
+      m_measureFlags.push_back((measure->IsIgnored() ? Ignored : 0) |
+                               (measure->IsEditLocked() ? EditLocked : 0) |
+                               (measure->IsRejected() ? Rejected : 0));
+      m_coordinates.push_back(measure->GetSample());
+      m_coordinates.push_back(measure->GetLine());
+      m_aprioriMeasures.push_back(measure->GetAprioriSample());
+      m_aprioriMeasures.push_back(measure->GetAprioriLine());
+      m_residuals.push_back(measure->GetSampleResidual());
+      m_residuals.push_back(measure->GetLineResidual());
+      m_sigmas.push_back(measure->GetSampleSigma());
+      m_sigmas.push_back(measure->GetLineSigma());
+      m_diameters.push_back(measure->GetDiameter());
+      m_measureDates.push_back(m_texts.add(measure->GetDateTime()));
+
+      QVector<ControlMeasureLogData> logs = measure->GetLogDataEntries();
+      for (int l = 0; l < logs.size(); l++) {
+        if (logs[l].IsValid()) {
+          m_logTypes.push_back(logs[l].GetDataType());
+          m_logValues.push_back(logs[l].GetNumericalValue());
+        }
+      }
+      m_measureLogs.push_back(m_logTypes.size());
+    }
+
+    m_pointMeasures.push_back(numMeasures());
+  }
+
+
+  /**
+   * Returns the number of points in the network.
+   *
+   * @return @b int The number of points
+   */
+  int CompactControlNet::numPoints() const {
+    return m_pointTypes.size();
+  }
+
+
+  /**
+   * Returns the number of measures in the network.
+   *
+   * @return @b int The number of measures
+   */
+  int CompactControlNet::numMeasures() const {
+    return m_measureTypes.size();
+  }
+
+
+  /**
+   * Returns the number of images that have measures in the network.
+   *
+   * @return @b int The number of images
+   */
+  int CompactControlNet::numImages() const {
+    return m_serialNumbers.strings.size();
+  }
+
+
+  /**
+   * Returns the ID of a point.
+   *
+   * @param point The index of the point
+   *
+   * @return @b QString The point ID
+   */
+  QString CompactControlNet::pointId(int point) const {
+    return m_pointIds.strings[point];
+  }
+
+
+  /**
+   * Returns the index of the point with an ID.
+   *
+   * @param pointId The point ID
+   *
+   * @return @b int The index of the point, or -1 if there is no such point
+   */
+  int CompactControlNet::pointIndex(const QString &pointId) const {
+    return m_pointIds.indexOf(pointId);
+  }
+
+
+  /**
+   * Returns the type of a point.
+   *
+   * @param point The index of the point
+   *
+   * @return @b ControlPoint::PointType The point type
+   */
+  ControlPoint::PointType CompactControlNet::pointType(int point) const {
+    return (ControlPoint::PointType) m_pointTypes[point];
+  }
+
+
+  /**
+   * Returns the chooser name of a point.
+   *
+   * @param point The index of the point
+   *
+   * @return @b QString The chooser name
+   */
+  QString CompactControlNet::pointChooserName(int point) const {
+    return m_chooserNames.strings[m_pointChooser[point]];
+  }
+
+
+  /**
+   * Returns whether a point is ignored.
+   *
+   * @param point The index of the point
+   *
+   * @return @b bool True if the point is ignored
+   */
+  bool CompactControlNet::isPointIgnored(int point) const {
+    return m_pointFlags[point] & Ignored;
+  }
+
+
+  /**
+   * Returns whether a point is edit locked.
+   *
+   * @param point The index of the point
+   *
+   * @return @b bool True if the point is edit locked
+   */
+  bool CompactControlNet::isPointEditLocked(int point) const {
+    return m_pointFlags[point] & EditLocked;
+  }
+
+
+  /**
+   * Returns whether a point was rejected by a bundle adjustment.
+   *
+   * @param point The index of the point
+   *
+   * @return @b bool True if the point is rejected
+   */
+  bool CompactControlNet::isPointRejected(int point) const {
+    return m_pointFlags[point] & Rejected;
+  }
+
+
+  /**
+   * Returns the explicit reference measure of a point.
+   *
+   * @param point The index of the point
+   *
+   * @return @b int The index of the reference measure, or -1 if the point
+   *                does not have an explicit reference
+   */
+  int CompactControlNet::referenceMeasure(int point) const {
+    return m_pointReference[point];
+  }
+
+
+  /**
+   * Returns the first measure of a point.
+   *
+   * @param point The index of the point
+   *
+   * @return @b int The index of the first measure
+   */
+  int CompactControlNet::measureBegin(int point) const {
+    return m_pointMeasures[point];
+  }
+
+
+  /**
+   * Returns the index after the last measure of a point.
+   *
+   * @param point The index of the point
+   *
+   * @return @b int One more than the index of the last measure
+   */
+  int CompactControlNet::measureEnd(int point) const {
+    return m_pointMeasures[point + 1];
+  }
+
+
+  /**
+   * Returns the apriori body-fixed coordinates of a point.
+   *
+   * @param point The index of the point
+   *
+   * @return @b const double* The X, Y and Z of the point in meters, Null
+   *                          if the point has no apriori surface point
+   */
+  const double *CompactControlNet::aprioriCoordinates(int point) const {
+    return &m_aprioriCoordinates[3 * point];
+  }
+
+
+  /**
+   * Returns the adjusted body-fixed coordinates of a point.
+   *
+   * @param point The index of the point
+   *
+   * @return @b const double* The X, Y and Z of the point in meters, Null
+   *                          if the point has no adjusted surface point
+   */
+  const double *CompactControlNet::adjustedCoordinates(int point) const {
+    return &m_adjustedCoordinates[3 * point];
+  }
+
+
+  /**
+   * Returns the apriori rectangular covariance of a point.
+   *
+   * @param point The index of the point
+   *
+   * @return @b const double* The XX, XY, XZ, YY, YZ and ZZ covariances in
+   *                          square meters, Null if the apriori surface
+   *                          point has no sigmas
+   */
+  const double *CompactControlNet::aprioriCovariance(int point) const {
+    return &m_aprioriCovariances[6 * point];
+  }
+
+
+  /**
+   * Returns the adjusted rectangular covariance of a point.
+   *
+   * @param point The index of the point
+   *
+   * @return @b const double* The XX, XY, XZ, YY, YZ and ZZ covariances in
+   *                          square meters, Null if the adjusted surface
+   *                          point has no covariance
+   */
+  const double *CompactControlNet::adjustedCovariance(int point) const {
+    return &m_adjustedCovariances[6 * point];
+  }
+
+
+  /**
+   * Returns the date a point was last changed.
+   *
+   * @param point The index of the point
+   *
+   * @return @b QString The date
+   */
+  QString CompactControlNet::pointDateTime(int point) const {
+    return m_texts.strings[m_pointDates[point]];
+  }
+
+
+  /**
+   * Returns the point a measure belongs to.
+   *
+   * @param measure The index of the measure
+   *
+   * @return @b int The index of the point
+   */
+  int CompactControlNet::measurePoint(int measure) const {
+    return m_measurePoint[measure];
+  }
+
+
+  /**
+   * Returns the image of a measure.
+   *
+   * @param measure The index of the measure
+   *
+   * @return @b int The index of the image
+   */
+  int CompactControlNet::measureImage(int measure) const {
+    return m_measureImage[measure];
+  }
+
+
+  /**
+   * Returns the type of a measure.
+   *
+   * @param measure The index of the measure
+   *
+   * @return @b ControlMeasure::MeasureType The measure type
+   */
+  ControlMeasure::MeasureType CompactControlNet::measureType(int measure) const {
+    return (ControlMeasure::MeasureType) m_measureTypes[measure];
+  }
+
+
+  /**
+   * Returns the chooser name of a measure.
+   *
+   * @param measure The index of the measure
+   *
+   * @return @b QString The chooser name
+   */
+  QString CompactControlNet::measureChooserName(int measure) const {
+    return m_chooserNames.strings[m_measureChooser[measure]];
+  }
+
+
+  /**
+   * Returns whether a measure is ignored.
+   *
+   * @param measure The index of the measure
+   *
+   * @return @b bool True if the measure is ignored
+   */
+  bool CompactControlNet::isMeasureIgnored(int measure) const {
+    return m_measureFlags[measure] & Ignored;
+  }
+
+
+  /**
+   * Returns whether a measure is edit locked.
+   *
+   * @param measure The index of the measure
+   *
+   * @return @b bool True if the measure is edit locked
+   */
+  bool CompactControlNet::isMeasureEditLocked(int measure) const {
+    return m_measureFlags[measure] & EditLocked;
+  }
+
+
+  /**
+   * Returns whether a measure was rejected by a bundle adjustment.
+   *
+   * @param measure The index of the measure
+   *
+   * @return @b bool True if the measure is rejected
+   */
+  bool CompactControlNet::isMeasureRejected(int measure) const {
+    return m_measureFlags[measure] & Rejected;
+  }
+
+
+  /**
+   * Returns the sample of a measure.
+   *
+   * @param measure The index of the measure
+   *
+   * @return @b double The sample
+   */
+  double CompactControlNet::sample(int measure) const {
+    return m_coordinates[2 * measure];
+  }
+
+
+  /**
+   * Returns the line of a measure.
+   *
+   * @param measure The index of the measure
+   *
+   * @return @b double The line
+   */
+  double CompactControlNet::line(int measure) const {
+    return m_coordinates[2 * measure + 1];
+  }
+
+
+  /**
+   * Returns the apriori sample of a measure.
+   *
+   * @param measure The index of the measure
+   *
+   * @return @b double The apriori sample
+   */
+  double CompactControlNet::aprioriSample(int measure) const {
+    return m_aprioriMeasures[2 * measure];
+  }
+
+
+  /**
+   * Returns the apriori line of a measure.
+   *
+   * @param measure The index of the measure
+   *
+   * @return @b double The apriori line
+   */
+  double CompactControlNet::aprioriLine(int measure) const {
+    return m_aprioriMeasures[2 * measure + 1];
+  }
+
+
+  /**
+   * Returns the sample residual of a measure.
+   *
+   * @param measure The index of the measure
+   *
+   * @return @b double The sample residual
+   */
+  double CompactControlNet::sampleResidual(int measure) const {
+    return m_residuals[2 * measure];
+  }
+
+
+  /**
+   * Returns the line residual of a measure.
+   *
+   * @param measure The index of the measure
+   *
+   * @return @b double The line residual
+   */
+  double CompactControlNet::lineResidual(int measure) const {
+    return m_residuals[2 * measure + 1];
+  }
+
+
+  /**
+   * Returns the sample sigma of a measure.
+   *
+   * @param measure The index of the measure
+   *
+   * @return @b double The sample sigma
+   */
+  double CompactControlNet::sampleSigma(int measure) const {
+    return m_sigmas[2 * measure];
+  }
+
+
+  /**
+   * Returns the line sigma of a measure.
+   *
+   * @param measure The index of the measure
+   *
+   * @return @b double The line sigma
+   */
+  double CompactControlNet::lineSigma(int measure) const {
+    return m_sigmas[2 * measure + 1];
+  }
+
+
+  /**
+   * Returns the date a measure was last changed.
+   *
+   * @param measure The index of the measure
+   *
+   * @return @b QString The date
+   */
+  QString CompactControlNet::measureDateTime(int measure) const {
+    return m_texts.strings[m_measureDates[measure]];
+  }
+
+
+  /**
+   * Returns the log data of a measure.
+   *
+   * @param measure The index of the measure
+   *
+   * @return @b QVector<ControlMeasureLogData> The log data entries
+   */
+  QVector<ControlMeasureLogData> CompactControlNet::measureLogData(int measure) const {
+    QVector<ControlMeasureLogData> logs;
+    for (int l = m_measureLogs[measure]; l < m_measureLogs[measure + 1]; l++) {
+      logs.append(ControlMeasureLogData(
+          (ControlMeasureLogData::NumericLogDataType) m_logTypes[l], m_logValues[l]));
+    }
+    return logs;
+  }
+
+
+  /**
+   * Returns the cube serial number of an image.
+   *
+   * @param image The index of the image
+   *
+   * @return @b QString The cube serial number
+   */
+  QString CompactControlNet::imageSerialNumber(int image) const {
+    return m_serialNumbers.strings[image];
+  }
+
+
+  /**
+   * Returns the index of the image with a cube serial number.
+   *
+   * @param serialNumber The cube serial number
+   *
+   * @return @b int The index of the image, or -1 if no measure is on the image
+   */
+  int CompactControlNet::imageIndex(const QString &serialNumber) const {
+    return m_serialNumbers.indexOf(serialNumber);
+  }
+
+
+  /**
+   * Returns the number of measures on an image.
+   *
+   * @param image The index of the image
+   *
+   * @return @b int The number of measures
+   */
+  int CompactControlNet::numMeasuresInImage(int image) const {
+    return m_imageMeasureCounts[image];
+  }
+
+
+  /**
+   * Creates a control point with the information stored for a point and its
+   * measures. The caller takes ownership of the point.
+   *
+   * @param point The index of the point
+   *
+   * @return @b ControlPoint* The new control point
+   */
+  ControlPoint *CompactControlNet::createPoint(int point) const {
+    ControlPoint *newPoint = new ControlPoint(pointId(point));
+
+    for (int m = measureBegin(point); m < measureEnd(point); m++) {
+      ControlMeasure *measure = new ControlMeasure;
+      measure->SetCubeSerialNumber(imageSerialNumber(measureImage(m)));
+      measure->SetCoordinate(sample(m), line(m), measureType(m));
+      measure->SetAprioriSample(aprioriSample(m));
+      measure->SetAprioriLine(aprioriLine(m));
+      measure->SetResidual(sampleResidual(m), lineResidual(m));
+      measure->SetSampleSigma(sampleSigma(m));
+      measure->SetLineSigma(lineSigma(m));
+      measure->SetDiameter(m_diameters[m]);
+      measure->SetIgnored(isMeasureIgnored(m));
+      measure->SetRejected(isMeasureRejected(m));
+      foreach (const ControlMeasureLogData &log, measureLogData(m)) {
+        measure->SetLogData(log);
+      }
+      // Changing a measure clears its chooser name and date, so set them last
+      measure->SetChooserName(measureChooserName(m));
+      measure->SetDateTime(measureDateTime(m));
+      newPoint->Add(measure);
+    }
+
+    if (referenceMeasure(point) != -1) {
+      newPoint->SetRefMeasure(referenceMeasure(point) - measureBegin(point));
+    }
+
+    newPoint->SetType(pointType(point));
+    newPoint->SetIgnored(isPointIgnored(point));
+    newPoint->SetRejected(isPointRejected(point));
+    newPoint->SetChooserName(pointChooserName(point));
+    newPoint->SetAprioriSurfacePointSource(
+        (ControlPoint::SurfacePointSource::Source) m_pointSources[2 * point]);
+    newPoint->SetAprioriRadiusSource(
+        (ControlPoint::RadiusSource::Source) m_pointSources[2 * point + 1]);
+    newPoint->SetAprioriSurfacePointSourceFile(m_texts.strings[m_pointSourceFiles[2 * point]]);
+    newPoint->SetAprioriRadiusSourceFile(m_texts.strings[m_pointSourceFiles[2 * point + 1]]);
+
+    // The constraints of the point come from the apriori sigmas, which are
+    //   only used once the type is set
+    newPoint->SetAdjustedSurfacePoint(surfacePoint(adjustedCoordinates(point),
+                                                   adjustedCovariance(point)));
+    newPoint->SetAprioriSurfacePoint(surfacePoint(aprioriCoordinates(point),
+                                                  aprioriCovariance(point)));
+
+    // Setting anything else on the point clears its date, and edit locks
+    //   stop any other changes, so set them after everything else
+    newPoint->SetDateTime(pointDateTime(point));
+    for (int m = measureBegin(point); m < measureEnd(point); m++) {
+      newPoint->GetMeasure(m - measureBegin(point))->SetEditLock(isMeasureEditLocked(m));
+    }
+    newPoint->SetEditLock(isPointEditLocked(point));
+
+    return newPoint;
+  }
+
+
+  /**
+   * Creates a control network with the information stored for the network,
+   * its points and measures. The caller takes ownership of the network.
+   *
+   * @return @b ControlNet* The new control network
+   */
+  ControlNet *CompactControlNet::toControlNet() const {
+    ControlNet *net = new ControlNet;
+    net->SetNetworkId(m_networkId);
+    net->SetTarget(m_targetName);
+    net->SetUserName(m_userName);
+    net->SetCreatedDate(m_created);
+    net->SetDescription(m_description);
+
+    for (int p = 0; p < numPoints(); p++) {
+      net->AddPoint(createPoint(p));
+    }
+
+    return net;
+  }
+
+
+  /**
+   * Writes the network to a binary control network file. The points are
+   * created and written one at a time, so the whole network is never in
+   * memory as ControlPoints.
+   *
+   * @param netFile The file to write
+   */
+  void CompactControlNet::write(const FileName &netFile) const {
+    // The header of the file comes from a network without points
+    ControlNet header;
+    header.SetNetworkId(m_networkId);
+    header.SetTarget(m_targetName);
+    header.SetUserName(m_userName);
+    header.SetCreatedDate(m_created);
+    header.SetDescription(m_description);
+
+    ControlNetVersioner writer(&header);
+    writer.write(netFile, numPoints(),
+                 [this](int point) {
+                   return createPoint(point);
+                 });
+  }
+}
@@ -0,0 +1,192 @@
+#ifndef CompactControlNet_h
+#define CompactControlNet_h
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include <vector>
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include "ControlMeasure.h"
+#include "ControlMeasureLogData.h"
+#include "ControlPoint.h"
+
+namespace Isis {
+  class ControlNet;
+  class FileName;
+  class Progress;
+
+  /**
+   * @brief A control network stored in flat arrays
+   *
+   * CompactControlNet stores the points and measures of a control network in
+   * flat arrays indexed by integer point, measure and image indices, instead
+   * of one ControlPoint and ControlMeasure object for each point and measure.
+   * Point IDs, cube serial numbers and chooser names are stored once each in
+   * string tables. The measures of a point are stored together, the measures
+   * of point p are the measures from measureBegin(p) to measureEnd(p) - 1.
+   *
+   * Everything a binary control network file holds is kept: the positions,
+   * sigmas, residuals, types, flags, dates and log data of the measures, and
+   * the apriori and adjusted body-fixed coordinates and covariances, apriori
+   * sources, dates and flags of the points. Writing a CompactControlNet read
+   * from a network gives the same network.
+   *
+   * Networks are read and written through ControlNetVersioner one point at a
+   * time, so the whole network is never in memory as ControlPoints.
+   * createPoint() and toControlNet() create ControlPoints and ControlNets for
+   * code that needs them.
+   *
+   * @ingroup ControlNetwork
+   */
+  class CompactControlNet {
+    public:
+      CompactControlNet();
+      CompactControlNet(const FileName &netFile, Progress *progress = NULL);
+      CompactControlNet(const ControlNet &net);
+      ~CompactControlNet();
+
+      QString networkId() const;
+      QString targetName() const;
+      QString userName() const;
+      QString createdDate() const;
+      QString description() const;
+
+      void setNetworkId(const QString &id);
+      void setTargetName(const QString &target);
+      void setUserName(const QString &name);
+      void setCreatedDate(const QString &date);
+      void setDescription(const QString &description);
+
+      void addPoint(const ControlPoint *point);
+
+      int numPoints() const;
+      int numMeasures() const;
+      int numImages() const;
+
+      QString pointId(int point) const;
+      int pointIndex(const QString &pointId) const;
+      ControlPoint::PointType pointType(int point) const;
+      QString pointChooserName(int point) const;
+      bool isPointIgnored(int point) const;
+      bool isPointEditLocked(int point) const;
+      bool isPointRejected(int point) const;
+      int referenceMeasure(int point) const;
+      int measureBegin(int point) const;
+      int measureEnd(int point) const;
+      QString pointDateTime(int point) const;
+      const double *aprioriCoordinates(int point) const;
+      const double *adjustedCoordinates(int point) const;
+      const double *aprioriCovariance(int point) const;
+      const double *adjustedCovariance(int point) const;
+
+      int measurePoint(int measure) const;
+      int measureImage(int measure) const;
+      ControlMeasure::MeasureType measureType(int measure) const;
+      QString measureChooserName(int measure) const;
+      bool isMeasureIgnored(int measure) const;
+      bool isMeasureEditLocked(int measure) const;
+      bool isMeasureRejected(int measure) const;
+      double sample(int measure) const;
+      double line(int measure) const;
+      double aprioriSample(int measure) const;
+      double aprioriLine(int measure) const;
+      double sampleResidual(int measure) const;
+      double lineResidual(int measure) const;
+      double sampleSigma(int measure) const;
+      double lineSigma(int measure) const;
+      QString measureDateTime(int measure) const;
+      QVector<ControlMeasureLogData> measureLogData(int measure) const;
+
+      QString imageSerialNumber(int image) const;
+      int imageIndex(const QString &serialNumber) const;
+      int numMeasuresInImage(int image) const;
+
+      ControlPoint *createPoint(int point) const;
+      ControlNet *toControlNet() const;
+      void write(const FileName &netFile) const;
+
+    private:
+      /**
+       * The flags of a point or measure
+       */
+      enum Flag {
+        Ignored = 1,    //!< The point or measure is ignored
+        EditLocked = 2, //!< The point or measure is edit locked
+        Rejected = 4    //!< The point or measure was rejected by a bundle adjustment
+      };
+
+      /**
+       * Strings that are stored once and referred to by index.
+       */
+      struct StringTable {
+        QVector<QString> strings;     //!< The strings, by index
+        QHash<QString, int> indices;  //!< The index of each string
+
+        int add(const QString &string);
+        int indexOf(const QString &string) const;
+      };
+
+      QString m_networkId;   //!< The network ID
+      QString m_targetName;  //!< The target name
+      QString m_userName;    //!< The name of the last user to change the network
+      QString m_created;     //!< The date the network was created
+      QString m_description; //!< The network description
+
+      StringTable m_pointIds;      //!< The point IDs
+      StringTable m_serialNumbers; //!< The cube serial numbers of the images
+      StringTable m_chooserNames;  //!< The point and measure chooser names
+      StringTable m_texts;         //!< The dates and apriori source files
+
+      // Point arrays, indexed by point
+      std::vector<int> m_pointChooser;           //!< The chooser name of each point
+      std::vector<unsigned char> m_pointTypes;   //!< The type of each point
+      std::vector<unsigned char> m_pointFlags;   //!< The Flags of each point
+      std::vector<int> m_pointReference;         /**< The explicit reference measure of each
+                                                      point, -1 if there is none*/
+      std::vector<int> m_pointMeasures;          /**< The first measure of each point, and
+                                                      numMeasures() at the end*/
+      std::vector<double> m_aprioriCoordinates;  //!< The apriori X, Y and Z of each point
+      std::vector<double> m_adjustedCoordinates; //!< The adjusted X, Y and Z of each point
+      std::vector<double> m_aprioriCovariances;  /**< The upper triangle of the apriori
+                                                      rectangular covariance of each point*/
+      std::vector<double> m_adjustedCovariances; /**< The upper triangle of the adjusted
+                                                      rectangular covariance of each point*/
+      std::vector<int> m_pointDates;             //!< The date of each point, in m_texts
+      std::vector<unsigned char> m_pointSources; /**< The apriori surface point and radius
+                                                      sources of each point*/
+      std::vector<int> m_pointSourceFiles;       /**< The apriori surface point and radius
+                                                      source files of each point, in m_texts*/
+
+      // Measure arrays, indexed by measure
+      std::vector<int> m_measurePoint;            //!< The point of each measure
+      std::vector<int> m_measureImage;            //!< The image of each measure
+      std::vector<int> m_measureChooser;          //!< The chooser name of each measure
+      std::vector<unsigned char> m_measureTypes;  //!< The type of each measure
+      std::vector<unsigned char> m_measureFlags;  //!< The Flags of each measure
+      std::vector<double> m_coordinates;          //!< The sample and line of each measure
+      std::vector<double> m_aprioriMeasures;      /**< The apriori sample and line of each
+                                                       measure*/
+      std::vector<double> m_residuals;            /**< The sample and line residuals of each
+                                                       measure*/
+      std::vector<double> m_sigmas;               /**< The sample and line sigmas of each
+                                                       measure*/
+      std::vector<double> m_diameters;            //!< The diameter of each measure
+      std::vector<int> m_measureDates;            //!< The date of each measure, in m_texts
+      std::vector<int> m_measureLogs;             /**< The first log entry of each measure,
+                                                       and the number of entries at the end*/
+
+      // Log data arrays, indexed by log entry
+      std::vector<unsigned char> m_logTypes;      //!< The data type of each log entry
+      std::vector<double> m_logValues;            //!< The value of each log entry
+
+      std::vector<int> m_imageMeasureCounts;      //!< The number of measures in each image
+  };
+}
+
+#endif
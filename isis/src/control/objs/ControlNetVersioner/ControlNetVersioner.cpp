@@ -11,8 +11,11 @@ find files of those names at the top level of this repository. **/
 #include <boost/numeric/ublas/symmetric.hpp>
 #include <boost/numeric/ublas/io.hpp>
 
+#include <QByteArray>
 #include <QDebug>
+#include <QScopedPointer>
 #include <QString>
+#include <QtConcurrentMap>
 
 #include "ControlNetFileHeaderV0002.pb.h"
 #include "ControlNetFileHeaderV0005.pb.h"
@@ -53,6 +56,22 @@ using namespace std;
 
 namespace Isis {
 
+  namespace {
+    /**
+     * One length prefixed point message in a batch read from a V0005 network, and the result
+     * of decoding it.
+     */
+    struct PointMessage {
+      PointMessage() : index(0), offset(0), size(0), point(NULL) {}
+
+      int index;                       //!< Index of the point in the network
+      qint64 offset;                   //!< Where the message starts in the batch
+      qint64 size;                     //!< Size of the message in bytes
+      ControlPoint *point;             //!< The decoded point
+      QSharedPointer<IException> error; //!< Why the point could not be decoded, if it failed
+    };
+  }
+
   /**
    * Construct a ControlNetVersioner from a control network. This versioner can only be used to
    * write out the control points in the control network. It is expected that the control points
@@ -93,6 +112,26 @@ namespace Isis {
   }
 
 
+  /**
+   * Read a control network file, passing each control point to a handler as soon as it is
+   * created instead of keeping the points in the versioner. This allows a network to be
+   * processed without holding all of its points in memory. The points are passed in file order,
+   * one at a time, from the calling thread. The handler takes ownership of each point.
+   *
+   * After construction, the header accessors can be used, and numPoints() is 0.
+   *
+   * @param netFile The control network file to read in.
+   * @param pointHandler Called with each ControlPoint read from the file.
+   * @param progress The progress object to track reading points.
+   */
+  ControlNetVersioner::ControlNetVersioner(const FileName netFile,
+                                           std::function<void(ControlPoint *)> pointHandler,
+                                           Progress *progress)
+      : m_ownsPoints(true), m_pointHandler(pointHandler) {
+    read(netFile, progress);
+  }
+
+
   /**
    * Destroy a ControlNetVersioner. If the versioner owns the control points stored in it,
    * they will also be deleted.
@@ -651,7 +690,7 @@ namespace Isis {
         PvlObject pointObject = network.object(objectIndex);
         ControlPointV0001 point(pointObject, m_header.targetName);
 
-        m_points.append( createPoint(point) );
+        addPoint( createPoint(point) );
 
         if (progress) {
           progress->CheckStatus();
@@ -702,7 +741,7 @@ namespace Isis {
         PvlObject pointObject = network.object(objectIndex);
         ControlPointV0002 point(pointObject);
 
-        m_points.append( createPoint(point) );
+        addPoint( createPoint(point) );
 
         if (progress) {
           progress->CheckStatus();
@@ -752,7 +791,7 @@ namespace Isis {
       try {
         PvlObject pointObject = network.object(objectIndex);
         ControlPointV0003 point(pointObject);
-        m_points.append( createPoint(point) );
+        addPoint( createPoint(point) );
 
         if (progress) {
           progress->CheckStatus();
@@ -802,7 +841,7 @@ namespace Isis {
       try {
         PvlObject pointObject = network.object(objectIndex);
         ControlPointV0004 point(pointObject);
-        m_points.append( createPoint(point) );
+        addPoint( createPoint(point) );
 
         if (progress) {
           progress->CheckStatus();
@@ -851,7 +890,7 @@ namespace Isis {
       try {
         PvlObject pointObject = network.object(objectIndex);
         ControlPointV0005 point(pointObject);
-        m_points.append( createPoint(point) );
+        addPoint( createPoint(point) );
 
         if (progress) {
           progress->CheckStatus();
@@ -1010,7 +1049,7 @@ namespace Isis {
         QSharedPointer<ControlNetLogDataProtoV0001_Point>
               protoPointLogData(new ControlNetLogDataProtoV0001_Point(protoLogData.points(i)));
         ControlPointV0002 point(protoPoint, protoPointLogData);
-        m_points.append( createPoint(point) );
+        addPoint( createPoint(point) );
 
         if (progress) {
           progress->CheckStatus();
@@ -1127,7 +1166,7 @@ namespace Isis {
 
       try {
         ControlPointV0004 point(newPoint);
-        m_points.append( createPoint(point) );
+        addPoint( createPoint(point) );
 
         if (progress) {
           progress->CheckStatus();
@@ -1225,8 +1264,6 @@ namespace Isis {
     input.open(netFile.expanded().toLatin1().data(), ios::in | ios::binary);
     input.seekg(filePos, ios::beg);
 
-    IstreamInputStream pointInStream(&input);
-
     BigInt numberOfPoints = 0;
 
     if ( protoBufferInfo.hasGroup("ControlNetworkInfo") ) {
@@ -1248,46 +1285,104 @@ namespace Isis {
       progress->CheckStatus();
     }
 
-    Isis::EndianSwapper lsb("LSB");
-    int pointIndex = -1;
-    while (pointInStream.ByteCount() < pointsLength) {
-      pointIndex += 1;
-      QSharedPointer<ControlPointFileEntryV0002> newPoint(new ControlPointFileEntryV0002);
-
+    // Decodes one point message from the current batch into a ControlPoint. This runs on the
+    //   global threads, so failures are returned rather than thrown.
+    QByteArray batch;
+    std::function<PointMessage(const PointMessage &)> decodePoint =
+        [&batch, this](const PointMessage &message) {
+      PointMessage result = message;
       try {
+        QSharedPointer<ControlPointFileEntryV0002> newPoint(new ControlPointFileEntryV0002);
+        if ( !newPoint->ParseFromArray(batch.constData() + message.offset, (int) message.size) ) {
+          throw IException(IException::Io, "Failed to parse the point message.", _FILEINFO_);
+        }
 
-        CodedInputStream pointCodedInStream(&pointInStream);
-        pointCodedInStream.SetTotalBytesLimit(1024 * 1024 * 512);
+        ControlPointV0005 point(newPoint);
+        result.point = createPoint(point);
+      }
+      catch (IException &e) {
+        result.error = QSharedPointer<IException>(new IException(e));
+      }
+      catch (...) {
+        result.error = QSharedPointer<IException>(new IException(IException::Io,
+            "Failed to parse the point.", _FILEINFO_));
+      }
+      return result;
+    };
 
-        uint32_t size;
-        pointCodedInStream.ReadRaw(reinterpret_cast<char *>(&size), sizeof(size));
+    // The points are read in batches. The messages of a batch are read from the file in one
+    //   pass that records where each one starts, then they are decoded on the global threads,
+    //   and the points are added in file order.
+    static const qint64 batchBytes = 64 * 1024 * 1024;
+    // A single point message may not be larger than this, as when the points were read through
+    //   a CodedInputStream
+    static const qint64 maximumPointBytes = 512 * 1024 * 1024;
+
+    Isis::EndianSwapper lsb("LSB");
+    BigInt bytesRead = 0;
+    int pointIndex = 0;
+    QVector<PointMessage> messages;
+    while (bytesRead < pointsLength) {
+      batch.clear();
+      messages.clear();
 
+      while (bytesRead < pointsLength && (messages.isEmpty() || batch.size() < batchBytes)) {
+        PointMessage message;
+        message.index = pointIndex + messages.size();
+
+        uint32_t size;
+        input.read(reinterpret_cast<char *>(&size), sizeof(size));
         size = lsb.Uint32_t(&size);
 
-        CodedInputStream::Limit oldPointLimit = pointCodedInStream.PushLimit(size);
-        newPoint->ParseFromCodedStream(&pointCodedInStream);
-        pointCodedInStream.PopLimit(oldPointLimit);
-      }
-      catch (...) {
-        QString msg = "Failed to read protobuf version 2 control point at index ["
-                      + toString(pointIndex) + "].";
-        throw IException(IException::Io, msg, _FILEINFO_);
+        message.offset = batch.size();
+        message.size = size;
+        if ( input.good() && message.size > maximumPointBytes ) {
+          QString msg = "Protobuf version 2 control point at index ["
+                        + toString(message.index) + "] is [" + toString((BigInt) message.size)
+                        + "] bytes, which is larger than the [" + toString((BigInt) maximumPointBytes)
+                        + "] byte limit.";
+          throw IException(IException::Io, msg, _FILEINFO_);
+        }
+        if ( input.good() ) {
+          // The batch is at most batchBytes plus one message, which is far below the 2 GB
+          //   QByteArray limit
+          batch.resize((int) (message.offset + message.size));
+          input.read(batch.data() + message.offset, message.size);
+        }
+
+        if ( !input.good() ) {
+          QString msg = "Failed to read protobuf version 2 control point at index ["
+                        + toString(message.index) + "].";
+          throw IException(IException::Io, msg, _FILEINFO_);
+        }
+
+        messages.append(message);
+        bytesRead += sizeof(size) + size;
       }
 
-      try {
-        ControlPointV0005 point(newPoint);
-        m_points.append( createPoint(point) );
+      QVector<PointMessage> decoded =
+          QtConcurrent::blockingMapped< QVector<PointMessage> >(messages, decodePoint);
+
+      for (int i = 0; i < decoded.size(); i++) {
+        if (decoded[i].error) {
+          // Nothing after the failed point is kept
+          for (int j = i + 1; j < decoded.size(); j++) {
+            delete decoded[j].point;
+          }
+
+          QString msg = "Failed to convert protobuf version 2 control point at index ["
+                        + toString(decoded[i].index) + "] into a ControlPoint.";
+          throw IException(*decoded[i].error, IException::Io, msg, _FILEINFO_);
+        }
+
+        addPoint(decoded[i].point);
 
         if (progress && numberOfPoints != 0) {
           progress->CheckStatus();
         }
-
-      }
-      catch (IException &e) {
-        QString msg = "Failed to convert protobuf version 2 control point at index ["
-                      + toString(pointIndex) + "] into a ControlPoint.";
-        throw IException(e, IException::Io, msg, _FILEINFO_);
       }
+
+      pointIndex += messages.size();
     }
   }
 
@@ -1631,6 +1726,21 @@ namespace Isis {
   }
 
 
+  /**
+   * Keep a point read from a file, or pass it to the point handler if there is one.
+   *
+   * @param point The point that was read. The versioner or the handler takes ownership of it.
+   */
+  void ControlNetVersioner::addPoint(ControlPoint *point) {
+    if (m_pointHandler) {
+      m_pointHandler(point);
+    }
+    else {
+      m_points.append(point);
+    }
+  }
+
+
   /**
    * Create the internal header from a V0001 header.
    *
@@ -1655,6 +1765,43 @@ namespace Isis {
    *
    */
   void ControlNetVersioner::write(FileName netFile) {
+    write(netFile, m_points.size(),
+          [this](int) {
+            return m_points.takeFirst();
+          },
+          m_ownsPoints);
+  }
+
+
+  /**
+   * Writes the header of the versioner and points created one at a time to a control net
+   * file. This writes a network without having all of its points in memory at once. The
+   * points in the versioner are not written.
+   *
+   * @param netFile The output filename that will be written to
+   * @param numPoints The number of points to write
+   * @param pointSource Creates the point with an index from 0 to numPoints - 1. The
+   *                    versioner takes ownership of the point and deletes it once it is
+   *                    written.
+   */
+  void ControlNetVersioner::write(FileName netFile, int numPoints,
+                                  std::function<ControlPoint *(int)> pointSource) {
+    write(netFile, numPoints, pointSource, true);
+  }
+
+
+  /**
+   * Writes the header of the versioner and the points given by a source to a control net
+   * file.
+   *
+   * @param netFile The output filename that will be written to
+   * @param numPoints The number of points to write
+   * @param pointSource Returns the point with an index from 0 to numPoints - 1
+   * @param ownsPoints If the points are deleted once they are written
+   */
+  void ControlNetVersioner::write(FileName netFile, int numPoints,
+                                  std::function<ControlPoint *(int)> pointSource,
+                                  bool ownsPoints) {
     try {
 
       const int labelBytes = 65536;
@@ -1664,19 +1811,21 @@ namespace Isis {
       output.write(blankLabel, labelBytes);
       delete [] blankLabel;
 
-      int numMeasures = 0;
-      int numPoints = m_points.size();
-      foreach (ControlPoint *point, m_points) {
-        numMeasures += point->GetNumMeasures();
-      }
-
       streampos startCoreHeaderPos = output.tellp();
 
       writeHeader(&output);
 
+      int numMeasures = 0;
       BigInt pointByteTotal = 0;
-      while ( !m_points.isEmpty() ) {
-         pointByteTotal += writeFirstPoint(&output);
+      for (int i = 0; i < numPoints; i++) {
+        QScopedPointer<ControlPoint> ownedPoint;
+        ControlPoint *point = pointSource(i);
+        if (ownsPoints) {
+          ownedPoint.reset(point);
+        }
+
+        numMeasures += point->GetNumMeasures();
+        pointByteTotal += writePoint(&output, point);
       }
 
       // Insert header at the beginning of the file once writing is done.
@@ -1761,20 +1910,18 @@ namespace Isis {
 
 
  /**
-  * This will write the first control point to a file stream.
-  * The written point will be removed from the versioner and then deleted if the versioner
-  * has ownership of it.
+  * This will write a control point to a file stream.
   *
   * @param output A pointer to the fileStream that we are writing the point to.
+  * @param controlPoint The point to write
   *
   * @return @b int The number of bytes written to the filestream.
   */
-  int ControlNetVersioner::writeFirstPoint(fstream *output) {
+  int ControlNetVersioner::writePoint(fstream *output, ControlPoint *controlPoint) {
 
       BigInt startPos = output->tellp();
 
       ControlPointFileEntryV0002 protoPoint;
-      ControlPoint *controlPoint = m_points.takeFirst();
 
       if ( controlPoint->GetId().isEmpty() ) {
         QString msg = "Unbable to write first point of control net. "
@@ -2060,11 +2207,6 @@ namespace Isis {
         throw IException(IException::Programmer, err, _FILEINFO_);
       }
 
-      // Make sure that if the versioner owns the ControlPoint it is properly cleaned up.
-      if ( m_ownsPoints ) {
-        delete controlPoint;
-        controlPoint = NULL;
-      }
       BigInt currentPos = output->tellp();
       BigInt byteCount = currentPos - startPos;
 
@@ -9,6 +9,8 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 
+#include <functional>
+
 #include <QString>
 
 #include <QList>
@@ -414,6 +416,9 @@ namespace Isis {
     public:
       ControlNetVersioner(ControlNet *net);
       ControlNetVersioner(const FileName netFile, Progress *progress=NULL);
+      ControlNetVersioner(const FileName netFile,
+                          std::function<void(ControlPoint *)> pointHandler,
+                          Progress *progress=NULL);
       ~ControlNetVersioner();
 
       QString netId() const;
@@ -427,6 +432,8 @@ namespace Isis {
       ControlPoint *takeFirstPoint();
 
       void write(FileName netFile);
+      void write(FileName netFile, int numPoints,
+                 std::function<ControlPoint *(int)> pointSource);
       Pvl toPvl();
 
     private:
@@ -508,10 +515,14 @@ namespace Isis {
 
       ControlMeasure *createMeasure(const ControlPointFileEntryV0002_Measure&);
 
+      void addPoint(ControlPoint *point);
+
       void createHeader(const ControlNetHeaderV0001 header);
 
       void writeHeader(std::fstream *output);
-      int writeFirstPoint(std::fstream *output);
+      void write(FileName netFile, int numPoints,
+                 std::function<ControlPoint *(int)> pointSource, bool ownsPoints);
+      int writePoint(std::fstream *output, ControlPoint *controlPoint);
 
       ControlNetHeaderV0005 m_header; /**< Header containing information about
                                            the whole network.*/
@@ -521,6 +532,9 @@ namespace Isis {
                              This will be true when the versioner created the points from a file.
                              This will be false when the versioner copied the points from an
                              esiting control network.*/
+      std::function<void(ControlPoint *)> m_pointHandler; /**< If set, points read from a file
+                                                               are passed to this as they are
+                                                               created instead of being kept.*/
 
   };
 }
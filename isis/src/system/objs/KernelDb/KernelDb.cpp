@@ -11,6 +11,13 @@ find files of those names at the top level of this repository. **/
 #include <iomanip>
 #include <queue>
 
+#include <QDateTime>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSharedPointer>
+
 #include "CameraFactory.h"
 #include "FileName.h"
 #include "IException.h"
@@ -25,6 +32,53 @@ find files of those names at the top level of this repository. **/
 
 using namespace std;
 namespace Isis {
+  namespace {
+    //! A kernel database or config file parsed by an earlier KernelDb
+    struct ParsedDbFile {
+      QDateTime lastModified;        //!< The modification time of the file when it was parsed
+      qint64 size;                   //!< The size of the file when it was parsed
+      QSharedPointer<const Pvl> pvl; //!< The contents of the file
+    };
+
+    //! Guards parsedDbFiles
+    QMutex parsedDbFilesMutex;
+    //! The parsed database and config files, by expanded file name
+    QHash<QString, ParsedDbFile> parsedDbFiles;
+
+
+    /**
+     * Returns the contents of a kernel database or config file. The files are
+     * only parsed the first time they are used in a process, or again if they
+     * have changed since, so programs that create many KernelDb objects do not
+     * parse the same large database files every time.
+     *
+     * @param expandedFile The expanded name of the file
+     *
+     * @return @b QSharedPointer<const Pvl> The contents of the file
+     */
+    QSharedPointer<const Pvl> parsedDbFile(const QString &expandedFile) {
+      QFileInfo info(expandedFile);
+
+      QMutexLocker locker(&parsedDbFilesMutex);
+      ParsedDbFile &parsed = parsedDbFiles[expandedFile];
+      if (!parsed.pvl || parsed.lastModified != info.lastModified() ||
+          parsed.size != info.size()) {
+        // Make sure a file that fails to parse is not left in the cache
+        parsedDbFiles.remove(expandedFile);
+
+        ParsedDbFile newParsed;
+        newParsed.lastModified = info.lastModified();
+        newParsed.size = info.size();
+        newParsed.pvl = QSharedPointer<const Pvl>(new Pvl(expandedFile));
+        parsedDbFiles.insert(expandedFile, newParsed);
+        return newParsed.pvl;
+      }
+
+      return parsed.pvl;
+    }
+  }
+
+
   /**
    * Constructs a new KernelDb object with a given integer value representing
    * the Kernel::Type enumerations that are allowed.  The filename is set
@@ -729,7 +783,40 @@ namespace Isis {
    * @see kernelDbFiles()
    */
   void KernelDb::loadSystemDb(const QString &mission, const Pvl &lab) {
+    findSystemDbFiles(mission, lab);
+    readKernelDbFiles();
+  }
+
+
+  /**
+   * Returns the kernel database files loadSystemDb() would read for a
+   * mission and cube label, without reading them. Programs that keep a
+   * KernelDb for more than one cube can compare these to kernelDbFiles() to
+   * know whether the KernelDb they already loaded applies to another cube.
+   *
+   * @param mission The name of the mission whose kernel database files are
+   *                selected
+   * @param lab The labels of a cube, used to match the InstrumentId value
+   *
+   * @return @b QList\<FileName\> The kernel database files for the cube
+   */
+  QList<FileName> KernelDb::systemDbFiles(const QString &mission, const Pvl &lab) const {
+    KernelDb selection(m_allowedKernelTypes);
+    selection.findSystemDbFiles(mission, lab);
+    return selection.m_kernelDbFiles;
+  }
+
 
+  /**
+   * Appends the kernel database files for each type of kernel of a mission
+   * to the list of kernel database files. See loadSystemDb() for the
+   * directories they are found in.
+   *
+   * @param mission The name of the mission whose kernel database files are
+   *                selected
+   * @param lab The labels of a cube, used to match the InstrumentId value
+   */
+  void KernelDb::findSystemDbFiles(const QString &mission, const Pvl &lab) {
     // Get the base DataDirectory
     PvlGroup &dataDir = Preference::Preferences().findGroup("DataDirectory");
     QString baseDir = dataDir["Base"];
@@ -769,7 +856,6 @@ namespace Isis {
     loadKernelDbFiles(dataDir, missionDir + "/kernels/spk", lab);
     // Load the mission specific instrument addendum DB
     loadKernelDbFiles(dataDir, missionDir + "/kernels/iak", lab);
-    readKernelDbFiles();
   }
 
   /**
@@ -817,7 +903,7 @@ namespace Isis {
       m_kernelDbFiles.append(kernelDb.highestVersion());
     }
     else { // else, read in the appropriate database files from the config file
-      PvlObject inst = Pvl(configFile.expanded()).findObject("Instrument");
+      PvlObject inst = parsedDbFile(configFile.expanded())->findObject("Instrument");
       bool foundMatch = false;
       // loop through each group until we find a match
       for (int groupIndex = 0; groupIndex < inst.groups(); groupIndex++) {
@@ -865,7 +951,17 @@ namespace Isis {
     // read each of the database files appended to the list into m_kernelData
     foreach (FileName kernelDbFile, m_kernelDbFiles) {
       try {
-        m_kernelData.read(kernelDbFile.expanded());
+        // Same as reading the file into m_kernelData, without parsing it again
+        QSharedPointer<const Pvl> kernelDb = parsedDbFile(kernelDbFile.expanded());
+        for (int i = 0; i < kernelDb->keywords(); i++) {
+          m_kernelData.addKeyword((*kernelDb)[i]);
+        }
+        for (int i = 0; i < kernelDb->groups(); i++) {
+          m_kernelData.addGroup(kernelDb->group(i));
+        }
+        for (int i = 0; i < kernelDb->objects(); i++) {
+          m_kernelData.addObject(kernelDb->object(i));
+        }
       }
       catch (IException &e) {
         QString msg = "Unable to read kernel database file ["
@@ -128,12 +128,14 @@ namespace Isis {
 
       void loadSystemDb(const QString &mission, const Pvl &lab);
       QList<FileName> kernelDbFiles();
+      QList<FileName> systemDbFiles(const QString &mission, const Pvl &lab) const;
 
       static bool matches(const Pvl &lab, PvlGroup &kernelDbGrp,
                           iTime timeToMatch, int cameraVersion);
     private:
       friend class ::KernelDbFixture_TestKernelsSmithOffset_Test; 
       
+      void findSystemDbFiles(const QString &mission, const Pvl &lab);
       void loadKernelDbFiles(PvlGroup &dataDir,
                              QString directory,
                              const Pvl &lab);
@@ -0,0 +1,141 @@
+#include <cmath>
+
+#include <QString>
+
+#include "AutoReg.h"
+#include "Chip.h"
+#include "MaximumCorrelation.h"
+#include "MinimumDifference.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "SpecialPixel.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+namespace {
+  Pvl registrationPvl(QString algorithm, QString tolerance, bool fastMatch) {
+    PvlGroup algo("Algorithm");
+    algo += PvlKeyword("Name", algorithm);
+    algo += PvlKeyword("Tolerance", tolerance);
+    algo += PvlKeyword("FastMatch", fastMatch ? "True" : "False");
+
+    PvlGroup patternChip("PatternChip");
+    patternChip += PvlKeyword("Samples", "15");
+    patternChip += PvlKeyword("Lines", "13");
+
+    PvlGroup searchChip("SearchChip");
+    searchChip += PvlKeyword("Samples", "41");
+    searchChip += PvlKeyword("Lines", "37");
+
+    PvlObject autoReg("AutoRegistration");
+    autoReg.addGroup(algo);
+    autoReg.addGroup(patternChip);
+    autoReg.addGroup(searchChip);
+
+    Pvl pvl;
+    pvl.addObject(autoReg);
+    return pvl;
+  }
+
+
+  double searchValue(int samp, int line) {
+    return 1000.0 + 60.0 * sin(0.45 * samp) * cos(0.3 * line) +
+           ((samp * 7 + line * 13) % 11);
+  }
+
+
+  // Fills the chips with a pattern cut from the search chip centered at
+  //   sample 23, line 19, with a few invalid pixels, and registers them
+  AutoReg::RegisterStatus registerChips(AutoReg &autoReg) {
+    Chip *search = autoReg.SearchChip();
+    for (int line = 1; line <= search->Lines(); line++) {
+      for (int samp = 1; samp <= search->Samples(); samp++) {
+        search->SetValue(samp, line, searchValue(samp, line));
+      }
+    }
+    search->SetValue(20, 30, Null);
+    search->SetValue(5, 7, Lrs);
+
+    Chip *pattern = autoReg.PatternChip();
+    for (int line = 1; line <= pattern->Lines(); line++) {
+      for (int samp = 1; samp <= pattern->Samples(); samp++) {
+        pattern->SetValue(samp, line, searchValue(samp + 15, line + 12));
+      }
+    }
+    pattern->SetValue(3, 2, Null);
+
+    pattern->TackCube(100.0, 100.0);
+    search->TackCube(100.0, 100.0);
+    return autoReg.Register();
+  }
+
+
+  void expectSameFitChips(AutoReg &expected, AutoReg &actual, double tolerance) {
+    Chip *expectedFit = expected.FitChip();
+    Chip *actualFit = actual.FitChip();
+    ASSERT_EQ(actualFit->Samples(), expectedFit->Samples());
+    ASSERT_EQ(actualFit->Lines(), expectedFit->Lines());
+    for (int line = 1; line <= expectedFit->Lines(); line++) {
+      for (int samp = 1; samp <= expectedFit->Samples(); samp++) {
+        double expectedValue = expectedFit->GetValue(samp, line);
+        double actualValue = actualFit->GetValue(samp, line);
+        if (IsSpecial(expectedValue)) {
+          EXPECT_EQ(actualValue, expectedValue) << "At " << samp << ", " << line;
+        }
+        else {
+          EXPECT_NEAR(actualValue, expectedValue, tolerance) << "At " << samp << ", " << line;
+        }
+      }
+    }
+  }
+}
+
+
+TEST(AutoRegTest, AutoRegFastMatchMaximumCorrelation) {
+  Pvl slowPvl = registrationPvl("MaximumCorrelation", "0.7", false);
+  Pvl fastPvl = registrationPvl("MaximumCorrelation", "0.7", true);
+  MaximumCorrelation slow(slowPvl);
+  MaximumCorrelation fast(fastPvl);
+  ASSERT_FALSE(slow.FastMatch());
+  ASSERT_TRUE(fast.FastMatch());
+
+  AutoReg::RegisterStatus slowStatus = registerChips(slow);
+  AutoReg::RegisterStatus fastStatus = registerChips(fast);
+
+  ASSERT_TRUE(slow.Success());
+  EXPECT_EQ(fastStatus, slowStatus);
+  EXPECT_NEAR(slow.ChipSample(), 23.0, 0.5);
+  EXPECT_NEAR(slow.ChipLine(), 19.0, 0.5);
+
+  // The correlation sums only differ from MultivariateStatistics by roundoff
+  EXPECT_NEAR(fast.ChipSample(), slow.ChipSample(), 1.0e-8);
+  EXPECT_NEAR(fast.ChipLine(), slow.ChipLine(), 1.0e-8);
+  EXPECT_NEAR(fast.GoodnessOfFit(), slow.GoodnessOfFit(), 1.0e-10);
+  expectSameFitChips(slow, fast, 1.0e-10);
+}
+
+
+TEST(AutoRegTest, AutoRegFastMatchMinimumDifference) {
+  Pvl slowPvl = registrationPvl("MinimumDifference", "100", false);
+  Pvl fastPvl = registrationPvl("MinimumDifference", "100", true);
+  MinimumDifference slow(slowPvl);
+  MinimumDifference fast(fastPvl);
+
+  AutoReg::RegisterStatus slowStatus = registerChips(slow);
+  AutoReg::RegisterStatus fastStatus = registerChips(fast);
+
+  ASSERT_TRUE(slow.Success());
+  EXPECT_EQ(fastStatus, slowStatus);
+  EXPECT_NEAR(slow.ChipSample(), 23.0, 0.5);
+  EXPECT_NEAR(slow.ChipLine(), 19.0, 0.5);
+
+  // The differences are summed the same way, so the results are identical
+  EXPECT_EQ(fast.ChipSample(), slow.ChipSample());
+  EXPECT_EQ(fast.ChipLine(), slow.ChipLine());
+  EXPECT_EQ(fast.GoodnessOfFit(), slow.GoodnessOfFit());
+  expectSameFitChips(slow, fast, 0.0);
+}
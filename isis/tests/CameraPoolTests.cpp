@@ -0,0 +1,66 @@
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPair>
+#include <QThreadPool>
+#include <QtConcurrentMap>
+
+#include "Camera.h"
+#include "CameraPool.h"
+
+#include "CameraFixtures.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+TEST_F(DefaultCube, CameraPoolOneCameraPerThread) {
+  CameraPool pool(*testCube);
+  EXPECT_EQ(pool.size(), 0);
+
+  Camera *cam = pool.camera();
+  ASSERT_NE(cam, nullptr);
+  EXPECT_EQ(pool.camera(), cam);
+  EXPECT_EQ(pool.size(), 1);
+  EXPECT_NE(cam, testCube->camera());
+}
+
+
+TEST_F(DefaultCube, CameraPoolSerializedSetImage) {
+  Camera *serialCam = testCube->camera();
+  QList<int> lines;
+  QList< QPair<double, double> > expected;
+  for (int line = 1; line <= testCube->lineCount(); line += 7) {
+    lines.append(line);
+    if (serialCam->SetImage(testCube->sampleCount() / 2.0, line)) {
+      expected.append(qMakePair(serialCam->UniversalLatitude(),
+                                serialCam->UniversalLongitude()));
+    }
+    else {
+      expected.append(qMakePair(0.0, 0.0));
+    }
+  }
+
+  // Each thread uses its own camera, but the CSPICE calls are serialized
+  CameraPool pool(*testCube);
+  QMutex spiceMutex;
+  std::function<QPair<double, double>(const int &)> groundPoint =
+      [&pool, &spiceMutex, this](const int &line) {
+        Camera *cam = pool.camera();
+        QMutexLocker locker(&spiceMutex);
+        if (cam->SetImage(testCube->sampleCount() / 2.0, line)) {
+          return qMakePair(cam->UniversalLatitude(), cam->UniversalLongitude());
+        }
+        return qMakePair(0.0, 0.0);
+      };
+  QList< QPair<double, double> > actual =
+      QtConcurrent::blockingMapped< QList< QPair<double, double> > >(lines, groundPoint);
+
+  ASSERT_EQ(actual.size(), expected.size());
+  for (int i = 0; i < actual.size(); i++) {
+    EXPECT_DOUBLE_EQ(actual[i].first, expected[i].first);
+    EXPECT_DOUBLE_EQ(actual[i].second, expected[i].second);
+  }
+  EXPECT_GE(pool.size(), 1);
+  EXPECT_LE(pool.size(), QThreadPool::globalInstance()->maxThreadCount());
+}
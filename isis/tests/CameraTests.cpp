@@ -6,6 +6,7 @@
 #include "CubeAttribute.h"
 #include "IException.h"
 #include "PixelType.h"
+#include "SpecialPixel.h"
 #include "Pvl.h"
 #include "PvlGroup.h"
 #include "PvlKeyword.h"
@@ -37,3 +38,79 @@ TEST_F(DemCube, CameraObliqueResolution) {
     EXPECT_NEAR(c->ObliqueDetectorResolution(false), 19.2788, 1e-4);
     EXPECT_NEAR(c->ObliqueDetectorResolution(), 19.3449, 1e-4);
 }
+
+
+TEST_F(DefaultCube, CameraBatchImageToGround) {
+  Camera *cam = testCube->camera();
+
+  std::vector<double> samples;
+  std::vector<double> lines;
+  for (int line = 1; line <= testCube->lineCount(); line += 100) {
+    for (int samp = 1; samp <= testCube->sampleCount(); samp += 100) {
+      samples.push_back(samp);
+      lines.push_back(line);
+    }
+  }
+  // A point off the image that cannot intersect the target
+  samples.push_back(-1.0e6);
+  lines.push_back(-1.0e6);
+
+  std::vector<double> lats, lons;
+  std::vector<bool> valid;
+  int numValid = cam->SetImages(samples, lines, lats, lons, valid);
+
+  ASSERT_EQ(lats.size(), samples.size());
+  int expectedValid = 0;
+  for (size_t i = 0; i < samples.size(); i++) {
+    bool success = cam->SetImage(samples[i], lines[i]);
+    EXPECT_EQ(valid[i], success);
+    if (success) {
+      expectedValid++;
+      EXPECT_DOUBLE_EQ(lats[i], cam->UniversalLatitude());
+      EXPECT_DOUBLE_EQ(lons[i], cam->UniversalLongitude());
+    }
+    else {
+      EXPECT_EQ(lats[i], Isis::Null);
+      EXPECT_EQ(lons[i], Isis::Null);
+    }
+  }
+  EXPECT_EQ(numValid, expectedValid);
+  EXPECT_FALSE(valid.back());
+
+  std::vector<double> groundSamples, groundLines;
+  std::vector<bool> groundValid;
+  std::vector<double> validLats, validLons;
+  for (size_t i = 0; i < lats.size(); i++) {
+    if (valid[i]) {
+      validLats.push_back(lats[i]);
+      validLons.push_back(lons[i]);
+    }
+  }
+  EXPECT_EQ(cam->SetUniversalGrounds(validLats, validLons, groundSamples,
+                                     groundLines, groundValid),
+            (int)validLats.size());
+  for (size_t i = 0, j = 0; i < samples.size(); i++) {
+    if (valid[i]) {
+      EXPECT_NEAR(groundSamples[j], samples[i], 1.0e-3);
+      EXPECT_NEAR(groundLines[j], lines[i], 1.0e-3);
+      j++;
+    }
+  }
+
+  // The arrays go through the camera maps in stages, which must give the
+  // same results as mapping one point at a time
+  for (size_t j = 0; j < validLats.size(); j++) {
+    ASSERT_TRUE(cam->SetUniversalGround(validLats[j], validLons[j]));
+    EXPECT_EQ(groundSamples[j], cam->Sample());
+    EXPECT_EQ(groundLines[j], cam->Line());
+  }
+}
+
+
+TEST_F(DefaultCube, CameraBatchMismatchedSizes) {
+  Camera *cam = testCube->camera();
+  std::vector<double> samples(2, 1.0), lines(1, 1.0), lats, lons;
+  std::vector<bool> valid;
+  EXPECT_THROW(cam->SetImages(samples, lines, lats, lons, valid), IException);
+  EXPECT_THROW(cam->SetUniversalGrounds(samples, lines, lats, lons, valid), IException);
+}
@@ -0,0 +1,121 @@
+#include <cmath>
+#include <vector>
+
+#include "Chip.h"
+#include "ChipCorrelator.h"
+#include "MultivariateStatistics.h"
+#include "SpecialPixel.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+namespace {
+  // What MaximumCorrelation::MatchAlgorithm computes for a sub-search chip
+  double referenceCorrelation(Chip &pattern, Chip &subsearch, double patternValidPercent) {
+    MultivariateStatistics mv;
+    std::vector<double> pdn(pattern.Samples());
+    std::vector<double> sdn(pattern.Samples());
+    for (int l = 1; l <= pattern.Lines(); l++) {
+      for (int s = 1; s <= pattern.Samples(); s++) {
+        pdn[s - 1] = pattern.GetValue(s, l);
+        sdn[s - 1] = subsearch.GetValue(s, l);
+      }
+      mv.AddData(&pdn[0], &sdn[0], pattern.Samples());
+    }
+    double percentValid = (double) mv.ValidPixels() /
+                          (pattern.Lines() * pattern.Samples());
+    if (percentValid * 100.0 < patternValidPercent) return Null;
+
+    double r = mv.Correlation();
+    if (r == Null) return Null;
+    return fabs(r);
+  }
+
+
+  void compareWithExtract(Chip &search, Chip &pattern, int start, int end) {
+    ChipCorrelator correlator(search, pattern, start, end, start, end);
+    Chip subsearch(pattern.Samples(), pattern.Lines());
+
+    for (int line = start; line <= end; line++) {
+      for (int samp = start; samp <= end; samp++) {
+        search.Extract(samp, line, subsearch);
+
+        int validCount = 0;
+        for (int l = 1; l <= subsearch.Lines(); l++) {
+          for (int s = 1; s <= subsearch.Samples(); s++) {
+            if (subsearch.IsValid(s, l)) validCount++;
+          }
+        }
+        EXPECT_DOUBLE_EQ(correlator.SubsearchValidPercent(samp, line),
+                         100.0 * validCount / (pattern.Samples() * pattern.Lines()));
+
+        double expected = referenceCorrelation(pattern, subsearch, 50.0);
+        double actual = correlator.Correlation(samp, line, 50.0);
+        if (expected == Null) {
+          EXPECT_EQ(actual, Null) << "At " << samp << ", " << line;
+        }
+        else {
+          EXPECT_NEAR(actual, expected, 1e-10) << "At " << samp << ", " << line;
+        }
+      }
+    }
+  }
+}
+
+
+class CorrelationChips : public ::testing::Test {
+  protected:
+    Chip search;
+    Chip pattern;
+
+    void SetUp() override {
+      search.SetSize(31, 27);
+      for (int line = 1; line <= search.Lines(); line++) {
+        for (int samp = 1; samp <= search.Samples(); samp++) {
+          search.SetValue(samp, line, 1000.0 + 50.0 * sin(0.7 * samp) * cos(0.4 * line) +
+                                      ((samp * 7 + line * 13) % 11));
+        }
+      }
+
+      pattern.SetSize(9, 7);
+      for (int line = 1; line <= pattern.Lines(); line++) {
+        for (int samp = 1; samp <= pattern.Samples(); samp++) {
+          pattern.SetValue(samp, line, search.GetValue(samp + 10, line + 8));
+        }
+      }
+    }
+};
+
+
+TEST_F(CorrelationChips, ChipCorrelatorCompletePattern) {
+  compareWithExtract(search, pattern, 2, 26);
+
+  // The pattern was cut from the search chip with its tack at 15, 12
+  ChipCorrelator correlator(search, pattern, 5, 20, 5, 20);
+  EXPECT_NEAR(correlator.Correlation(15, 12, 50.0), 1.0, 1e-12);
+}
+
+
+TEST_F(CorrelationChips, ChipCorrelatorInvalidPixels) {
+  search.SetValue(12, 10, Null);
+  search.SetValue(20, 3, Lrs);
+  search.SetValue(5, 20, His);
+  search.SetValidRange(990.0, 1100.0);
+  pattern.SetValue(1, 1, Null);
+  pattern.SetValue(5, 4, Hrs);
+
+  compareWithExtract(search, pattern, 2, 26);
+}
+
+
+TEST_F(CorrelationChips, ChipCorrelatorConstantChips) {
+  for (int line = 1; line <= pattern.Lines(); line++) {
+    for (int samp = 1; samp <= pattern.Samples(); samp++) {
+      pattern.SetValue(samp, line, 5.0);
+    }
+  }
+
+  ChipCorrelator correlator(search, pattern, 5, 20, 5, 20);
+  EXPECT_EQ(correlator.Correlation(10, 10, 50.0), Null);
+}
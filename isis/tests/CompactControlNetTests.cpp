@@ -0,0 +1,218 @@
+#include <QScopedPointer>
+#include <QString>
+
+#include "Angle.h"
+#include "CompactControlNet.h"
+#include "ControlMeasure.h"
+#include "ControlMeasureLogData.h"
+#include "ControlNet.h"
+#include "ControlPoint.h"
+#include "Distance.h"
+#include "FileName.h"
+#include "Latitude.h"
+#include "Longitude.h"
+#include "SpecialPixel.h"
+#include "SurfacePoint.h"
+
+#include "TempFixtures.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+class CompactNetwork : public TempTestingFiles {
+  protected:
+    ControlNet network;
+
+    void SetUp() override {
+      TempTestingFiles::SetUp();
+
+      network.SetNetworkId("CompactTest");
+      network.SetDescription("Compact network test");
+      for (int i = 0; i < 10; i++) {
+        ControlPoint *point = new ControlPoint(QString("Point%1").arg(i));
+        for (int j = 0; j < 3; j++) {
+          ControlMeasure *measure = new ControlMeasure;
+          measure->SetCubeSerialNumber(QString("Cube%1").arg(i % 2 + j));
+          measure->SetCoordinate(i + 1.0, j + 1.0, ControlMeasure::RegisteredPixel);
+          measure->SetResidual(0.5 * j, -0.25 * j);
+          measure->SetIgnored(j == 2);
+          point->Add(measure);
+        }
+        point->SetRefMeasure(1);
+        point->SetIgnored(i == 3);
+        point->SetEditLock(i == 4);
+        network.AddPoint(point);
+      }
+    }
+};
+
+
+TEST_F(CompactNetwork, CompactControlNetFromControlNet) {
+  CompactControlNet compact(network);
+
+  EXPECT_EQ(compact.networkId(), "CompactTest");
+  EXPECT_EQ(compact.description(), "Compact network test");
+  ASSERT_EQ(compact.numPoints(), 10);
+  ASSERT_EQ(compact.numMeasures(), 30);
+  ASSERT_EQ(compact.numImages(), 4);
+
+  EXPECT_EQ(compact.numMeasuresInImage(compact.imageIndex("Cube0")), 5);
+  EXPECT_EQ(compact.numMeasuresInImage(compact.imageIndex("Cube1")), 10);
+  EXPECT_EQ(compact.imageIndex("Cube9"), -1);
+
+  int point = compact.pointIndex("Point7");
+  ASSERT_EQ(point, 7);
+  EXPECT_EQ(compact.measureEnd(point) - compact.measureBegin(point), 3);
+  EXPECT_EQ(compact.referenceMeasure(point), compact.measureBegin(point) + 1);
+  EXPECT_TRUE(compact.isPointIgnored(3));
+  EXPECT_FALSE(compact.isPointIgnored(7));
+  EXPECT_TRUE(compact.isPointEditLocked(4));
+  EXPECT_EQ(compact.aprioriCoordinates(point)[0], Null);
+
+  int measure = compact.measureBegin(point) + 2;
+  EXPECT_EQ(compact.measurePoint(measure), point);
+  EXPECT_EQ(compact.imageSerialNumber(compact.measureImage(measure)), "Cube3");
+  EXPECT_EQ(compact.measureType(measure), ControlMeasure::RegisteredPixel);
+  EXPECT_DOUBLE_EQ(compact.sample(measure), 8.0);
+  EXPECT_DOUBLE_EQ(compact.line(measure), 3.0);
+  EXPECT_DOUBLE_EQ(compact.sampleResidual(measure), 1.0);
+  EXPECT_DOUBLE_EQ(compact.lineResidual(measure), -0.5);
+  EXPECT_TRUE(compact.isMeasureIgnored(measure));
+}
+
+
+TEST_F(CompactNetwork, CompactControlNetCreatePoint) {
+  CompactControlNet compact(network);
+
+  for (int i = 0; i < network.GetNumPoints(); i++) {
+    QScopedPointer<ControlPoint> point(compact.createPoint(i));
+    const ControlPoint *original = network.GetPoint(i);
+
+    EXPECT_EQ(point->GetId(), original->GetId());
+    EXPECT_EQ(point->IsIgnored(), original->IsIgnored());
+    EXPECT_EQ(point->IsEditLocked(), original->IsEditLocked());
+    EXPECT_EQ(point->GetRefMeasure()->GetCubeSerialNumber(),
+              original->GetRefMeasure()->GetCubeSerialNumber());
+    ASSERT_EQ(point->GetNumMeasures(), original->GetNumMeasures());
+    for (int j = 0; j < point->GetNumMeasures(); j++) {
+      EXPECT_EQ(point->GetMeasure(j)->GetCubeSerialNumber(),
+                original->GetMeasure(j)->GetCubeSerialNumber());
+      EXPECT_EQ(point->GetMeasure(j)->GetType(), original->GetMeasure(j)->GetType());
+      EXPECT_EQ(point->GetMeasure(j)->IsIgnored(), original->GetMeasure(j)->IsIgnored());
+      EXPECT_DOUBLE_EQ(point->GetMeasure(j)->GetSample(), original->GetMeasure(j)->GetSample());
+      EXPECT_DOUBLE_EQ(point->GetMeasure(j)->GetLine(), original->GetMeasure(j)->GetLine());
+    }
+  }
+}
+
+
+TEST_F(CompactNetwork, CompactControlNetWriteRead) {
+  QString networkFile = tempDir.path() + "/compact.net";
+  CompactControlNet(network).write(networkFile);
+
+  CompactControlNet compact{FileName(networkFile)};
+  EXPECT_EQ(compact.networkId(), "CompactTest");
+  ASSERT_EQ(compact.numPoints(), network.GetNumPoints());
+  ASSERT_EQ(compact.numMeasures(), 30);
+  for (int i = 0; i < compact.numPoints(); i++) {
+    EXPECT_EQ(compact.pointId(i), network.GetPoint(i)->GetId());
+    EXPECT_EQ(compact.isPointIgnored(i), network.GetPoint(i)->IsIgnored());
+  }
+}
+
+
+TEST_F(CompactNetwork, CompactControlNetWriteConstrainedPoints) {
+  for (int i = 0; i < network.GetNumPoints(); i += 2) {
+    ControlPoint *point = network.GetPoint(i);
+    point->SetEditLock(false);
+    point->SetType(ControlPoint::Constrained);
+    point->SetAprioriSurfacePointSource(ControlPoint::SurfacePointSource::Basemap);
+    point->SetAprioriSurfacePointSourceFile("base.cub");
+    point->SetAprioriRadiusSource(ControlPoint::RadiusSource::DEM);
+    point->SetAprioriRadiusSourceFile("dem.cub");
+    point->SetAprioriSurfacePoint(SurfacePoint(Latitude(10.0 + i, Angle::Degrees),
+                                               Longitude(20.0 + i, Angle::Degrees),
+                                               Distance(3396.0, Distance::Kilometers),
+                                               Angle(0.01, Angle::Degrees),
+                                               Angle(0.02, Angle::Degrees),
+                                               Distance(50.0, Distance::Meters)));
+    point->SetAdjustedSurfacePoint(SurfacePoint(Latitude(10.5 + i, Angle::Degrees),
+                                                Longitude(20.5 + i, Angle::Degrees),
+                                                Distance(3395.0, Distance::Kilometers),
+                                                Angle(0.005, Angle::Degrees),
+                                                Angle(0.01, Angle::Degrees),
+                                                Distance(25.0, Distance::Meters)));
+    for (int j = 0; j < point->GetNumMeasures(); j++) {
+      ControlMeasure *measure = point->GetMeasure(j);
+      measure->SetSampleSigma(0.25 * (j + 1));
+      measure->SetLineSigma(0.5 * (j + 1));
+      measure->SetDiameter(12.0);
+      measure->SetLogData(ControlMeasureLogData(ControlMeasureLogData::GoodnessOfFit,
+                                                0.9 - 0.1 * j));
+      measure->SetLogData(ControlMeasureLogData(ControlMeasureLogData::MinimumPixelZScore,
+                                                -1.5));
+      measure->SetDateTime(QString("2020-01-0%1T00:00:00").arg(j + 1));
+    }
+    point->SetDateTime("2021-06-01T12:00:00");
+  }
+
+  QString networkFile = tempDir.path() + "/constrained.net";
+  CompactControlNet(network).write(networkFile);
+  ControlNet readNet(networkFile);
+
+  ASSERT_EQ(readNet.GetNumPoints(), network.GetNumPoints());
+  for (int i = 0; i < network.GetNumPoints(); i++) {
+    ControlPoint *original = network.GetPoint(i);
+    ControlPoint *point = readNet.GetPoint(i);
+
+    EXPECT_EQ(point->GetType(), original->GetType());
+    EXPECT_EQ(point->GetDateTime(), original->GetDateTime());
+    EXPECT_EQ(point->GetAprioriSurfacePointSource(), original->GetAprioriSurfacePointSource());
+    EXPECT_EQ(point->GetAprioriSurfacePointSourceFile(),
+              original->GetAprioriSurfacePointSourceFile());
+    EXPECT_EQ(point->GetAprioriRadiusSource(), original->GetAprioriRadiusSource());
+    EXPECT_EQ(point->GetAprioriRadiusSourceFile(), original->GetAprioriRadiusSourceFile());
+    EXPECT_EQ(point->IsCoord1Constrained(), original->IsCoord1Constrained());
+    EXPECT_EQ(point->IsCoord2Constrained(), original->IsCoord2Constrained());
+    EXPECT_EQ(point->IsCoord3Constrained(), original->IsCoord3Constrained());
+    EXPECT_EQ(point->NumberOfConstrainedCoordinates(),
+              original->NumberOfConstrainedCoordinates());
+
+    SurfacePoint originalApriori = original->GetAprioriSurfacePoint();
+    SurfacePoint apriori = point->GetAprioriSurfacePoint();
+    ASSERT_EQ(apriori.Valid(), originalApriori.Valid());
+    if (originalApriori.Valid()) {
+      EXPECT_NEAR(apriori.GetLatSigmaDistance().meters(),
+                  originalApriori.GetLatSigmaDistance().meters(), 1.0e-6);
+      EXPECT_NEAR(apriori.GetLonSigmaDistance().meters(),
+                  originalApriori.GetLonSigmaDistance().meters(), 1.0e-6);
+      EXPECT_NEAR(apriori.GetLocalRadiusSigma().meters(),
+                  originalApriori.GetLocalRadiusSigma().meters(), 1.0e-6);
+      for (int row = 0; row < 3; row++) {
+        for (int col = row; col < 3; col++) {
+          EXPECT_DOUBLE_EQ(apriori.GetRectangularMatrix()(row, col),
+                           originalApriori.GetRectangularMatrix()(row, col));
+          EXPECT_DOUBLE_EQ(point->GetAdjustedSurfacePoint().GetRectangularMatrix()(row, col),
+                           original->GetAdjustedSurfacePoint().GetRectangularMatrix()(row, col));
+        }
+      }
+    }
+
+    ASSERT_EQ(point->GetNumMeasures(), original->GetNumMeasures());
+    for (int j = 0; j < point->GetNumMeasures(); j++) {
+      const ControlMeasure *originalMeasure = original->GetMeasure(j);
+      const ControlMeasure *measure = point->GetMeasure(j);
+      EXPECT_EQ(measure->GetSampleSigma(), originalMeasure->GetSampleSigma());
+      EXPECT_EQ(measure->GetLineSigma(), originalMeasure->GetLineSigma());
+      EXPECT_EQ(measure->GetDiameter(), originalMeasure->GetDiameter());
+      EXPECT_EQ(measure->GetDateTime(), originalMeasure->GetDateTime());
+      EXPECT_EQ(measure->GetLogDataEntries().size(),
+                originalMeasure->GetLogDataEntries().size());
+      EXPECT_EQ(measure->GetLogValue(ControlMeasureLogData::GoodnessOfFit),
+                originalMeasure->GetLogValue(ControlMeasureLogData::GoodnessOfFit));
+      EXPECT_EQ(measure->GetLogValue(ControlMeasureLogData::MinimumPixelZScore),
+                originalMeasure->GetLogValue(ControlMeasureLogData::MinimumPixelZScore));
+    }
+  }
+}
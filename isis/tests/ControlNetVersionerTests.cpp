@@ -0,0 +1,118 @@
+#include <QFile>
+#include <QList>
+#include <QString>
+#include <QtEndian>
+
+#include "ControlMeasure.h"
+#include "ControlNet.h"
+#include "ControlNetVersioner.h"
+#include "ControlPoint.h"
+#include "FileName.h"
+#include "IException.h"
+#include "Pvl.h"
+
+#include "TempFixtures.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+class BinaryNetwork : public TempTestingFiles {
+  protected:
+    QString networkFile;
+
+    void SetUp() override {
+      TempTestingFiles::SetUp();
+
+      ControlNet network;
+      network.SetNetworkId("StreamingTest");
+      for (int i = 0; i < 50; i++) {
+        ControlPoint *point = new ControlPoint(QString("Point%1").arg(i));
+        for (int j = 0; j < 3; j++) {
+          ControlMeasure *measure = new ControlMeasure;
+          measure->SetCubeSerialNumber(QString("Cube%1").arg(j));
+          measure->SetCoordinate(i + 1.0, j + 1.0);
+          point->Add(measure);
+        }
+        network.AddPoint(point);
+      }
+
+      networkFile = tempDir.path() + "/streaming.net";
+      network.Write(networkFile);
+    }
+
+    /**
+     * Overwrites bytes of the points section of the network file, starting at
+     * the size prefix of the first point.
+     */
+    void overwritePoints(qint64 offset, const QByteArray &bytes) {
+      Pvl header(networkFile);
+      qint64 pointsStart = header.findObject("ProtoBuffer").findObject("Core")["PointsStartByte"];
+
+      QFile file(networkFile);
+      ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+      ASSERT_TRUE(file.seek(pointsStart + offset));
+      ASSERT_EQ(file.write(bytes), bytes.size());
+    }
+};
+
+
+TEST_F(BinaryNetwork, ControlNetVersionerReadsPointsInOrder) {
+  ControlNetVersioner versioner(FileName(networkFile));
+
+  EXPECT_EQ(versioner.netId(), "StreamingTest");
+  ASSERT_EQ(versioner.numPoints(), 50);
+  for (int i = 0; i < 50; i++) {
+    ControlPoint *point = versioner.takeFirstPoint();
+    EXPECT_EQ(point->GetId(), QString("Point%1").arg(i));
+    ASSERT_EQ(point->GetNumMeasures(), 3);
+    EXPECT_DOUBLE_EQ(point->GetMeasure(0)->GetSample(), i + 1.0);
+    delete point;
+  }
+}
+
+
+TEST_F(BinaryNetwork, ControlNetVersionerPointHandler) {
+  QList<ControlPoint *> points;
+  ControlNetVersioner versioner(FileName(networkFile),
+                                [&points](ControlPoint *point) { points.append(point); });
+
+  EXPECT_EQ(versioner.netId(), "StreamingTest");
+  EXPECT_EQ(versioner.numPoints(), 0);
+
+  ASSERT_EQ(points.size(), 50);
+  for (int i = 0; i < points.size(); i++) {
+    EXPECT_EQ(points[i]->GetId(), QString("Point%1").arg(i));
+    EXPECT_EQ(points[i]->GetNumMeasures(), 3);
+  }
+  qDeleteAll(points);
+}
+
+
+TEST_F(BinaryNetwork, ControlNetVersionerOversizedPoint) {
+  // A size prefix claiming the first point is 1 GB long
+  quint32 size = qToLittleEndian<quint32>(1024 * 1024 * 1024);
+  overwritePoints(0, QByteArray(reinterpret_cast<const char *>(&size), sizeof(size)));
+
+  try {
+    ControlNetVersioner versioner(FileName(networkFile));
+    FAIL() << "Expected an exception for an oversized point";
+  }
+  catch (IException &e) {
+    EXPECT_THAT(e.what(), testing::HasSubstr("byte limit"));
+  }
+}
+
+
+TEST_F(BinaryNetwork, ControlNetVersionerUnparsablePoint) {
+  // An invalid protobuf tag at the start of the first point message
+  overwritePoints(sizeof(quint32), QByteArray(4, char(0xFF)));
+
+  try {
+    ControlNetVersioner versioner(FileName(networkFile));
+    FAIL() << "Expected an exception for an unparsable point";
+  }
+  catch (IException &e) {
+    EXPECT_THAT(e.what(), testing::HasSubstr("control point at index [0]"));
+  }
+}
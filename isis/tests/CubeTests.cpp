@@ -1,3 +1,4 @@
+#include <QFile>
 #include <QTemporaryFile>
 #include <QString>
 #include <iostream>
@@ -6,8 +7,15 @@
 using json = nlohmann::json;
 
 #include "Blob.h"
+#include "Buffer.h"
 #include "Cube.h"
+#include "CubeAttribute.h"
 #include "Camera.h"
+#include "IException.h"
+#include "LineManager.h"
+#include "Portal.h"
+#include "Preference.h"
+#include "ProcessByLine.h"
 
 #include "CubeFixtures.h"
 #include "TestUtilities.h"
@@ -239,3 +247,147 @@ TEST_F(SmallCube, TestCubeHasBlob) {
   EXPECT_TRUE(testCube->hasBlob("TestBlob", "SomeBlob"));
   EXPECT_FALSE(testCube->hasBlob("SomeOtherTestBlob", "SomeBlob"));
 }
+
+TEST_F(SmallCube, TestCubeMemoryMappedRead) {
+  QString path = testCube->fileName();
+  testCube->close();
+
+  PvlGroup &performance = Preference::Preferences().findGroup("Performance");
+  performance.addKeyword(PvlKeyword("CubeReadMode", "MemoryMapped"), PvlContainer::Replace);
+
+  Cube mappedCube;
+  mappedCube.open(path, "r");
+  LineManager line(mappedCube);
+  double pixelValue = 0.0;
+  for(line.begin(); !line.end(); line++) {
+    mappedCube.read(line);
+    for(int i = 0; i < line.size(); i++) {
+      EXPECT_DOUBLE_EQ(line[i], pixelValue++);
+    }
+  }
+  EXPECT_TRUE(mappedCube.isMemoryMapped());
+  mappedCube.close();
+
+  // Writable cubes never map their data file
+  Cube writableCube;
+  writableCube.open(path, "rw");
+  line.begin();
+  writableCube.read(line);
+  EXPECT_FALSE(writableCube.isMemoryMapped());
+  writableCube.close();
+
+  performance.addKeyword(PvlKeyword("CubeReadMode", "Buffered"), PvlContainer::Replace);
+}
+
+TEST_F(SmallCube, TestCubeOverviews) {
+  EXPECT_EQ(testCube->overviewCount(), 0);
+
+  // 10x10 -> 5x5 -> 3x3 -> 2x2
+  testCube->createOverviews(2);
+  ASSERT_EQ(testCube->overviewCount(), 3);
+
+  QString path = testCube->fileName();
+  testCube->close();
+  testCube->open(path, "r");
+  ASSERT_EQ(testCube->overviewCount(), 3);
+
+  // Averages of 0, 1, 10, 11 and 88, 89, 98, 99
+  Portal portal(1, 1, testCube->pixelType());
+  portal.SetPosition(1, 1, 1);
+  testCube->read(portal, 1);
+  EXPECT_DOUBLE_EQ(portal[0], 5.5);
+  portal.SetPosition(5, 5, 1);
+  testCube->read(portal, 1);
+  EXPECT_DOUBLE_EQ(portal[0], 93.5);
+  portal.SetPosition(1, 1, 2);
+  testCube->read(portal, 1);
+  EXPECT_DOUBLE_EQ(portal[0], 105.5);
+
+  // Only the last pixel of level 1 is in the last pixel of level 2
+  portal.SetPosition(3, 3, 1);
+  testCube->read(portal, 2);
+  EXPECT_DOUBLE_EQ(portal[0], 93.5);
+  portal.SetPosition(1, 1, 1);
+  testCube->read(portal, 2);
+  EXPECT_DOUBLE_EQ(portal[0], 16.5);
+
+  // Level 0 is the cube itself
+  portal.SetPosition(2, 1, 1);
+  testCube->read(portal, 0);
+  EXPECT_DOUBLE_EQ(portal[0], 1.0);
+
+  EXPECT_THROW(testCube->read(portal, 4), IException);
+}
+
+TEST_F(SmallCube, TestCubeOverviewsRebuiltWithFewerLevels) {
+  QString base = tempDir.path() + "/small_overview";
+  testCube->createOverviews(2);
+  ASSERT_EQ(testCube->overviewCount(), 3);
+  EXPECT_TRUE(QFile::exists(base + "3.cub"));
+
+  // 10x10 -> 5x5
+  testCube->createOverviews(5);
+  EXPECT_EQ(testCube->overviewCount(), 1);
+  EXPECT_TRUE(QFile::exists(base + "1.cub"));
+  EXPECT_FALSE(QFile::exists(base + "2.cub"));
+  EXPECT_FALSE(QFile::exists(base + "3.cub"));
+
+  testCube->createOverviews(10);
+  EXPECT_EQ(testCube->overviewCount(), 0);
+  EXPECT_FALSE(testCube->hasGroup("Overviews"));
+  EXPECT_FALSE(QFile::exists(base + "1.cub"));
+}
+
+TEST_F(SmallCube, TestCubeOverviewsRemovedOnWrite) {
+  QString base = tempDir.path() + "/small_overview";
+  testCube->createOverviews(2);
+  ASSERT_EQ(testCube->overviewCount(), 3);
+
+  QString path = testCube->fileName();
+  testCube->close();
+  testCube->open(path, "rw");
+  ASSERT_EQ(testCube->overviewCount(), 3);
+
+  Portal portal(1, 1, testCube->pixelType());
+  portal.SetPosition(1, 1, 1);
+  testCube->read(portal, 1);
+  portal[0] = 50.0;
+  testCube->write(portal);
+  EXPECT_EQ(testCube->overviewCount(), 0);
+  EXPECT_FALSE(testCube->hasGroup("Overviews"));
+  EXPECT_FALSE(QFile::exists(base + "1.cub"));
+  EXPECT_FALSE(QFile::exists(base + "3.cub"));
+  EXPECT_THROW(testCube->read(portal, 1), IException);
+
+  testCube->close();
+  testCube->open(path, "r");
+  EXPECT_EQ(testCube->overviewCount(), 0);
+}
+
+static void copyLine(Buffer &in, Buffer &out) {
+  for (int i = 0; i < in.size(); i++) {
+    out[i] = in[i];
+  }
+}
+
+TEST_F(SmallCube, TestCubeOverviewsNotCopiedToOutputs) {
+  testCube->createOverviews(2);
+  ASSERT_EQ(testCube->overviewCount(), 3);
+
+  ProcessByLine p;
+  p.SetInputCube(testCube);
+  Cube *outputCube = p.SetOutputCube(tempDir.path() + "/copy.cub", CubeAttributeOutput(),
+                                     testCube->sampleCount(), testCube->lineCount(),
+                                     testCube->bandCount());
+  p.StartProcess(copyLine);
+  EXPECT_FALSE(outputCube->hasGroup("Overviews"));
+  EXPECT_EQ(outputCube->overviewCount(), 0);
+
+  // Overviews listed for another cube are not used
+  outputCube->putGroup(testCube->group("Overviews"));
+  EXPECT_EQ(outputCube->overviewCount(), 0);
+  Portal portal(1, 1, outputCube->pixelType());
+  portal.SetPosition(1, 1, 1);
+  EXPECT_THROW(outputCube->read(portal, 1), IException);
+  p.EndProcess();
+}
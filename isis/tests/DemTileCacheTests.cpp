@@ -0,0 +1,121 @@
+#include <QSharedPointer>
+
+#include "Camera.h"
+#include "CameraFactory.h"
+#include "Cube.h"
+#include "DemTileCache.h"
+#include "Portal.h"
+#include "Preference.h"
+#include "SpecialPixel.h"
+#include "SurfacePoint.h"
+
+#include "CameraFixtures.h"
+#include "CubeFixtures.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+TEST_F(SmallCube, DemTileCacheSharedPerCube) {
+  QSharedPointer<DemTileCache> cache = DemTileCache::forCube(testCube);
+  QSharedPointer<DemTileCache> sameCache = DemTileCache::forCube(testCube);
+  EXPECT_EQ(cache.data(), sameCache.data());
+}
+
+
+TEST_F(SmallCube, DemTileCacheMatchesPortal) {
+  QSharedPointer<DemTileCache> cache = DemTileCache::forCube(testCube);
+  DemTileCache::TilePtr lastTile;
+
+  // Includes neighborhoods that hang off of every edge of the cube
+  for (int line = -1; line <= 11; line++) {
+    for (int samp = -1; samp <= 11; samp++) {
+      Portal portal(2, 2, testCube->pixelType());
+      portal.SetPosition(samp, line, 1);
+      testCube->read(portal);
+
+      double buffer[4];
+      cache->read(0, samp, line, 2, 2, buffer, lastTile);
+      for (int i = 0; i < 4; i++) {
+        if (IsSpecial(portal[i])) {
+          EXPECT_EQ(buffer[i], portal[i]);
+        }
+        else {
+          EXPECT_DOUBLE_EQ(buffer[i], portal[i]);
+        }
+      }
+    }
+  }
+}
+
+
+TEST_F(SmallCube, DemTileCachePyramidLevels) {
+  QSharedPointer<DemTileCache> cache = DemTileCache::forCube(testCube);
+  DemTileCache::TilePtr lastTile;
+
+  EXPECT_EQ(cache->sampleCount(1), 5);
+  EXPECT_EQ(cache->lineCount(1), 5);
+  EXPECT_EQ(cache->sampleCount(2), 3);
+  EXPECT_EQ(cache->lineCount(3), 2);
+
+  // Averages of 0, 1, 10, 11 and 88, 89, 98, 99
+  double buffer[2];
+  cache->read(1, 1, 1, 1, 1, buffer, lastTile);
+  EXPECT_DOUBLE_EQ(buffer[0], 5.5);
+  cache->read(1, 5, 5, 1, 1, buffer, lastTile);
+  EXPECT_DOUBLE_EQ(buffer[0], 93.5);
+
+  // Only 88, 89, 98, 99 are in the cube
+  cache->read(2, 3, 3, 2, 1, buffer, lastTile);
+  EXPECT_DOUBLE_EQ(buffer[0], 93.5);
+  EXPECT_EQ(buffer[1], Null);
+}
+
+
+TEST_F(SmallCube, DemTileCacheSizePreference) {
+  PvlGroup &performance = Preference::Preferences().findGroup("Performance");
+  performance.addKeyword(PvlKeyword("DemTileCacheSize", "2"), PvlContainer::Replace);
+  QSharedPointer<DemTileCache> cache = DemTileCache::forCube(testCube);
+  performance.addKeyword(PvlKeyword("DemTileCacheSize", "2048"), PvlContainer::Replace);
+  EXPECT_EQ(cache->maximumTiles(), 2);
+
+  // Every level is one tile, so reading them evicts tiles
+  DemTileCache::TilePtr lastTile;
+  double buffer[1];
+  for (int level = 3; level >= 0; level--) {
+    cache->read(level, 1, 1, 1, 1, buffer, lastTile);
+  }
+  cache->read(1, 5, 5, 1, 1, buffer, lastTile);
+  EXPECT_DOUBLE_EQ(buffer[0], 93.5);
+  cache->read(0, 10, 10, 1, 1, buffer, lastTile);
+  EXPECT_DOUBLE_EQ(buffer[0], 99.0);
+}
+
+
+TEST_F(DemCube, DemShapePyramidLevelsIntersection) {
+  Camera *fullCam = testCube->camera();
+
+  PvlGroup &performance = Preference::Preferences().findGroup("Performance");
+  performance.addKeyword(PvlKeyword("DemPyramidLevels", "3"), PvlContainer::Replace);
+  Camera *pyramidCam = CameraFactory::Create(*testCube);
+  performance.addKeyword(PvlKeyword("DemPyramidLevels", "0"), PvlContainer::Replace);
+
+  // Intersections that start on the coarse levels still converge on the full
+  //   resolution DEM, so they find the same surface point within the
+  //   intersection tolerance of 1/100 of a pixel
+  for (int line = 1; line <= testCube->lineCount(); line += 150) {
+    for (int samp = 1; samp <= testCube->sampleCount(); samp += 150) {
+      ASSERT_TRUE(fullCam->SetImage(samp, line));
+      ASSERT_TRUE(pyramidCam->SetImage(samp, line));
+      double tolerance = fullCam->PixelResolution() / 50.0;
+      EXPECT_NEAR(pyramidCam->GetSurfacePoint().GetX().meters(),
+                  fullCam->GetSurfacePoint().GetX().meters(), tolerance);
+      EXPECT_NEAR(pyramidCam->GetSurfacePoint().GetY().meters(),
+                  fullCam->GetSurfacePoint().GetY().meters(), tolerance);
+      EXPECT_NEAR(pyramidCam->GetSurfacePoint().GetZ().meters(),
+                  fullCam->GetSurfacePoint().GetZ().meters(), tolerance);
+    }
+  }
+
+  delete pyramidCam;
+}
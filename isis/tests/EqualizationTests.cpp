@@ -0,0 +1,79 @@
+#include <sstream>
+
+#include <QString>
+#include <QThreadPool>
+
+#include "Cube.h"
+#include "Equalization.h"
+#include "FileList.h"
+#include "LeastSquares.h"
+#include "LineManager.h"
+#include "OverlapNormalization.h"
+#include "Pvl.h"
+
+#include "NetworkFixtures.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+namespace {
+  // Fills a cube with a ramp that differs from image to image
+  void fillCube(Cube *cube, double offset) {
+    LineManager line(*cube);
+    for (line.begin(); !line.end(); line++) {
+      for (int i = 0; i < line.size(); i++) {
+        line[i] = offset + 0.25 * (i + 1) + 0.5 * line.Line();
+      }
+      cube->write(line);
+    }
+  }
+
+
+  // Gathers the statistics of the images in a list with the given number of
+  //   threads and returns the results that would be written out
+  QString equalizationResults(QString fromList, int threads) {
+    QThreadPool *pool = QThreadPool::globalInstance();
+    int maxThreads = pool->maxThreadCount();
+    pool->setMaxThreadCount(threads);
+
+    Pvl results;
+    try {
+      Equalization equalizer(OverlapNormalization::Both, fromList);
+      equalizer.calculateStatistics(100.0, 10, false, LeastSquares::QRD);
+      results.addGroup(equalizer.getResults());
+    }
+    catch (...) {
+      pool->setMaxThreadCount(maxThreads);
+      throw;
+    }
+    pool->setMaxThreadCount(maxThreads);
+
+    std::stringstream resultsStream;
+    resultsStream << results;
+    return QString::fromStdString(resultsStream.str());
+  }
+}
+
+
+TEST_F(ThreeImageNetwork, EqualizationParallelMatchesSerial) {
+  fillCube(cube1map, 100.0);
+  fillCube(cube2map, 140.0);
+  fillCube(cube3map, 90.0);
+  cube1map->close();
+  cube2map->close();
+  cube3map->close();
+
+  FileList cubes;
+  cubes.append(tempDir.path() + "/cube1map.cub");
+  cubes.append(tempDir.path() + "/cube2map.cub");
+  cubes.append(tempDir.path() + "/cube3map.cub");
+  QString fromList = tempDir.path() + "/fromList.lis";
+  cubes.write(fromList);
+
+  QString serial = equalizationResults(fromList, 1);
+  QString parallel = equalizationResults(fromList, 4);
+
+  EXPECT_THAT(serial.toStdString(), ::testing::HasSubstr("ValidOverlaps"));
+  EXPECT_EQ(parallel.toStdString(), serial.toStdString());
+}
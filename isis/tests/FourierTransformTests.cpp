@@ -0,0 +1,65 @@
+#include <complex>
+#include <vector>
+
+#include "FourierTransform.h"
+#include "IException.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+TEST(FourierTransform, RealInputMatchesComplexInput) {
+  FourierTransform fft;
+  std::vector<double> real = {1.0, 4.0, 2.0, 8.0, 5.0, 7.0, 3.0, 0.5, 6.0, 2.5, 9.0};
+  std::vector< std::complex<double> > complexInput(real.begin(), real.end());
+
+  std::vector< std::complex<double> > fromReal = fft.Transform(real);
+  std::vector< std::complex<double> > fromComplex = fft.Transform(complexInput);
+
+  ASSERT_EQ(fromReal.size(), 16u);
+  ASSERT_EQ(fromComplex.size(), 16u);
+  for (unsigned int i = 0; i < fromReal.size(); i++) {
+    EXPECT_NEAR(fromReal[i].real(), fromComplex[i].real(), 1e-12);
+    EXPECT_NEAR(fromReal[i].imag(), fromComplex[i].imag(), 1e-12);
+  }
+}
+
+
+TEST(FourierTransform, InPlaceRoundTrip) {
+  FourierTransform fft;
+  std::vector< std::complex<double> > data(32);
+  for (unsigned int i = 0; i < data.size(); i++) {
+    data[i] = std::complex<double>(i, 32.0 - i);
+  }
+  std::vector< std::complex<double> > original = data;
+
+  fft.Transform(data.data(), data.size());
+  std::vector< std::complex<double> > copied = fft.Transform(original);
+  for (unsigned int i = 0; i < data.size(); i++) {
+    EXPECT_NEAR(data[i].real(), copied[i].real(), 1e-12);
+    EXPECT_NEAR(data[i].imag(), copied[i].imag(), 1e-12);
+  }
+
+  // The sum of the data is the first element of the transform
+  EXPECT_NEAR(data[0].real(), 496.0, 1e-12);
+  EXPECT_NEAR(data[0].imag(), 528.0, 1e-12);
+
+  fft.Inverse(data.data(), data.size());
+  for (unsigned int i = 0; i < data.size(); i++) {
+    EXPECT_NEAR(data[i].real(), original[i].real(), 1e-12);
+    EXPECT_NEAR(data[i].imag(), original[i].imag(), 1e-12);
+  }
+}
+
+
+TEST(FourierTransform, InPlaceNeedsPowerOfTwo) {
+  FourierTransform fft;
+  std::vector< std::complex<double> > data(12, std::complex<double>(1.0, 2.0));
+  EXPECT_THROW(fft.Transform(data.data(), data.size()), IException);
+
+  // The data is not changed when the size is rejected
+  EXPECT_THROW(fft.Inverse(data.data(), data.size()), IException);
+  for (size_t i = 0; i < data.size(); i++) {
+    EXPECT_EQ(data[i], std::complex<double>(1.0, 2.0));
+  }
+}
@@ -4,6 +4,7 @@
 #include <QtMath>
 #include <QFile>
 #include <QScopedPointer>
+#include <QThreadPool>
 
 #include "Pvl.h"
 #include "PvlGroup.h"
@@ -14,6 +15,7 @@
 #include "ControlPoint.h"
 #include "CSMCamera.h"
 #include "LidarData.h"
+#include "Preference.h"
 #include "SerialNumber.h"
 
 #include "jigsaw.h"
@@ -664,6 +666,65 @@ TEST_F(ApolloNetwork, FunctionalTestJigsawHeldList) {
 }
 
 
+TEST_F(ApolloNetwork, FunctionalTestJigsawThreadedNormals) {
+  PvlGroup &performance = Preference::Preferences().findGroup("Performance");
+  int threadCount = QThreadPool::globalInstance()->maxThreadCount();
+
+  // Serial, then threaded with two different numbers of threads
+  QStringList threadingModes;
+  threadingModes << "Never" << "Always" << "Always";
+  QList<int> threadCounts;
+  threadCounts << 1 << 2 << 4;
+  QStringList imagesOutputs;
+
+  for (int run = 0; run < threadingModes.size(); run++) {
+    performance.addKeyword(PvlKeyword("BundleAdjustThreading", threadingModes[run]),
+                           PvlContainer::Replace);
+    QThreadPool::globalInstance()->setMaxThreadCount(threadCounts[run]);
+
+    QString prefix = tempDir.path() + "/" + threadingModes[run] + QString::number(threadCounts[run]);
+    QVector<QString> args = {"fromlist="+cubeListFile, "cnet="+controlNetPath,
+                             "onet="+prefix+"_out.net", "radius=yes", "errorpropagation=yes",
+                             "spsolve=position", "Spacecraft_position_sigma=1000",
+                             "Camsolve=angles", "Twist=yes", "Camera_angles_sigma=2",
+                             "bundleout_txt=no", "update=no", "file_prefix="+prefix+"_"};
+    UserInterface options(APP_XML, args);
+
+    Pvl log;
+    try {
+      jigsaw(options, &log);
+    }
+    catch (IException &e) {
+      performance.addKeyword(PvlKeyword("BundleAdjustThreading", "Never"),
+                             PvlContainer::Replace);
+      QThreadPool::globalInstance()->setMaxThreadCount(threadCount);
+      FAIL() << "Unable to bundle: " << e.what() << std::endl;
+    }
+    imagesOutputs << prefix + "_bundleout_images.csv";
+  }
+
+  performance.addKeyword(PvlKeyword("BundleAdjustThreading", "Never"), PvlContainer::Replace);
+  QThreadPool::globalInstance()->setMaxThreadCount(threadCount);
+
+  CSVReader serial = CSVReader(imagesOutputs[0], false, 0, ',', false, true);
+  CSVReader twoThreads = CSVReader(imagesOutputs[1], false, 0, ',', false, true);
+  CSVReader fourThreads = CSVReader(imagesOutputs[2], false, 0, ',', false, true);
+  ASSERT_EQ(serial.rows(), twoThreads.rows());
+  ASSERT_EQ(serial.rows(), fourThreads.rows());
+  for (int row = 3; row < serial.rows(); row++) {
+    CSVReader::CSVAxis serialLine = serial.getRow(row);
+    CSVReader::CSVAxis twoThreadsLine = twoThreads.getRow(row);
+    CSVReader::CSVAxis fourThreadsLine = fourThreads.getRow(row);
+    ASSERT_EQ(serialLine.dim(), twoThreadsLine.dim());
+    ASSERT_EQ(serialLine.dim(), fourThreadsLine.dim());
+    for (int column = 0; column < serialLine.dim(); column++) {
+      EXPECT_EQ(twoThreadsLine[column], serialLine[column]);
+      EXPECT_EQ(fourThreadsLine[column], serialLine[column]);
+    }
+  }
+}
+
+
 TEST_F(ApolloNetwork, FunctionalTestJigsawOutlierRejection) {
   QTemporaryDir prefix;
 
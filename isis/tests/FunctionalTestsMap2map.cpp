@@ -1,10 +1,14 @@
 #include <QTemporaryDir>
+#include <QThreadPool>
 
+#include "CameraFixtures.h"
+#include "LineManager.h"
 #include "NetworkFixtures.h"
 #include "Pvl.h"
 #include "PvlGroup.h"
 #include "TestUtilities.h"
 #include "Histogram.h"
+#include "SpecialPixel.h"
 
 #include "map2map.h"
 
@@ -270,3 +274,72 @@ TEST(Map2mapTest, FunctionalTestMap2mapProjection) {
   EXPECT_EQ(hist->ValidPixels(), 0);
   EXPECT_NEAR(hist->StandardDeviation(), -1.7976931348623149e+308, .0001);
 }
+
+
+TEST_F(DefaultCube, FunctionalTestMap2mapThreadedMatchesSerial) {
+  std::istringstream mapStrm(R"(
+    Group = Mapping
+      ProjectionName     = Equirectangular
+      CenterLongitude    = 5.0 <degrees>
+      CenterLatitude     = 5.0 <degrees>
+      TargetName         = MARS
+      EquatorialRadius   = 3396190.0 <meters>
+      PolarRadius        = 3376200.0 <meters>
+      LatitudeType       = Planetocentric
+      LongitudeDirection = PositiveEast
+      LongitudeDomain    = 360 <degrees>
+      PixelResolution    = 2000.0 <meters/pixel>
+    End_Group
+  )");
+  Pvl userMap;
+  mapStrm >> userMap;
+  QString mapFileName = tempDir.path() + "/equirectangular.map";
+  userMap.write(mapFileName);
+
+  int threadCount = QThreadPool::globalInstance()->maxThreadCount();
+
+  // The output is several tiles wide, so the threaded run spreads its tiles
+  //   over the threads
+  QStringList outputs;
+  outputs << tempDir.path() + "/serial.cub" << tempDir.path() + "/threaded.cub";
+  for (int run = 0; run < outputs.size(); run++) {
+    QThreadPool::globalInstance()->setMaxThreadCount(run == 0 ? 1 : 4);
+
+    QVector<QString> args = {"from=" + projTestCube->fileName(),
+                             "to=" + outputs[run],
+                             "map=" + mapFileName,
+                             "pixres=map",
+                             "interp=bilinear"};
+    UserInterface options(APP_XML, args);
+    try {
+      map2map(options);
+    }
+    catch (IException &e) {
+      QThreadPool::globalInstance()->setMaxThreadCount(threadCount);
+      FAIL() << "Unable to project image: " << e.what() << std::endl;
+    }
+  }
+  QThreadPool::globalInstance()->setMaxThreadCount(threadCount);
+
+  Cube serialCube(outputs[0]);
+  Cube threadedCube(outputs[1]);
+  ASSERT_EQ(threadedCube.sampleCount(), serialCube.sampleCount());
+  ASSERT_EQ(threadedCube.lineCount(), serialCube.lineCount());
+  ASSERT_GT(serialCube.sampleCount(), 128);
+
+  LineManager serialLine(serialCube);
+  LineManager threadedLine(threadedCube);
+  int validPixels = 0;
+  for (serialLine.begin(), threadedLine.begin(); !serialLine.end();
+       serialLine++, threadedLine++) {
+    serialCube.read(serialLine);
+    threadedCube.read(threadedLine);
+    for (int i = 0; i < serialLine.size(); i++) {
+      EXPECT_EQ(threadedLine[i], serialLine[i]);
+      if (IsValidPixel(serialLine[i])) {
+        validPixels++;
+      }
+    }
+  }
+  EXPECT_GT(validPixels, 0);
+}
@@ -3,7 +3,10 @@
 #include "NetworkFixtures.h"
 #include "TestUtilities.h"
 #include "UserInterface.h"
+#include "ControlMeasure.h"
+#include "ControlMeasureLogData.h"
 #include "ControlNet.h"
+#include "ControlPoint.h"
 #include "LineManager.h"
 
 #include "gmock/gmock.h"
@@ -386,3 +389,65 @@ TEST_F(ThreeImageNetwork, FunctionalTestPointregValidationSkipped) {
   EXPECT_TRUE(falsePos.size() == 140);  // 140 is the size of the empty table due to column names
 }
 
+
+TEST_F(ThreeImageNetwork, FunctionalTestPointregThreadedMatchesSerial) {
+  QTemporaryDir prefix;
+  QString serialNetPath = prefix.path() + "/serialNet.net";
+  QString threadedNetPath = prefix.path() + "/threadedNet.net";
+  Pvl serialLog;
+  Pvl threadedLog;
+
+  QVector<QString> serialArgs = { "fromlist=" + cubeListFile,
+                                  "cnet=" + networkFile,
+                                  "deffile=data/threeImageNetwork/autoRegTemplate.def",
+                                  "onet=" + serialNetPath,
+                                  "points=all", "measures=all",
+                                  "maxthreads=1" };
+  QVector<QString> threadedArgs = { "fromlist=" + cubeListFile,
+                                    "cnet=" + networkFile,
+                                    "deffile=data/threeImageNetwork/autoRegTemplate.def",
+                                    "onet=" + threadedNetPath,
+                                    "points=all", "measures=all",
+                                    "maxthreads=4" };
+  UserInterface serialOptions(APP_XML, serialArgs);
+  UserInterface threadedOptions(APP_XML, threadedArgs);
+
+  try {
+    pointreg(serialOptions, &serialLog);
+    pointreg(threadedOptions, &threadedLog);
+  }
+  catch (IException &e) {
+    FAIL() << e.toString().toStdString().c_str() << std::endl;
+  }
+
+  PvlGroup serialMeasures = serialLog.findGroup("Measures");
+  PvlGroup threadedMeasures = threadedLog.findGroup("Measures");
+  EXPECT_EQ(int(threadedMeasures["Registered"]), int(serialMeasures["Registered"]));
+  EXPECT_EQ(int(threadedMeasures["NotIntersected"]), int(serialMeasures["NotIntersected"]));
+  EXPECT_EQ(int(threadedMeasures["Unregistered"]), int(serialMeasures["Unregistered"]));
+
+  ControlNet serialNet(serialNetPath);
+  ControlNet threadedNet(threadedNetPath);
+  ASSERT_EQ(threadedNet.GetNumPoints(), serialNet.GetNumPoints());
+  ASSERT_EQ(threadedNet.GetNumMeasures(), serialNet.GetNumMeasures());
+
+  for (int i = 0; i < serialNet.GetNumPoints(); i++) {
+    ControlPoint *serialPoint = serialNet.GetPoint(i);
+    ControlPoint *threadedPoint = threadedNet.GetPoint(i);
+    ASSERT_EQ(threadedPoint->GetId(), serialPoint->GetId());
+    EXPECT_EQ(threadedPoint->IsIgnored(), serialPoint->IsIgnored());
+    ASSERT_EQ(threadedPoint->GetNumMeasures(), serialPoint->GetNumMeasures());
+
+    for (int j = 0; j < serialPoint->GetNumMeasures(); j++) {
+      ControlMeasure *serialMeasure = serialPoint->GetMeasure(j);
+      ControlMeasure *threadedMeasure = threadedPoint->GetMeasure(j);
+      EXPECT_EQ(threadedMeasure->GetCubeSerialNumber(), serialMeasure->GetCubeSerialNumber());
+      EXPECT_EQ(threadedMeasure->GetType(), serialMeasure->GetType());
+      EXPECT_EQ(threadedMeasure->IsIgnored(), serialMeasure->IsIgnored());
+      EXPECT_EQ(threadedMeasure->GetSample(), serialMeasure->GetSample());
+      EXPECT_EQ(threadedMeasure->GetLine(), serialMeasure->GetLine());
+      EXPECT_EQ(threadedMeasure->GetLogData(ControlMeasureLogData::GoodnessOfFit).GetNumericalValue(),
+                serialMeasure->GetLogData(ControlMeasureLogData::GoodnessOfFit).GetNumericalValue());
+    }
+  }
+}
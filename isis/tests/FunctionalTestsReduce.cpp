@@ -3,6 +3,7 @@
 #include "PvlGroup.h"
 #include "TestUtilities.h"
 #include "Histogram.h"
+#include "LineManager.h"
 
 #include "reduce_app.h"
 
@@ -188,6 +189,66 @@ TEST_F(LargeCube, FunctionalTestReduceRoundOff) {
 
 }
 
+TEST_F(LargeCube, FunctionalTestReduceOverviews) {
+  QString fromName = testCube->fileName();
+  testCube->close();
+
+  QTemporaryDir prefix;
+  QString fullName = prefix.path() + "/full.cub";
+  QString overviewName = prefix.path() + "/overview.cub";
+  QVector<QString> fullArgs = {"from=" + fromName,
+                               "to=" + fullName,
+                               "algorithm=average",
+                               "mode=total",
+                               "ons=125",
+                               "onl=125"
+                              };
+  QVector<QString> overviewArgs = {"from=" + fromName,
+                                   "to=" + overviewName,
+                                   "algorithm=average",
+                                   "mode=total",
+                                   "ons=125",
+                                   "onl=125",
+                                   "overviews=create"
+                                  };
+
+  UserInterface fullOptions(APP_XML, fullArgs);
+  UserInterface overviewOptions(APP_XML, overviewArgs);
+  Pvl fullLog;
+  Pvl overviewLog;
+  try {
+    reduce(fullOptions, &fullLog);
+    reduce(overviewOptions, &overviewLog);
+  }
+  catch (IException &e) {
+    FAIL() << "Unable to reduce image: " << e.what() << std::endl;
+  }
+
+  // 1000x1000 -> 500x500 -> 250x250, and a scale of 8 averages level 2
+  Cube inCube(fromName);
+  EXPECT_EQ(inCube.overviewCount(), 2);
+  PvlGroup &overviewResults = overviewLog.findGroup("Results");
+  EXPECT_EQ(toInt(overviewResults["OverviewLevel"][0]), 2);
+  overviewResults.deleteKeyword("OverviewLevel");
+  EXPECT_PRED_FORMAT2(AssertPvlGroupEqual, overviewResults, fullLog.findGroup("Results"));
+
+  Cube fullCube(fullName);
+  Cube overviewCube(overviewName);
+  EXPECT_PRED_FORMAT2(AssertPvlGroupEqual, overviewCube.group("AlphaCube"),
+                      fullCube.group("AlphaCube"));
+
+  // All of the pixels are valid and the blocks line up with the levels
+  LineManager fullLine(fullCube);
+  LineManager overviewLine(overviewCube);
+  for (fullLine.begin(), overviewLine.begin(); !fullLine.end(); fullLine++, overviewLine++) {
+    fullCube.read(fullLine);
+    overviewCube.read(overviewLine);
+    for (int i = 0; i < fullLine.size(); i++) {
+      EXPECT_DOUBLE_EQ(overviewLine[i], fullLine[i]);
+    }
+  }
+}
+
 TEST_F(LargeCube, FunctionalTestReduceError) {
   QTemporaryDir prefix;
   QString outCubeFileName = prefix.path() + "/outTemp.cub";
@@ -1,4 +1,6 @@
 #include <iostream>
+#include <sstream>
+#include <QTemporaryDir>
 #include <QTemporaryFile>
 #include <QRegularExpression>
 
@@ -8,12 +10,15 @@
 #include "csminit.h"
 
 #include "Blob.h"
+#include "Camera.h"
 #include "Cube.h"
 #include "CubeAttribute.h"
+#include "FileList.h"
 #include "PixelType.h"
 #include "Pvl.h"
 #include "PvlGroup.h"
 #include "PvlKeyword.h"
+#include "Table.h"
 #include "TestUtilities.h"
 #include "FileName.h"
 
@@ -110,6 +115,158 @@ TEST(Spiceinit, TestSpiceinitPredictAndReconCk) {
 }
 
 
+TEST(Spiceinit, TestSpiceinitFromList) {
+
+  std::istringstream labelStrm(R"(
+    Object = IsisCube
+      Object = Core
+        StartByte   = 65537
+        Format      = Tile
+        TileSamples = 384
+        TileLines   = 288
+
+        Group = Dimensions
+          Samples = 384
+          Lines   = 288
+          Bands   = 1
+        End_Group
+
+        Group = Pixels
+          Type       = UnsignedByte
+          ByteOrder  = Lsb
+          Base       = 0.0
+          Multiplier = 1.0
+        End_Group
+      End_Object
+
+      Group = Instrument
+        SpacecraftName           = "CLEMENTINE 1"
+        InstrumentId             = UVVIS
+        TargetName               = MOON
+        StartTime                = 1994-03-05T08:21:22.626
+        OrbitNumber              = 063
+        FocalPlaneTemperature    = 273.633 <K>
+        ExposureDuration         = 20.3904 <ms>
+        OffsetModeID             = 6
+        GainModeID               = 1
+        CryocoolerDuration       = N/A
+        EncodingCompressionRatio = 3.55
+        EncodingFormat           = CLEM-JPEG-1
+      End_Group
+
+      Group = Archive
+        ProductID    = LUB5120P.063
+        MissionPhase = "LUNAR MAPPING"
+      End_Group
+
+      Group = BandBin
+        FilterName = B
+        Center     = 0.75 <micrometers>
+        Width      = 0.01 <micrometers>
+      End_Group
+
+      Group = Kernels
+        NaifFrameCode = -40022
+      End_Group
+    End_Object
+  End
+  )");
+
+  Pvl label;
+  labelStrm >> label;
+
+  // Two images of the same mission, spiceinit'd together and one at a time
+  QStringList startTimes = {"1994-03-05T08:21:22.626", "1994-03-05T08:23:40.120"};
+  QTemporaryDir prefix;
+  FileList listedCubes;
+  QStringList tableNames = {"InstrumentPointing", "InstrumentPosition",
+                            "BodyRotation", "SunPosition"};
+  QList<PvlGroup> expectedKernels;
+  QList<QStringList> expectedTables;
+  QStringList expectedNaifKeywords;
+  for (int i = 0; i < startTimes.size(); i++) {
+    label.findObject("IsisCube").findGroup("Instrument")["StartTime"] = startTimes[i];
+
+    Cube singleCube;
+    singleCube.fromLabel(prefix.path() + "/single" + toString(i) + ".cub", label, "rw");
+    QVector<QString> singleArgs = {"attach=true"};
+    UserInterface singleOptions(APP_XML, singleArgs);
+    spiceinit(&singleCube, singleOptions);
+    expectedKernels.append(singleCube.group("Kernels"));
+
+    QStringList tables;
+    for (const QString &tableName : tableNames) {
+      tables.append(Table::toString(singleCube.readTable(tableName)));
+    }
+    expectedTables.append(tables);
+
+    std::stringstream naifKeywords;
+    naifKeywords << singleCube.label()->findObject("NaifKeywords");
+    expectedNaifKeywords.append(QString::fromStdString(naifKeywords.str()));
+
+    Cube listedCube;
+    listedCube.fromLabel(prefix.path() + "/listed" + toString(i) + ".cub", label, "rw");
+    listedCubes.append(FileName(listedCube.fileName()));
+  }
+
+  QString fromList = prefix.path() + "/cubes.lis";
+  listedCubes.write(fromList);
+  QVector<QString> args = {"fromlist=" + fromList, "attach=true"};
+  UserInterface options(APP_XML, args);
+  Pvl appLog;
+  spiceinit(options, &appLog);
+
+  for (int i = 0; i < listedCubes.size(); i++) {
+    Cube listedCube(listedCubes[i].expanded());
+    PvlGroup kernels = listedCube.group("Kernels");
+    EXPECT_PRED_FORMAT2(AssertPvlGroupEqual, kernels, expectedKernels[i]);
+
+    // The SPICE computed from kept kernels is the same as from loading them again
+    for (int t = 0; t < tableNames.size(); t++) {
+      EXPECT_EQ(Table::toString(listedCube.readTable(tableNames[t])).toStdString(),
+                expectedTables[i][t].toStdString()) << tableNames[t].toStdString();
+    }
+    std::stringstream naifKeywords;
+    naifKeywords << listedCube.label()->findObject("NaifKeywords");
+    EXPECT_EQ(naifKeywords.str(), expectedNaifKeywords[i].toStdString());
+
+    // The camera still sees the same kernels, whether they were kept or
+    // loaded again
+    Camera *cam = listedCube.camera();
+    EXPECT_TRUE(cam->SetImage(192, 144));
+  }
+
+  // A cube that fails is logged and the rest of the list is still spiceinit'd
+  label.findObject("IsisCube").findGroup("Instrument")["StartTime"] = startTimes[0];
+  QString missingCube = prefix.path() + "/missing.cub";
+  Cube afterCube;
+  afterCube.fromLabel(prefix.path() + "/after.cub", label, "rw");
+  afterCube.close();
+  FileList failingCubes;
+  failingCubes.append(FileName(missingCube));
+  failingCubes.append(FileName(prefix.path() + "/after.cub"));
+  QString failingList = prefix.path() + "/failing.lis";
+  failingCubes.write(failingList);
+
+  QVector<QString> failingArgs = {"fromlist=" + failingList, "attach=true"};
+  UserInterface failingOptions(APP_XML, failingArgs);
+  Pvl failingLog;
+  try {
+    spiceinit(failingOptions, &failingLog);
+    FAIL() << "Expected an error for the missing cube";
+  }
+  catch (IException &e) {
+    EXPECT_THAT(e.what(), testing::HasSubstr("Unable to spiceinit [1] of [2] cubes"));
+  }
+  ASSERT_TRUE(failingLog.hasGroup("Warning"));
+  EXPECT_EQ(failingLog.findGroup("Warning")["FileName"][0], missingCube);
+
+  afterCube.open(prefix.path() + "/after.cub");
+  PvlGroup afterKernels = afterCube.group("Kernels");
+  EXPECT_PRED_FORMAT2(AssertPvlGroupEqual, afterKernels, expectedKernels[0]);
+}
+
+
 TEST(Spiceinit, TestSpiceinitCkConfigFile) {
 
   std::istringstream labelStrm(R"(
@@ -1,8 +1,13 @@
 #include <fstream>
 
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
 #include <QList>
 #include <QString>
 #include <QStringList>
+#include <QTemporaryDir>
 
 #include "FileName.h"
 #include "KernelDb.h"
@@ -336,6 +341,67 @@ TEST_F(KernelDbFixture, SystemCKConfig) {
   EXPECT_PRED_FORMAT2(AssertQStringsEqual, cks2[0], "$mro/kernels/ck/mro_crm_psp_080101_080131.bc");
 }
 
+TEST_F(KernelDbFixture, SystemKernelsReloaded) {
+  // A mission whose CK database names one kernel
+  QTemporaryDir missionDir;
+  ASSERT_TRUE(missionDir.isValid());
+  QStringList dbObjects = {"SpacecraftPointing", "Frame", "Instrument",
+                           "SpacecraftClock", "SpacecraftPosition", "InstrumentAddendum"};
+  QStringList dbDirs = {"ck", "fk", "ik", "sclk", "spk", "iak"};
+  for (int i = 0; i < dbDirs.size(); i++) {
+    ASSERT_TRUE(QDir().mkpath(missionDir.path() + "/kernels/" + dbDirs[i]));
+    std::ofstream db((missionDir.path() + "/kernels/" + dbDirs[i] + "/kernels.0001.db").toStdString());
+    db << "Object = " << dbObjects[i].toStdString() << "\nEnd_Object\nEnd\n";
+  }
+
+  QString ckDbPath = missionDir.path() + "/kernels/ck/kernels.0001.db";
+  auto writeCkDb = [&ckDbPath](QString kernel) {
+    std::ofstream db(ckDbPath.toStdString());
+    db << "Object = SpacecraftPointing\n"
+          "  Group = Selection\n"
+          "    Time = (\"2005 JAN 01 01:00:00.000 TDB\", \"2006 JAN 01 01:00:00.000 TDB\")\n"
+          "    File = (\"KernelDbTestMission\", \"kernels/ck/" << kernel.toStdString() << "\")\n"
+          "    Type = Reconstructed\n"
+          "  End_Group\n"
+          "End_Object\n"
+          "End\n";
+  };
+  auto setModified = [&ckDbPath](QDateTime modified) {
+    QFile db(ckDbPath);
+    ASSERT_TRUE(db.open(QIODevice::Append));
+    ASSERT_TRUE(db.setFileTime(modified, QFileDevice::FileModificationTime));
+  };
+  auto systemCk = [this]() {
+    KernelDb db(Kernel::Reconstructed);
+    db.loadSystemDb("KernelDbTestMission", cubeLabel);
+    QList< std::priority_queue<Kernel> > cklist = db.spacecraftPointing(cubeLabel);
+    if (cklist.size() != 1 || cklist[0].size() != 1) {
+      return QString();
+    }
+    QStringList cks = Kernel(cklist[0].top()).kernels();
+    return cks.size() == 1 ? cks[0] : QString();
+  };
+
+  PvlGroup &dataDir = Preference::Preferences().findGroup("DataDirectory");
+  dataDir += PvlKeyword("KernelDbTestMission", missionDir.path());
+
+  writeCkDb("first.bc");
+  QDateTime modified = QFileInfo(ckDbPath).lastModified();
+  EXPECT_PRED_FORMAT2(AssertQStringsEqual, systemCk(), "$KernelDbTestMission/kernels/ck/first.bc");
+
+  // The same size and modification time, so the database parsed for the
+  // first KernelDb is used instead of parsing the file again
+  writeCkDb("other.bc");
+  setModified(modified);
+  EXPECT_PRED_FORMAT2(AssertQStringsEqual, systemCk(), "$KernelDbTestMission/kernels/ck/first.bc");
+
+  // A changed file is parsed again
+  setModified(modified.addSecs(10));
+  EXPECT_PRED_FORMAT2(AssertQStringsEqual, systemCk(), "$KernelDbTestMission/kernels/ck/other.bc");
+
+  dataDir.deleteKeyword("KernelDbTestMission");
+}
+
 
 
 TEST_F(KernelDbFixture, TestKernelsSmithOffset) {
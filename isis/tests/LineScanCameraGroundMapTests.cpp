@@ -0,0 +1,71 @@
+#include <QList>
+#include <QPointF>
+
+#include "Camera.h"
+#include "CameraFactory.h"
+#include "LineScanCameraDetectorMap.h"
+#include "LineScanCameraGroundMap.h"
+#include "Preference.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "SurfacePoint.h"
+
+#include "CameraFixtures.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+TEST_F(MroCtxCube, LineScanCameraGroundMapInverseModel) {
+  Camera *cam = testCube->camera();
+
+  QList<QPointF> imagePoints;
+  QList<QPointF> groundPoints;
+  for (int line = 1; line <= 20; line += 19) {
+    for (int samp = 1; samp <= 20; samp += 19) {
+      ASSERT_TRUE(cam->SetImage(samp, line));
+      imagePoints << QPointF(samp, line);
+      groundPoints << QPointF(cam->UniversalLatitude(), cam->UniversalLongitude());
+    }
+  }
+  ASSERT_TRUE(cam->SetImage(10.5, 10.5));
+  imagePoints << QPointF(10.5, 10.5);
+  groundPoints << QPointF(cam->UniversalLatitude(), cam->UniversalLongitude());
+
+  PvlGroup &performance = Preference::Preferences().findGroup("Performance");
+  performance.addKeyword(PvlKeyword("LineScanInverseModel", "On"), PvlContainer::Replace);
+  Camera *modelCam = CameraFactory::Create(*testCube);
+  performance.addKeyword(PvlKeyword("LineScanInverseModel", "Off"), PvlContainer::Replace);
+
+  for (int i = 0; i < groundPoints.size(); i++) {
+    ASSERT_TRUE(modelCam->SetUniversalGround(groundPoints[i].x(), groundPoints[i].y()));
+    EXPECT_NEAR(modelCam->Sample(), imagePoints[i].x(), 0.02);
+    EXPECT_NEAR(modelCam->Line(), imagePoints[i].y(), 0.02);
+
+    ASSERT_TRUE(cam->SetUniversalGround(groundPoints[i].x(), groundPoints[i].y()));
+    EXPECT_NEAR(modelCam->Sample(), cam->Sample(), 0.02);
+    EXPECT_NEAR(modelCam->Line(), cam->Line(), 0.02);
+  }
+
+  delete modelCam;
+}
+
+
+TEST_F(MroCtxCube, LineScanCameraGroundMapApproximateLine) {
+  Camera *cam = testCube->camera();
+  LineScanCameraGroundMap *groundMap = (LineScanCameraGroundMap *) cam->GroundMap();
+  double lineRate = ((LineScanCameraDetectorMap *) cam->DetectorMap())->LineRate();
+
+  for (int line = 5; line <= 15; line += 5) {
+    ASSERT_TRUE(cam->SetImage(10.0, line));
+    SurfacePoint surfacePoint = cam->GetSurfacePoint();
+    double expectedTime = cam->time().Et();
+
+    // The search must end at the time that images the point, not at the
+    //   approximate line it started from
+    for (int offset = -3; offset <= 3; offset += 6) {
+      ASSERT_TRUE(groundMap->SetGround(surfacePoint, line + offset));
+      EXPECT_NEAR(cam->time().Et(), expectedTime, 0.05 * lineRate);
+    }
+  }
+}
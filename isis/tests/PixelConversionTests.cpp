@@ -0,0 +1,485 @@
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <QString>
+
+#include "EndianSwapper.h"
+#include "PixelConversion.h"
+#include "PixelType.h"
+#include "SpecialPixel.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+/**
+ * The per-pixel conversion CubeIoHandler::writeIntoDouble used before the
+ * conversion kernels were added. This is the reference the kernels are
+ * checked and timed against.
+ */
+static void legacyRawToDouble(PixelType pixelType, EndianSwapper *byteSwapper,
+                              const char *chunkBuf, char *buffersRawBuf,
+                              double *buffersDoubleBuf, int count,
+                              double multiplier, double base) {
+  for (int index = 0; index < count; index++) {
+    double &bufferVal = buffersDoubleBuf[index];
+
+    if (pixelType == Real) {
+      float raw = ((float *)chunkBuf)[index];
+      if (byteSwapper)
+        raw = byteSwapper->Float(&raw);
+
+      if (raw >= VALID_MIN4) {
+        bufferVal = (double) raw;
+      }
+      else {
+        if (raw == NULL4)
+          bufferVal = NULL8;
+        else if (raw == LOW_INSTR_SAT4)
+          bufferVal = LOW_INSTR_SAT8;
+        else if (raw == LOW_REPR_SAT4)
+          bufferVal = LOW_REPR_SAT8;
+        else if (raw == HIGH_INSTR_SAT4)
+          bufferVal = HIGH_INSTR_SAT8;
+        else if (raw == HIGH_REPR_SAT4)
+          bufferVal = HIGH_REPR_SAT8;
+        else
+          bufferVal = LOW_REPR_SAT8;
+      }
+
+      ((float *)buffersRawBuf)[index] = raw;
+    }
+    else if (pixelType == SignedWord) {
+      short raw = ((short *)chunkBuf)[index];
+      if (byteSwapper)
+        raw = byteSwapper->ShortInt(&raw);
+
+      if (raw >= VALID_MIN2) {
+        bufferVal = (double) raw * multiplier + base;
+      }
+      else {
+        if (raw == NULL2)
+          bufferVal = NULL8;
+        else if (raw == LOW_INSTR_SAT2)
+          bufferVal = LOW_INSTR_SAT8;
+        else if (raw == LOW_REPR_SAT2)
+          bufferVal = LOW_REPR_SAT8;
+        else if (raw == HIGH_INSTR_SAT2)
+          bufferVal = HIGH_INSTR_SAT8;
+        else if (raw == HIGH_REPR_SAT2)
+          bufferVal = HIGH_REPR_SAT8;
+        else
+          bufferVal = LOW_REPR_SAT8;
+      }
+
+      ((short *)buffersRawBuf)[index] = raw;
+    }
+    else if (pixelType == UnsignedWord) {
+      unsigned short raw = ((unsigned short *)chunkBuf)[index];
+      if (byteSwapper)
+        raw = byteSwapper->UnsignedShortInt(&raw);
+
+      if (raw >= VALID_MINU2) {
+        bufferVal = (double) raw * multiplier + base;
+      }
+      else {
+        if (raw == NULLU2)
+          bufferVal = NULL8;
+        else if (raw == LOW_INSTR_SATU2)
+          bufferVal = LOW_INSTR_SAT8;
+        else
+          bufferVal = LOW_REPR_SAT8;
+      }
+
+      ((unsigned short *)buffersRawBuf)[index] = raw;
+    }
+    else if (pixelType == UnsignedInteger) {
+      unsigned int raw = ((unsigned int *)chunkBuf)[index];
+      if (byteSwapper)
+        raw = byteSwapper->Uint32_t(&raw);
+
+      if (raw >= VALID_MINUI4) {
+        bufferVal = (double) raw * multiplier + base;
+      }
+      else {
+        if (raw == NULLUI4)
+          bufferVal = NULL8;
+        else if (raw == LOW_INSTR_SATUI4)
+          bufferVal = LOW_INSTR_SAT8;
+        else
+          bufferVal = LOW_REPR_SAT8;
+      }
+
+      ((unsigned int *)buffersRawBuf)[index] = raw;
+    }
+    else if (pixelType == UnsignedByte) {
+      unsigned char raw = ((unsigned char *)chunkBuf)[index];
+
+      if (raw == NULL1)
+        bufferVal = NULL8;
+      else if (raw == HIGH_REPR_SAT1)
+        bufferVal = HIGH_REPR_SAT8;
+      else
+        bufferVal = (double) raw * multiplier + base;
+
+      ((unsigned char *)buffersRawBuf)[index] = raw;
+    }
+  }
+}
+
+
+/**
+ * The per-pixel conversion CubeIoHandler::writeIntoRaw used before the
+ * conversion kernels were added. Only in range values and special pixels
+ * are compared, since some out of range values were not well defined here.
+ */
+static void legacyDoubleToRaw(PixelType pixelType, EndianSwapper *byteSwapper,
+                              const double *buffersDoubleBuf, char *chunkBuf,
+                              int count, double multiplier, double base) {
+  for (int index = 0; index < count; index++) {
+    double bufferVal = buffersDoubleBuf[index];
+
+    if (pixelType == Real) {
+      float raw = 0;
+
+      if (bufferVal >= VALID_MIN8) {
+        double filePixelValueDbl = (bufferVal - base) / multiplier;
+
+        if (filePixelValueDbl < (double) VALID_MIN4)
+          raw = LOW_REPR_SAT4;
+        else if (filePixelValueDbl > (double) VALID_MAX4)
+          raw = HIGH_REPR_SAT4;
+        else
+          raw = (float) filePixelValueDbl;
+      }
+      else {
+        if (bufferVal == NULL8)
+          raw = NULL4;
+        else if (bufferVal == LOW_INSTR_SAT8)
+          raw = LOW_INSTR_SAT4;
+        else if (bufferVal == LOW_REPR_SAT8)
+          raw = LOW_REPR_SAT4;
+        else if (bufferVal == HIGH_INSTR_SAT8)
+          raw = HIGH_INSTR_SAT4;
+        else if (bufferVal == HIGH_REPR_SAT8)
+          raw = HIGH_REPR_SAT4;
+        else
+          raw = LOW_REPR_SAT4;
+      }
+      ((float *)chunkBuf)[index] = byteSwapper ? byteSwapper->Float(&raw) : raw;
+    }
+    else if (pixelType == SignedWord) {
+      short raw;
+
+      if (bufferVal >= VALID_MIN8) {
+        double filePixelValueDbl = (bufferVal - base) / multiplier;
+        if (filePixelValueDbl < VALID_MIN2 - 0.5) {
+          raw = LOW_REPR_SAT2;
+        }
+        if (filePixelValueDbl > VALID_MAX2 + 0.5) {
+          raw = HIGH_REPR_SAT2;
+        }
+        else {
+          int filePixelValue = (int)round(filePixelValueDbl);
+
+          if (filePixelValue < VALID_MIN2)
+            raw = LOW_REPR_SAT2;
+          else if (filePixelValue > VALID_MAX2)
+            raw = HIGH_REPR_SAT2;
+          else
+            raw = filePixelValue;
+        }
+      }
+      else {
+        if (bufferVal == NULL8)
+          raw = NULL2;
+        else if (bufferVal == LOW_INSTR_SAT8)
+          raw = LOW_INSTR_SAT2;
+        else if (bufferVal == LOW_REPR_SAT8)
+          raw = LOW_REPR_SAT2;
+        else if (bufferVal == HIGH_INSTR_SAT8)
+          raw = HIGH_INSTR_SAT2;
+        else if (bufferVal == HIGH_REPR_SAT8)
+          raw = HIGH_REPR_SAT2;
+        else
+          raw = LOW_REPR_SAT2;
+      }
+      ((short *)chunkBuf)[index] = byteSwapper ? byteSwapper->ShortInt(&raw) : raw;
+    }
+    else if (pixelType == UnsignedWord) {
+      unsigned short raw;
+
+      if (bufferVal >= VALID_MIN8) {
+        double filePixelValueDbl = (bufferVal - base) / multiplier;
+        if (filePixelValueDbl < VALID_MINU2 - 0.5) {
+          raw = LOW_REPR_SATU2;
+        }
+        if (filePixelValueDbl > VALID_MAXU2 + 0.5) {
+          raw = HIGH_REPR_SATU2;
+        }
+        else {
+          int filePixelValue = (int)round(filePixelValueDbl);
+
+          if (filePixelValue < VALID_MINU2)
+            raw = LOW_REPR_SATU2;
+          else if (filePixelValue > VALID_MAXU2)
+            raw = HIGH_REPR_SATU2;
+          else
+            raw = filePixelValue;
+        }
+      }
+      else {
+        if (bufferVal == NULL8)
+          raw = NULLU2;
+        else if (bufferVal == LOW_INSTR_SAT8)
+          raw = LOW_INSTR_SATU2;
+        else if (bufferVal == LOW_REPR_SAT8)
+          raw = LOW_REPR_SATU2;
+        else if (bufferVal == HIGH_INSTR_SAT8)
+          raw = HIGH_INSTR_SATU2;
+        else if (bufferVal == HIGH_REPR_SAT8)
+          raw = HIGH_REPR_SATU2;
+        else
+          raw = LOW_REPR_SATU2;
+      }
+      ((unsigned short *)chunkBuf)[index] =
+          byteSwapper ? byteSwapper->UnsignedShortInt(&raw) : raw;
+    }
+    else if (pixelType == UnsignedInteger) {
+      unsigned int raw;
+
+      if (bufferVal >= VALID_MINUI4) {
+        double filePixelValueDbl = (bufferVal - base) / multiplier;
+        if (filePixelValueDbl < VALID_MINUI4 - 0.5) {
+          raw = LOW_REPR_SATUI4;
+        }
+        if (filePixelValueDbl > VALID_MAXUI4) {
+          raw = HIGH_REPR_SATUI4;
+        }
+        else {
+          unsigned int filePixelValue = (unsigned int)round(filePixelValueDbl);
+
+          if (filePixelValue < VALID_MINUI4)
+            raw = LOW_REPR_SATUI4;
+          else if (filePixelValue > VALID_MAXUI4)
+            raw = HIGH_REPR_SATUI4;
+          else
+            raw = filePixelValue;
+        }
+      }
+      else {
+        if (bufferVal == NULL8)
+          raw = NULLUI4;
+        else if (bufferVal == LOW_INSTR_SAT8)
+          raw = LOW_INSTR_SATUI4;
+        else if (bufferVal == LOW_REPR_SAT8)
+          raw = LOW_REPR_SATUI4;
+        else if (bufferVal == HIGH_INSTR_SAT8)
+          raw = HIGH_INSTR_SATUI4;
+        else if (bufferVal == HIGH_REPR_SAT8)
+          raw = HIGH_REPR_SATUI4;
+        else
+          raw = LOW_REPR_SATUI4;
+      }
+      ((unsigned int *)chunkBuf)[index] = byteSwapper ? byteSwapper->Uint32_t(&raw) : raw;
+    }
+    else if (pixelType == UnsignedByte) {
+      unsigned char raw;
+
+      if (bufferVal >= VALID_MIN8) {
+        double filePixelValueDbl = (bufferVal - base) / multiplier;
+        if (filePixelValueDbl < VALID_MIN1 - 0.5) {
+          raw = LOW_REPR_SAT1;
+        }
+        else if (filePixelValueDbl > VALID_MAX1 + 0.5) {
+          raw = HIGH_REPR_SAT1;
+        }
+        else {
+          int filePixelValue = (int)(filePixelValueDbl + 0.5);
+
+          if (filePixelValue < VALID_MIN1)
+            raw = LOW_REPR_SAT1;
+          else if (filePixelValue > VALID_MAX1)
+            raw = HIGH_REPR_SAT1;
+          else
+            raw = (unsigned char)(filePixelValue);
+        }
+      }
+      else {
+        if (bufferVal == NULL8)
+          raw = NULL1;
+        else if (bufferVal == LOW_INSTR_SAT8)
+          raw = LOW_INSTR_SAT1;
+        else if (bufferVal == LOW_REPR_SAT8)
+          raw = LOW_REPR_SAT1;
+        else if (bufferVal == HIGH_INSTR_SAT8)
+          raw = HIGH_INSTR_SAT1;
+        else if (bufferVal == HIGH_REPR_SAT8)
+          raw = HIGH_REPR_SAT1;
+        else
+          raw = LOW_REPR_SAT1;
+      }
+      ((unsigned char *)chunkBuf)[index] = raw;
+    }
+  }
+}
+
+
+/**
+ * Builds a buffer of in range doubles for a pixel type with every special
+ * pixel value mixed in.
+ */
+static std::vector<double> testDoubles(PixelType pixelType, int count) {
+  std::vector<double> values(count);
+  const double specials[] = {NULL8, LOW_INSTR_SAT8, LOW_REPR_SAT8, HIGH_INSTR_SAT8, HIGH_REPR_SAT8};
+
+  double minimum = 1.0;
+  double maximum = 254.0;
+  if (pixelType == SignedWord) {
+    minimum = -32000.0;
+    maximum = 32000.0;
+  }
+  else if (pixelType == UnsignedWord) {
+    minimum = 3.0;
+    maximum = 65000.0;
+  }
+  else if (pixelType == UnsignedInteger) {
+    minimum = 3.0;
+    maximum = 4.0e9;
+  }
+  else if (pixelType == Real) {
+    minimum = -1.0e6;
+    maximum = 1.0e6;
+  }
+
+  for (int i = 0; i < count; i++) {
+    if (i % 97 == 13) {
+      values[i] = specials[(i / 97) % 5];
+    }
+    else {
+      values[i] = minimum + (maximum - minimum) * ((i * 7919) % 1000) / 999.0;
+    }
+  }
+
+  return values;
+}
+
+
+class PixelConversionTest : public ::testing::TestWithParam<std::pair<PixelType, QString>> {
+};
+
+
+TEST_P(PixelConversionTest, RawToDoubleMatchesLegacy) {
+  PixelType pixelType = GetParam().first;
+  EndianSwapper swapper(GetParam().second);
+  EndianSwapper *byteSwapper = swapper.willSwap() ? &swapper : NULL;
+  int count = 1021;
+  int pixelSize = SizeOf(pixelType);
+
+  std::vector<double> values = testDoubles(pixelType, count);
+  std::vector<char> raw(count * pixelSize);
+  legacyDoubleToRaw(pixelType, byteSwapper, values.data(), raw.data(), count, 1.0, 0.0);
+
+  std::vector<double> legacyDoubles(count);
+  std::vector<double> kernelDoubles(count);
+  std::vector<char> legacyRawCopy(count * pixelSize);
+  std::vector<char> kernelRawCopy(count * pixelSize);
+
+  legacyRawToDouble(pixelType, byteSwapper, raw.data(), legacyRawCopy.data(),
+                    legacyDoubles.data(), count, 1.0, 0.0);
+  PixelConversion::rawToDoubleKernel(pixelType, byteSwapper != NULL)(
+      raw.data(), kernelRawCopy.data(), kernelDoubles.data(), count, 1.0, 0.0);
+
+  EXPECT_EQ(0, memcmp(legacyDoubles.data(), kernelDoubles.data(), count * sizeof(double)));
+  EXPECT_EQ(legacyRawCopy, kernelRawCopy);
+}
+
+
+TEST_P(PixelConversionTest, DoubleToRawMatchesLegacy) {
+  PixelType pixelType = GetParam().first;
+  EndianSwapper swapper(GetParam().second);
+  EndianSwapper *byteSwapper = swapper.willSwap() ? &swapper : NULL;
+  int count = 1021;
+  int pixelSize = SizeOf(pixelType);
+
+  std::vector<double> values = testDoubles(pixelType, count);
+  std::vector<char> legacyRaw(count * pixelSize);
+  std::vector<char> kernelRaw(count * pixelSize);
+
+  legacyDoubleToRaw(pixelType, byteSwapper, values.data(), legacyRaw.data(), count, 2.0, 2.0);
+  PixelConversion::doubleToRawKernel(pixelType, byteSwapper != NULL)(
+      values.data(), kernelRaw.data(), count, 2.0, 2.0);
+
+  EXPECT_EQ(legacyRaw, kernelRaw);
+}
+
+
+/**
+ * Not a pass/fail test; this reports how long the legacy and kernel
+ * conversions take for one large chunk so changes to the kernels can be
+ * compared. It is disabled so it stays out of the unit suite, run it with
+ * --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*.
+ */
+TEST_P(PixelConversionTest, DISABLED_Benchmark) {
+  PixelType pixelType = GetParam().first;
+  EndianSwapper swapper(GetParam().second);
+  EndianSwapper *byteSwapper = swapper.willSwap() ? &swapper : NULL;
+  int count = 1 << 20;
+  int pixelSize = SizeOf(pixelType);
+  int repeats = 10;
+
+  std::vector<double> values = testDoubles(pixelType, count);
+  std::vector<char> raw(count * pixelSize);
+  std::vector<char> rawCopy(count * pixelSize);
+  std::vector<double> doubles(count);
+
+  PixelConversion::RawToDoubleKernel readKernel =
+      PixelConversion::rawToDoubleKernel(pixelType, byteSwapper != NULL);
+  PixelConversion::DoubleToRawKernel writeKernel =
+      PixelConversion::doubleToRawKernel(pixelType, byteSwapper != NULL);
+
+  typedef std::chrono::steady_clock Clock;
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < repeats; i++) {
+    legacyDoubleToRaw(pixelType, byteSwapper, values.data(), raw.data(), count, 1.0, 0.0);
+  }
+  Clock::time_point legacyWriteEnd = Clock::now();
+  for (int i = 0; i < repeats; i++) {
+    writeKernel(values.data(), raw.data(), count, 1.0, 0.0);
+  }
+  Clock::time_point kernelWriteEnd = Clock::now();
+  for (int i = 0; i < repeats; i++) {
+    legacyRawToDouble(pixelType, byteSwapper, raw.data(), rawCopy.data(), doubles.data(),
+                      count, 1.0, 0.0);
+  }
+  Clock::time_point legacyReadEnd = Clock::now();
+  for (int i = 0; i < repeats; i++) {
+    readKernel(raw.data(), rawCopy.data(), doubles.data(), count, 1.0, 0.0);
+  }
+  Clock::time_point kernelReadEnd = Clock::now();
+
+  typedef std::chrono::duration<double, std::milli> Milliseconds;
+  std::cout << PixelTypeName(pixelType).toStdString() << " "
+            << GetParam().second.toStdString() << ": read legacy "
+            << Milliseconds(legacyReadEnd - kernelWriteEnd).count() << " ms, kernel "
+            << Milliseconds(kernelReadEnd - legacyReadEnd).count() << " ms; write legacy "
+            << Milliseconds(legacyWriteEnd - start).count() << " ms, kernel "
+            << Milliseconds(kernelWriteEnd - legacyWriteEnd).count() << " ms" << std::endl;
+}
+
+
+INSTANTIATE_TEST_SUITE_P(
+    PixelConversion,
+    PixelConversionTest,
+    ::testing::Values(std::make_pair(UnsignedByte, QString("Lsb")),
+                      std::make_pair(SignedWord, QString("Lsb")),
+                      std::make_pair(SignedWord, QString("Msb")),
+                      std::make_pair(UnsignedWord, QString("Lsb")),
+                      std::make_pair(UnsignedWord, QString("Msb")),
+                      std::make_pair(UnsignedInteger, QString("Lsb")),
+                      std::make_pair(UnsignedInteger, QString("Msb")),
+                      std::make_pair(Real, QString("Lsb")),
+                      std::make_pair(Real, QString("Msb"))));
@@ -0,0 +1,55 @@
+#include "BoxcarManager.h"
+#include "Buffer.h"
+#include "Cube.h"
+#include "LineManager.h"
+#include "ProcessByBoxcar.h"
+#include "SpecialPixel.h"
+
+#include "CubeFixtures.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+static double sumValid(Buffer &in) {
+  double sum = 0.0;
+  for (int i = 0; i < in.size(); i++) {
+    if (IsValidPixel(in[i])) {
+      sum += in[i] * (i + 1);
+    }
+  }
+  return sum;
+}
+
+static void sumBoxcar(Buffer &in, double &out) {
+  out = sumValid(in);
+}
+
+
+TEST_F(SmallCube, ProcessByBoxcarMatchesCubeReads) {
+  Cube outputCube;
+  outputCube.setDimensions(testCube->sampleCount(), testCube->lineCount(),
+                           testCube->bandCount());
+  outputCube.create(tempDir.path() + "/boxcar.cub");
+
+  ProcessByBoxcar p;
+  p.SetBoxcarSize(4, 3);
+  p.SetInputCube(testCube);
+  p.AddOutputCube(&outputCube, false);
+  p.StartProcess(sumBoxcar);
+  p.EndProcess();
+
+  // Every boxcar, including the ones hanging off the edges of the cube,
+  //   must be the same as reading it from the cube
+  BoxcarManager box(*testCube, 4, 3);
+  LineManager line(outputCube);
+  box.begin();
+  for (line.begin(); !line.end(); line++) {
+    outputCube.read(line);
+    for (int i = 0; i < line.size(); i++) {
+      testCube->read(box);
+      EXPECT_DOUBLE_EQ(line[i], sumValid(box));
+      box++;
+    }
+  }
+}
@@ -0,0 +1,106 @@
+#include <QString>
+
+#include "Buffer.h"
+#include "Cube.h"
+#include "LineManager.h"
+#include "ProcessByLine.h"
+
+#include "CubeFixtures.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+static void doubleLine(Buffer &in, Buffer &out) {
+  for (int i = 0; i < in.size(); i++) {
+    out[i] = in[i] * 2.0;
+  }
+}
+
+static void negateLine(Buffer &inout) {
+  for (int i = 0; i < inout.size(); i++) {
+    inout[i] = -inout[i];
+  }
+}
+
+static void sumLines(std::vector<Buffer *> &in, std::vector<Buffer *> &out) {
+  for (int i = 0; i < in[0]->size(); i++) {
+    (*out[0])[i] = (*in[0])[i] + (*in[1])[i];
+  }
+}
+
+
+TEST_F(SmallCube, ProcessByLineThreadedDefaultsToPreference) {
+  ProcessByLine p;
+  EXPECT_FALSE(p.Threaded());
+  p.SetThreaded(true);
+  EXPECT_TRUE(p.Threaded());
+}
+
+
+TEST_F(SmallCube, ProcessByLineThreadedInputOutput) {
+  Cube outputCube;
+  outputCube.setDimensions(testCube->sampleCount(), testCube->lineCount(),
+                           testCube->bandCount());
+  outputCube.create(tempDir.path() + "/doubled.cub");
+
+  ProcessByLine p;
+  p.SetThreaded(true);
+  p.SetInputCube(testCube);
+  p.AddOutputCube(&outputCube, false);
+  p.StartProcess(doubleLine);
+  p.EndProcess();
+
+  LineManager inputLine(*testCube);
+  LineManager outputLine(outputCube);
+  for (inputLine.begin(), outputLine.begin(); !inputLine.end(); inputLine++, outputLine++) {
+    testCube->read(inputLine);
+    outputCube.read(outputLine);
+    for (int i = 0; i < inputLine.size(); i++) {
+      EXPECT_DOUBLE_EQ(outputLine[i], inputLine[i] * 2.0);
+    }
+  }
+}
+
+
+TEST_F(SmallCube, ProcessByLineThreadedInPlace) {
+  ProcessByLine p;
+  p.SetThreaded(true);
+  p.SetInputCube(testCube);
+  p.StartProcess(negateLine);
+  p.EndProcess();
+
+  LineManager line(*testCube);
+  double pixelValue = 0.0;
+  for (line.begin(); !line.end(); line++) {
+    testCube->read(line);
+    for (int i = 0; i < line.size(); i++) {
+      EXPECT_DOUBLE_EQ(line[i], -(pixelValue++));
+    }
+  }
+}
+
+
+TEST_F(SmallCube, ProcessByLineThreadedMultipleCubes) {
+  Cube outputCube;
+  outputCube.setDimensions(testCube->sampleCount(), testCube->lineCount(),
+                           testCube->bandCount());
+  outputCube.create(tempDir.path() + "/summed.cub");
+
+  ProcessByLine p;
+  p.SetThreaded(true);
+  p.SetInputCube(testCube);
+  p.SetInputCube(testCube);
+  p.AddOutputCube(&outputCube, false);
+  p.StartProcess(sumLines);
+  p.EndProcess();
+
+  LineManager line(outputCube);
+  double pixelValue = 0.0;
+  for (line.begin(); !line.end(); line++) {
+    outputCube.read(line);
+    for (int i = 0; i < line.size(); i++) {
+      EXPECT_DOUBLE_EQ(line[i], 2.0 * (pixelValue++));
+    }
+  }
+}
@@ -0,0 +1,87 @@
+#include "Buffer.h"
+#include "Cube.h"
+#include "LineManager.h"
+#include "Portal.h"
+#include "ProcessByQuickFilter.h"
+#include "QuickFilter.h"
+#include "SpecialPixel.h"
+
+#include "CubeFixtures.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+// Replaces valid pixels with the boxcar average, like lowpass
+static void lowpassFilter(Buffer &in, Buffer &out, QuickFilter &filter) {
+  for (int i = 0; i < in.size(); i++) {
+    out[i] = IsValidPixel(in[i]) ? filter.Average(i) : in[i];
+  }
+}
+
+// Reflects an index that is off an edge back into [first, last]
+static int reflect(int index, int first, int last) {
+  if (index < first) return 2 * first - index;
+  if (index > last) return 2 * last - index;
+  return index;
+}
+
+
+TEST_F(SmallCube, ProcessByQuickFilterMatchesCubeReads) {
+  // Null some pixels, including ones on the edges of the cube
+  int nulls[][3] = {{1, 1, 1}, {5, 2, 1}, {10, 10, 1}, {3, 1, 2}, {7, 9, 3}};
+  Portal pixel(1, 1, testCube->pixelType());
+  for (auto &null : nulls) {
+    pixel.SetPosition(null[0], null[1], null[2]);
+    pixel[0] = Null;
+    testCube->write(pixel);
+  }
+
+  Cube outputCube;
+  outputCube.setDimensions(testCube->sampleCount(), testCube->lineCount(),
+                           testCube->bandCount());
+  outputCube.create(tempDir.path() + "/quickfilter.cub");
+
+  ProcessByQuickFilter p;
+  p.SetFilterParameters(3, 5);
+  p.SetInputCube(testCube);
+  p.AddOutputCube(&outputCube, false);
+  p.StartProcess(lowpassFilter);
+  p.EndProcess();
+
+  // Every boxcar, including the lines reflected off the top and bottom of
+  //   the cube, must be the same as reading its lines from the cube
+  int samples = testCube->sampleCount();
+  int lines = testCube->lineCount();
+  LineManager line(outputCube);
+  LineManager inLine(*testCube);
+  LineManager boxLine(*testCube);
+  for (line.begin(); !line.end(); line++) {
+    outputCube.read(line);
+    inLine.SetLine(line.Line(), line.Band());
+    testCube->read(inLine);
+
+    for (int i = 0; i < line.size(); i++) {
+      if (!IsValidPixel(inLine[i])) {
+        EXPECT_TRUE(IsNullPixel(line[i]));
+        continue;
+      }
+
+      double sum = 0.0;
+      int count = 0;
+      for (int l = line.Line() - 2; l <= line.Line() + 2; l++) {
+        boxLine.SetLine(reflect(l, 1, lines), line.Band());
+        testCube->read(boxLine);
+        for (int s = i - 1; s <= i + 1; s++) {
+          double value = boxLine[reflect(s, 0, samples - 1)];
+          if (IsValidPixel(value)) {
+            sum += value;
+            count++;
+          }
+        }
+      }
+
+      EXPECT_NEAR(line[i], sum / count, 1e-10);
+    }
+  }
+}
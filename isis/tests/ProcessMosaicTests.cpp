@@ -0,0 +1,152 @@
+#include <QString>
+#include <QVector>
+
+#include "Cube.h"
+#include "CubeAttribute.h"
+#include "LineManager.h"
+#include "ProcessMosaic.h"
+#include "SpecialPixel.h"
+
+#include "TempFixtures.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+namespace {
+  // Creates a cube where every pixel is value(sample, line, band)
+  QString createCube(QString path, int samples, int lines, int bands,
+                     double value(int, int, int)) {
+    Cube cube;
+    cube.setDimensions(samples, lines, bands);
+    cube.setPixelType(Real);
+    cube.create(path);
+
+    LineManager line(cube);
+    for (line.begin(); !line.end(); line++) {
+      for (int i = 0; i < line.size(); i++) {
+        line[i] = value(i + 1, line.Line(), line.Band());
+      }
+      cube.write(line);
+    }
+    cube.close();
+    return path;
+  }
+
+
+  double fiveValue(int, int, int) {
+    return 5.0;
+  }
+
+
+  double nullValue(int, int, int) {
+    return Null;
+  }
+
+
+  // Null mosaic bands followed by count bands of zero for averaging
+  double emptyMosaicValue(int, int, int band) {
+    return band == 1 ? Null : 0.0;
+  }
+
+
+  double inputValue(int sample, int line, int) {
+    if ((sample + line) % 5 == 0) {
+      return Null;
+    }
+    return sample * 3.0 + line;
+  }
+
+
+  // Places each input on a mosaic, one at a time or batched, and returns the
+  //   pixels of the mosaic
+  QVector<double> placeInputs(QString mosaicPath, QVector<QString> inputs,
+                              QVector<int> samples, QVector<int> lines,
+                              ProcessMosaic::ImageOverlay overlay, bool batch) {
+    ProcessMosaic p;
+    p.SetBandBinMatch(false);
+    p.SetImageOverlay(overlay);
+    p.AddOutputCube(new Cube(mosaicPath, "rw"));
+    if (batch) {
+      p.StartBatch();
+    }
+    for (int i = 0; i < inputs.size(); i++) {
+      CubeAttributeInput att;
+      p.SetInputCube(inputs[i], att);
+      p.StartProcess(samples[i], lines[i], 1);
+      p.ClearInputCubes();
+    }
+    if (batch) {
+      p.EndBatch();
+    }
+    p.EndProcess();
+
+    QVector<double> pixels;
+    Cube mosaic(mosaicPath);
+    LineManager line(mosaic);
+    for (line.begin(); !line.end(); line++) {
+      mosaic.read(line);
+      for (int i = 0; i < line.size(); i++) {
+        pixels.append(line[i]);
+      }
+    }
+    return pixels;
+  }
+}
+
+
+TEST_F(TempTestingFiles, ProcessMosaicSkipsUnchangedLines) {
+  QString mosaicPath = createCube(tempDir.path() + "/mosaic.cub", 10, 10, 1, fiveValue);
+  QString validPath = createCube(tempDir.path() + "/valid.cub", 4, 4, 1, inputValue);
+  QString nullPath = createCube(tempDir.path() + "/null.cub", 4, 4, 1, nullValue);
+
+  // Nothing is placed on a full mosaic, so writing any line to the read-only
+  //   mosaic would fail
+  ProcessMosaic p;
+  p.SetBandBinMatch(false);
+  p.AddOutputCube(new Cube(mosaicPath, "r"));
+
+  CubeAttributeInput att;
+  p.SetImageOverlay(ProcessMosaic::PlaceImagesBeneath);
+  p.SetInputCube(validPath, att);
+  EXPECT_NO_THROW(p.StartProcess(3, 3, 1));
+  p.ClearInputCubes();
+
+  p.SetImageOverlay(ProcessMosaic::PlaceImagesOnTop);
+  p.SetInputCube(nullPath, att);
+  EXPECT_NO_THROW(p.StartProcess(5, 5, 1));
+  p.ClearInputCubes();
+
+  // Placing valid pixels on top still writes
+  p.SetInputCube(validPath, att);
+  EXPECT_ANY_THROW(p.StartProcess(5, 5, 1));
+  p.EndProcess();
+}
+
+
+TEST_F(TempTestingFiles, ProcessMosaicBatchMatchesSingleInputs) {
+  QVector<QString> inputs;
+  inputs.append(createCube(tempDir.path() + "/input1.cub", 6, 5, 1, inputValue));
+  inputs.append(createCube(tempDir.path() + "/input2.cub", 7, 6, 1, inputValue));
+  inputs.append(createCube(tempDir.path() + "/input3.cub", 5, 8, 1, inputValue));
+  QVector<int> samples = {1, 4, -1};
+  QVector<int> lines = {2, 0, 5};
+
+  QVector<ProcessMosaic::ImageOverlay> overlays = {ProcessMosaic::PlaceImagesOnTop,
+                                                   ProcessMosaic::PlaceImagesBeneath,
+                                                   ProcessMosaic::AverageImageWithMosaic};
+  foreach (ProcessMosaic::ImageOverlay overlay, overlays) {
+    int bands = (overlay == ProcessMosaic::AverageImageWithMosaic) ? 2 : 1;
+    QString single = createCube(tempDir.path() + "/single.cub", 12, 12, bands, emptyMosaicValue);
+    QString batched = createCube(tempDir.path() + "/batched.cub", 12, 12, bands, emptyMosaicValue);
+
+    QVector<double> expected = placeInputs(single, inputs, samples, lines, overlay, false);
+    QVector<double> actual = placeInputs(batched, inputs, samples, lines, overlay, true);
+
+    ASSERT_EQ(actual.size(), expected.size());
+    for (int i = 0; i < expected.size(); i++) {
+      EXPECT_EQ(actual[i], expected[i])
+          << "Pixel " << i << " with " << ProcessMosaic::OverlayToString(overlay).toStdString();
+    }
+  }
+}
@@ -426,6 +426,16 @@ TEST(PvlKeyword, testJsonSet) {
 		EXPECT_EQ(keyword[0], "2");
 }
 
+TEST(PvlKeyword, StringEqual) {
+  EXPECT_TRUE(PvlKeyword::stringEqual("TargetName", "TARGETNAME"));
+  EXPECT_TRUE(PvlKeyword::stringEqual("Target_Name", "target name"));
+  EXPECT_TRUE(PvlKeyword::stringEqual("_Target\tName\n", "TARGETNAME"));
+  EXPECT_TRUE(PvlKeyword::stringEqual("", "_ _"));
+  EXPECT_FALSE(PvlKeyword::stringEqual("TargetName", "TargetNames"));
+  EXPECT_FALSE(PvlKeyword::stringEqual("TargetName", "Target-Name"));
+  EXPECT_FALSE(PvlKeyword::stringEqual("", "A"));
+}
+
 void comparePvlKeywords(PvlKeyword pvlKeyword1, PvlKeyword pvlKeyword2)
 {
 	EXPECT_TRUE(PvlKeyword::stringEqual(pvlKeyword1.name(), pvlKeyword2.name()));
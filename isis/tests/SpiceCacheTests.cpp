@@ -0,0 +1,141 @@
+#include <QFile>
+
+#include <nlohmann/json.hpp>
+
+#include "Camera.h"
+#include "CameraFactory.h"
+#include "Preference.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "SpiceCache.h"
+#include "Table.h"
+#include "TableRecord.h"
+
+#include "CameraFixtures.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+namespace {
+  void setSpiceCacheDirectory(QString directory) {
+    PvlGroup &performance = Preference::Preferences().findGroup("Performance");
+    performance.addKeyword(PvlKeyword("SpiceCacheDirectory", directory), PvlContainer::Replace);
+  }
+
+  void setSpiceTableCache(QString onOff) {
+    PvlGroup &performance = Preference::Preferences().findGroup("Performance");
+    performance.addKeyword(PvlKeyword("SpiceTableCache", onOff), PvlContainer::Replace);
+  }
+}
+
+
+TEST_F(DefaultCube, SpiceCacheIsdFile) {
+  QString kernelFile = tempDir.path() + "/extra.tpc";
+  QFile kernel(kernelFile);
+  ASSERT_TRUE(kernel.open(QIODevice::WriteOnly));
+  kernel.write("\\begindata\nBODY499_RADII = ( 3396.19 3396.19 3376.2 )\n");
+  kernel.close();
+
+  PvlGroup &kernels = label.findObject("IsisCube").findGroup("Kernels");
+  kernels.addKeyword(PvlKeyword("Extra", kernelFile), PvlContainer::Replace);
+
+  setSpiceCacheDirectory("None");
+  EXPECT_TRUE(SpiceCache::isdFile(label).isEmpty());
+  EXPECT_FALSE(SpiceCache::enabled());
+
+  setSpiceCacheDirectory(tempDir.path() + "/spiceCache");
+  QString isdFile = SpiceCache::isdFile(label);
+  EXPECT_TRUE(isdFile.startsWith(tempDir.path() + "/spiceCache/"));
+
+  // Hit: the same label in another file uses the same file
+  Pvl otherCubeLabel = label;
+  otherCubeLabel.setFileName(tempDir.path() + "/other.cub");
+  EXPECT_EQ(SpiceCache::isdFile(otherCubeLabel), isdFile);
+
+  // Invalidation: different dimensions use another file
+  Pvl widerLabel = label;
+  widerLabel.findObject("IsisCube").findObject("Core").findGroup("Dimensions")
+            .findKeyword("Samples").setValue("2048");
+  EXPECT_NE(SpiceCache::isdFile(widerLabel), isdFile);
+
+  // Invalidation: a cropped cube uses another file
+  Pvl croppedLabel = label;
+  PvlGroup alphaCube("AlphaCube");
+  alphaCube += PvlKeyword("AlphaSamples", "1056");
+  alphaCube += PvlKeyword("AlphaLines", "1204");
+  alphaCube += PvlKeyword("AlphaStartingSample", "100.5");
+  alphaCube += PvlKeyword("AlphaStartingLine", "0.5");
+  alphaCube += PvlKeyword("AlphaEndingSample", "1056.5");
+  alphaCube += PvlKeyword("AlphaEndingLine", "1204.5");
+  alphaCube += PvlKeyword("BetaSamples", "956");
+  alphaCube += PvlKeyword("BetaLines", "1204");
+  croppedLabel.findObject("IsisCube").addGroup(alphaCube);
+  EXPECT_NE(SpiceCache::isdFile(croppedLabel), isdFile);
+
+  // Invalidation: a different observation time uses another file
+  Pvl laterLabel = label;
+  laterLabel.findObject("IsisCube").findGroup("Instrument")
+            .findKeyword("StartTime").setValue("1977-07-09T20:15:51");
+  EXPECT_NE(SpiceCache::isdFile(laterLabel), isdFile);
+
+  // Invalidation: changing a kernel file uses another file
+  ASSERT_TRUE(kernel.open(QIODevice::Append));
+  kernel.write("BODY499_PM = ( 176.630 350.89198226 0. )\n");
+  kernel.close();
+  EXPECT_NE(SpiceCache::isdFile(label), isdFile);
+
+  // Miss, then a hit after the ISD is saved
+  EXPECT_TRUE(SpiceCache::readIsd(isdFile).is_null());
+  nlohmann::json isd;
+  isd["name_model"] = "USGS_ASTRO_FRAME_SENSOR_MODEL";
+  isd["center_ephemeris_time"] = -709401200.26114;
+  isd["line_scan_rate"] = {{0.5, -0.25, 0.001}};
+  SpiceCache::writeIsd(isdFile, isd);
+  EXPECT_EQ(SpiceCache::readIsd(isdFile), isd);
+
+  setSpiceCacheDirectory("None");
+}
+
+
+TEST_F(DefaultCube, SpiceCacheTables) {
+  Pvl &cubeLabel = *testCube->label();
+
+  // Without the cache every read is a new copy of the records, even with
+  //   the ISD cache on
+  setSpiceCacheDirectory(tempDir.path() + "/spiceCache");
+  setSpiceTableCache("Off");
+  Table uncached1 = SpiceCache::table("InstrumentPointing", cubeLabel);
+  Table uncached2 = SpiceCache::table("InstrumentPointing", cubeLabel);
+  EXPECT_NE(uncached1.RecordData(0), uncached2.RecordData(0));
+
+  // Miss, then hits that share the records of the first read
+  setSpiceCacheDirectory("None");
+  setSpiceTableCache("On");
+  Table cached1 = SpiceCache::table("InstrumentPointing", cubeLabel);
+  Table cached2 = SpiceCache::table("InstrumentPointing", cubeLabel);
+  ASSERT_EQ(cached1.Records(), uncached1.Records());
+  EXPECT_EQ(cached1.RecordData(0), cached2.RecordData(0));
+  EXPECT_NE(cached1.RecordData(0), uncached1.RecordData(0));
+
+  // Cameras created with the cache are the same as without it
+  Camera *cachedCam = CameraFactory::Create(*testCube);
+  ASSERT_TRUE(cachedCam->SetImage(512, 512));
+  ASSERT_TRUE(testCube->camera()->SetImage(512, 512));
+  EXPECT_DOUBLE_EQ(cachedCam->UniversalLatitude(), testCube->camera()->UniversalLatitude());
+  EXPECT_DOUBLE_EQ(cachedCam->UniversalLongitude(), testCube->camera()->UniversalLongitude());
+  delete cachedCam;
+
+  // Invalidation: rewriting the table reads it again
+  Table rewritten = cached1;
+  TableRecord record = rewritten[rewritten.Records() - 1];
+  rewritten += record;
+  testCube->write(rewritten);
+
+  Table reread = SpiceCache::table("InstrumentPointing", cubeLabel);
+  EXPECT_EQ(reread.Records(), cached1.Records() + 1);
+  EXPECT_NE(reread.RecordData(0), cached1.RecordData(0));
+
+  setSpiceTableCache("Off");
+}
@@ -14,6 +14,7 @@
 #include <QDomDocument>
 
 #include <float.h>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -201,6 +202,98 @@ TEST(Statistics,ValidRange) {
 }
 
 
+TEST(Statistics,BatchMatchesSingleValues) {
+
+    Statistics batch;
+    Statistics single;
+    batch.SetValidRange(-50.0, 50.0);
+    single.SetValidRange(-50.0, 50.0);
+
+    // Odd length so both the paired and the leftover paths are used
+    double a[101];
+    for (int i = 0; i < 101; i++) {
+      a[i] = (i * 37 % 113) - 56.5;
+    }
+    a[3] = Null;
+    a[10] = Hrs;
+    a[11] = Lrs;
+    a[40] = His;
+    a[100] = Lis;
+
+    batch.AddData(a, 101);
+    for (int i = 0; i < 101; i++) {
+      single.AddData(a[i]);
+    }
+
+    EXPECT_EQ(batch.TotalPixels(), single.TotalPixels());
+    EXPECT_EQ(batch.ValidPixels(), single.ValidPixels());
+    EXPECT_EQ(batch.NullPixels(), 1);
+    EXPECT_EQ(batch.HrsPixels(), 1);
+    EXPECT_EQ(batch.LrsPixels(), 1);
+    EXPECT_EQ(batch.HisPixels(), 1);
+    EXPECT_EQ(batch.LisPixels(), 1);
+    EXPECT_EQ(batch.OverRangePixels(), single.OverRangePixels());
+    EXPECT_EQ(batch.UnderRangePixels(), single.UnderRangePixels());
+    EXPECT_DOUBLE_EQ(batch.Sum(), single.Sum());
+    EXPECT_DOUBLE_EQ(batch.SumSquare(), single.SumSquare());
+    EXPECT_DOUBLE_EQ(batch.Minimum(), single.Minimum());
+    EXPECT_DOUBLE_EQ(batch.Maximum(), single.Maximum());
+}
+
+TEST(Statistics,CompensatedSum) {
+
+    Statistics t;
+
+    // Adding these one at a time accumulates an error of about 1.0e-6
+    std::vector<double> a(1000000, 0.1);
+    t.AddData(a.data(), a.size());
+
+    EXPECT_DOUBLE_EQ(t.Sum(), 100000.0);
+}
+
+TEST(Statistics,Merge) {
+
+    Statistics whole;
+    Statistics first;
+    Statistics second;
+
+    double a[10] = {1.0, 2.0, 3.0, Null, Hrs, Lrs, His, Lis, 10.0, -1.0};
+    whole.AddData(a, 10);
+    first.AddData(a, 4);
+    second.AddData(a + 4, 6);
+    first.Merge(second);
+
+    EXPECT_EQ(first.TotalPixels(), whole.TotalPixels());
+    EXPECT_EQ(first.ValidPixels(), whole.ValidPixels());
+    EXPECT_EQ(first.NullPixels(), whole.NullPixels());
+    EXPECT_EQ(first.LisPixels(), whole.LisPixels());
+    EXPECT_EQ(first.LrsPixels(), whole.LrsPixels());
+    EXPECT_EQ(first.HisPixels(), whole.HisPixels());
+    EXPECT_EQ(first.HrsPixels(), whole.HrsPixels());
+    EXPECT_DOUBLE_EQ(first.Sum(), whole.Sum());
+    EXPECT_DOUBLE_EQ(first.SumSquare(), whole.SumSquare());
+    EXPECT_DOUBLE_EQ(first.Minimum(), whole.Minimum());
+    EXPECT_DOUBLE_EQ(first.Maximum(), whole.Maximum());
+    EXPECT_DOUBLE_EQ(first.Variance(), whole.Variance());
+}
+
+TEST(Statistics,MergeDifferentValidRange) {
+
+    Statistics t;
+    Statistics other;
+    other.SetValidRange(1.0, 6.0);
+
+    try {
+      t.Merge(other);
+      FAIL() << "Expected an exception when merging different valid ranges";
+    }
+    catch (IException &e) {
+      EXPECT_TRUE(e.toString().contains("Unable to merge statistics"))
+        << e.toString().toStdString();
+    }
+}
+
+
 
 
 TEST(Statistics,XMLReadWrite) {
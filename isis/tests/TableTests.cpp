@@ -1,4 +1,6 @@
 #include "Blob.h"
+#include "Endian.h"
+#include "IException.h"
 #include "TempFixtures.h"
 #include "Table.h"
 #include "TableField.h"
@@ -295,3 +297,167 @@ TEST(TableTests, Clear) {
 
   EXPECT_EQ(t.Records(), 0);
 }
+
+
+TEST(TableTests, CopiesAreIndependent) {
+  TableField f1("Column1", TableField::Integer);
+  TableField f2("Column2", TableField::Double);
+  TableRecord rec;
+  rec += f1;
+  rec += f2;
+  Table t("UNITTEST", rec);
+
+  rec[0] = 5;
+  rec[1] = 3.14;
+  t += rec;
+
+  Table t2 = t;
+  rec[0] = -1;
+  rec[1] = 0.5;
+  t2.Update(rec, 0);
+  t2 += rec;
+
+  ASSERT_EQ(t.Records(), 1);
+  EXPECT_EQ((int)t[0][0], 5);
+  EXPECT_DOUBLE_EQ((double)t[0][1], 3.14);
+
+  ASSERT_EQ(t2.Records(), 2);
+  EXPECT_EQ((int)t2[0][0], -1);
+  EXPECT_DOUBLE_EQ((double)t2[0][1], 0.5);
+
+  t2.Delete(0);
+  EXPECT_EQ(t2.Records(), 1);
+  EXPECT_EQ(t.Records(), 1);
+}
+
+
+TEST(TableTests, DoubleColumn) {
+  TableField f1("Column1", TableField::Integer);
+  TableField f2("Column2", TableField::Double, 2);
+  TableField f3("Column3", TableField::Text, 10);
+  TableField f4("Column4", TableField::Double);
+  TableRecord rec;
+  rec += f1;
+  rec += f2;
+  rec += f3;
+  rec += f4;
+  Table t("UNITTEST", rec);
+
+  for (int i = 0; i < 3; i++) {
+    rec[0] = i;
+    std::vector<double> pair;
+    pair.push_back(i + 0.25);
+    pair.push_back(i + 0.5);
+    rec[1] = pair;
+    rec[2] = "TEXT";
+    rec[3] = -i * 2.0;
+    t += rec;
+  }
+
+  std::vector<double> pairs = t.DoubleColumn(1);
+  ASSERT_EQ(pairs.size(), 6u);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_DOUBLE_EQ(pairs[2 * i], i + 0.25);
+    EXPECT_DOUBLE_EQ(pairs[2 * i + 1], i + 0.5);
+  }
+
+  std::vector<double> last = t.DoubleColumn(3);
+  ASSERT_EQ(last.size(), 3u);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_DOUBLE_EQ(last[i], -i * 2.0);
+  }
+
+  EXPECT_ANY_THROW(t.DoubleColumn(0));
+  EXPECT_ANY_THROW(t.DoubleColumn(2));
+}
+
+
+TEST(TableTests, FromSwappedBlob) {
+  TableField f1("Column1", TableField::Integer);
+  TableField f2("Column2", TableField::Double);
+  TableField f3("Column3", TableField::Text, 10);
+  TableField f4("Column4", TableField::Real);
+  TableRecord rec;
+  rec += f1;
+  rec += f2;
+  rec += f3;
+  rec += f4;
+  Table t("UNITTEST", rec);
+
+  rec[0] = 5;
+  rec[1] = 3.14;
+  rec[2] = "PI";
+  rec[3] = (float)2.5;
+  t += rec;
+
+  rec[0] = -1;
+  rec[1] = 0.5;
+  rec[2] = "HI";
+  rec[3] = (float)-0.75;
+  t += rec;
+
+  // Store the records in the other byte order
+  Blob tableBlob = t.toBlob();
+  for (int i = 0; i < t.Records(); i++) {
+    rec.Swap(tableBlob.getBuffer() + i * t.RecordSize());
+  }
+  tableBlob.Label()["ByteOrder"] = IsLsb() ? ByteOrderName(Msb) : ByteOrderName(Lsb);
+
+  Table t2(tableBlob);
+
+  ASSERT_EQ(t.Records(), t2.Records());
+  for (int i = 0; i < t.Records(); i++) {
+    EXPECT_EQ(TableRecord::toString(t[i]).toStdString(), TableRecord::toString(t2[i]).toStdString());
+  }
+}
+
+
+TEST(TableTests, RecordsLargerThanBlob) {
+  TableField f1("Column1", TableField::Double);
+  TableRecord rec;
+  rec += f1;
+  Table t("UNITTEST", rec);
+
+  rec[0] = 1.5;
+  t += rec;
+  t += rec;
+
+  // 300,000,000 records of 8 bytes overflow an int byte count
+  Blob hugeBlob = t.toBlob();
+  hugeBlob.Label()["Records"] = "300000000";
+  try {
+    Table t2(hugeBlob);
+    FAIL() << "Expected an exception for a table over the 2 GB limit";
+  }
+  catch (IException &e) {
+    EXPECT_TRUE(e.toString().contains("2 GB limit")) << e.toString().toStdString();
+  }
+
+  Blob shortBlob = t.toBlob();
+  shortBlob.Label()["Records"] = "3";
+  try {
+    Table t2(shortBlob);
+    FAIL() << "Expected an exception for more records than table data";
+  }
+  catch (IException &e) {
+    EXPECT_TRUE(e.toString().contains("do not fit")) << e.toString().toStdString();
+  }
+}
+
+
+TEST(TableTests, DeleteOutOfRange) {
+  TableField f1("Column1", TableField::Integer);
+  TableRecord rec;
+  rec += f1;
+  Table t("UNITTEST", rec);
+
+  rec[0] = 5;
+  t += rec;
+
+  EXPECT_ANY_THROW(t.Delete(-1));
+  EXPECT_ANY_THROW(t.Delete(1));
+  ASSERT_EQ(t.Records(), 1);
+
+  t.Delete(0);
+  EXPECT_EQ(t.Records(), 0);
+}
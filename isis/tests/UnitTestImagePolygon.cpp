@@ -69,6 +69,31 @@ TEST_F(DefaultCube, UnitTestImagePolygonSubPoly) {
   EXPECT_NEAR(10.126704, centroid->getY(), 1e-6);
 }
 
+TEST_F(DefaultCube, UnitTestImagePolygonRemembersImagePoints) {
+  ImagePolygon fresh;
+  fresh.Create(*testCube, 10, 10);
+
+  // A second footprint of the same cube reuses the image coordinates tested
+  //   by the first one, including the ones tested at coarser increments
+  ImagePolygon reused;
+  reused.Create(*testCube, 40, 40);
+  reused.Create(*testCube, 10, 10);
+  EXPECT_EQ(reused.numVertices(), fresh.numVertices());
+  EXPECT_EQ(reused.polyStr(), fresh.polyStr());
+
+  reused.Create(*testCube, 10, 10);
+  EXPECT_EQ(reused.numVertices(), fresh.numVertices());
+  EXPECT_EQ(reused.polyStr(), fresh.polyStr());
+
+  // Changing the limits forgets the remembered coordinates
+  ImagePolygon limited;
+  limited.Emission(30.0);
+  limited.Create(*testCube, 10, 10);
+  reused.Emission(30.0);
+  reused.Create(*testCube, 10, 10);
+  EXPECT_EQ(reused.polyStr(), limited.polyStr());
+}
+
 TEST_F(TempTestingFiles, UnitTestImagePolygonCross) {
   FileName isdFile("$ISISROOT/../isis/tests/data/footprintinit/cross.isd");
   FileName labelFile("$ISISROOT/../isis/tests/data/footprintinit/cross.pvl");